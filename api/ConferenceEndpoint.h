@@ -15,6 +15,7 @@ struct ConferenceEndpoint
     ice::IceSession::State iceState;
     transport::SrtpClient::State dtlsState;
     bridge::ActiveTalker activeTalkerInfo;
+    uint64_t cpuTimeMs = 0; // transport jobs
 
     bool operator==(const ConferenceEndpoint& rhs) const
     {
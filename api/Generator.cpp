@@ -2,219 +2,243 @@
 #include "api/BarbellDescription.h"
 #include "api/ConferenceEndpoint.h"
 #include "api/EndpointDescription.h"
+#include "api/JsonWriter.h"
 #include "api/utils.h"
 #include "utils/Base64.h"
+#include "utils/StringBuilder.h"
+#include <algorithm>
 
 namespace
 {
 
-template <typename T>
-void setIfExists(nlohmann::json& target, const char* name, const T& value)
-{
-    if (value.isSet())
-    {
-        target[name] = value.get();
-    }
-}
+using JsonBuilder = utils::DynamicStringBuilder;
+using JsonObject = json::writer::Object<JsonBuilder>;
+using JsonArray = json::writer::Array<JsonBuilder>;
 
-nlohmann::json generateTransport(const api::Transport& transport)
+// typical allocate response with a handful of candidates and codecs
+const size_t endpointResponseSize = 4096;
+
+void writeTransport(JsonBuilder& builder, const char* name, const api::Transport& transport)
 {
-    nlohmann::json transportJson;
-    transportJson["rtcp-mux"] = transport.rtcpMux;
+    JsonObject transportJson(builder, name);
+    transportJson.addProperty("rtcp-mux", transport.rtcpMux);
 
     if (transport.ice.isSet())
     {
         const auto& ice = transport.ice.get();
-        nlohmann::json iceJson;
-        iceJson["ufrag"] = ice.ufrag;
-        iceJson["pwd"] = ice.pwd;
+        JsonObject iceJson(builder, "ice");
+        iceJson.addProperty("ufrag", ice.ufrag);
+        iceJson.addProperty("pwd", ice.pwd);
 
-        iceJson["candidates"] = nlohmann::json::array();
+        JsonArray candidatesJson(builder, "candidates");
         for (const auto& candidate : ice.candidates)
         {
-            nlohmann::json candidateJson;
-            candidateJson["generation"] = candidate.generation;
-            candidateJson["component"] = candidate.component;
-            candidateJson["protocol"] = candidate.protocol;
-            candidateJson["port"] = candidate.port;
-            candidateJson["ip"] = candidate.ip;
-            candidateJson["foundation"] = candidate.foundation;
-            candidateJson["priority"] = candidate.priority;
-            candidateJson["type"] = candidate.type;
-            candidateJson["network"] = candidate.network;
-            setIfExists(candidateJson, "rel-port", candidate.relPort);
-            setIfExists(candidateJson, "rel-addr", candidate.relAddr);
-            iceJson["candidates"].push_back(candidateJson);
+            JsonObject candidateJson(builder);
+            candidateJson.addProperty("generation", candidate.generation);
+            candidateJson.addProperty("component", candidate.component);
+            candidateJson.addProperty("protocol", candidate.protocol);
+            candidateJson.addProperty("port", candidate.port);
+            candidateJson.addProperty("ip", candidate.ip);
+            candidateJson.addProperty("foundation", candidate.foundation);
+            candidateJson.addProperty("priority", candidate.priority);
+            candidateJson.addProperty("type", candidate.type);
+            candidateJson.addProperty("network", candidate.network);
+            if (candidate.relPort.isSet())
+            {
+                candidateJson.addProperty("rel-port", candidate.relPort.get());
+            }
+            if (candidate.relAddr.isSet())
+            {
+                candidateJson.addProperty("rel-addr", candidate.relAddr.get());
+            }
         }
-
-        transportJson["ice"] = iceJson;
     }
 
     if (transport.dtls.isSet())
     {
         const auto& dtls = transport.dtls.get();
-        nlohmann::json dtlsJson;
-        dtlsJson["type"] = dtls.type;
-        dtlsJson["hash"] = dtls.hash;
-        dtlsJson["setup"] = dtls.setup;
-        transportJson["dtls"] = dtlsJson;
+        JsonObject dtlsJson(builder, "dtls");
+        dtlsJson.addProperty("type", dtls.type);
+        dtlsJson.addProperty("hash", dtls.hash);
+        dtlsJson.addProperty("setup", dtls.setup);
     }
+
     if (!transport.sdesKeys.empty())
     {
-        transportJson["sdes"] = nlohmann::json::array();
-        for (auto sdesKey : transport.sdesKeys)
+        JsonArray sdesArrayJson(builder, "sdes");
+        for (const auto& sdesKey : transport.sdesKeys)
         {
-            nlohmann::json sdesJson;
-            sdesJson["key"] = utils::Base64::encode(sdesKey.keySalt, sdesKey.getLength());
-            sdesJson["profile"] = api::utils::toString(sdesKey.profile);
-            transportJson["sdes"].push_back(sdesJson);
+            JsonObject sdesJson(builder);
+            sdesJson.addProperty("key", utils::Base64::encode(sdesKey.keySalt, sdesKey.getLength()));
+            sdesJson.addProperty("profile", api::utils::toString(sdesKey.profile));
         }
     }
 
     if (transport.connection.isSet())
     {
-        nlohmann::json connectionJson;
-        connectionJson["port"] = transport.connection.get().port;
-        connectionJson["ip"] = transport.connection.get().ip;
-        transportJson["connection"] = connectionJson;
+        JsonObject connectionJson(builder, "connection");
+        connectionJson.addProperty("port", transport.connection.get().port);
+        connectionJson.addProperty("ip", transport.connection.get().ip);
     }
-
-    return transportJson;
 }
 
-nlohmann::json generatePayloadType(const api::PayloadType& payloadType)
+void writePayloadTypes(JsonBuilder& builder, const std::vector<api::PayloadType>& payloadTypes)
 {
-    nlohmann::json payloadTypeJson;
-
-    payloadTypeJson["id"] = payloadType.id;
-    payloadTypeJson["name"] = payloadType.name;
-    payloadTypeJson["clockrate"] = payloadType.clockRate;
-    setIfExists(payloadTypeJson, "channels", payloadType.channels);
-
-    payloadTypeJson["parameters"] = nlohmann::json::object();
-
-    for (const auto& parameter : payloadType.parameters)
+    JsonArray payloadTypesJson(builder, "payload-types");
+    for (const auto& payloadType : payloadTypes)
     {
-        payloadTypeJson["parameters"][parameter.first] = parameter.second;
-    }
+        JsonObject payloadTypeJson(builder);
+        payloadTypeJson.addProperty("id", payloadType.id);
+        payloadTypeJson.addProperty("name", payloadType.name);
+        payloadTypeJson.addProperty("clockrate", payloadType.clockRate);
+        if (payloadType.channels.isSet())
+        {
+            payloadTypeJson.addProperty("channels", payloadType.channels.get());
+        }
 
-    payloadTypeJson["rtcp-fbs"] = nlohmann::json::array();
-    for (const auto& rtcpFeedback : payloadType.rtcpFeedbacks)
-    {
-        nlohmann::json rtcpFeedbackJson;
-        rtcpFeedbackJson["type"] = rtcpFeedback.first;
-        setIfExists(rtcpFeedbackJson, "subtype", rtcpFeedback.second);
-        payloadTypeJson["rtcp-fbs"].push_back(rtcpFeedbackJson);
-    }
+        {
+            JsonObject parametersJson(builder, "parameters");
+            for (const auto& parameter : payloadType.parameters)
+            {
+                parametersJson.addProperty(parameter.first.c_str(), parameter.second);
+            }
+        }
 
-    return payloadTypeJson;
+        JsonArray rtcpFeedbacksJson(builder, "rtcp-fbs");
+        for (const auto& rtcpFeedback : payloadType.rtcpFeedbacks)
+        {
+            JsonObject rtcpFeedbackJson(builder);
+            rtcpFeedbackJson.addProperty("type", rtcpFeedback.first);
+            if (rtcpFeedback.second.isSet())
+            {
+                rtcpFeedbackJson.addProperty("subtype", rtcpFeedback.second.get());
+            }
+        }
+    }
 }
 
-nlohmann::json generateRtpHeaderExtensions(const std::vector<std::pair<uint32_t, std::string>>& rtpHeaderExtensions)
+void writeRtpHeaderExtensions(JsonBuilder& builder,
+    const std::vector<std::pair<uint32_t, std::string>>& rtpHeaderExtensions)
 {
-    auto rtpHeaderExtensionsJson = nlohmann::json::array();
-
+    JsonArray rtpHeaderExtensionsJson(builder, "rtp-hdrexts");
     for (const auto& rtpHeaderExtension : rtpHeaderExtensions)
     {
-        nlohmann::json rtpHeaderExtensionJson;
-        rtpHeaderExtensionJson["id"] = rtpHeaderExtension.first;
-        rtpHeaderExtensionJson["uri"] = rtpHeaderExtension.second;
-        rtpHeaderExtensionsJson.push_back(rtpHeaderExtensionJson);
+        JsonObject rtpHeaderExtensionJson(builder);
+        rtpHeaderExtensionJson.addProperty("id", rtpHeaderExtension.first);
+        rtpHeaderExtensionJson.addProperty("uri", rtpHeaderExtension.second);
     }
-
-    return rtpHeaderExtensionsJson;
 }
 
-} // namespace
-
-namespace api
+void writeSsrcs(JsonBuilder& builder, const std::vector<uint32_t>& ssrcs)
 {
+    JsonArray ssrcsJson(builder, "ssrcs");
+    for (const auto ssrc : ssrcs)
+    {
+        ssrcsJson.addElement(ssrc);
+    }
+}
 
-namespace Generator
+void writeVideoStreams(JsonBuilder& builder, const std::vector<api::VideoStream>& streams)
 {
+    JsonArray streamsJson(builder, "streams");
+    for (const auto& stream : streams)
+    {
+        JsonObject streamJson(builder);
+        {
+            JsonArray sourcesJson(builder, "sources");
+            for (const auto level : stream.sources)
+            {
+                JsonObject sourceJson(builder);
+                sourceJson.addProperty("main", level.main);
+                if (level.feedback != 0)
+                {
+                    sourceJson.addProperty("feedback", level.feedback);
+                }
+                if (level.fec != 0)
+                {
+                    sourceJson.addProperty("fec", level.fec);
+                }
+            }
+        }
+        streamJson.addProperty("content", stream.content);
+    }
+}
 
-nlohmann::json generateAllocateEndpointResponse(const EndpointDescription& channelsDescription)
+// writes the properties into the currently open object
+void writeAllocateEndpointResponse(JsonBuilder& builder, const api::EndpointDescription& channelsDescription)
 {
-    nlohmann::json responseJson;
-
     if (channelsDescription.bundleTransport.isSet())
     {
-        responseJson["bundle-transport"] = generateTransport(channelsDescription.bundleTransport.get());
+        writeTransport(builder, "bundle-transport", channelsDescription.bundleTransport.get());
     }
 
     if (channelsDescription.audio.isSet())
     {
         const auto& audio = channelsDescription.audio.get();
-        nlohmann::json audioJson;
+        JsonObject audioJson(builder, "audio");
         if (audio.transport.isSet())
         {
-            audioJson["transport"] = generateTransport(audio.transport.get());
-        }
-        audioJson["ssrcs"] = nlohmann::json::array();
-        for (const auto ssrc : audio.ssrcs)
-        {
-            audioJson["ssrcs"].push_back(ssrc);
-        }
-
-        audioJson["payload-types"] = nlohmann::json::array();
-        for (const auto& payloadType : audio.payloadTypes)
-        {
-            audioJson["payload-types"].push_back(generatePayloadType(payloadType));
+            writeTransport(builder, "transport", audio.transport.get());
         }
-        audioJson["rtp-hdrexts"] = generateRtpHeaderExtensions(audio.rtpHeaderExtensions);
-
-        responseJson["audio"] = audioJson;
+        writeSsrcs(builder, audio.ssrcs);
+        writePayloadTypes(builder, audio.payloadTypes);
+        writeRtpHeaderExtensions(builder, audio.rtpHeaderExtensions);
     }
 
     if (channelsDescription.video.isSet())
     {
         const auto& video = channelsDescription.video.get();
-        nlohmann::json videoJson;
+        JsonObject videoJson(builder, "video");
         if (video.transport.isSet())
         {
-            videoJson["transport"] = generateTransport(video.transport.get());
+            writeTransport(builder, "transport", video.transport.get());
         }
+        writeVideoStreams(builder, video.streams);
+        writePayloadTypes(builder, video.payloadTypes);
+        writeRtpHeaderExtensions(builder, video.rtpHeaderExtensions);
+    }
 
-        videoJson["streams"] = nlohmann::json::array();
-        for (const auto& stream : video.streams)
-        {
-            nlohmann::json streamJson;
-            streamJson["sources"] = nlohmann::json::array();
-            for (const auto level : stream.sources)
-            {
-                nlohmann::json sourceJson;
-                sourceJson["main"] = level.main;
-                if (level.feedback != 0)
-                {
-                    sourceJson["feedback"] = level.feedback;
-                }
-                streamJson["sources"].push_back(sourceJson);
-            }
-            streamJson["content"] = stream.content;
-            videoJson["streams"].push_back(streamJson);
-        }
+    if (channelsDescription.data.isSet())
+    {
+        const auto& data = channelsDescription.data.get();
+        JsonObject dataJson(builder, "data");
+        dataJson.addProperty("port", data.port);
+        dataJson.addProperty("max-message-size", data.maxMessageSize);
+    }
+}
 
-        videoJson["payload-types"] = nlohmann::json::array();
-        for (const auto& payloadType : video.payloadTypes)
-        {
-            videoJson["payload-types"].push_back(generatePayloadType(payloadType));
-        }
+} // namespace
 
-        videoJson["rtp-hdrexts"] = generateRtpHeaderExtensions(video.rtpHeaderExtensions);
+namespace api
+{
 
-        responseJson["video"] = videoJson;
-    }
+namespace Generator
+{
 
-    if (channelsDescription.data.isSet())
+std::string generateAllocateEndpointResponse(const EndpointDescription& channelsDescription)
+{
+    JsonBuilder builder(endpointResponseSize);
     {
-        const auto& data = channelsDescription.data.get();
-        nlohmann::json dataJson;
-        dataJson["port"] = data.port;
-        dataJson["max-message-size"] = data.maxMessageSize;
-        responseJson["data"] = dataJson;
+        JsonObject responseJson(builder);
+        writeAllocateEndpointResponse(builder, channelsDescription);
     }
+    return builder.release();
+}
 
-    return responseJson;
+std::string generateAllocateEndpointsResponse(const std::vector<EndpointDescription>& channelsDescriptions)
+{
+    JsonBuilder builder(endpointResponseSize * std::max(size_t(1), channelsDescriptions.size()));
+    {
+        JsonObject responseJson(builder);
+        JsonArray endpointsJson(builder, "endpoints");
+        for (const auto& channelsDescription : channelsDescriptions)
+        {
+            JsonObject endpointJson(builder);
+            endpointJson.addProperty("endpoint-id", channelsDescription.endpointId);
+            writeAllocateEndpointResponse(builder, channelsDescription);
+        }
+    }
+    return builder.release();
 }
 
 nlohmann::json generateConferenceEndpoint(const ConferenceEndpoint& endpoint)
@@ -225,6 +249,7 @@ nlohmann::json generateConferenceEndpoint(const ConferenceEndpoint& endpoint)
     jsonEndpoint.emplace("isActiveTalker", endpoint.isActiveTalker);
     jsonEndpoint.emplace("iceState", api::utils::toString(endpoint.iceState));
     jsonEndpoint.emplace("dtlsState", api::utils::toString(endpoint.dtlsState));
+    jsonEndpoint.emplace("cpuTimeMs", endpoint.cpuTimeMs);
 
     if (endpoint.isActiveTalker)
     {
@@ -267,72 +292,34 @@ nlohmann::json generateExtendedConferenceEndpoint(const ConferenceEndpointExtend
     return jsonEndpoint;
 }
 
-nlohmann::json generateAllocateBarbellResponse(const BarbellDescription& channelsDescription)
+std::string generateAllocateBarbellResponse(const BarbellDescription& channelsDescription)
 {
-    nlohmann::json responseJson;
-
-    responseJson["bundle-transport"] = generateTransport(channelsDescription.transport);
-
-    const auto& audio = channelsDescription.audio;
-    nlohmann::json audioJson;
-
-    audioJson["ssrcs"] = nlohmann::json::array();
-    for (const auto ssrc : audio.ssrcs)
-    {
-        audioJson["ssrcs"].push_back(ssrc);
-    }
-    audioJson["payload-types"] = nlohmann::json::array();
-    for (const auto& payloadType : audio.payloadTypes)
-    {
-        audioJson["payload-types"].push_back(generatePayloadType(payloadType));
-    }
-
-    audioJson["rtp-hdrexts"] = generateRtpHeaderExtensions(audio.rtpHeaderExtensions);
-
-    responseJson["audio"] = audioJson;
-
-    const auto& video = channelsDescription.video;
-
-    if (!video.streams.empty())
+    JsonBuilder builder(endpointResponseSize);
     {
-        nlohmann::json videoJson;
-        videoJson["streams"] = nlohmann::json::array();
+        JsonObject responseJson(builder);
+        writeTransport(builder, "bundle-transport", channelsDescription.transport);
 
-        for (const auto& stream : video.streams)
         {
-            nlohmann::json streamJson;
-            streamJson["sources"] = nlohmann::json::array();
-            for (const auto level : stream.sources)
-            {
-                nlohmann::json sourceJson;
-                sourceJson["main"] = level.main;
-                if (level.feedback != 0)
-                {
-                    sourceJson["feedback"] = level.feedback;
-                }
-                streamJson["sources"].push_back(sourceJson);
-            }
-            streamJson["content"] = stream.content;
-            videoJson["streams"].push_back(streamJson);
-
-            videoJson["payload-types"] = nlohmann::json::array();
-            for (const auto& payloadType : video.payloadTypes)
-            {
-                videoJson["payload-types"].push_back(generatePayloadType(payloadType));
-            }
+            const auto& audio = channelsDescription.audio;
+            JsonObject audioJson(builder, "audio");
+            writeSsrcs(builder, audio.ssrcs);
+            writePayloadTypes(builder, audio.payloadTypes);
+            writeRtpHeaderExtensions(builder, audio.rtpHeaderExtensions);
+        }
 
-            videoJson["rtp-hdrexts"] = generateRtpHeaderExtensions(video.rtpHeaderExtensions);
+        const auto& video = channelsDescription.video;
+        if (!video.streams.empty())
+        {
+            JsonObject videoJson(builder, "video");
+            writeVideoStreams(builder, video.streams);
+            writePayloadTypes(builder, video.payloadTypes);
+            writeRtpHeaderExtensions(builder, video.rtpHeaderExtensions);
         }
 
-        responseJson["video"] = std::move(videoJson);
+        JsonObject dataJson(builder, "data");
+        dataJson.addProperty("port", channelsDescription.data.port);
     }
-
-    const auto& data = channelsDescription.data;
-    nlohmann::json dataJson;
-    dataJson["port"] = data.port;
-    responseJson["data"] = dataJson;
-
-    return responseJson;
+    return builder.release();
 }
 
 } // namespace Generator
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "nlohmann/json.hpp"
+#include <string>
+#include <vector>
 
 namespace api
 {
@@ -13,10 +15,13 @@ struct BarbellDescription;
 namespace Generator
 {
 
-nlohmann::json generateAllocateEndpointResponse(const EndpointDescription& channelsDescription);
+// The allocate responses are written directly as text without building a json tree.
+std::string generateAllocateEndpointResponse(const EndpointDescription& channelsDescription);
+std::string generateAllocateEndpointsResponse(const std::vector<EndpointDescription>& channelsDescriptions);
+std::string generateAllocateBarbellResponse(const BarbellDescription& channelsDescription);
+
 nlohmann::json generateConferenceEndpoint(const ConferenceEndpoint&);
 nlohmann::json generateExtendedConferenceEndpoint(const ConferenceEndpointExtendedInfo&);
-nlohmann::json generateAllocateBarbellResponse(const BarbellDescription& channelsDescription);
 
 } // namespace Generator
 
@@ -0,0 +1,510 @@
+#include "api/JsonReader.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace json
+{
+namespace reader
+{
+
+Document::Document(const char* text, const size_t length)
+    : _text(text),
+      _end(text + length),
+      _tokens(_inlineTokens),
+      _count(0),
+      _capacity(inlineTokenCount),
+      _valid(false)
+{
+    if (!text || length >= UINT32_MAX)
+    {
+        return;
+    }
+
+    const char* cursor = text;
+    if (parseValue(cursor, 0))
+    {
+        skipSpace(cursor);
+        _valid = (cursor == _end);
+    }
+}
+
+uint32_t Document::addToken(const Type type, const char* begin)
+{
+    if (_count == _capacity)
+    {
+        const uint32_t capacity = _capacity * 2;
+        std::unique_ptr<Token[]> tokens(new Token[capacity]);
+        std::memcpy(tokens.get(), _tokens, _count * sizeof(Token));
+        _heapTokens = std::move(tokens);
+        _tokens = _heapTokens.get();
+        _capacity = capacity;
+    }
+
+    auto& token = _tokens[_count];
+    token.type = type;
+    token.begin = static_cast<uint32_t>(begin - _text);
+    token.end = token.begin;
+    token.next = _count + 1;
+    return _count++;
+}
+
+void Document::skipSpace(const char*& cursor) const
+{
+    while (cursor != _end && std::isspace(*cursor))
+    {
+        ++cursor;
+    }
+}
+
+bool Document::parseValue(const char*& cursor, const int depth)
+{
+    skipSpace(cursor);
+    if (cursor == _end)
+    {
+        return false;
+    }
+
+    switch (*cursor)
+    {
+    case '{':
+        return parseObject(cursor, depth + 1);
+    case '[':
+        return parseArray(cursor, depth + 1);
+    case '"':
+        return parseString(cursor);
+    case 't':
+        return parseLiteral(cursor, "true", Type::Boolean);
+    case 'f':
+        return parseLiteral(cursor, "false", Type::Boolean);
+    case 'n':
+        return parseLiteral(cursor, "null", Type::Null);
+    default:
+        return parseNumber(cursor);
+    }
+}
+
+bool Document::parseObject(const char*& cursor, const int depth)
+{
+    if (depth > maxDepth)
+    {
+        return false;
+    }
+
+    const auto index = addToken(Type::Object, cursor);
+    ++cursor;
+    skipSpace(cursor);
+    if (cursor != _end && *cursor == '}')
+    {
+        ++cursor;
+    }
+    else
+    {
+        for (;;)
+        {
+            skipSpace(cursor);
+            if (cursor == _end || *cursor != '"' || !parseString(cursor))
+            {
+                return false;
+            }
+
+            skipSpace(cursor);
+            if (cursor == _end || *cursor != ':')
+            {
+                return false;
+            }
+            ++cursor;
+
+            if (!parseValue(cursor, depth))
+            {
+                return false;
+            }
+
+            skipSpace(cursor);
+            if (cursor == _end)
+            {
+                return false;
+            }
+            if (*cursor == '}')
+            {
+                ++cursor;
+                break;
+            }
+            if (*cursor != ',')
+            {
+                return false;
+            }
+            ++cursor;
+        }
+    }
+
+    _tokens[index].end = static_cast<uint32_t>(cursor - _text);
+    _tokens[index].next = _count;
+    return true;
+}
+
+bool Document::parseArray(const char*& cursor, const int depth)
+{
+    if (depth > maxDepth)
+    {
+        return false;
+    }
+
+    const auto index = addToken(Type::Array, cursor);
+    ++cursor;
+    skipSpace(cursor);
+    if (cursor != _end && *cursor == ']')
+    {
+        ++cursor;
+    }
+    else
+    {
+        for (;;)
+        {
+            if (!parseValue(cursor, depth))
+            {
+                return false;
+            }
+
+            skipSpace(cursor);
+            if (cursor == _end)
+            {
+                return false;
+            }
+            if (*cursor == ']')
+            {
+                ++cursor;
+                break;
+            }
+            if (*cursor != ',')
+            {
+                return false;
+            }
+            ++cursor;
+        }
+    }
+
+    _tokens[index].end = static_cast<uint32_t>(cursor - _text);
+    _tokens[index].next = _count;
+    return true;
+}
+
+bool Document::parseString(const char*& cursor)
+{
+    const auto index = addToken(Type::String, cursor);
+    for (++cursor; cursor != _end; ++cursor)
+    {
+        const auto c = static_cast<unsigned char>(*cursor);
+        if (c == '"')
+        {
+            ++cursor;
+            _tokens[index].end = static_cast<uint32_t>(cursor - _text);
+            return true;
+        }
+        else if (c < 0x20)
+        {
+            return false;
+        }
+        else if (c == '\\')
+        {
+            if (++cursor == _end)
+            {
+                return false;
+            }
+
+            if (*cursor == 'u')
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    if (++cursor == _end || !std::isxdigit(*cursor))
+                    {
+                        return false;
+                    }
+                }
+            }
+            else if (*cursor == 0 || !std::strchr("\"\\/bfnrt", *cursor))
+            {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+bool Document::parseNumber(const char*& cursor)
+{
+    const auto index = addToken(Type::Number, cursor);
+    auto skipDigits = [this](const char*& position) {
+        const auto start = position;
+        while (position != _end && std::isdigit(*position))
+        {
+            ++position;
+        }
+        return position != start;
+    };
+
+    if (*cursor == '-')
+    {
+        ++cursor;
+    }
+    const auto integerStart = cursor;
+    if (!skipDigits(cursor) || (*integerStart == '0' && cursor - integerStart > 1))
+    {
+        // leading zeros are not allowed
+        return false;
+    }
+    if (cursor != _end && *cursor == '.')
+    {
+        ++cursor;
+        if (!skipDigits(cursor))
+        {
+            return false;
+        }
+    }
+    if (cursor != _end && (*cursor == 'e' || *cursor == 'E'))
+    {
+        ++cursor;
+        if (cursor != _end && (*cursor == '+' || *cursor == '-'))
+        {
+            ++cursor;
+        }
+        if (!skipDigits(cursor))
+        {
+            return false;
+        }
+    }
+
+    _tokens[index].end = static_cast<uint32_t>(cursor - _text);
+    return true;
+}
+
+bool Document::parseLiteral(const char*& cursor, const char* literal, const Type type)
+{
+    const size_t length = std::strlen(literal);
+    if (static_cast<size_t>(_end - cursor) < length || 0 != std::strncmp(cursor, literal, length))
+    {
+        return false;
+    }
+
+    const auto index = addToken(type, cursor);
+    cursor += length;
+    _tokens[index].end = static_cast<uint32_t>(cursor - _text);
+    return true;
+}
+
+Value::Iterator& Value::Iterator::operator++()
+{
+    _index = _document->_tokens[_index].next;
+    return *this;
+}
+
+const Token* Value::getToken() const
+{
+    return _document ? &_document->_tokens[_index] : nullptr;
+}
+
+Type Value::getType() const
+{
+    const auto* token = getToken();
+    return token ? token->type : Type::None;
+}
+
+Value Value::find(const char* name) const
+{
+    const auto* token = getToken();
+    if (!token || token->type != Type::Object)
+    {
+        return Value();
+    }
+
+    const size_t nameLength = std::strlen(name);
+    for (uint32_t nameIndex = _index + 1; nameIndex < token->next;)
+    {
+        const auto& nameToken = _document->_tokens[nameIndex];
+        if (nameToken.end - nameToken.begin == nameLength + 2 &&
+            0 == std::memcmp(_document->_text + nameToken.begin + 1, name, nameLength))
+        {
+            return Value(_document, nameIndex + 1);
+        }
+        nameIndex = _document->_tokens[nameIndex + 1].next;
+    }
+    return Value();
+}
+
+bool Value::getString(std::string& target) const
+{
+    target.clear();
+    if (!isString())
+    {
+        return false;
+    }
+
+    const auto* token = getToken();
+    const char* const end = _document->_text + token->end - 1;
+    target.reserve(token->end - token->begin - 2);
+    for (const char* cursor = _document->_text + token->begin + 1; cursor < end; ++cursor)
+    {
+        if (*cursor != '\\')
+        {
+            target.push_back(*cursor);
+            continue;
+        }
+
+        switch (*++cursor)
+        {
+        case 'b':
+            target.push_back('\b');
+            break;
+        case 'f':
+            target.push_back('\f');
+            break;
+        case 'n':
+            target.push_back('\n');
+            break;
+        case 'r':
+            target.push_back('\r');
+            break;
+        case 't':
+            target.push_back('\t');
+            break;
+        case 'u':
+        {
+            char hex[5] = {cursor[1], cursor[2], cursor[3], cursor[4], 0};
+            uint32_t codePoint = std::strtoul(hex, nullptr, 16);
+            cursor += 4;
+
+            if (codePoint >= 0xD800 && codePoint < 0xDC00 && end - cursor > 6 && cursor[1] == '\\' && cursor[2] == 'u')
+            {
+                char lowHex[5] = {cursor[3], cursor[4], cursor[5], cursor[6], 0};
+                const uint32_t low = std::strtoul(lowHex, nullptr, 16);
+                if (low >= 0xDC00 && low < 0xE000)
+                {
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    cursor += 6;
+                }
+            }
+
+            if (codePoint < 0x80)
+            {
+                target.push_back(static_cast<char>(codePoint));
+            }
+            else if (codePoint < 0x800)
+            {
+                target.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+                target.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+            else if (codePoint < 0x10000)
+            {
+                target.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+                target.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                target.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+            else
+            {
+                target.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+                target.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+                target.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                target.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+            break;
+        }
+        default:
+            target.push_back(*cursor);
+            break;
+        }
+    }
+    return true;
+}
+
+bool Value::equals(const char* text) const
+{
+    if (!isString())
+    {
+        return false;
+    }
+
+    const auto* token = getToken();
+    const size_t length = std::strlen(text);
+    return token->end - token->begin == length + 2 &&
+        0 == std::memcmp(_document->_text + token->begin + 1, text, length);
+}
+
+utils::Optional<int64_t> Value::getInt() const
+{
+    if (getType() != Type::Number)
+    {
+        return utils::Optional<int64_t>();
+    }
+
+    const auto* token = getToken();
+    const char* cursor = _document->_text + token->begin;
+    const char* const end = _document->_text + token->end;
+    const bool negative = (*cursor == '-');
+    if (negative)
+    {
+        ++cursor;
+    }
+
+    uint64_t value = 0;
+    for (; cursor != end; ++cursor)
+    {
+        if (!std::isdigit(*cursor))
+        {
+            // fraction or exponent
+            return utils::Optional<int64_t>();
+        }
+        const uint64_t digit = *cursor - '0';
+        if (value > (static_cast<uint64_t>(INT64_MAX) - digit) / 10)
+        {
+            return utils::Optional<int64_t>();
+        }
+        value = value * 10 + digit;
+    }
+
+    return utils::Optional<int64_t>(negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value));
+}
+
+utils::Optional<bool> Value::getBool() const
+{
+    if (getType() != Type::Boolean)
+    {
+        return utils::Optional<bool>();
+    }
+    return utils::Optional<bool>(_document->_text[getToken()->begin] == 't');
+}
+
+const char* Value::getText() const
+{
+    const auto* token = getToken();
+    return token ? _document->_text + token->begin : nullptr;
+}
+
+size_t Value::getTextLength() const
+{
+    const auto* token = getToken();
+    return token ? token->end - token->begin : 0;
+}
+
+Value::Elements Value::getElements() const
+{
+    const auto* token = getToken();
+    if (!token || token->type != Type::Array)
+    {
+        return Elements(Iterator(nullptr, 0), Iterator(nullptr, 0));
+    }
+    return Elements(Iterator(_document, _index + 1), Iterator(_document, token->next));
+}
+
+size_t Value::getElementCount() const
+{
+    size_t count = 0;
+    for (const auto& element : getElements())
+    {
+        (void)element;
+        ++count;
+    }
+    return count;
+}
+
+} // namespace reader
+} // namespace json
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "utils/Optional.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * Single pass json reader. The document text is validated and indexed into a flat token array, held inline for
+ * typical API requests and on the heap for larger ones. Values are views into the text, no tree is built and nothing
+ * is copied until a string is read. Each token knows where the next sibling starts so property lookups skip nested
+ * content without scanning it.
+ * example:
+ * Document document(body, length);
+ * if (document.isValid())
+ * {
+ *     auto ice = document.getRoot()["bundle-transport"]["ice"];
+ *     std::string ufrag;
+ *     ice["ufrag"].getString(ufrag);
+ *     for (const auto& candidate : ice["candidates"].getElements()) {...}
+ * }
+ * The document text must outlive the Document and its Values.
+ * */
+namespace json
+{
+namespace reader
+{
+
+enum class Type : uint8_t
+{
+    None,
+    Object,
+    Array,
+    String,
+    Number,
+    Boolean,
+    Null
+};
+
+struct Token
+{
+    Type type;
+    uint32_t begin; // offset of the first character
+    uint32_t end; // offset after the last character
+    uint32_t next; // index of the token following this value and its children
+};
+
+class Document;
+
+class Value
+{
+public:
+    class Iterator
+    {
+    public:
+        Iterator(const Document* document, uint32_t index) : _document(document), _index(index) {}
+
+        Value operator*() const { return Value(_document, _index); }
+        Iterator& operator++();
+        bool operator!=(const Iterator& it) const { return _index != it._index; }
+
+    private:
+        const Document* _document;
+        uint32_t _index;
+    };
+
+    class Elements
+    {
+    public:
+        Elements(const Iterator& begin, const Iterator& end) : _begin(begin), _end(end) {}
+        Iterator begin() const { return _begin; }
+        Iterator end() const { return _end; }
+
+    private:
+        Iterator _begin;
+        Iterator _end;
+    };
+
+    Value() : _document(nullptr), _index(0) {}
+    Value(const Document* document, uint32_t index) : _document(document), _index(index) {}
+
+    Type getType() const;
+    bool isNone() const { return getType() == Type::None; }
+    bool isObject() const { return getType() == Type::Object; }
+    bool isArray() const { return getType() == Type::Array; }
+    bool isString() const { return getType() == Type::String; }
+
+    // names are compared as written in the document, a name containing escape sequences does not match
+    Value find(const char* name) const;
+    Value operator[](const char* name) const { return find(name); }
+    bool exists(const char* name) const { return !find(name).isNone(); }
+
+    // escape sequences are decoded, \uXXXX to utf-8
+    bool getString(std::string& target) const;
+    // compares the text as written without decoding escape sequences. Use getString for escaped strings
+    bool equals(const char* text) const;
+    utils::Optional<int64_t> getInt() const;
+    utils::Optional<bool> getBool() const;
+
+    // the value as written in the document, strings include the quotes
+    const char* getText() const;
+    size_t getTextLength() const;
+
+    // elements of an array, nothing for other types
+    Elements getElements() const;
+    size_t getElementCount() const;
+
+    // calls func(const Value& name, const Value& value) for each property of an object
+    template <typename TFunc>
+    void forEachProperty(TFunc&& func) const;
+
+private:
+    const Token* getToken() const;
+
+    const Document* _document;
+    uint32_t _index;
+};
+
+class Document
+{
+public:
+    Document(const char* text, size_t length);
+    Document(const Document&) = delete;
+    Document& operator=(const Document&) = delete;
+
+    bool isValid() const { return _valid; }
+    Value getRoot() const { return _valid ? Value(this, 0) : Value(); }
+    uint32_t getTokenCount() const { return _count; }
+
+private:
+    friend class Value;
+
+    static const uint32_t inlineTokenCount = 512;
+    static const int maxDepth = 64;
+
+    uint32_t addToken(Type type, const char* begin);
+    void skipSpace(const char*& cursor) const;
+    bool parseValue(const char*& cursor, int depth);
+    bool parseObject(const char*& cursor, int depth);
+    bool parseArray(const char*& cursor, int depth);
+    bool parseString(const char*& cursor);
+    bool parseNumber(const char*& cursor);
+    bool parseLiteral(const char*& cursor, const char* literal, Type type);
+
+    const char* const _text;
+    const char* const _end;
+    Token* _tokens;
+    uint32_t _count;
+    uint32_t _capacity;
+    std::unique_ptr<Token[]> _heapTokens;
+    bool _valid;
+    Token _inlineTokens[inlineTokenCount];
+};
+
+template <typename TFunc>
+void Value::forEachProperty(TFunc&& func) const
+{
+    const auto* token = getToken();
+    if (!token || token->type != Type::Object)
+    {
+        return;
+    }
+
+    for (uint32_t name = _index + 1; name < token->next;)
+    {
+        const uint32_t value = name + 1;
+        func(Value(_document, name), Value(_document, value));
+        name = _document->_tokens[value].next;
+    }
+}
+
+} // namespace reader
+} // namespace json
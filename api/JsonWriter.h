@@ -1,4 +1,6 @@
 #pragma once
+#include <cassert>
+#include <cstdio>
 #include <cstring>
 
 /**
@@ -27,6 +29,58 @@ namespace json
 namespace writer
 {
 
+// Appends a quoted string and escapes the characters json does not allow in strings.
+template <typename TBuilder>
+void appendString(TBuilder& builder, const char* value)
+{
+    builder.append("\"");
+    const char* run = value;
+    for (const char* cursor = value; *cursor; ++cursor)
+    {
+        const auto c = static_cast<unsigned char>(*cursor);
+        if (c >= 0x20 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+
+        if (cursor != run)
+        {
+            builder.append(run, static_cast<size_t>(cursor - run));
+        }
+        run = cursor + 1;
+
+        char escaped[8];
+        switch (c)
+        {
+        case '"':
+            builder.append("\\\"");
+            break;
+        case '\\':
+            builder.append("\\\\");
+            break;
+        case '\n':
+            builder.append("\\n");
+            break;
+        case '\r':
+            builder.append("\\r");
+            break;
+        case '\t':
+            builder.append("\\t");
+            break;
+        default:
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            builder.append(escaped);
+            break;
+        }
+    }
+
+    if (*run)
+    {
+        builder.append(run);
+    }
+    builder.append("\"");
+}
+
 template <typename TBuilder>
 class Object
 {
@@ -41,11 +95,8 @@ public:
             _builder.append(",");
         }
 
-        _builder.append("\"");
-        _builder.append(name);
-        _builder.append("\":");
-
-        _builder.append("{");
+        appendString(_builder, name);
+        _builder.append(":{");
     };
 
     Object(TBuilder& builder) : _builder(builder)
@@ -66,15 +117,23 @@ public:
         {
             _builder.append(",");
         }
-        _builder.append("\"");
-        _builder.append(name);
-        _builder.append("\":\"");
-        _builder.append(value);
-        _builder.append("\"");
+        appendString(_builder, name);
+        _builder.append(":");
+        appendString(_builder, value);
     }
 
     void addProperty(const char* name, const std::string& value) { addProperty(name, value.c_str()); }
 
+    void addProperty(const char* name, const bool value)
+    {
+        if (!_builder.endsWidth('{'))
+        {
+            _builder.append(",");
+        }
+        appendString(_builder, name);
+        _builder.append(value ? ":true" : ":false");
+    }
+
     template <typename T>
     void addProperty(const char* name, const T& value)
     {
@@ -82,9 +141,8 @@ public:
         {
             _builder.append(",");
         }
-        _builder.append("\"");
-        _builder.append(name);
-        _builder.append("\":");
+        appendString(_builder, name);
+        _builder.append(":");
         _builder.append(value);
     }
 };
@@ -101,9 +159,8 @@ public:
         {
             _builder.append(",");
         }
-        _builder.append("\"");
-        _builder.append(name);
-        _builder.append("\":[");
+        appendString(_builder, name);
+        _builder.append(":[");
     };
 
     ~Array() { _builder.append("]"); }
@@ -114,9 +171,7 @@ public:
         {
             _builder.append(",");
         }
-        _builder.append("\"");
-        _builder.append(value);
-        _builder.append("\"");
+        appendString(_builder, value);
     }
 
     void addElement(const std::string& value) { addElement(value.c_str()); }
@@ -1,20 +1,15 @@
 #include "api/Parser.h"
 #include "api/ConferenceEndpoint.h"
-#include "api/JsonUtils.h"
 #include "api/utils.h"
 #include "utils/Base64.h"
 #include "utils/Format.h"
+#include <type_traits>
 
 namespace
 {
 
-const nlohmann::json& optionalJsonArray(const nlohmann::json& data, const char* arrayProperty)
-{
-    static const nlohmann::json EMPTY_JSON_ARRAY = nlohmann::json::array();
-
-    const auto it = data.find(arrayProperty);
-    return it == data.end() ? EMPTY_JSON_ARRAY : *it;
-}
+using JsonValue = json::reader::Value;
+using JsonElements = json::reader::Value::Elements;
 
 const nlohmann::json& requiredJsonArray(const nlohmann::json& data, const char* arrayProperty)
 {
@@ -48,163 +43,222 @@ void setIfExistsOrThrow(T& target, const nlohmann::json& data, const char* name)
 }
 
 template <typename T>
-void setIfExists(utils::Optional<T>& target, const nlohmann::json& data, const char* name)
+void setIfExistsOrDefault(T& target, const nlohmann::json& data, const char* name, T&& defaultValue)
 {
-    if (data.find(name) != data.end())
+    const auto& it = data.find(name);
+    if (it != data.end())
+    {
+        target = it->get<T>();
+    }
+    else
     {
-        target.set(data[name].get<typename utils::Optional<T>::ValueType>());
+        target = std::forward<T>(defaultValue);
     }
 }
 
-template <typename T>
-void setIfExists(T& target, const nlohmann::json& data, const char* name)
+// The request bodies below are read in place from a json::reader::Document. Errors are reported as json exceptions
+// like the nlohmann parsing does.
+
+[[noreturn]] void throwJsonError(const char* message, const char* name)
 {
-    const auto& it = data.find(name);
-    if (it != data.end())
+    throw nlohmann::detail::other_error::create(-1, std::string(message).append(name));
+}
+
+bool readValue(std::string& target, const JsonValue& value)
+{
+    switch (value.getType())
     {
-        target = it->get<T>();
+    case json::reader::Type::String:
+        return value.getString(target);
+    case json::reader::Type::Number:
+    case json::reader::Type::Boolean:
+        target.assign(value.getText(), value.getTextLength());
+        return true;
+    default:
+        return false;
     }
 }
 
+bool readValue(bool& target, const JsonValue& value)
+{
+    if (value.isString())
+    {
+        target = value.equals("true");
+        return true;
+    }
+
+    const auto boolValue = value.getBool();
+    if (boolValue.isSet())
+    {
+        target = boolValue.get();
+    }
+    return boolValue.isSet();
+}
+
 template <typename T>
-void setIfExistsOrDefault(T& target, const nlohmann::json& data, const char* name, T&& defaultValue)
+bool readValue(T& target, const JsonValue& value)
 {
-    const auto& it = data.find(name);
-    if (it != data.end())
+    static_assert(std::is_integral<T>::value, "json number expected");
+    const auto intValue = value.getInt();
+    if (intValue.isSet())
     {
-        target = it->get<T>();
+        target = static_cast<T>(intValue.get());
     }
-    else
+    return intValue.isSet();
+}
+
+JsonValue findRequired(const JsonValue& data, const char* name)
+{
+    const auto value = data.find(name);
+    if (value.isNone())
     {
-        target = std::forward<T>(defaultValue);
+        throwJsonError("Missing required property: ", name);
     }
+    return value;
 }
 
-template <>
-void setIfExists(utils::Optional<bool>& target, const nlohmann::json& data, const char* name)
+template <typename T>
+T readRequired(const JsonValue& data, const char* name)
 {
-    if (data.find(name) != data.end())
+    T target;
+    if (!readValue(target, findRequired(data, name)))
     {
-        const auto& jsonElement = data[name];
-        if (jsonElement.is_string())
-        {
-            target.set(data[name].get<std::string>().compare("true") == 0);
-        }
-        else
-        {
-            target.set(data[name].get<bool>());
-        }
+        throwJsonError("Invalid type of property: ", name);
     }
+    return target;
 }
 
-template <>
-void setIfExists(utils::Optional<std::string>& target, const nlohmann::json& data, const char* name)
+template <typename T>
+void readIfExists(T& target, const JsonValue& data, const char* name)
 {
-    if (data.find(name) != data.end())
+    const auto value = data.find(name);
+    if (!value.isNone() && !readValue(target, value))
     {
-        const auto& jsonElement = data[name];
-        if (jsonElement.is_string())
-        {
-            target.set(data[name].get<std::string>());
-        }
-        else if (jsonElement.is_number_integer())
-        {
-            target.set(std::to_string(data[name].get<int32_t>()));
-        }
-        else if (jsonElement.is_boolean())
-        {
-            if (jsonElement.get<bool>())
-            {
-                target.set("true");
-            }
-            else
-            {
-                target.set("false");
-            }
-        }
+        throwJsonError("Invalid type of property: ", name);
     }
 }
 
-template <typename... Args>
-void throwIfNotExists(const nlohmann::json& json, Args&&... keys)
+template <typename T>
+void readIfExists(utils::Optional<T>& target, const JsonValue& data, const char* name)
 {
-    if (!exists(json, std::forward<Args>(keys)...))
+    const auto value = data.find(name);
+    if (value.isNone())
     {
-        const char* vec[sizeof...(keys)] = {keys...};
-        const auto sb = std::string().append("Missing required under property: ").append(vec[0]);
-        throw nlohmann::detail::other_error::create(-1, sb);
+        return;
     }
+
+    T result;
+    if (!readValue(result, value))
+    {
+        throwJsonError("Invalid type of property: ", name);
+    }
+    target.set(std::move(result));
 }
 
-api::AllocateEndpoint::Transport parseAllocateEndpointTransport(const nlohmann::json& data)
+template <typename T>
+void readIfExistsOrDefault(T& target, const JsonValue& data, const char* name, T defaultValue)
 {
-    api::AllocateEndpoint::Transport transport;
-    setIfExists(transport.ice, data, "ice");
-    setIfExists(transport.iceControlling, data, "ice-controlling");
+    target = defaultValue;
+    readIfExists(target, data, name);
+}
 
-    setIfExists(transport.dtls, data, "dtls");
-    setIfExists(transport.sdes, data, "sdes");
-    setIfExists(transport.privatePort, data, "private-port");
+JsonElements getArray(const JsonValue& data, const char* name, bool required)
+{
+    const auto value = data.find(name);
+    if (value.isNone())
+    {
+        if (required)
+        {
+            throwJsonError("Missing required array property: ", name);
+        }
+        return JsonValue().getElements();
+    }
 
-    return transport;
+    if (!value.isArray())
+    {
+        throwJsonError("Invalid type of property: ", name);
+    }
+    return value.getElements();
 }
 
-api::AllocateEndpoint::Audio parseAllocateEndpointAudio(const nlohmann::json& data)
+JsonElements optionalJsonArray(const JsonValue& data, const char* name)
 {
-    api::AllocateEndpoint::Audio audio;
-    setIfExists(audio.relayType, data, "relay-type");
+    return getArray(data, name, false);
+}
 
-    if (data.find("transport") != data.end())
+JsonElements requiredJsonArray(const JsonValue& data, const char* name)
+{
+    return getArray(data, name, true);
+}
+
+template <typename T>
+T readElement(const JsonValue& element, const char* arrayName)
+{
+    T target;
+    if (!readValue(target, element))
     {
-        audio.transport.set(parseAllocateEndpointTransport(data["transport"]));
+        throwJsonError("Invalid element in array: ", arrayName);
     }
+    return target;
+}
+
+api::AllocateEndpoint::Transport parseAllocateEndpointTransport(const JsonValue& data)
+{
+    api::AllocateEndpoint::Transport transport;
+    readIfExists(transport.ice, data, "ice");
+    readIfExists(transport.iceControlling, data, "ice-controlling");
+
+    readIfExists(transport.dtls, data, "dtls");
+    readIfExists(transport.sdes, data, "sdes");
+    readIfExists(transport.privatePort, data, "private-port");
 
-    return audio;
+    return transport;
 }
 
-api::AllocateEndpoint::Video parseAllocateEndpointVideo(const nlohmann::json& data)
+template <typename TMedia>
+TMedia parseAllocateEndpointMedia(const JsonValue& data)
 {
-    api::AllocateEndpoint::Video video;
-    setIfExists(video.relayType, data, "relay-type");
+    TMedia media;
+    readIfExists(media.relayType, data, "relay-type");
 
-    if (data.find("transport") != data.end())
+    const auto transportJson = data.find("transport");
+    if (!transportJson.isNone())
     {
-        video.transport.set(parseAllocateEndpointTransport(data["transport"]));
+        media.transport.set(parseAllocateEndpointTransport(transportJson));
     }
 
-    return video;
+    return media;
 }
 
-api::Transport parsePatchEndpointTransport(const nlohmann::json& data)
+api::Transport parsePatchEndpointTransport(const JsonValue& data)
 {
     api::Transport transport;
-    setIfExists(transport.rtcpMux, data, "rtcp-mux");
+    readIfExists(transport.rtcpMux, data, "rtcp-mux");
 
-    if (data.find("ice") != data.end())
+    const auto iceJson = data.find("ice");
+    if (!iceJson.isNone())
     {
-        api::Ice ice = api::Parser::parseIce(data["ice"]);
-        transport.ice.set(ice);
+        transport.ice.set(api::Parser::parseIce(iceJson));
     }
 
-    if (exists(data, "dtls", "type") && exists(data, "dtls", "hash") && exists(data, "dtls", "setup"))
+    const auto dtlsJson = data.find("dtls");
+    const auto sdesJson = data.find("sdes");
+    if (!dtlsJson.isNone() && dtlsJson.exists("type") && dtlsJson.exists("hash") && dtlsJson.exists("setup"))
     {
         api::Dtls dtls;
-        const auto& dtlsJson = data["dtls"];
-        dtls.type = dtlsJson["type"].get<std::string>();
-        dtls.hash = dtlsJson["hash"].get<std::string>();
-        dtls.setup = dtlsJson["setup"].get<std::string>();
+        dtls.type = readRequired<std::string>(dtlsJson, "type");
+        dtls.hash = readRequired<std::string>(dtlsJson, "hash");
+        dtls.setup = readRequired<std::string>(dtlsJson, "setup");
         transport.dtls.set(dtls);
     }
-    else if (exists(data, "sdes"))
+    else if (!sdesJson.isNone())
     {
-        throwIfNotExists(data, "sdes", "key");
-        throwIfNotExists(data, "sdes", "profile");
+        const auto key = readRequired<std::string>(sdesJson, "key");
+        const auto profile = readRequired<std::string>(sdesJson, "profile");
 
-        const auto& sdesJson = data["sdes"];
         srtp::AesKey aesKey;
-        const size_t decodedLength =
-            utils::Base64::decode(sdesJson["key"].get<std::string>().c_str(), aesKey.keySalt, sizeof(aesKey.keySalt));
-        aesKey.profile = api::utils::stringToSrtpProfile(sdesJson["profile"].get<std::string>());
+        const size_t decodedLength = utils::Base64::decode(key.c_str(), aesKey.keySalt, sizeof(aesKey.keySalt));
+        aesKey.profile = api::utils::stringToSrtpProfile(profile);
         if (decodedLength != aesKey.getLength())
         {
             throw nlohmann::detail::other_error::create(-1,
@@ -213,47 +267,43 @@ api::Transport parsePatchEndpointTransport(const nlohmann::json& data)
         transport.sdesKeys.push_back(aesKey);
     }
 
-    if (exists(data, "connection"))
+    const auto connectionJson = data.find("connection");
+    if (!connectionJson.isNone())
     {
-        throwIfNotExists(data, "connection", "port");
-        throwIfNotExists(data, "connection", "ip");
-
-        const auto& connectionJson = data["connection"];
         api::Connection connection;
-        connection.port = connectionJson["port"].get<uint32_t>();
-        connection.ip = connectionJson["ip"].get<std::string>();
+        connection.port = readRequired<uint32_t>(connectionJson, "port");
+        connection.ip = readRequired<std::string>(connectionJson, "ip");
         transport.connection.set(std::move(connection));
     }
 
     return transport;
 }
 
-api::PayloadType parsePatchEndpointPayloadType(const nlohmann::json& data)
+api::PayloadType parsePatchEndpointPayloadType(const JsonValue& data)
 {
     api::PayloadType payloadType;
 
-    payloadType.id = data["id"].get<uint32_t>();
-    payloadType.name = data["name"].get<std::string>();
-
-    payloadType.clockRate = data["clockrate"].get<uint32_t>();
+    payloadType.id = readRequired<uint32_t>(data, "id");
+    payloadType.name = readRequired<std::string>(data, "name");
+    payloadType.clockRate = readRequired<uint32_t>(data, "clockrate");
 
-    setIfExists(payloadType.channels, data, "channels");
+    readIfExists(payloadType.channels, data, "channels");
 
-    if (data.find("parameters") != data.end())
-    {
-        const auto& parametersJson = data["parameters"];
-        for (auto it = parametersJson.begin(); it != parametersJson.end(); ++it)
+    data.find("parameters").forEachProperty([&payloadType](const JsonValue& name, const JsonValue& value) {
+        payloadType.parameters.emplace_back();
+        auto& parameter = payloadType.parameters.back();
+        if (!name.getString(parameter.first) || !readValue(parameter.second, value))
         {
-            payloadType.parameters.emplace_back(std::make_pair(it.key(), it.value()));
+            throwJsonError("Invalid type of property: ", "parameters");
         }
-    }
+    });
 
     for (const auto& rtcpFbJson : optionalJsonArray(data, "rtcp-fbs"))
     {
-        const auto& type = rtcpFbJson["type"].get<std::string>();
-        if (rtcpFbJson.find("subtype") != rtcpFbJson.end())
+        const auto type = readRequired<std::string>(rtcpFbJson, "type");
+        if (rtcpFbJson.exists("subtype"))
         {
-            const auto& subtype = rtcpFbJson["subtype"].get<std::string>();
+            const auto subtype = readRequired<std::string>(rtcpFbJson, "subtype");
             payloadType.rtcpFeedbacks.emplace_back(type, utils::Optional<std::string>(subtype));
         }
         else
@@ -265,6 +315,53 @@ api::PayloadType parsePatchEndpointPayloadType(const nlohmann::json& data)
     return payloadType;
 }
 
+void parseSsrcs(std::vector<uint32_t>& ssrcs, const JsonValue& mediaJson, const char* name)
+{
+    for (const auto& ssrcJson : optionalJsonArray(mediaJson, name))
+    {
+        ssrcs.push_back(readElement<uint32_t>(ssrcJson, name));
+    }
+}
+
+void parsePayloadTypes(std::vector<api::PayloadType>& payloadTypes, const JsonValue& mediaJson)
+{
+    for (const auto& payloadTypeJson : optionalJsonArray(mediaJson, "payload-types"))
+    {
+        payloadTypes.emplace_back(parsePatchEndpointPayloadType(payloadTypeJson));
+    }
+}
+
+void parseRtpHeaderExtensions(std::vector<std::pair<uint32_t, std::string>>& rtpHeaderExtensions,
+    const JsonValue& mediaJson)
+{
+    for (const auto& rtpHdrExtJson : optionalJsonArray(mediaJson, "rtp-hdrexts"))
+    {
+        const auto id = readRequired<uint32_t>(rtpHdrExtJson, "id");
+        if (id > 0 && id < 15)
+        {
+            rtpHeaderExtensions.emplace_back(id, readRequired<std::string>(rtpHdrExtJson, "uri"));
+        }
+    }
+}
+
+void parseVideoStreams(std::vector<api::VideoStream>& streams, const JsonValue& videoJson)
+{
+    for (const auto& streamJson : optionalJsonArray(videoJson, "streams"))
+    {
+        streams.emplace_back();
+        auto& videoStream = streams.back();
+        for (const auto& rtpSource : requiredJsonArray(streamJson, "sources"))
+        {
+            api::SsrcPair level = {0, 0};
+            level.main = readRequired<uint32_t>(rtpSource, "main");
+            readIfExists(level.feedback, rtpSource, "feedback");
+            readIfExists(level.fec, rtpSource, "fec");
+            videoStream.sources.push_back(level);
+        }
+        videoStream.content = readRequired<std::string>(streamJson, "content");
+    }
+}
+
 } // namespace
 
 namespace api
@@ -309,183 +406,147 @@ AllocateConference parseAllocateConference(const nlohmann::json& data)
     return allocateConference;
 }
 
-AllocateEndpoint parseAllocateEndpoint(const nlohmann::json& data)
+AllocateEndpoint parseAllocateEndpoint(const json::reader::Value& data)
 {
     AllocateEndpoint allocateEndpoint;
 
-    if (data.find("bundle-transport") != data.end())
+    const auto bundleTransportJson = data.find("bundle-transport");
+    if (!bundleTransportJson.isNone())
     {
-        allocateEndpoint.bundleTransport.set(parseAllocateEndpointTransport(data["bundle-transport"]));
+        allocateEndpoint.bundleTransport.set(parseAllocateEndpointTransport(bundleTransportJson));
     }
 
-    if (data.find("audio") != data.end())
+    const auto audioJson = data.find("audio");
+    if (!audioJson.isNone())
     {
-        allocateEndpoint.audio.set(parseAllocateEndpointAudio(data["audio"]));
+        allocateEndpoint.audio.set(parseAllocateEndpointMedia<AllocateEndpoint::Audio>(audioJson));
     }
 
-    if (data.find("video") != data.end())
+    const auto videoJson = data.find("video");
+    if (!videoJson.isNone())
     {
-        allocateEndpoint.video.set(parseAllocateEndpointVideo(data["video"]));
+        allocateEndpoint.video.set(parseAllocateEndpointMedia<AllocateEndpoint::Video>(videoJson));
     }
 
-    if (data.find("data") != data.end())
+    if (data.exists("data"))
     {
         allocateEndpoint.data.set(AllocateEndpoint::Data());
     }
 
-    setIfExists(allocateEndpoint.idleTimeoutSeconds, data, "idleTimeout");
+    readIfExists(allocateEndpoint.idleTimeoutSeconds, data, "idleTimeout");
     return allocateEndpoint;
 }
 
-EndpointDescription parsePatchEndpoint(const nlohmann::json& data, const std::string& endpointId)
+EndpointDescription parsePatchEndpoint(const json::reader::Value& data, const std::string& endpointId)
 {
     EndpointDescription endpointDescription;
     endpointDescription.endpointId = endpointId;
 
-    if (data.find("bundle-transport") != data.end())
+    const auto bundleTransportJson = data.find("bundle-transport");
+    if (!bundleTransportJson.isNone())
     {
-        endpointDescription.bundleTransport.set(parsePatchEndpointTransport(data["bundle-transport"]));
+        endpointDescription.bundleTransport.set(parsePatchEndpointTransport(bundleTransportJson));
     }
 
-    if (data.find("audio") != data.end())
+    const auto audioJson = data.find("audio");
+    if (!audioJson.isNone())
     {
         api::Audio audioChannel;
-        const auto& audioJson = data["audio"];
 
-        if (audioJson.find("transport") != audioJson.end())
+        const auto transportJson = audioJson.find("transport");
+        if (!transportJson.isNone())
         {
-            audioChannel.transport.set(parsePatchEndpointTransport(audioJson["transport"]));
+            audioChannel.transport.set(parsePatchEndpointTransport(transportJson));
         }
 
-        for (const auto& ssrcJson : optionalJsonArray(audioJson, "ssrcs"))
-        {
-            const auto ssrc = ssrcJson.get<uint32_t>();
-            audioChannel.ssrcs.push_back(ssrc);
-        }
+        parseSsrcs(audioChannel.ssrcs, audioJson, "ssrcs");
 
-        if (audioJson.find("payload-types") != audioJson.end())
+        const auto payloadTypeJson = audioJson.find("payload-type");
+        if (audioJson.exists("payload-types"))
         {
-            for (const auto& payloadTypeJson : audioJson["payload-types"])
-            {
-                audioChannel.payloadTypes.emplace_back(parsePatchEndpointPayloadType(payloadTypeJson));
-            }
+            parsePayloadTypes(audioChannel.payloadTypes, audioJson);
         }
-        else if (audioJson.find("payload-type") !=
-            audioJson.end()) // payload-type is deprecated and it will be removed in a future version
+        else if (!payloadTypeJson.isNone()) // payload-type is deprecated and it will be removed in a future version
         {
-            audioChannel.payloadTypes.push_back(parsePatchEndpointPayloadType(audioJson["payload-type"]));
+            audioChannel.payloadTypes.push_back(parsePatchEndpointPayloadType(payloadTypeJson));
         }
 
-        for (const auto& rtpHdrExtJson : optionalJsonArray(audioJson, "rtp-hdrexts"))
-        {
-            const auto id = rtpHdrExtJson["id"].get<uint32_t>();
-            if (id > 0 && id < 15)
-            {
-                audioChannel.rtpHeaderExtensions.emplace_back(id, rtpHdrExtJson["uri"].get<std::string>());
-            }
-        }
+        parseRtpHeaderExtensions(audioChannel.rtpHeaderExtensions, audioJson);
 
         endpointDescription.audio.set(std::move(audioChannel));
     }
 
-    if (data.find("video") != data.end())
+    const auto videoJson = data.find("video");
+    if (!videoJson.isNone())
     {
         api::Video videoChannel;
-        const auto& videoJson = data["video"];
 
-        if (videoJson.find("transport") != videoJson.end())
+        const auto transportJson = videoJson.find("transport");
+        if (!transportJson.isNone())
         {
-            videoChannel.transport.set(parsePatchEndpointTransport(videoJson["transport"]));
+            videoChannel.transport.set(parsePatchEndpointTransport(transportJson));
         }
 
-        for (const auto& payloadTypeJson : optionalJsonArray(videoJson, "payload-types"))
-        {
-            videoChannel.payloadTypes.emplace_back(parsePatchEndpointPayloadType(payloadTypeJson));
-        }
-
-        for (const auto& rtpHdrExtJson : optionalJsonArray(videoJson, "rtp-hdrexts"))
-        {
-            const auto id = rtpHdrExtJson["id"].get<uint32_t>();
-            if (id > 0 && id < 15)
-            {
-                videoChannel.rtpHeaderExtensions.emplace_back(id, rtpHdrExtJson["uri"].get<std::string>());
-            }
-        }
-
-        for (const auto& stream : optionalJsonArray(videoJson, "streams"))
-        {
-            videoChannel.streams.emplace_back();
-            auto& videoStream = videoChannel.streams.back();
-            for (const auto& rtpSource : requiredJsonArray(stream, "sources"))
-            {
-                api::SsrcPair level;
-                level.main = rtpSource["main"].get<uint32_t>();
-                setIfExists(level.feedback, rtpSource, "feedback");
-                videoStream.sources.push_back(level);
-            }
-            videoStream.content = stream["content"];
-        }
+        parsePayloadTypes(videoChannel.payloadTypes, videoJson);
+        parseRtpHeaderExtensions(videoChannel.rtpHeaderExtensions, videoJson);
+        parseVideoStreams(videoChannel.streams, videoJson);
 
-        if (videoJson.find("ssrc-whitelist") != videoJson.end())
+        if (videoJson.exists("ssrc-whitelist"))
         {
             std::vector<uint32_t> ssrcWhitelist;
-            for (const auto& ssrcJson : videoJson["ssrc-whitelist"])
-            {
-                const auto ssrc = ssrcJson.get<uint32_t>();
-                ssrcWhitelist.push_back(ssrc);
-            }
+            parseSsrcs(ssrcWhitelist, videoJson, "ssrc-whitelist");
             videoChannel.ssrcWhitelist.set(std::move(ssrcWhitelist));
         }
 
         endpointDescription.video.set(std::move(videoChannel));
     }
 
-    if (data.find("data") != data.end())
+    const auto dataJson = data.find("data");
+    if (!dataJson.isNone())
     {
         api::Data dataChannel;
-        const auto& dataJson = data["data"];
-        const auto& portJson = dataJson["port"];
-        dataChannel.port = portJson.get<uint32_t>();
+        dataChannel.port = readRequired<uint32_t>(dataJson, "port");
         endpointDescription.data.set(dataChannel);
     }
 
-    if (data.find("neighbours") != data.end())
+    const auto neighboursJson = data.find("neighbours");
+    if (!neighboursJson.isNone())
     {
         std::vector<std::string> neighbours;
-        for (auto& group : requiredJsonArray(data["neighbours"], "groups"))
+        for (const auto& group : requiredJsonArray(neighboursJson, "groups"))
         {
-            neighbours.push_back(group);
+            neighbours.push_back(readElement<std::string>(group, "groups"));
         }
         endpointDescription.neighbours.set(neighbours);
     }
     return endpointDescription;
 }
 
-Recording parseRecording(const nlohmann::json& data)
+Recording parseRecording(const json::reader::Value& data)
 {
     Recording recording;
 
-    const auto& recordingJson = data["recording"];
+    const auto recordingJson = findRequired(data, "recording");
 
-    recording.recordingId = recordingJson["recording-id"].get<std::string>();
-    recording.userId = recordingJson["user-id"].get<std::string>();
+    recording.recordingId = readRequired<std::string>(recordingJson, "recording-id");
+    recording.userId = readRequired<std::string>(recordingJson, "user-id");
 
-    const auto& modalities = recordingJson["recording-modalities"];
-    setIfExistsOrDefault<>(recording.isAudioEnabled, modalities, "audio", false);
-    setIfExistsOrDefault<>(recording.isVideoEnabled, modalities, "video", false);
-    setIfExistsOrDefault<>(recording.isScreenshareEnabled, modalities, "screenshare", false);
+    const auto modalities = findRequired(recordingJson, "recording-modalities");
+    readIfExistsOrDefault(recording.isAudioEnabled, modalities, "audio", false);
+    readIfExistsOrDefault(recording.isVideoEnabled, modalities, "video", false);
+    readIfExistsOrDefault(recording.isScreenshareEnabled, modalities, "screenshare", false);
 
     for (const auto& channelJson : optionalJsonArray(recordingJson, "channels"))
     {
         api::RecordingChannel recordingChannel;
-        setIfExists<>(recordingChannel.id, channelJson, "id");
-        setIfExists<>(recordingChannel.host, channelJson, "host");
-        setIfExistsOrDefault<>(recordingChannel.port, channelJson, "port", uint16_t(0));
+        readIfExists(recordingChannel.id, channelJson, "id");
+        readIfExists(recordingChannel.host, channelJson, "host");
+        readIfExistsOrDefault(recordingChannel.port, channelJson, "port", uint16_t(0));
 
         std::string aesKeyEnc;
         std::string saltEnc;
-        setIfExists<>(aesKeyEnc, channelJson, "aes-key");
-        setIfExists<>(saltEnc, channelJson, "aes-salt");
+        readIfExists(aesKeyEnc, channelJson, "aes-key");
+        readIfExists(saltEnc, channelJson, "aes-salt");
 
         if (!aesKeyEnc.empty())
         {
@@ -513,6 +574,7 @@ ConferenceEndpoint parseConferenceEndpoint(const nlohmann::json& data)
     std::string dtlsStateStr;
     setIfExistsOrThrow<>(iceStateStr, data, "iceState");
     setIfExistsOrThrow<>(dtlsStateStr, data, "dtlsState");
+    setIfExistsOrDefault<>(endpoint.cpuTimeMs, data, "cpuTimeMs", uint64_t(0));
 
     endpoint.iceState = utils::stringToIceState(iceStateStr);
     endpoint.dtlsState = utils::stringToDtlsState(dtlsStateStr);
@@ -567,106 +629,61 @@ ConferenceEndpointExtendedInfo parseEndpointExtendedInfo(const nlohmann::json& d
     return endpoint;
 }
 
-Ice parseIce(const nlohmann::json& iceJson)
+Ice parseIce(const json::reader::Value& iceJson)
 {
     api::Ice ice;
-    ice.ufrag = iceJson["ufrag"].get<std::string>();
-    ice.pwd = iceJson["pwd"].get<std::string>();
+    ice.ufrag = readRequired<std::string>(iceJson, "ufrag");
+    ice.pwd = readRequired<std::string>(iceJson, "pwd");
 
     for (const auto& candidateJson : optionalJsonArray(iceJson, "candidates"))
     {
         api::Candidate candidate;
-        candidate.generation = candidateJson["generation"].get<uint32_t>();
-        candidate.component = candidateJson["component"].get<uint32_t>();
-        candidate.protocol = candidateJson["protocol"].get<std::string>();
-        candidate.port = candidateJson["port"].get<uint32_t>();
-        candidate.ip = candidateJson["ip"].get<std::string>();
-        setIfExists(candidate.relPort, candidateJson, "rel-port");
-        setIfExists(candidate.relAddr, candidateJson, "rel-addr");
-        candidate.foundation = candidateJson["foundation"].get<std::string>();
-        candidate.priority = candidateJson["priority"].get<uint32_t>();
-        candidate.type = candidateJson["type"].get<std::string>();
-        candidate.network =
-            candidateJson.find("network") != candidateJson.end() ? candidateJson["network"].get<uint32_t>() : 0;
+        candidate.generation = readRequired<uint32_t>(candidateJson, "generation");
+        candidate.component = readRequired<uint32_t>(candidateJson, "component");
+        candidate.protocol = readRequired<std::string>(candidateJson, "protocol");
+        candidate.port = readRequired<uint32_t>(candidateJson, "port");
+        candidate.ip = readRequired<std::string>(candidateJson, "ip");
+        readIfExists(candidate.relPort, candidateJson, "rel-port");
+        readIfExists(candidate.relAddr, candidateJson, "rel-addr");
+        candidate.foundation = readRequired<std::string>(candidateJson, "foundation");
+        candidate.priority = readRequired<uint32_t>(candidateJson, "priority");
+        candidate.type = readRequired<std::string>(candidateJson, "type");
+        readIfExistsOrDefault(candidate.network, candidateJson, "network", uint32_t(0));
         ice.candidates.emplace_back(std::move(candidate));
     }
 
     return ice;
 }
 
-BarbellDescription parsePatchBarbell(const nlohmann::json& data, const std::string& barbellId)
+BarbellDescription parsePatchBarbell(const json::reader::Value& data, const std::string& barbellId)
 {
     BarbellDescription barbellDescription;
     barbellDescription.barbellId = barbellId;
 
-    barbellDescription.transport = parsePatchEndpointTransport(getJsonFieldOrThrow(data, "bundle-transport"));
+    barbellDescription.transport = parsePatchEndpointTransport(findRequired(data, "bundle-transport"));
 
-    if (data.find("audio") != data.end())
+    const auto audioJson = data.find("audio");
+    if (!audioJson.isNone())
     {
         api::Audio audioChannel;
-        const auto& audioJson = data["audio"];
-
-        for (const auto& ssrcJson : optionalJsonArray(audioJson, "ssrcs"))
-        {
-            const auto ssrc = ssrcJson.get<uint32_t>();
-            audioChannel.ssrcs.push_back(ssrc);
-        }
-
-        for (const auto& payloadTypeJson : optionalJsonArray(audioJson, "payload-types"))
-        {
-            audioChannel.payloadTypes.emplace_back(parsePatchEndpointPayloadType(payloadTypeJson));
-        }
-
-        for (const auto& rtpHdrExtJson : optionalJsonArray(audioJson, "rtp-hdrexts"))
-        {
-            const auto id = rtpHdrExtJson["id"].get<uint32_t>();
-            if (id > 0 && id < 15)
-            {
-                audioChannel.rtpHeaderExtensions.emplace_back(id, rtpHdrExtJson["uri"].get<std::string>());
-            }
-        }
-
+        parseSsrcs(audioChannel.ssrcs, audioJson, "ssrcs");
+        parsePayloadTypes(audioChannel.payloadTypes, audioJson);
+        parseRtpHeaderExtensions(audioChannel.rtpHeaderExtensions, audioJson);
         barbellDescription.audio = std::move(audioChannel);
     }
 
-    if (data.find("video") != data.end())
+    const auto videoJson = data.find("video");
+    if (!videoJson.isNone())
     {
         api::Video videoChannel;
-        const auto& videoJson = data["video"];
-
-        for (const auto& payloadTypeJson : optionalJsonArray(videoJson, "payload-types"))
-        {
-            videoChannel.payloadTypes.emplace_back(parsePatchEndpointPayloadType(payloadTypeJson));
-        }
-
-        for (const auto& rtpHdrExtJson : optionalJsonArray(videoJson, "rtp-hdrexts"))
-        {
-            const auto id = rtpHdrExtJson["id"].get<uint32_t>();
-            if (id > 0 && id < 15)
-            {
-                videoChannel.rtpHeaderExtensions.emplace_back(id, rtpHdrExtJson["uri"].get<std::string>());
-            }
-        }
-
-        for (const auto& stream : optionalJsonArray(videoJson, "streams"))
-        {
-            videoChannel.streams.emplace_back();
-            auto& videoStream = videoChannel.streams.back();
-            for (const auto& rtpSource : requiredJsonArray(stream, "sources"))
-            {
-                api::SsrcPair level;
-                level.main = rtpSource["main"].get<uint32_t>();
-                setIfExists(level.feedback, rtpSource, "feedback");
-                videoStream.sources.push_back(level);
-            }
-            videoStream.content = stream["content"];
-        }
-
+        parsePayloadTypes(videoChannel.payloadTypes, videoJson);
+        parseRtpHeaderExtensions(videoChannel.rtpHeaderExtensions, videoJson);
+        parseVideoStreams(videoChannel.streams, videoJson);
         barbellDescription.video = std::move(videoChannel);
     }
 
-    const auto& dataJson = getJsonFieldOrThrow(data, "data");
-    setIfExistsOrThrow(barbellDescription.data.port, dataJson, "port");
+    const auto dataJson = findRequired(data, "data");
+    barbellDescription.data.port = readRequired<uint32_t>(dataJson, "port");
 
     return barbellDescription;
 }
@@ -5,6 +5,7 @@
 #include "api/BarbellDescription.h"
 #include "api/ConferenceEndpoint.h"
 #include "api/EndpointDescription.h"
+#include "api/JsonReader.h"
 #include "api/Recording.h"
 #include "nlohmann/json.hpp"
 #include "transport/dtls/SrtpProfiles.h"
@@ -16,14 +17,15 @@ namespace Parser
 {
 
 AllocateConference parseAllocateConference(const nlohmann::json&);
-AllocateEndpoint parseAllocateEndpoint(const nlohmann::json&);
-EndpointDescription parsePatchEndpoint(const nlohmann::json&, const std::string& endpointId);
-Recording parseRecording(const nlohmann::json&);
 std::vector<ConferenceEndpoint> parseConferenceEndpoints(const nlohmann::json&);
 ConferenceEndpointExtendedInfo parseEndpointExtendedInfo(const nlohmann::json&);
-api::Ice parseIce(const nlohmann::json&);
 
-BarbellDescription parsePatchBarbell(const nlohmann::json& data, const std::string& barbellId);
+// Endpoint and barbell requests are read in place from the validated request body, without building a json tree.
+AllocateEndpoint parseAllocateEndpoint(const json::reader::Value&);
+EndpointDescription parsePatchEndpoint(const json::reader::Value&, const std::string& endpointId);
+Recording parseRecording(const json::reader::Value&);
+api::Ice parseIce(const json::reader::Value&);
+BarbellDescription parsePatchBarbell(const json::reader::Value& data, const std::string& barbellId);
 } // namespace Parser
 
 } // namespace api
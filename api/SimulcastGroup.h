@@ -11,6 +11,7 @@ struct SsrcPair
 {
     uint32_t main;
     uint32_t feedback;
+    uint32_t fec = 0; // FlexFEC repair ssrc, announced as FEC-FR group with main
 };
 
 template <size_t SIZE>
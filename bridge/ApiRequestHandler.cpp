@@ -60,6 +60,10 @@ httpd::Response ApiRequestHandler::handleConferenceRequest(RequestLogger& reques
     {
         return getConferenceInfo(this, requestLogger, request, conferenceId);
     }
+    else if (request.method == httpd::Method::POST)
+    {
+        return allocateEndpoints(this, requestLogger, request, conferenceId);
+    }
 
     throw httpd::RequestErrorException(httpd::StatusCode::METHOD_NOT_ALLOWED,
         utils::format("HTTP method '%s' not allowed on this endpoint", request.getMethodString()));
@@ -11,6 +11,8 @@
 
 namespace bridge
 {
+class BarbellTrunk;
+class BarbellTrunkRegistry;
 
 struct Barbell
 {
@@ -18,7 +20,10 @@ struct Barbell
         : id(barbellId),
           transport(rtcTransport),
           markedForDeletion(false),
-          isConfigured(false)
+          isConfigured(false),
+          trunkRegistry(nullptr),
+          sharesTransport(false),
+          trunkDrained(std::make_shared<std::atomic_bool>(false))
     {
     }
 
@@ -35,6 +40,15 @@ struct Barbell
 
     bool markedForDeletion;
     bool isConfigured;
+
+    // Set when the transport is a trunk shared with other conferences linking the same bridges.
+    // trunkRegistry is cleared on release. sharesTransport tells whether other conferences still use it then.
+    std::shared_ptr<BarbellTrunk> trunk;
+    BarbellTrunkRegistry* trunkRegistry;
+    std::string trunkTag;
+    bool sharesTransport;
+    // set by a job on the shared transport, which may run after the barbell is gone
+    std::shared_ptr<std::atomic_bool> trunkDrained;
 };
 
 } // namespace bridge
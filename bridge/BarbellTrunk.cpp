@@ -0,0 +1,431 @@
+#include "bridge/BarbellTrunk.h"
+#include "bridge/engine/EngineBarbell.h"
+#include "logger/Logger.h"
+#include "rtp/RtcpFeedback.h"
+#include "rtp/RtcpHeader.h"
+#include "transport/TransportFactory.h"
+#include "utils/StdExtensions.h"
+#include "webrtc/DataChannel.h"
+#include <algorithm>
+
+namespace
+{
+const uint32_t maxTrunkSessionsPerPort = 32;
+const size_t expectedInboundStreamCount = 512;
+const size_t expectedOutboundStreamCount = 512;
+const size_t trunkJobQueueSize = 16 * 1024;
+const size_t maxSsrcRoutes = 4096;
+const size_t maxSctpStreamRoutes = 1024;
+
+bool isDataChannelOpen(uint32_t payloadProtocol, const void* data, size_t length)
+{
+    return payloadProtocol == webrtc::DataChannelPpid::WEBRTC_ESTABLISH &&
+        length >= sizeof(webrtc::DataChannelOpenMessage) &&
+        reinterpret_cast<const uint8_t*>(data)[0] == webrtc::DataChannelMessageType::DATA_CHANNEL_OPEN;
+}
+
+const char* getOpenMessageLabel(const void* data, size_t length, size_t& outLabelLength)
+{
+    const auto& openMessage = *reinterpret_cast<const webrtc::DataChannelOpenMessage*>(data);
+    if (openMessage.size() > length)
+    {
+        outLabelLength = 0;
+        return nullptr;
+    }
+
+    outLabelLength = openMessage.labelLength;
+    return reinterpret_cast<const char*>(&openMessage.protocolLength + 1);
+}
+} // namespace
+
+namespace bridge
+{
+
+BarbellTrunk::BarbellTrunk(const std::string& trunkId, const std::shared_ptr<transport::RtcTransport>& transport)
+    : _id(trunkId),
+      _transport(transport),
+      _configured(false),
+      _started(false),
+      _sctpEstablished(false),
+      _ssrcRoutes(maxSsrcRoutes),
+      _sctpStreamRoutes(maxSctpStreamRoutes)
+{
+}
+
+std::string BarbellTrunk::makeDataChannelLabel(const std::string& conferenceTag)
+{
+    return std::string("barbell:") + conferenceTag;
+}
+
+bool BarbellTrunk::attach(const std::string& conferenceTag,
+    transport::DataReceiver& receiver,
+    const std::vector<uint32_t>& ssrcs)
+{
+    std::lock_guard<std::mutex> locker(_lock);
+    const auto label = makeDataChannelLabel(conferenceTag);
+    if (_members.find(label) != _members.end())
+    {
+        logger::warn("conference tag %s already attached", _transport->getLoggableId().c_str(), conferenceTag.c_str());
+        return false;
+    }
+
+    if (_members.size() >= maxMembers)
+    {
+        logger::warn("trunk %s is full", _transport->getLoggableId().c_str(), _id.c_str());
+        return false;
+    }
+
+    for (const auto ssrc : ssrcs)
+    {
+        if (_ssrcRoutes.contains(ssrc))
+        {
+            logger::warn("ssrc %u of conference tag %s is already routed on trunk %s",
+                _transport->getLoggableId().c_str(),
+                ssrc,
+                conferenceTag.c_str(),
+                _id.c_str());
+            return false;
+        }
+    }
+
+    auto& member = _members[label];
+    member.receiver = &receiver;
+    for (const auto ssrc : ssrcs)
+    {
+        if (!_ssrcRoutes.emplace(ssrc, &receiver).second)
+        {
+            logger::warn("ssrc routes of trunk %s are full", _transport->getLoggableId().c_str(), _id.c_str());
+            for (const auto routedSsrc : member.ssrcs)
+            {
+                _ssrcRoutes.erase(routedSsrc);
+            }
+            _members.erase(label);
+            return false;
+        }
+        member.ssrcs.push_back(ssrc);
+    }
+
+    logger::info("attached conference tag %s to trunk %s, %zu members",
+        _transport->getLoggableId().c_str(),
+        conferenceTag.c_str(),
+        _id.c_str(),
+        _members.size());
+    return true;
+}
+
+void BarbellTrunk::detach(const std::string& conferenceTag)
+{
+    std::lock_guard<std::mutex> locker(_lock);
+    auto it = _members.find(makeDataChannelLabel(conferenceTag));
+    if (it == _members.end())
+    {
+        return;
+    }
+
+    for (const auto ssrc : it->second.ssrcs)
+    {
+        _ssrcRoutes.erase(ssrc);
+    }
+    for (const auto streamId : it->second.sctpStreams)
+    {
+        _sctpStreamRoutes.erase(streamId);
+    }
+    _members.erase(it);
+
+    logger::info("detached conference tag %s from trunk %s, %zu members",
+        _transport->getLoggableId().c_str(),
+        conferenceTag.c_str(),
+        _id.c_str(),
+        _members.size());
+}
+
+void BarbellTrunk::start()
+{
+    if (_started.exchange(true))
+    {
+        return;
+    }
+
+    _transport->setDataReceiver(this);
+    _transport->start();
+    _transport->connect();
+}
+
+size_t BarbellTrunk::getMemberCount() const
+{
+    std::lock_guard<std::mutex> locker(_lock);
+    return _members.size();
+}
+
+BarbellTrunk::Member* BarbellTrunk::findMemberByLabel(const char* label, size_t labelLength)
+{
+    auto it = _members.find(std::string(label, labelLength));
+    return it != _members.end() ? &it->second : nullptr;
+}
+
+// Routes the stream to the conference that has the label, on the first open message in either direction
+transport::DataReceiver* BarbellTrunk::routeDataChannel(const uint16_t streamId,
+    const char* label,
+    const size_t labelLength)
+{
+    std::lock_guard<std::mutex> locker(_lock);
+    auto* member = findMemberByLabel(label, labelLength);
+    if (!member)
+    {
+        return nullptr;
+    }
+
+    if (_sctpStreamRoutes.emplace(streamId, member->receiver).second)
+    {
+        member->sctpStreams.push_back(streamId);
+    }
+    return member->receiver;
+}
+
+size_t BarbellTrunk::getReceivers(transport::DataReceiver** receivers) const
+{
+    std::lock_guard<std::mutex> locker(_lock);
+    size_t count = 0;
+    for (auto& member : _members)
+    {
+        receivers[count++] = member.second.receiver;
+    }
+    return count;
+}
+
+void BarbellTrunk::onRtpPacketReceived(transport::RtcTransport* sender,
+    memory::UniquePacket packet,
+    const uint32_t extendedSequenceNumber,
+    const uint64_t timestamp)
+{
+    const auto* rtpHeader = rtp::RtpHeader::fromPacket(*packet);
+    if (!rtpHeader)
+    {
+        return;
+    }
+
+    auto* receiver = _ssrcRoutes.getItem(rtpHeader->ssrc.get());
+    if (receiver)
+    {
+        receiver->onRtpPacketReceived(sender, std::move(packet), extendedSequenceNumber, timestamp);
+    }
+}
+
+// Reports are consumed by the transport itself. Only feedback is of interest to the conferences, which is routed
+// on media ssrc. A compound packet carrying feedback for several conferences is copied to each of them.
+void BarbellTrunk::onRtcpPacketDecoded(transport::RtcTransport* sender,
+    memory::UniquePacket packet,
+    const uint64_t timestamp)
+{
+    transport::DataReceiver* receivers[8];
+    size_t receiverCount = 0;
+    const rtp::CompoundRtcpPacket compoundPacket(packet->get(), packet->getLength());
+    for (const auto& rtcpPacket : compoundPacket)
+    {
+        if (rtcpPacket.packetType != rtp::RtcpPacketType::RTPTRANSPORT_FB &&
+            rtcpPacket.packetType != rtp::RtcpPacketType::PAYLOADSPECIFIC_FB)
+        {
+            continue;
+        }
+
+        const auto* feedback = reinterpret_cast<const rtp::RtcpFeedback*>(&rtcpPacket);
+        auto* receiver = _ssrcRoutes.getItem(feedback->mediaSsrc.get());
+        if (!receiver || std::find(receivers, receivers + receiverCount, receiver) != receivers + receiverCount)
+        {
+            continue;
+        }
+
+        if (receiverCount == sizeof(receivers) / sizeof(receivers[0]))
+        {
+            break;
+        }
+        receivers[receiverCount++] = receiver;
+    }
+
+    for (size_t i = 1; i < receiverCount; ++i)
+    {
+        auto packetCopy = memory::makeUniquePacket(_transport->getAllocator(), *packet);
+        if (packetCopy)
+        {
+            receivers[i]->onRtcpPacketDecoded(sender, std::move(packetCopy), timestamp);
+        }
+    }
+    if (receiverCount > 0)
+    {
+        receivers[0]->onRtcpPacketDecoded(sender, std::move(packet), timestamp);
+    }
+}
+
+void BarbellTrunk::onConnected(transport::RtcTransport* sender)
+{
+    transport::DataReceiver* receivers[maxMembers];
+    const size_t receiverCount = getReceivers(receivers);
+    for (size_t i = 0; i < receiverCount; ++i)
+    {
+        receivers[i]->onConnected(sender);
+    }
+}
+
+void BarbellTrunk::onSctpEstablished(transport::RtcTransport* sender)
+{
+    _sctpEstablished = true;
+    transport::DataReceiver* receivers[maxMembers];
+    const size_t receiverCount = getReceivers(receivers);
+    for (size_t i = 0; i < receiverCount; ++i)
+    {
+        receivers[i]->onSctpEstablished(sender);
+    }
+}
+
+void BarbellTrunk::onSctpMessage(transport::RtcTransport* sender,
+    const uint16_t streamId,
+    const uint16_t streamSequenceNumber,
+    const uint32_t payloadProtocol,
+    const void* data,
+    const size_t length)
+{
+    auto* receiver = _sctpStreamRoutes.getItem(streamId);
+    if (receiver)
+    {
+        receiver->onSctpMessage(sender, streamId, streamSequenceNumber, payloadProtocol, data, length);
+        return;
+    }
+
+    if (!isDataChannelOpen(payloadProtocol, data, length))
+    {
+        return;
+    }
+
+    size_t labelLength = 0;
+    const char* label = getOpenMessageLabel(data, length, labelLength);
+    receiver = label ? routeDataChannel(streamId, label, labelLength) : nullptr;
+    if (!receiver)
+    {
+        logger::warn("data channel %u opened for unknown conference on trunk %s",
+            _transport->getLoggableId().c_str(),
+            streamId,
+            _id.c_str());
+        return;
+    }
+
+    receiver->onSctpMessage(sender, streamId, streamSequenceNumber, payloadProtocol, data, length);
+}
+
+void BarbellTrunk::onIceReceived(transport::RtcTransport* transport, const uint64_t timestamp)
+{
+    transport::DataReceiver* receivers[maxMembers];
+    const size_t receiverCount = getReceivers(receivers);
+    for (size_t i = 0; i < receiverCount; ++i)
+    {
+        receivers[i]->onIceReceived(transport, timestamp);
+    }
+}
+
+// Data channels opened by this side are learnt from the outbound open message, as the remote acknowledges on the
+// same stream.
+bool BarbellTrunk::sendSctp(const uint16_t streamId,
+    const uint32_t protocolId,
+    memory::PoolBuffer<memory::PacketPoolAllocator>&& buffer)
+{
+    if (protocolId == webrtc::DataChannelPpid::WEBRTC_ESTABLISH && buffer.getLength() <= 1024)
+    {
+        char openMessage[buffer.getLength()];
+        buffer.copyTo(openMessage, 0, buffer.getLength());
+        if (isDataChannelOpen(protocolId, openMessage, buffer.getLength()))
+        {
+            size_t labelLength = 0;
+            const char* label = getOpenMessageLabel(openMessage, buffer.getLength(), labelLength);
+            if (label)
+            {
+                routeDataChannel(streamId, label, labelLength);
+            }
+        }
+    }
+
+    return _transport->sendSctp(streamId, protocolId, std::move(buffer));
+}
+
+uint16_t BarbellTrunk::allocateOutboundSctpStream()
+{
+    return _transport->allocateOutboundSctpStream();
+}
+
+memory::PacketPoolAllocator& BarbellTrunk::getAllocator()
+{
+    return _transport->getAllocator();
+}
+
+BarbellTrunkRegistry::BarbellTrunkRegistry(transport::TransportFactory& transportFactory)
+    : _transportFactory(transportFactory)
+{
+}
+
+std::shared_ptr<BarbellTrunk> BarbellTrunkRegistry::acquire(const std::string& trunkId, const ice::IceRole iceRole)
+{
+    std::lock_guard<std::mutex> locker(_lock);
+    auto it = _trunks.find(trunkId);
+    if (it != _trunks.end())
+    {
+        ++it->second.users;
+        return it->second.trunk;
+    }
+
+    if (_ports.empty() && !_transportFactory.openRtpMuxPorts(_ports, maxTrunkSessionsPerPort))
+    {
+        logger::error("Failed to open UDP ports for barbell trunks", "BarbellTrunkRegistry");
+        return nullptr;
+    }
+
+    auto transport = _transportFactory.createOnPorts(iceRole,
+        utils::hash<std::string>{}(trunkId),
+        _ports,
+        expectedInboundStreamCount,
+        expectedOutboundStreamCount,
+        trunkJobQueueSize,
+        false,
+        false);
+    if (!transport || !transport->isInitialized())
+    {
+        logger::error("Failed to create transport for barbell trunk %s", "BarbellTrunkRegistry", trunkId.c_str());
+        return nullptr;
+    }
+    transport->setTag(EngineBarbell::barbellTag);
+
+    auto& entry = _trunks[trunkId];
+    entry.trunk = std::make_shared<BarbellTrunk>(trunkId, transport);
+    entry.users = 1;
+    logger::info("Created barbell trunk %s, transport %s",
+        "BarbellTrunkRegistry",
+        trunkId.c_str(),
+        transport->getLoggableId().c_str());
+    return entry.trunk;
+}
+
+bool BarbellTrunkRegistry::release(const std::shared_ptr<BarbellTrunk>& trunk, const std::string& conferenceTag)
+{
+    std::lock_guard<std::mutex> locker(_lock);
+    trunk->detach(conferenceTag);
+
+    auto it = _trunks.find(trunk->getId());
+    if (it == _trunks.end() || it->second.trunk != trunk)
+    {
+        return false;
+    }
+
+    if (--it->second.users > 0)
+    {
+        return false;
+    }
+
+    logger::info("Removed barbell trunk %s", "BarbellTrunkRegistry", trunk->getId().c_str());
+    _trunks.erase(it);
+    return true;
+}
+
+size_t BarbellTrunkRegistry::size() const
+{
+    std::lock_guard<std::mutex> locker(_lock);
+    return _trunks.size();
+}
+
+} // namespace bridge
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "concurrency/MpmcHashmap.h"
+#include "transport/DataReceiver.h"
+#include "transport/RtcTransport.h"
+#include "transport/ice/IceSession.h"
+#include "webrtc/DataStreamTransport.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace transport
+{
+class TransportFactory;
+} // namespace transport
+
+namespace bridge
+{
+
+/**
+ * One ICE/DTLS/SRTP transport and SCTP association towards a remote bridge, shared by all conferences barbelled
+ * over the same trunk id. Each conference attaches its EngineMixer under a conference tag that both bridges agree
+ * on. Inbound RTP is routed on ssrc, RTCP feedback on media ssrc and SCTP on the data channel opened with the
+ * conference tag as label. Ssrcs must be unique across the conferences on a trunk, attach fails otherwise.
+ * Packets are routed without locking. Callbacks into a detached receiver may still be running when detach returns,
+ * they are done once a job posted on the trunk transport after detach has run.
+ */
+class BarbellTrunk : public transport::DataReceiver, public webrtc::DataStreamTransport
+{
+public:
+    BarbellTrunk(const std::string& trunkId, const std::shared_ptr<transport::RtcTransport>& transport);
+
+    static std::string makeDataChannelLabel(const std::string& conferenceTag);
+
+    // ssrcs are the inbound barbell ssrcs and the local ssrcs the remote bridge sends feedback for
+    bool attach(const std::string& conferenceTag, transport::DataReceiver& receiver, const std::vector<uint32_t>& ssrcs);
+    void detach(const std::string& conferenceTag);
+
+    // first caller configures remote ice and dtls, later conferences reuse the established transport
+    bool claimConfiguration() { return !_configured.exchange(true); }
+    // starts the transport with the trunk as data receiver the first time it is called
+    void start();
+
+    // conferences attaching later open their data channel when added to the engine
+    bool isSctpEstablished() const { return _sctpEstablished; }
+
+    const std::string& getId() const { return _id; }
+    std::shared_ptr<transport::RtcTransport>& getTransport() { return _transport; }
+    size_t getMemberCount() const;
+
+public: // transport::DataReceiver
+    void onRtpPacketReceived(transport::RtcTransport* sender,
+        memory::UniquePacket packet,
+        uint32_t extendedSequenceNumber,
+        uint64_t timestamp) override;
+    void onRtcpPacketDecoded(transport::RtcTransport* sender, memory::UniquePacket packet, uint64_t timestamp) override;
+    void onConnected(transport::RtcTransport* sender) override;
+    bool onSctpConnectionRequest(transport::RtcTransport* sender, uint16_t remotePort) override { return true; }
+    void onSctpEstablished(transport::RtcTransport* sender) override;
+    void onSctpMessage(transport::RtcTransport* sender,
+        uint16_t streamId,
+        uint16_t streamSequenceNumber,
+        uint32_t payloadProtocol,
+        const void* data,
+        size_t length) override;
+    void onRecControlReceived(transport::RecordingTransport* sender,
+        memory::UniquePacket packet,
+        uint64_t timestamp) override
+    {
+    }
+    void onIceReceived(transport::RtcTransport* transport, uint64_t timestamp) override;
+
+public: // webrtc::DataStreamTransport
+    bool sendSctp(uint16_t streamId,
+        uint32_t protocolId,
+        memory::PoolBuffer<memory::PacketPoolAllocator>&& buffer) override;
+    uint16_t allocateOutboundSctpStream() override;
+    memory::PacketPoolAllocator& getAllocator() override;
+
+private:
+    struct Member
+    {
+        transport::DataReceiver* receiver = nullptr;
+        std::vector<uint32_t> ssrcs;
+        std::vector<uint16_t> sctpStreams;
+    };
+
+    static const size_t maxMembers = 64;
+
+    Member* findMemberByLabel(const char* label, size_t labelLength);
+    transport::DataReceiver* routeDataChannel(uint16_t streamId, const char* label, size_t labelLength);
+    size_t getReceivers(transport::DataReceiver** receivers) const;
+
+    const std::string _id;
+    std::shared_ptr<transport::RtcTransport> _transport;
+    std::atomic_bool _configured;
+    std::atomic_bool _started;
+
+    std::atomic_bool _sctpEstablished;
+
+    // Guards the members and route changes. Not held while calling the receivers.
+    mutable std::mutex _lock;
+    std::unordered_map<std::string, Member> _members;
+    concurrency::MpmcHashmap32<uint32_t, transport::DataReceiver*> _ssrcRoutes;
+    concurrency::MpmcHashmap32<uint16_t, transport::DataReceiver*> _sctpStreamRoutes;
+};
+
+/**
+ * Trunks by trunk id. A trunk and its transport live as long as some barbell uses it.
+ */
+class BarbellTrunkRegistry
+{
+public:
+    explicit BarbellTrunkRegistry(transport::TransportFactory& transportFactory);
+
+    std::shared_ptr<BarbellTrunk> acquire(const std::string& trunkId, ice::IceRole iceRole);
+
+    // Returns true if this was the last user. The caller then owns the transport and must stop it.
+    bool release(const std::shared_ptr<BarbellTrunk>& trunk, const std::string& conferenceTag);
+
+    size_t size() const;
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<BarbellTrunk> trunk;
+        uint32_t users = 0;
+    };
+
+    transport::TransportFactory& _transportFactory;
+    mutable std::mutex _lock;
+    transport::Endpoints _ports;
+    std::unordered_map<std::string, Entry> _trunks;
+};
+
+} // namespace bridge
@@ -3,15 +3,18 @@
 #include "bridge/ApiRequestHandler.h"
 #include "bridge/MixerManager.h"
 #include "bridge/engine/Engine.h"
+#include "concurrency/ThreadUtils.h"
 #include "httpd/Httpd.h"
 #include "httpd/HttpdFactory.h"
 #include "jobmanager/JobManager.h"
 #include "jobmanager/TimerQueue.h"
 #include "jobmanager/WorkerThread.h"
+#include "transport/DtlsHandshakePool.h"
 #include "transport/Endpoint.h"
 #include "transport/EndpointFactoryImpl.h"
 #include "transport/ProbeServer.h"
 #include "transport/RtcePoll.h"
+#include "transport/SocketHandover.h"
 #include "transport/TransportFactory.h"
 #include "transport/dtls/SrtpClientFactory.h"
 #include "transport/dtls/SslDtls.h"
@@ -63,6 +66,7 @@ Bridge::Bridge(const config::Config& config)
       _timers(std::make_unique<jobmanager::TimerQueue>(4096 * 8)),
       _rtJobManager(std::make_unique<jobmanager::JobManager>(*_timers)),
       _backgroundJobQueue(std::make_unique<jobmanager::JobManager>(*_timers)),
+      _handshakeJobManager(std::make_unique<jobmanager::JobManager>(*_timers)),
       _sslDtls(std::make_unique<transport::SslDtls>()),
       _network(transport::createRtcePoll()),
       _mainPacketAllocator(std::make_unique<memory::PacketPoolAllocator>(_config.mem.sendPool / 4, "main")),
@@ -74,6 +78,11 @@ Bridge::Bridge(const config::Config& config)
 
 Bridge::~Bridge()
 {
+    if (_handoverServer)
+    {
+        _handoverServer->stop();
+    }
+
     if (_httpd)
     {
         _httpd = nullptr;
@@ -105,6 +114,11 @@ Bridge::~Bridge()
     {
         _rtJobManager->stop();
     }
+
+    if (_handshakeJobManager)
+    {
+        _handshakeJobManager->stop();
+    }
     logger::info("JobManager stopped", "main");
 
     _timers.reset();
@@ -120,6 +134,14 @@ Bridge::~Bridge()
     {
         _backgroundWorker->stop();
     }
+
+    for (auto& handshakeWorker : _handshakeWorkers)
+    {
+        handshakeWorker->stop();
+    }
+
+    // all receive jobs have stopped, a pending handover can pass the sockets on
+    _handoverServer.reset();
 }
 
 void Bridge::initialize()
@@ -174,6 +196,7 @@ void Bridge::initialize(std::shared_ptr<transport::EndpointFactory> endpointFact
     // create deadlocks
     const bool yieldEnabled = false;
     _backgroundWorker = std::make_unique<jobmanager::WorkerThread>(*_backgroundJobQueue, yieldEnabled, "MMWorker");
+    startHandshakeWorkers();
 
     if (!_sslDtls->isInitialized())
     {
@@ -193,6 +216,15 @@ void Bridge::initialize(std::shared_ptr<transport::EndpointFactory> endpointFact
 
     _srtpClientFactory = std::make_unique<transport::SrtpClientFactory>(*_sslDtls);
     _bweConfig.sanitize();
+
+    // waits for the bridge serving the path to shut down
+    if (!_config.handover.path.get().empty())
+    {
+        std::vector<transport::HandoverSocket> sockets;
+        transport::handover::fetchSockets(_config.handover.path, sockets);
+        transport::handover::setInheritedSockets(sockets);
+    }
+
     _transportFactory = transport::createTransportFactory(*_rtJobManager,
         *_srtpClientFactory,
         _config,
@@ -203,7 +235,9 @@ void Bridge::initialize(std::shared_ptr<transport::EndpointFactory> endpointFact
         _localInterfaces,
         *_network,
         *_mainPacketAllocator,
-        endpointFactory);
+        endpointFactory,
+        _dtlsHandshakePool.get());
+    transport::handover::closeInheritedSockets();
     if (!_transportFactory->isGood())
     {
         logger::error("Failed to initialize transport factory", "main");
@@ -230,6 +264,7 @@ void Bridge::initialize(std::shared_ptr<transport::EndpointFactory> endpointFact
         *_mainPacketAllocator,
         *_sendPacketAllocator,
         *_audioPacketAllocator);
+    _mixerManager->setPlacement(applyPlacement());
 
     _requestHandler = std::make_unique<bridge::ApiRequestHandler>(*_mixerManager, *_sslDtls, *_probeServer, _config);
 
@@ -243,6 +278,123 @@ void Bridge::initialize(std::shared_ptr<transport::EndpointFactory> endpointFact
     _initialized = true;
 }
 
+void Bridge::startHandoverServer(std::function<void()> onHandoverRequested)
+{
+    if (_config.handover.path.get().empty())
+    {
+        return;
+    }
+
+    _handoverServer = std::make_unique<transport::HandoverServer>(
+        _config.handover.path,
+        [this]() { return transport::handover::findBoundSockets(getSharedPortAddresses()); },
+        std::move(onHandoverRequested));
+}
+
+std::vector<transport::SocketAddress> Bridge::getSharedPortAddresses() const
+{
+    std::vector<transport::SocketAddress> addresses;
+    for (const auto& localInterface : _localInterfaces)
+    {
+        if (_config.ice.singlePort != 0)
+        {
+            for (uint32_t portOffset = 0; portOffset < std::max(1u, _config.ice.sharedPorts.get()); ++portOffset)
+            {
+                addresses.push_back(transport::SocketAddress(localInterface, _config.ice.singlePort + portOffset));
+            }
+        }
+        if (_config.ice.tcp.enable)
+        {
+            addresses.push_back(transport::SocketAddress(localInterface, _config.ice.tcp.port));
+        }
+        if (!_config.recording.local.enable && _config.recording.singlePort != 0)
+        {
+            for (uint32_t portOffset = 0; portOffset < std::max(1u, _config.recording.sharedPorts.get()); ++portOffset)
+            {
+                addresses.push_back(
+                    transport::SocketAddress(localInterface, _config.recording.singlePort + portOffset));
+            }
+        }
+    }
+    return addresses;
+}
+
+Stats::PlacementStats Bridge::applyPlacement()
+{
+    Stats::PlacementStats placement;
+    auto parseCpus = [](const std::string& text, concurrency::CpuList& cpus) {
+        if (!concurrency::parseCpuList(text, cpus))
+        {
+            logger::warn("invalid cpu list '%s'", "main", text.c_str());
+            cpus.clear();
+        }
+        return !cpus.empty();
+    };
+
+    concurrency::CpuList engineCpus;
+    if (parseCpus(_config.placement.engine, engineCpus) && _engine->setAffinity(engineCpus))
+    {
+        placement.engineCpus = concurrency::formatCpuList(engineCpus);
+    }
+    else
+    {
+        engineCpus.clear();
+    }
+
+    concurrency::CpuList cpus;
+    if (parseCpus(_config.placement.rtce, cpus) && _network->setAffinity(cpus))
+    {
+        placement.rtceCpus = concurrency::formatCpuList(cpus);
+    }
+    if (parseCpus(_config.placement.timers, cpus) && _timers->setAffinity(cpus))
+    {
+        placement.timerCpus = concurrency::formatCpuList(cpus);
+    }
+
+    concurrency::CpuList workerCpus;
+    if (parseCpus(_config.placement.workers, workerCpus))
+    {
+        bool pinned = true;
+        for (size_t i = 0; i < _workerThreads.size(); ++i)
+        {
+            pinned &= _workerThreads[i]->setAffinity({workerCpus[i % workerCpus.size()]});
+        }
+        if (pinned)
+        {
+            placement.workerCpus = concurrency::formatCpuList(workerCpus);
+        }
+        else
+        {
+            workerCpus.clear();
+        }
+    }
+
+    // the pools carry packets from receive through engine and workers to send
+    const auto& poolCpus = (!engineCpus.empty() ? engineCpus : workerCpus);
+    const int node = (poolCpus.empty() ? -1 : concurrency::getNumaNode(poolCpus[0]));
+    if (node >= 0)
+    {
+        if (_mainPacketAllocator->bindToNumaNode(node) && _sendPacketAllocator->bindToNumaNode(node) &&
+            _audioPacketAllocator->bindToNumaNode(node))
+        {
+            placement.memoryNode = node;
+        }
+        else
+        {
+            logger::warn("failed to bind packet pools to NUMA node %d, err %d", "main", node, errno);
+        }
+    }
+
+    logger::info("placement engine '%s', rtce '%s', workers '%s', timers '%s', memory node %d",
+        "main",
+        placement.engineCpus.c_str(),
+        placement.rtceCpus.c_str(),
+        placement.workerCpus.c_str(),
+        placement.timerCpus.c_str(),
+        placement.memoryNode);
+    return placement;
+}
+
 void Bridge::startWorkerThreads()
 {
     auto numWorkerThreads = _config.numWorkerTreads.get();
@@ -269,4 +421,25 @@ void Bridge::startWorkerThreads()
         _workerThreads.push_back(std::make_unique<jobmanager::WorkerThread>(*_rtJobManager, true, "RTWorker"));
     }
 }
+
+void Bridge::startHandshakeWorkers()
+{
+    const auto numHandshakeThreads = _config.dtls.handshakeThreads.get();
+    if (!_config.dtls.handshakePool || numHandshakeThreads == 0)
+    {
+        logger::info("DTLS handshakes run on worker threads", "main");
+        return;
+    }
+
+    logger::info("Starting %u DTLS handshake threads", "main", numHandshakeThreads);
+    _handshakeWorkers.reserve(numHandshakeThreads);
+    for (uint32_t i = 0; i < numHandshakeThreads; ++i)
+    {
+        _handshakeWorkers.push_back(
+            std::make_unique<jobmanager::WorkerThread>(*_handshakeJobManager, true, "DtlsWorker"));
+        _handshakeWorkers.back()->setPriority(concurrency::Priority::Low);
+    }
+
+    _dtlsHandshakePool = std::make_unique<transport::DtlsHandshakePool>(_config, *_handshakeJobManager);
+}
 } // namespace bridge
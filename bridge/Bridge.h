@@ -1,4 +1,5 @@
 #pragma once
+#include "bridge/Stats.h"
 #include "bwe/BandwidthEstimator.h"
 #include "bwe/RateController.h"
 #include "config/Config.h"
@@ -7,6 +8,7 @@
 #include "memory/PacketPoolAllocator.h"
 #include "transport/ice/IceSession.h"
 #include "transport/sctp/SctpConfig.h"
+#include <functional>
 
 namespace utils
 {
@@ -28,7 +30,9 @@ class SrtpClientFactory;
 class SslDtls;
 class TransportFactory;
 class EndpointFactory;
+class DtlsHandshakePool;
 class ProbeServer;
+class HandoverServer;
 } // namespace transport
 
 namespace httpd
@@ -57,6 +61,10 @@ public:
         const std::vector<transport::SocketAddress>& interfaces = std::vector<transport::SocketAddress>());
     bool isInitialized() const { return _initialized; }
 
+    // Serves handover.path. onHandoverRequested is called when a new process asks for the sockets. They are sent when
+    // this Bridge is destroyed, after it has stopped receiving on them.
+    void startHandoverServer(std::function<void()> onHandoverRequested);
+
     transport::SslDtls& getSslDtls() { return *_sslDtls; }
 
 private:
@@ -73,6 +81,8 @@ private:
     const std::unique_ptr<jobmanager::JobManager> _rtJobManager;
     const std::unique_ptr<jobmanager::JobManager> _backgroundJobQueue;
     std::unique_ptr<jobmanager::WorkerThread> _backgroundWorker;
+    const std::unique_ptr<jobmanager::JobManager> _handshakeJobManager;
+    std::vector<std::unique_ptr<jobmanager::WorkerThread>> _handshakeWorkers;
 
     std::vector<transport::SocketAddress> _localInterfaces;
     const std::unique_ptr<transport::SslDtls> _sslDtls;
@@ -81,13 +91,18 @@ private:
     const std::unique_ptr<memory::PacketPoolAllocator> _mainPacketAllocator;
     const std::unique_ptr<memory::PacketPoolAllocator> _sendPacketAllocator;
     const std::unique_ptr<memory::AudioPacketPoolAllocator> _audioPacketAllocator;
+    std::unique_ptr<transport::DtlsHandshakePool> _dtlsHandshakePool;
     std::unique_ptr<transport::TransportFactory> _transportFactory;
     std::unique_ptr<transport::ProbeServer> _probeServer;
     const std::unique_ptr<bridge::Engine> _engine;
     std::unique_ptr<bridge::MixerManager> _mixerManager;
     std::unique_ptr<bridge::ApiRequestHandler> _requestHandler;
     std::unique_ptr<httpd::HttpDaemon> _httpd;
+    std::unique_ptr<transport::HandoverServer> _handoverServer;
 
     void startWorkerThreads();
+    void startHandshakeWorkers();
+    Stats::PlacementStats applyPlacement();
+    std::vector<transport::SocketAddress> getSharedPortAddresses() const;
 };
 } // namespace bridge
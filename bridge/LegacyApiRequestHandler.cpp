@@ -854,6 +854,15 @@ httpd::Response LegacyApiRequestHandler::generatePatchConferenceResponse(const l
                         group._sources.push_back(level.feedback);
                         group._semantics = "FID";
                         channel._ssrcGroups.push_back(group);
+
+                        if (level.fec != 0)
+                        {
+                            legacyapi::SsrcGroup fecGroup;
+                            fecGroup._sources.push_back(level.main);
+                            fecGroup._sources.push_back(level.fec);
+                            fecGroup._semantics = "FEC-FR";
+                            channel._ssrcGroups.push_back(fecGroup);
+                        }
                     }
 
                     legacyapi::SsrcAttribute ssrcAttribute;
@@ -4,6 +4,7 @@
 #include "bridge/AudioStream.h"
 #include "bridge/AudioStreamDescription.h"
 #include "bridge/Barbell.h"
+#include "bridge/BarbellTrunk.h"
 #include "bridge/BarbellVideoStreamDescription.h"
 #include "bridge/DataStreamDescription.h"
 #include "bridge/MixerJobs.h"
@@ -17,6 +18,7 @@
 #include "bridge/engine/EngineRecordingStream.h"
 #include "bridge/engine/EngineVideoStream.h"
 #include "bridge/engine/PacketCache.h"
+#include "concurrency/CounterWait.h"
 #include "config/Config.h"
 #include "jobmanager/JobManager.h"
 #include "logger/Logger.h"
@@ -28,7 +30,6 @@
 #include "utils/SsrcGenerator.h"
 #include "utils/StdExtensions.h"
 #include "utils/StringBuilder.h"
-#include <unistd.h>
 #include <utility>
 
 namespace
@@ -128,16 +129,10 @@ void makeSsrcWhitelistLog(const bridge::SsrcWhitelist& ssrcWhitelist, utils::Str
     }
 }
 
-bool waitForPendingJobs(const uint32_t timeoutMs, const uint32_t pollIntervalMs, transport::Transport& transport)
+// wakes when the transport job counter drains rather than polling it
+bool waitForPendingJobs(const uint32_t timeoutMs, transport::Transport& transport)
 {
-    uint32_t totalSleepTimeMs = 0;
-    while (totalSleepTimeMs < timeoutMs && transport.hasPendingJobs())
-    {
-        totalSleepTimeMs += pollIntervalMs;
-        usleep(pollIntervalMs * 1000);
-    }
-
-    return totalSleepTimeMs < timeoutMs;
+    return concurrency::waitForZero(transport.getJobCounter(), timeoutMs * utils::Time::ms);
 }
 
 } // namespace
@@ -170,6 +165,9 @@ Mixer::Mixer(std::string id,
       _engineMixer(std::move(engineMixer)),
       _idGenerator(idGenerator),
       _ssrcGenerator(ssrcGenerator),
+      _removedTransportsCpuTime(0),
+      _statsCpuTime(0),
+      _statsTimestamp(utils::Time::getAbsoluteTime()),
       _videoCodecs(videoCodecs),
       _useGlobalPort(useGlobalPort)
 {
@@ -224,7 +222,21 @@ void Mixer::stopTransports()
     for (auto& barbell : _barbells)
     {
         logTransportPacketLoss(barbell.second->id, *barbell.second->transport, _loggableId.c_str());
-        barbell.second->transport->stop();
+        if (releaseBarbellTrunk(*barbell.second))
+        {
+            barbell.second->transport->stop();
+            continue;
+        }
+
+        // trunk keeps running for other conferences. Jobs of this conference are done when this one has run
+        auto trunkDrained = barbell.second->trunkDrained;
+        if (!barbell.second->transport->postOnQueue([trunkDrained]() { *trunkDrained = true; }))
+        {
+            logger::warn("Failed to post drain job on barbell trunk %s",
+                _loggableId.c_str(),
+                barbell.second->trunk->getId().c_str());
+            *trunkDrained = true;
+        }
     }
 
     _barbellPorts.clear();
@@ -259,7 +271,8 @@ bool Mixer::hasPendingTransportJobs()
 
     for (auto& barbell : _barbells)
     {
-        if (barbell.second->transport->hasPendingJobs())
+        if (barbell.second->sharesTransport ? !*barbell.second->trunkDrained
+                                            : barbell.second->transport->hasPendingJobs())
         {
             return true;
         }
@@ -276,6 +289,14 @@ bool Mixer::addBundleTransportIfNeeded(const std::string& endpointId,
     const bool usePrivatePort)
 {
     std::lock_guard<std::mutex> locker(_configurationLock);
+    return createBundleTransport(endpointId, iceRole, hasVideoEnabled, usePrivatePort);
+}
+
+bool Mixer::createBundleTransport(const std::string& endpointId,
+    const ice::IceRole iceRole,
+    const bool hasVideoEnabled,
+    const bool usePrivatePort)
+{
     if (_bundleTransports.find(endpointId) != _bundleTransports.end())
     {
         return true;
@@ -456,6 +477,14 @@ bool Mixer::addBundledAudioStream(std::string& outId,
     utils::Optional<uint32_t> idleTimeoutSeconds)
 {
     std::lock_guard<std::mutex> locker(_configurationLock);
+    return createBundledAudioStream(outId, endpointId, mediaMode, idleTimeoutSeconds);
+}
+
+bool Mixer::createBundledAudioStream(std::string& outId,
+    const std::string& endpointId,
+    MediaMode mediaMode,
+    utils::Optional<uint32_t> idleTimeoutSeconds)
+{
     if (_audioStreams.find(endpointId) != _audioStreams.end())
     {
         logger::warn("AudioStream with endpointId %s already exists", _loggableId.c_str(), endpointId.c_str());
@@ -502,7 +531,14 @@ bool Mixer::addBundledVideoStream(std::string& outId,
     utils::Optional<uint32_t> idleTimeoutSeconds)
 {
     std::lock_guard<std::mutex> locker(_configurationLock);
+    return createBundledVideoStream(outId, endpointId, ssrcRewrite, idleTimeoutSeconds);
+}
 
+bool Mixer::createBundledVideoStream(std::string& outId,
+    const std::string& endpointId,
+    const bool ssrcRewrite,
+    utils::Optional<uint32_t> idleTimeoutSeconds)
+{
     if (!hasVideoEnabled())
     {
         logger::warn("Tried to allocate video for endpointId %s when the conference has the video disabled",
@@ -556,6 +592,13 @@ bool Mixer::addBundledDataStream(std::string& outId,
     utils::Optional<uint32_t> idleTimeoutSeconds)
 {
     std::lock_guard<std::mutex> locker(_configurationLock);
+    return createBundledDataStream(outId, endpointId, idleTimeoutSeconds);
+}
+
+bool Mixer::createBundledDataStream(std::string& outId,
+    const std::string& endpointId,
+    utils::Optional<uint32_t> idleTimeoutSeconds)
+{
     if (_dataStreams.find(endpointId) != _dataStreams.end())
     {
         logger::warn("DataStream with endpointId %s already exists", _loggableId.c_str(), endpointId.c_str());
@@ -594,6 +637,162 @@ bool Mixer::addBundledDataStream(std::string& outId,
     return streamItr.first->second->transport->isInitialized();
 }
 
+bool Mixer::addBundledEndpoints(std::vector<BundledEndpointAllocation>& allocations)
+{
+    std::lock_guard<std::mutex> locker(_configurationLock);
+
+    std::unordered_set<std::string> endpointIds;
+    endpointIds.reserve(allocations.size());
+    for (const auto& allocation : allocations)
+    {
+        const auto& endpointId = allocation.endpointId;
+        if (!endpointIds.insert(endpointId).second || _bundleTransports.find(endpointId) != _bundleTransports.end() ||
+            _audioStreams.find(endpointId) != _audioStreams.end() ||
+            _videoStreams.find(endpointId) != _videoStreams.end() ||
+            _dataStreams.find(endpointId) != _dataStreams.end())
+        {
+            logger::warn("Bulk allocation of endpointId %s that already exists",
+                _loggableId.c_str(),
+                endpointId.c_str());
+            return false;
+        }
+
+        // video is left out if the conference has no video
+        const bool hasVideo = allocation.videoSsrcRewrite.isSet() && hasVideoEnabled();
+        if (!allocation.audio.isSet() && !hasVideo && !allocation.data)
+        {
+            logger::warn("Bulk allocation of endpointId %s without media", _loggableId.c_str(), endpointId.c_str());
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < allocations.size(); ++i)
+    {
+        auto& allocation = allocations[i];
+        const auto& endpointId = allocation.endpointId;
+        bool created = createBundleTransport(endpointId,
+            allocation.iceRole,
+            allocation.videoSsrcRewrite.isSet(),
+            allocation.usePrivatePort);
+
+        std::string outId;
+        if (created && allocation.audio.isSet())
+        {
+            created =
+                createBundledAudioStream(outId, endpointId, allocation.audio.get(), allocation.idleTimeoutSeconds);
+            if (created)
+            {
+                allocation.audioId.set(outId);
+            }
+        }
+
+        if (created && allocation.videoSsrcRewrite.isSet() && hasVideoEnabled())
+        {
+            created = createBundledVideoStream(outId,
+                endpointId,
+                allocation.videoSsrcRewrite.get(),
+                allocation.idleTimeoutSeconds);
+            if (created)
+            {
+                allocation.videoId.set(outId);
+            }
+        }
+
+        if (created && allocation.data)
+        {
+            created = createBundledDataStream(outId, endpointId, allocation.idleTimeoutSeconds);
+            if (created)
+            {
+                allocation.dataId.set(outId);
+            }
+        }
+
+        if (!created)
+        {
+            logger::warn("Bulk allocation failed at endpointId %s", _loggableId.c_str(), endpointId.c_str());
+            for (size_t j = 0; j <= i; ++j)
+            {
+                removeBundledEndpoint(allocations[j].endpointId);
+                allocations[j].audioId = utils::Optional<std::string>();
+                allocations[j].videoId = utils::Optional<std::string>();
+                allocations[j].dataId = utils::Optional<std::string>();
+            }
+            return false;
+        }
+    }
+
+    logger::info("Created %zu bundled endpoints", _loggableId.c_str(), allocations.size());
+    return true;
+}
+
+void Mixer::removeBundledEndpoints(const std::vector<BundledEndpointAllocation>& allocations)
+{
+    std::lock_guard<std::mutex> locker(_configurationLock);
+    for (const auto& allocation : allocations)
+    {
+        removeBundledEndpoint(allocation.endpointId);
+    }
+}
+
+// Streams that are not yet in the engine are erased here. Streams the engine has, after a concurrent configure, are
+// removed through the engine and the transport is stopped when the last of them is gone.
+void Mixer::removeBundledEndpoint(const std::string& endpointId)
+{
+    auto transportItr = _bundleTransports.find(endpointId);
+    if (transportItr == _bundleTransports.end())
+    {
+        return;
+    }
+    const auto transport = transportItr->second.transport;
+
+    auto audioStreamItr = _audioStreams.find(endpointId);
+    if (audioStreamItr != _audioStreams.end())
+    {
+        auto engineStreamItr = _audioEngineStreams.find(endpointId);
+        if (engineStreamItr == _audioEngineStreams.end())
+        {
+            _audioStreams.erase(audioStreamItr);
+        }
+        else if (!audioStreamItr->second->markedForDeletion)
+        {
+            audioStreamItr->second->markedForDeletion = true;
+            _engineMixer->asyncRemoveStream(engineStreamItr->second.get());
+        }
+    }
+
+    auto videoStreamItr = _videoStreams.find(endpointId);
+    if (videoStreamItr != _videoStreams.end())
+    {
+        auto engineStreamItr = _videoEngineStreams.find(endpointId);
+        if (engineStreamItr == _videoEngineStreams.end())
+        {
+            _videoStreams.erase(videoStreamItr);
+        }
+        else if (!videoStreamItr->second->markedForDeletion)
+        {
+            videoStreamItr->second->markedForDeletion = true;
+            _engineMixer->asyncRemoveStream(engineStreamItr->second.get());
+        }
+    }
+
+    auto dataStreamItr = _dataStreams.find(endpointId);
+    if (dataStreamItr != _dataStreams.end())
+    {
+        auto engineStreamItr = _dataEngineStreams.find(endpointId);
+        if (engineStreamItr == _dataEngineStreams.end())
+        {
+            _dataStreams.erase(dataStreamItr);
+        }
+        else if (!dataStreamItr->second->markedForDeletion)
+        {
+            dataStreamItr->second->markedForDeletion = true;
+            _engineMixer->asyncRemoveStream(engineStreamItr->second.get());
+        }
+    }
+
+    stopTransportIfNeeded(transport, endpointId);
+}
+
 bool Mixer::removeAudioStream(const std::string& endpointId)
 {
     std::lock_guard<std::mutex> locker(_configurationLock);
@@ -906,6 +1105,7 @@ bool Mixer::getEndpointInfo(const std::string& endpointId,
             auto transport = audio->second->transport;
             endpoint.iceState = transport->getIceState();
             endpoint.dtlsState = transport->getDtlsState();
+            endpoint.cpuTimeMs = transport->getJobQueue().getCost().getTime() / utils::Time::ms;
 
             auto const& it = activeTalkers.find(audio->second->endpointIdHash);
             endpoint.isActiveTalker = (it != activeTalkers.end());
@@ -954,6 +1154,23 @@ bool Mixer::getEndpointExtendedInfo(const std::string& endpointId,
     return true;
 }
 
+bool Mixer::dumpPacketRecords(const std::string& endpointId, bool& outDumped)
+{
+    std::shared_ptr<transport::RtcTransport> transport;
+    {
+        std::lock_guard<std::mutex> locker(_configurationLock);
+        const auto transportItr = _bundleTransports.find(endpointId);
+        if (transportItr == _bundleTransports.end())
+        {
+            return false;
+        }
+        transport = transportItr->second.transport;
+    }
+
+    outDumped = transport->dumpPacketRecords("request");
+    return true;
+}
+
 bool Mixer::getAudioStreamDescription(const std::string& endpointId, AudioStreamDescription& outDescription) const
 {
     std::lock_guard<std::mutex> locker(_configurationLock);
@@ -1243,9 +1460,65 @@ Mixer::Stats Mixer::getStats()
     result.audioStreams = _audioStreams.size();
     result.dataStreams = _dataStreams.size();
     result.transports = _bundleTransports.size();
+
+    const auto timestamp = utils::Time::getAbsoluteTime();
+    result.cpuTime = sumCpuTime();
+    if (timestamp != _statsTimestamp)
+    {
+        result.cpuLoad = static_cast<double>(result.cpuTime - _statsCpuTime) / (timestamp - _statsTimestamp);
+    }
+    _statsCpuTime = result.cpuTime;
+    _statsTimestamp = timestamp;
     return result;
 }
 
+uint64_t Mixer::getCpuTime() const
+{
+    std::lock_guard<std::mutex> locker(_configurationLock);
+    return sumCpuTime();
+}
+
+uint64_t Mixer::sumCpuTime() const
+{
+    uint64_t cpuTime = _engineMixer->getEngineCost().getTime() + _removedTransportsCpuTime;
+    for (const auto& bundleTransportEntry : _bundleTransports)
+    {
+        cpuTime += bundleTransportEntry.second.transport->getJobQueue().getCost().getTime();
+    }
+
+    // streams of bundled endpoints run on the bundle transport counted above
+    auto sumStreams = [this, &cpuTime](const auto& streams) {
+        for (const auto& streamEntry : streams)
+        {
+            if (_bundleTransports.find(streamEntry.first) == _bundleTransports.end())
+            {
+                cpuTime += streamEntry.second->transport->getJobQueue().getCost().getTime();
+            }
+        }
+    };
+    sumStreams(_audioStreams);
+    sumStreams(_videoStreams);
+    sumStreams(_dataStreams);
+
+    for (const auto& recordingStreamEntry : _recordingStreams)
+    {
+        for (const auto& transportEntry : recordingStreamEntry.second->_transports)
+        {
+            cpuTime += transportEntry.second->getJobQueue().getCost().getTime();
+        }
+    }
+
+    for (const auto& barbellEntry : _barbells)
+    {
+        // a trunk serves several conferences and its cost cannot be split between them
+        if (!barbellEntry.second->trunk)
+        {
+            cpuTime += barbellEntry.second->transport->getJobQueue().getCost().getTime();
+        }
+    }
+    return cpuTime;
+}
+
 bool Mixer::configureAudioStream(const std::string& endpointId,
     const RtpMap& rtpMap,
     const RtpMap& telephoneEventRtpMap,
@@ -1920,6 +2193,7 @@ void Mixer::stopTransportIfNeeded(const std::shared_ptr<transport::RtcTransport>
         return;
     }
 
+    _removedTransportsCpuTime += transportToBeFinalized->getJobQueue().getCost().getTime();
     logTransportPacketLoss(endpointId, *transportToBeFinalized, _loggableId.c_str());
 
     logger::info("Engine stream removed, stopping transport %s, endpointId %s.",
@@ -2229,11 +2503,11 @@ void Mixer::engineRecordingStreamRemoved(const EngineRecordingStream& engineStre
         // Try first wait for pending jobs without stop the transport
         // as we may have some recording events to be sent and we don't
         // want to lose them
-        waitForPendingJobs(200, 5, *transportEntry.second);
+        waitForPendingJobs(200, *transportEntry.second);
         transportEntry.second->stop();
         _engineMixer->getJobManager().abortTimedJobs(transportEntry.second->getId());
 
-        if (!waitForPendingJobs(500, 5, *transportEntry.second))
+        if (!waitForPendingJobs(500, *transportEntry.second))
         {
             logger::error("RecordingStream id %s did not finish pending jobs in time. count=%u. Continuing "
                           "deletion anyway.",
@@ -2243,6 +2517,11 @@ void Mixer::engineRecordingStreamRemoved(const EngineRecordingStream& engineStre
         }
     }
 
+    for (const auto& transportEntry : stream->_transports)
+    {
+        _removedTransportsCpuTime += transportEntry.second->getJobQueue().getCost().getTime();
+    }
+
     _recordingEventPacketCache.erase(stream->_endpointIdHash);
     _recordingRtpPacketCaches.erase(stream->_endpointIdHash);
     _recordingStreams.erase(streamItr);
@@ -2303,10 +2582,10 @@ void Mixer::removeRecordingTransport(const std::string& streamId, const size_t e
     // Try first wait for pending jobs without stop the transport
     // as we may have some recording events to be sent and we don't
     // want to lose them
-    waitForPendingJobs(200, 5, *transportItr->second);
+    waitForPendingJobs(200, *transportItr->second);
     transportItr->second->stop();
     _engineMixer->getJobManager().abortTimedJobs(transportItr->second->getId());
-    if (!waitForPendingJobs(500, 5, *transportItr->second))
+    if (!waitForPendingJobs(500, *transportItr->second))
     {
         logger::error("RecordingTransport for streamId %s did not finish pending jobs in time. count=%u. Continuing "
                       "deletion anyway.",
@@ -2315,6 +2594,7 @@ void Mixer::removeRecordingTransport(const std::string& streamId, const size_t e
             transportItr->second->getJobCounter().load());
     }
 
+    _removedTransportsCpuTime += transportItr->second->getJobQueue().getCost().getTime();
     stream->_recEventUnackedPacketsTracker.erase(endpointIdHash);
     stream->_transports.erase(endpointIdHash);
 }
@@ -2366,6 +2646,58 @@ bool Mixer::addBarbell(const std::string& barbellId, ice::IceRole iceRole)
     return streamItr.first->second->transport->isInitialized();
 }
 
+bool Mixer::addTrunkedBarbell(const std::string& barbellId,
+    BarbellTrunkRegistry& trunkRegistry,
+    const std::string& trunkId,
+    const std::string& conferenceTag,
+    const ice::IceRole iceRole)
+{
+    std::lock_guard<std::mutex> locker(_configurationLock);
+    if (_barbells.find(barbellId) != _barbells.end())
+    {
+        logger::warn("Barbell with id %s already exists", _loggableId.c_str(), barbellId.c_str());
+        return false;
+    }
+
+    // engine identifies barbells by transport, so a conference can only use a trunk once
+    for (auto& barbellEntry : _barbells)
+    {
+        if (barbellEntry.second->trunk && barbellEntry.second->trunk->getId() == trunkId)
+        {
+            logger::warn("Barbell %s already uses trunk %s",
+                _loggableId.c_str(),
+                barbellEntry.first.c_str(),
+                trunkId.c_str());
+            return false;
+        }
+    }
+
+    auto trunk = trunkRegistry.acquire(trunkId, iceRole);
+    if (!trunk)
+    {
+        logger::error("Failed to acquire trunk %s for barbell %s",
+            _loggableId.c_str(),
+            trunkId.c_str(),
+            barbellId.c_str());
+        return false;
+    }
+
+    auto barbell = std::make_unique<Barbell>(barbellId, trunk->getTransport());
+    barbell->trunk = trunk;
+    barbell->trunkRegistry = &trunkRegistry;
+    barbell->trunkTag = conferenceTag;
+    _barbells.emplace(barbellId, std::move(barbell));
+
+    logger::info("Created barbell id %s on trunk %s, conference tag %s, transport %s",
+        _loggableId.c_str(),
+        barbellId.c_str(),
+        trunkId.c_str(),
+        conferenceTag.c_str(),
+        trunk->getTransport()->getLoggableId().c_str());
+
+    return true;
+}
+
 bool Mixer::addBarbellToEngine(const std::string& barbellId)
 {
     std::lock_guard<std::mutex> locker(_configurationLock);
@@ -2378,6 +2710,37 @@ bool Mixer::addBarbellToEngine(const std::string& barbellId)
     logger::debug("Adding barbell to engine, id %s", getLoggableId().c_str(), barbellId.c_str());
 
     auto& barbell = *barbellIt->second;
+    if (barbell.trunk)
+    {
+        // inbound media ssrcs and the local ssrcs the remote bridge sends feedback on
+        std::vector<uint32_t> trunkSsrcs(barbell.audioSsrcs);
+        trunkSsrcs.insert(trunkSsrcs.end(), _audioSsrcs.begin(), _audioSsrcs.end());
+        for (auto& videoStream : barbell.videoSsrcs)
+        {
+            for (auto& level : videoStream.ssrcLevels)
+            {
+                trunkSsrcs.push_back(level.main);
+                trunkSsrcs.push_back(level.feedback);
+            }
+        }
+        for (auto& ssrcGroup : _videoSsrcs)
+        {
+            for (auto& level : ssrcGroup)
+            {
+                trunkSsrcs.push_back(level.main);
+                trunkSsrcs.push_back(level.feedback);
+            }
+        }
+
+        if (!barbell.trunk->attach(barbell.trunkTag, *_engineMixer, trunkSsrcs))
+        {
+            logger::error("Failed to attach barbell %s to trunk %s",
+                _loggableId.c_str(),
+                barbellId.c_str(),
+                barbell.trunk->getId().c_str());
+            return false;
+        }
+    }
     barbell.isConfigured = true;
 
     assert(_engineBarbells.find(barbell.id) == _engineBarbells.end());
@@ -2388,7 +2751,9 @@ bool Mixer::addBarbellToEngine(const std::string& barbellId)
             barbell.audioSsrcs,
             barbell.audioRtpMap,
             barbell.videoRtpMap,
-            barbell.videoFeedbackRtpMap));
+            barbell.videoFeedbackRtpMap,
+            barbell.trunk.get(),
+            barbell.trunk ? BarbellTrunk::makeDataChannelLabel(barbell.trunkTag) : std::string("barbell")));
 
     return _engineMixer->asyncAddBarbell(emplaceResult.first->second.get());
 }
@@ -2407,6 +2772,11 @@ bool Mixer::configureBarbellTransport(const std::string& barbellId,
         return false;
     }
 
+    if (barbellItr->second->trunk && !barbellItr->second->trunk->claimConfiguration())
+    {
+        return true; // trunk transport was configured by the first conference on it
+    }
+
     barbellItr->second->transport->setRemoteIce(credentials, candidates, _engineMixer->getAudioAllocator());
     barbellItr->second->transport->asyncSetRemoteDtlsFingerprint(fingerprintType, fingerprintHash, isDtlsClient);
     barbellItr->second->transport->setSctp(5000, 5000);
@@ -2460,6 +2830,12 @@ bool Mixer::startBarbellTransport(const std::string& barbellId)
         return false;
     }
 
+    if (barbellIt->second->trunk)
+    {
+        barbellIt->second->trunk->start();
+        return true;
+    }
+
     return _engineMixer->asyncStartTransport(*barbellIt->second->transport);
 }
 
@@ -2487,10 +2863,24 @@ void Mixer::engineBarbellRemoved(const EngineBarbell& engineBarbell)
         barbell = std::move(it->second);
         _barbells.erase(it);
         _engineBarbells.erase(barbell->id);
+        if (!barbell->trunk)
+        {
+            _removedTransportsCpuTime += barbell->transport->getJobQueue().getCost().getTime();
+        }
     }
 
     logTransportPacketLoss(barbell->id, *barbell->transport, _loggableId.c_str());
-    if (!waitForPendingJobs(700, 5, *barbell->transport))
+    if (!releaseBarbellTrunk(*barbell))
+    {
+        // removal ran on the trunk's serial job queue after all jobs of this conference
+        return;
+    }
+    if (barbell->trunk)
+    {
+        barbell->transport->stop(); // last conference on the trunk, engine left it running
+    }
+
+    if (!waitForPendingJobs(700, *barbell->transport))
     {
         logger::error("Transport for barbell %s did not finish pending jobs in time. Continuing "
                       "deletion anyway.",
@@ -2499,6 +2889,22 @@ void Mixer::engineBarbellRemoved(const EngineBarbell& engineBarbell)
     }
 }
 
+// Returns true if no other conference uses the barbell transport, which then is stopped as any barbell transport
+bool Mixer::releaseBarbellTrunk(Barbell& barbell)
+{
+    if (!barbell.trunk)
+    {
+        return true;
+    }
+
+    if (barbell.trunkRegistry)
+    {
+        barbell.sharesTransport = !barbell.trunkRegistry->release(barbell.trunk, barbell.trunkTag);
+        barbell.trunkRegistry = nullptr;
+    }
+    return !barbell.sharesTransport;
+}
+
 bool Mixer::isH264Enabled() const
 {
     return _videoCodecs.h264;
@@ -12,6 +12,7 @@
 #include "transport/Endpoint.h"
 #include "transport/dtls/SrtpClient.h"
 #include "transport/ice/IceSession.h"
+#include "utils/Optional.h"
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -69,11 +70,28 @@ struct SimulcastStream;
 struct SsrcWhitelist;
 struct VideoStream;
 struct Barbell;
+class BarbellTrunkRegistry;
 struct EngineBarbell;
 
 class Mixer
 {
 public:
+    struct BundledEndpointAllocation
+    {
+        std::string endpointId;
+        ice::IceRole iceRole = ice::IceRole::CONTROLLING;
+        bool usePrivatePort = false;
+        utils::Optional<MediaMode> audio;
+        utils::Optional<bool> videoSsrcRewrite;
+        bool data = false;
+        utils::Optional<uint32_t> idleTimeoutSeconds;
+
+        // filled in by addBundledEndpoints
+        utils::Optional<std::string> audioId;
+        utils::Optional<std::string> videoId;
+        utils::Optional<std::string> dataId;
+    };
+
     struct Stats
     {
         uint32_t videoStreams = 0;
@@ -82,6 +100,8 @@ public:
         uint32_t pacingQueue = 0;
         uint32_t rtxPacingQueue = 0;
         uint32_t transports = 0;
+        uint64_t cpuTime = 0; // ns on engine and transport jobs, including removed endpoints
+        double cpuLoad = 0; // cpus used since previous getStats
     };
 
     Mixer(std::string id,
@@ -135,7 +155,19 @@ public:
         const std::string& endpointId,
         utils::Optional<uint32_t> idleTimeoutSeconds = utils::Optional<uint32_t>());
 
+    // Adds bundle transports and streams for many new endpoints under one configuration lock. Fails without
+    // changes if an endpoint already exists or would have no media. On other failures everything added for the
+    // batch is removed again.
+    bool addBundledEndpoints(std::vector<BundledEndpointAllocation>& allocations);
+    // Removes the bundle transports and streams added by a successful addBundledEndpoints
+    void removeBundledEndpoints(const std::vector<BundledEndpointAllocation>& allocations);
+
     bool addBarbell(const std::string& barbellId, ice::IceRole iceRole);
+    bool addTrunkedBarbell(const std::string& barbellId,
+        BarbellTrunkRegistry& trunkRegistry,
+        const std::string& trunkId,
+        const std::string& conferenceTag,
+        ice::IceRole iceRole);
 
     bool removeAudioStream(const std::string& endpointId);
     bool removeAudioStreamId(const std::string& id);
@@ -257,6 +289,8 @@ public:
     bool isAudioStreamConfigured(const std::string& endpointId) const;
     bool isVideoStreamConfigured(const std::string& endpointId) const;
     bool isDataStreamConfigured(const std::string& endpointId) const;
+    // Writes the packet flight recorder of the endpoint's bundle transport. False if there is no such transport.
+    bool dumpPacketRecords(const std::string& endpointId, bool& outDumped);
 
     void getAudioStreamDescription(AudioStreamDescription& outDescription) const;
     void getBarbellVideoStreamDescription(std::vector<BarbellVideoStreamDescription>& outDescription);
@@ -292,6 +326,7 @@ public:
     void removeRecordingTransport(const std::string& streamId, const size_t endpointIdHash);
 
     Stats getStats();
+    uint64_t getCpuTime() const;
     bool hasPendingTransportJobs();
 
     void sendEndpointMessage(const std::string& toEndpointId,
@@ -343,6 +378,9 @@ private:
     std::unordered_map<std::string, std::unique_ptr<EngineRecordingStream>> _recordingEngineStreams;
 
     std::unordered_map<std::string, BundleTransport> _bundleTransports;
+    uint64_t _removedTransportsCpuTime;
+    uint64_t _statsCpuTime;
+    uint64_t _statsTimestamp;
     const VideoCodecSpec _videoCodecs;
     const bool _useGlobalPort;
     transport::Endpoints _rtpPorts;
@@ -358,9 +396,29 @@ private:
 
     RecordingStream* findRecordingStream(const std::string& recordingId);
 
+    // caller holds _configurationLock
+    uint64_t sumCpuTime() const;
+    bool createBundleTransport(const std::string& endpointId,
+        const ice::IceRole iceRole,
+        const bool hasVideoEnabled,
+        const bool usePrivatePort);
+    bool createBundledAudioStream(std::string& outId,
+        const std::string& endpointId,
+        MediaMode mediaMode,
+        utils::Optional<uint32_t> idleTimeoutSeconds);
+    bool createBundledVideoStream(std::string& outId,
+        const std::string& endpointId,
+        const bool ssrcRewrite,
+        utils::Optional<uint32_t> idleTimeoutSeconds);
+    bool createBundledDataStream(std::string& outId,
+        const std::string& endpointId,
+        utils::Optional<uint32_t> idleTimeoutSeconds);
+    void removeBundledEndpoint(const std::string& endpointId);
+
     void stopTransportIfNeeded(const std::shared_ptr<transport::RtcTransport>& streamTransport,
         const std::string& endpointId);
     bridge::Stats::BarbellPayloadStats fromPacketCounter(const transport::PacketCounters& counters);
+    bool releaseBarbellTrunk(Barbell& barbell);
 };
 
 } // namespace bridge
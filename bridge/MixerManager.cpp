@@ -99,6 +99,8 @@ MixerManager::MixerManager(utils::IdGenerator& idGenerator,
       _transportFactory(transportFactory),
       _engine(engine),
       _config(config),
+      _barbellTrunks(transportFactory),
+      _opusCodecPool(config.opusPool.warmCount, config.opusPool.maxCount),
       _running(true),
       _statsRefreshPacer(500 * utils::Time::ms),
       _mainAllocator(mainAllocator),
@@ -139,16 +141,20 @@ Mixer* MixerManager::create(utils::Optional<uint32_t> optionalLastN,
 
     if (enableVideo)
     {
+        // Level 0 and pin ssrcs are the ones sent to clients and get a FlexFEC repair ssrc
+        const bool allocateFec = _config.flexfec.enable;
         videoSsrcs.reserve(lastN + 3);
         // screen share / slides
         {
-            api::SsrcPair a[1] = {{_ssrcGenerator.next(), _ssrcGenerator.next()}};
+            api::SsrcPair a[1] = {
+                {_ssrcGenerator.next(), _ssrcGenerator.next(), allocateFec ? _ssrcGenerator.next() : 0}};
             videoSsrcs.push_back(api::SimulcastGroup(a));
         }
         // Last-n + extra
         for (uint32_t i = 0; i < lastN + 2; ++i)
         {
-            api::SsrcPair a[3] = {{_ssrcGenerator.next(), _ssrcGenerator.next()},
+            api::SsrcPair a[3] = {
+                {_ssrcGenerator.next(), _ssrcGenerator.next(), allocateFec ? _ssrcGenerator.next() : 0},
                 {_ssrcGenerator.next(), _ssrcGenerator.next()},
                 {_ssrcGenerator.next(), _ssrcGenerator.next()}};
             videoSsrcs.push_back(api::SimulcastGroup(a));
@@ -156,7 +162,8 @@ Mixer* MixerManager::create(utils::Optional<uint32_t> optionalLastN,
 
         for (uint32_t i = 0; i < 4; ++i)
         {
-            videoPinSsrcs.push_back({_ssrcGenerator.next(), _ssrcGenerator.next()});
+            videoPinSsrcs.push_back(
+                {_ssrcGenerator.next(), _ssrcGenerator.next(), allocateFec ? _ssrcGenerator.next() : 0});
         }
     }
 
@@ -169,6 +176,7 @@ Mixer* MixerManager::create(utils::Optional<uint32_t> optionalLastN,
         _config,
         _sendAllocator,
         _audioAllocator,
+        _opusCodecPool,
         _mainAllocator,
         audioSsrcs,
         videoSsrcs,
@@ -463,7 +471,7 @@ void MixerManager::mixerTimedOut(EngineMixer& mixer)
 void MixerManager::inboundSsrcContextRemoved(EngineMixer& mixer, uint32_t ssrc, codec::OpusDecoder* opusDecoder)
 {
     logger::info("Mixer %s removed ssrc %u", "MixerManager", mixer.getLoggableId().c_str(), ssrc);
-    delete opusDecoder;
+    _opusCodecPool.recycle(opusDecoder);
 }
 
 void MixerManager::allocateVideoPacketCache(EngineMixer& mixer, uint32_t ssrc, size_t endpointIdHash)
@@ -675,6 +683,9 @@ Stats::MixerManagerStats MixerManager::getStats()
         result.engineStats = _stats.engine;
         result.systemStats = systemStats;
         result.largestConference = _stats.largestConference;
+        result.conferencesCpuLoad = _stats.conferencesCpuLoad;
+        result.maxConferenceCpuLoad = _stats.maxConferenceCpuLoad;
+        result.placement = _placement;
     }
 
     EndpointMetrics udpMetrics = _transportFactory.getSharedUdpEndpointsMetrics();
@@ -682,14 +693,34 @@ Stats::MixerManagerStats MixerManager::getStats()
     result.jobQueueLength = _rtJobManager.getCount();
     result.receivePoolSize = _mainAllocator.size();
     result.sendPoolSize = _sendAllocator.size();
+    result.opusPoolHits = _opusCodecPool.getHitCount();
+    result.opusPoolMisses = _opusCodecPool.getMissCount();
     result.udpSharedEndpointsSendQueue = udpMetrics.sendQueue;
     result.udpSharedEndpointsReceiveKbps = static_cast<uint32_t>(udpMetrics.receiveKbps);
     result.udpSharedEndpointsSendKbps = static_cast<uint32_t>(udpMetrics.sendKbps);
     result.udpSharedEndpointsSendDrops = udpMetrics.sendQueueDrops;
 
+    const auto ingressDrops = _transportFactory.getIngressDrops();
+    result.ingressTransportRateDrops = ingressDrops.transportRate;
+    result.ingressSourceRateDrops = ingressDrops.sourceRate;
+    result.ingressRejectedSsrcDrops = ingressDrops.rejectedSsrc;
+
+    const auto handshakeStats = _transportFactory.getDtlsHandshakeStats();
+    result.dtlsHandshakes = handshakeStats.active;
+    result.dtlsHandshakeQueue = handshakeStats.queueDepth;
+    result.dtlsHandshakesRejected = handshakeStats.rejected;
+    result.dtlsHandshakeLatencyMs = handshakeStats.avgLatencyMs;
+    result.dtlsHandshakeMaxLatencyMs = handshakeStats.maxLatencyMs;
+
     return result;
 }
 
+void MixerManager::setPlacement(const Stats::PlacementStats& placement)
+{
+    std::lock_guard<std::mutex> locker(_configurationLock);
+    _placement = placement;
+}
+
 void MixerManager::updateStats()
 {
     std::lock_guard<std::mutex> locker(_configurationLock);
@@ -699,6 +730,8 @@ void MixerManager::updateStats()
     _stats.audioStreams = 0;
     _stats.dataStreams = 0;
     _stats.largestConference = 0;
+    _stats.conferencesCpuLoad = 0;
+    _stats.maxConferenceCpuLoad = 0;
 
     for (const auto& mixer : _mixers)
     {
@@ -707,6 +740,8 @@ void MixerManager::updateStats()
         _stats.audioStreams += stats.audioStreams;
         _stats.dataStreams += stats.videoStreams;
         _stats.largestConference = std::max(stats.transports, _stats.largestConference);
+        _stats.conferencesCpuLoad += stats.cpuLoad;
+        _stats.maxConferenceCpuLoad = std::max(stats.cpuLoad, _stats.maxConferenceCpuLoad);
     }
 
     _stats.engine = _engine.getStats();
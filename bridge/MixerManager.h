@@ -1,11 +1,13 @@
 #pragma once
 
+#include "bridge/BarbellTrunk.h"
 #include "bridge/CodecCapabilities.h"
 #include "bridge/MixerManagerAsync.h"
 #include "bridge/Stats.h"
 #include "bridge/engine/EngineMixer.h"
 #include "bridge/engine/EngineStats.h"
 #include "bridge/engine/Engine.h"
+#include "codec/OpusCodecPool.h"
 #include "concurrency/MpmcQueue.h"
 #include "memory/PacketPoolAllocator.h"
 #include "utils/Pacer.h"
@@ -69,8 +71,10 @@ public:
     void maintenance(uint64_t timestamp);
 
     Stats::MixerManagerStats getStats();
+    void setPlacement(const Stats::PlacementStats& placement);
 
     Stats::AggregatedBarbellStats getBarbellStats();
+    BarbellTrunkRegistry& getBarbellTrunks() { return _barbellTrunks; }
     void finalizeEngineMixerRemoval(const std::string& mixerId);
 
     // Protected for unit test spies to extend and have access to the variables
@@ -83,6 +87,8 @@ protected:
         uint32_t dataStreams = 0;
         uint64_t lastRefreshTimestamp = 0;
         uint32_t largestConference = 0;
+        double conferencesCpuLoad = 0;
+        double maxConferenceCpuLoad = 0;
         EngineStats::EngineStats engine;
     };
 
@@ -93,6 +99,8 @@ protected:
     transport::TransportFactory& _transportFactory;
     Engine& _engine;
     const config::Config& _config;
+    BarbellTrunkRegistry _barbellTrunks;
+    codec::OpusCodecPool _opusCodecPool;
 
     std::unordered_map<std::string, std::shared_ptr<Mixer>> _mixers;
 
@@ -102,6 +110,7 @@ protected:
     std::mutex _configurationLock;
 
     MixerStats _stats;
+    Stats::PlacementStats _placement;
     Stats::SystemStatsCollector _systemStatCollector;
     memory::PacketPoolAllocator& _mainAllocator;
     memory::PacketPoolAllocator& _sendAllocator;
@@ -78,6 +78,7 @@ std::string MixerManagerStats::describe()
     nlohmann::json result;
     result["current_timestamp"] = utils::Time::getAbsoluteTime() / 1000000ULL;
     result["conferences"] = conferences;
+    result["hibernating_conferences"] = engineStats.hibernatingMixers;
     result["largestConference"] = largestConference;
     result["participants"] = std::max({videoStreams, audioStreams, dataStreams});
     result["audiochannels"] = audioStreams;
@@ -88,6 +89,8 @@ std::string MixerManagerStats::describe()
     result["cpu_rtce"] = systemStats.rtceCpu;
     result["cpu_workers"] = systemStats.workerCpu;
     result["cpu_manager"] = systemStats.managerCpu;
+    result["cpu_conferences"] = conferencesCpuLoad;
+    result["cpu_max_conference"] = maxConferenceCpuLoad;
 
     result["total_memory"] = systemStats.virtualMemory;
     result["used_memory"] = systemStats.processMemory;
@@ -114,6 +117,8 @@ std::string MixerManagerStats::describe()
     result["loss_upload"] = engineStats.activeMixers.outbound.total().getSendLossRatio();
     result["loss_download"] = engineStats.activeMixers.inbound.total().getReceiveLossRatio();
 
+    result["mixer_memory_kb"] = engineStats.activeMixers.containerMemory / 1024;
+    result["mixer_memory_max_kb"] = engineStats.activeMixers.maxContainerMemory / 1024;
     result["pacing_queue"] = engineStats.activeMixers.pacingQueue;
     result["rtx_pacing_queue"] = engineStats.activeMixers.rtxPacingQueue;
 
@@ -121,9 +126,24 @@ std::string MixerManagerStats::describe()
     result["shared_udp_receive_rate"] = udpSharedEndpointsReceiveKbps;
     result["shared_udp_send_rate"] = udpSharedEndpointsSendKbps;
     result["shared_udp_end_drops"] = udpSharedEndpointsSendDrops;
+    result["ingress_transport_rate_drops"] = ingressTransportRateDrops;
+    result["ingress_source_rate_drops"] = ingressSourceRateDrops;
+    result["ingress_rejected_ssrc_drops"] = ingressRejectedSsrcDrops;
+    result["dtls_handshakes"] = dtlsHandshakes;
+    result["dtls_handshake_queue"] = dtlsHandshakeQueue;
+    result["dtls_handshakes_rejected"] = dtlsHandshakesRejected;
+    result["dtls_handshake_latency_ms"] = dtlsHandshakeLatencyMs;
+    result["dtls_handshake_max_latency_ms"] = dtlsHandshakeMaxLatencyMs;
+    result["cpus_engine"] = placement.engineCpus;
+    result["cpus_rtce"] = placement.rtceCpus;
+    result["cpus_workers"] = placement.workerCpus;
+    result["cpus_timers"] = placement.timerCpus;
+    result["memory_numa_node"] = placement.memoryNode;
 
     result["send_pool"] = sendPoolSize;
     result["receive_pool"] = receivePoolSize;
+    result["opus_pool_hits"] = opusPoolHits;
+    result["opus_pool_misses"] = opusPoolMisses;
 
     result["loss_upload_hist"] = nlohmann::to_json(engineStats.activeMixers.outbound.transport.lossGroup);
     result["loss_download_hist"] = nlohmann::to_json(engineStats.activeMixers.inbound.transport.lossGroup);
@@ -52,6 +52,16 @@ struct SystemStats
     struct ConnectionsStats connections;
 };
 
+// applied thread and memory placement, empty where placement is left to the OS
+struct PlacementStats
+{
+    std::string engineCpus;
+    std::string rtceCpus;
+    std::string workerCpus;
+    std::string timerCpus;
+    int memoryNode = -1;
+};
+
 struct MixerManagerStats
 {
     SystemStats systemStats;
@@ -60,15 +70,28 @@ struct MixerManagerStats
     uint32_t audioStreams = 0;
     uint32_t dataStreams = 0;
     uint32_t largestConference = 0;
+    double conferencesCpuLoad = 0; // cpus
+    double maxConferenceCpuLoad = 0;
     EngineStats::EngineStats engineStats;
     uint32_t jobQueueLength = 0;
 
     uint32_t receivePoolSize = 0;
     uint32_t sendPoolSize = 0;
+    uint64_t opusPoolHits = 0;
+    uint64_t opusPoolMisses = 0;
     uint32_t udpSharedEndpointsSendQueue = 0;
     uint32_t udpSharedEndpointsReceiveKbps = 0;
     uint32_t udpSharedEndpointsSendKbps = 0;
     uint64_t udpSharedEndpointsSendDrops = 0;
+    uint64_t ingressTransportRateDrops = 0;
+    uint64_t ingressSourceRateDrops = 0;
+    uint64_t ingressRejectedSsrcDrops = 0;
+    uint32_t dtlsHandshakes = 0;
+    uint32_t dtlsHandshakeQueue = 0;
+    uint64_t dtlsHandshakesRejected = 0;
+    double dtlsHandshakeLatencyMs = 0;
+    double dtlsHandshakeMaxLatencyMs = 0;
+    PlacementStats placement;
 
     std::string describe();
 };
@@ -17,7 +17,7 @@ struct VideoStreamDescription
     std::vector<uint32_t> getSsrcs()
     {
         std::vector<uint32_t> v;
-        v.reserve(sources.size() + 1);
+        v.reserve(sources.size() * 3 + 1);
         if (localSsrc != 0)
         {
             v.push_back(localSsrc);
@@ -27,6 +27,10 @@ struct VideoStreamDescription
         {
             v.push_back(level.main);
             v.push_back(level.feedback);
+            if (level.fec != 0)
+            {
+                v.push_back(level.fec);
+            }
         }
         return v;
     }
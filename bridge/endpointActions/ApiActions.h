@@ -18,6 +18,12 @@ httpd::Response allocateConference(ActionContext*, RequestLogger&, const httpd::
 httpd::Response getConferences(ActionContext* context, RequestLogger&);
 httpd::Response fetchBriefConferenceList(ActionContext* context, RequestLogger& requestLogger);
 
+// Allocates many bundled endpoints in one request
+httpd::Response allocateEndpoints(ActionContext* context,
+    RequestLogger& requestLogger,
+    const httpd::Request& request,
+    const std::string& conferenceId);
+
 httpd::Response processEndpointPostRequest(ActionContext* context,
     RequestLogger& requestLogger,
     const httpd::Request& request,
@@ -12,6 +12,15 @@
 
 namespace bridge
 {
+json::reader::Value getRequestJson(const json::reader::Document& document)
+{
+    if (!document.isValid())
+    {
+        throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST, "Invalid json format");
+    }
+    return document.getRoot();
+}
+
 std::unique_lock<std::mutex> getConferenceMixer(ActionContext* context,
     const std::string& conferenceId,
     Mixer*& outMixer)
@@ -110,6 +119,21 @@ void addDefaultVideoProperties(api::Video& video)
     video.rtpHeaderExtensions.emplace_back(4, "urn:ietf:params:rtp-hdrext:sdes:rtp-stream-id");
 }
 
+void addFlexFecVideoProperties(api::Video& video, const uint8_t payloadType)
+{
+    api::PayloadType flexFec;
+    flexFec.id = payloadType;
+    flexFec.name = "flexfec-03";
+    flexFec.clockRate = 90000;
+    flexFec.parameters.emplace_back("repair-window", "10000000");
+    video.payloadTypes.push_back(flexFec);
+}
+
+bool isFlexFecPayloadType(const api::PayloadType& payloadType)
+{
+    return payloadType.name == "flexfec-03";
+}
+
 ice::TransportType parseTransportType(const std::string& protocol)
 {
     if (protocol.compare("udp") == 0)
@@ -1,5 +1,6 @@
 #pragma once
 #include "api/EndpointDescription.h"
+#include "api/JsonReader.h"
 #include "bridge/RtpMap.h"
 #include "bridge/endpointActions/ApiActions.h"
 #include "bridge/engine/SimulcastStream.h"
@@ -19,6 +20,8 @@ std::pair<std::vector<ice::IceCandidate>, std::pair<std::string, std::string>> g
     const api::Transport&);
 std::pair<std::vector<ice::IceCandidate>, std::pair<std::string, std::string>> getIceCandidatesAndCredentials(
     const api::Ice& ice);
+// root of a request body document, throws BAD_REQUEST if the body is not valid json
+json::reader::Value getRequestJson(const json::reader::Document& document);
 std::unique_lock<std::mutex> getConferenceMixer(ActionContext*,
     const std::string& conferenceId,
     bridge::Mixer*& outMixer);
@@ -27,6 +30,8 @@ void addDefaultAudioProperties(api::Audio& audio, bool includeTelephoneEvent);
 void addVp8VideoProperties(api::Video& video);
 void addH264VideoProperties(api::Video& video, const std::string& profileLevelId, const uint32_t packetizationMode);
 void addDefaultVideoProperties(api::Video& video);
+void addFlexFecVideoProperties(api::Video& video, uint8_t payloadType);
+bool isFlexFecPayloadType(const api::PayloadType& payloadType);
 
 bridge::RtpMap makeRtpMap(const api::Audio& audio, const api::PayloadType& payloadType);
 bridge::RtpMap makeRtpMap(const api::Video& video, const api::PayloadType& payloadType);
@@ -13,7 +13,6 @@
 #include "bridge/VideoStreamDescription.h"
 #include "config/Config.h"
 #include "httpd/RequestErrorException.h"
-#include "nlohmann/json.hpp"
 #include "transport/dtls/SslDtls.h"
 #include "utils/Format.h"
 
@@ -113,9 +112,8 @@ httpd::Response generateBarbellResponse(ActionContext* context,
     responseData.maxMessageSize = 2048;
     channelsDescription.data = responseData;
 
-    const auto responseBody = api::Generator::generateAllocateBarbellResponse(channelsDescription);
-
-    auto response = httpd::Response(httpd::StatusCode::OK, responseBody.dump());
+    auto response = httpd::Response(httpd::StatusCode::OK,
+        api::Generator::generateAllocateBarbellResponse(channelsDescription));
     response.headers["Content-type"] = "text/json";
 
     logger::debug("barbell response %s", "BarbellActions", response.body.c_str());
@@ -126,13 +124,25 @@ httpd::Response allocateBarbell(ActionContext* context,
     RequestLogger& requestLogger,
     bool iceControlling,
     const std::string& conferenceId,
-    const std::string& barbellId)
+    const std::string& barbellId,
+    const std::string& trunkId,
+    const std::string& conferenceTag)
 {
     Mixer* mixer;
     auto scopedMixerLock = getConferenceMixer(context, conferenceId, mixer);
 
     const auto iceRole = iceControlling ? ice::IceRole::CONTROLLING : ice::IceRole::CONTROLLED;
-    if (!mixer->addBarbell(barbellId, iceRole))
+    const bool useTrunk = context->config.barbell.trunking && !trunkId.empty();
+    if (useTrunk && conferenceTag.empty())
+    {
+        throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST,
+            "Missing required json property: trunk.conference-tag");
+    }
+
+    const bool added = useTrunk
+        ? mixer->addTrunkedBarbell(barbellId, context->mixerManager.getBarbellTrunks(), trunkId, conferenceTag, iceRole)
+        : mixer->addBarbell(barbellId, iceRole);
+    if (!added)
     {
         throw httpd::RequestErrorException(httpd::StatusCode::INTERNAL_SERVER_ERROR,
             utils::format("Failed to create barbell leg for conference'%s'", conferenceId.c_str()));
@@ -255,13 +265,14 @@ httpd::Response processBarbellPutAction(ActionContext* context,
     const std::string& conferenceId,
     const std::string& barbellId)
 {
-    const auto requestBodyJson = nlohmann::json::parse(request.body.getSpan());
-    const auto actionJsonItr = requestBodyJson.find("action");
-    if (actionJsonItr == requestBodyJson.end())
+    const auto requestBody = request.body.getSpan();
+    const json::reader::Document requestDocument(requestBody.data(), requestBody.size());
+    const auto requestBodyJson = getRequestJson(requestDocument);
+    std::string action;
+    if (!requestBodyJson.find("action").getString(action))
     {
         throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST, "Missing required json property: action");
     }
-    const auto& action = actionJsonItr->get<std::string>();
 
     if (action.compare("configure") == 0)
     {
@@ -285,19 +296,40 @@ httpd::Response processBarbellAction(ActionContext* context,
     }
     else if (request.method == httpd::Method::POST)
     {
-        const auto requestBodyJson = nlohmann::json::parse(request.body.getSpan());
-        const auto actionJsonItr = requestBodyJson.find("action");
-        if (actionJsonItr == requestBodyJson.end())
+        const auto requestBody = request.body.getSpan();
+        const json::reader::Document requestDocument(requestBody.data(), requestBody.size());
+        const auto requestBodyJson = getRequestJson(requestDocument);
+        std::string action;
+        if (!requestBodyJson.find("action").getString(action))
         {
             throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST,
                 "Missing required json property: action");
         }
-        const auto& action = actionJsonItr->get<std::string>();
 
         if (action.compare("allocate") == 0)
         {
-            bool iceControlling = requestBodyJson["bundle-transport"]["ice-controlling"];
-            return allocateBarbell(context, requestLogger, iceControlling, conferenceId, barbellId);
+            const auto bundleTransportJson = requestBodyJson.find("bundle-transport");
+            const auto iceControlling = bundleTransportJson.find("ice-controlling").getBool();
+            if (!iceControlling.isSet())
+            {
+                throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST,
+                    "Missing required json property: bundle-transport.ice-controlling");
+            }
+
+            // optional trunk shared with the other conferences linking the same pair of bridges
+            std::string trunkId;
+            std::string conferenceTag;
+            const auto trunkJson = bundleTransportJson.find("trunk");
+            trunkJson.find("id").getString(trunkId);
+            trunkJson.find("conference-tag").getString(conferenceTag);
+
+            return allocateBarbell(context,
+                requestLogger,
+                iceControlling.get(),
+                conferenceId,
+                barbellId,
+                trunkId,
+                conferenceTag);
         }
         else
         {
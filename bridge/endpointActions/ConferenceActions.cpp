@@ -26,8 +26,7 @@ const uint32_t GUUID_LENGTH = 36;
 namespace
 {
 
-httpd::Response generateAllocateEndpointResponse(ActionContext* context,
-    RequestLogger& requestLogger,
+api::EndpointDescription makeAllocateEndpointDescription(ActionContext* context,
     const api::AllocateEndpoint& allocateChannel,
     const Mixer& mixer,
     const std::string& conferenceId,
@@ -183,7 +182,7 @@ httpd::Response generateAllocateEndpointResponse(ActionContext* context,
         for (auto& level : streamDescription.sources)
         {
             api::VideoStream videoStream;
-            videoStream.sources.push_back({level.main, level.feedback});
+            videoStream.sources.push_back(level);
             if (index++ == 0)
             {
                 videoStream.content = "slides";
@@ -257,6 +256,10 @@ httpd::Response generateAllocateEndpointResponse(ActionContext* context,
         }
 
         addDefaultVideoProperties(responseVideo);
+        if (context->config.flexfec.enable)
+        {
+            addFlexFecVideoProperties(responseVideo, context->config.flexfec.payloadType);
+        }
         channelsDescription.video.set(responseVideo);
     }
 
@@ -276,8 +279,20 @@ httpd::Response generateAllocateEndpointResponse(ActionContext* context,
         channelsDescription.data.set(responseData);
     }
 
-    const auto responseBody = api::Generator::generateAllocateEndpointResponse(channelsDescription);
-    auto response = httpd::Response(httpd::StatusCode::OK, responseBody.dump());
+    return channelsDescription;
+}
+
+httpd::Response generateAllocateEndpointResponse(ActionContext* context,
+    RequestLogger& requestLogger,
+    const api::AllocateEndpoint& allocateChannel,
+    const Mixer& mixer,
+    const std::string& conferenceId,
+    const std::string& endpointId)
+{
+    const auto channelsDescription =
+        makeAllocateEndpointDescription(context, allocateChannel, mixer, conferenceId, endpointId);
+    auto response = httpd::Response(httpd::StatusCode::OK,
+        api::Generator::generateAllocateEndpointResponse(channelsDescription));
     response.headers["Content-type"] = "text/json";
     logger::debug("POST response %s", "RequestHandler", response.body.c_str());
     requestLogger.setResponse(response);
@@ -499,6 +514,20 @@ httpd::Response allocateEndpoint(ActionContext* context,
     return generateAllocateEndpointResponse(context, requestLogger, allocateChannel, *mixer, conferenceId, endpointId);
 }
 
+bool isGatheringComplete(const Mixer& mixer, const std::vector<Mixer::BundledEndpointAllocation>& allocations)
+{
+    for (const auto& allocation : allocations)
+    {
+        if ((allocation.audioId.isSet() && !mixer.isAudioStreamGatheringComplete(allocation.endpointId)) ||
+            (allocation.videoId.isSet() && !mixer.isVideoStreamGatheringComplete(allocation.endpointId)) ||
+            (allocation.dataId.isSet() && !mixer.isDataStreamGatheringComplete(allocation.endpointId)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 std::vector<uint32_t> convertGroupIds(const std::vector<std::string>& groupIds)
 {
     std::vector<uint32_t> result;
@@ -665,7 +694,11 @@ void configureVideoEndpoint(const api::EndpointDescription& endpointDescription,
     std::vector<RtpMap> rtpMaps;
     for (const auto& payloadType : video.payloadTypes)
     {
-        rtpMaps.emplace_back(makeRtpMap(video, payloadType));
+        // FlexFEC is only sent by the bridge, on the payload type from config
+        if (!isFlexFecPayloadType(payloadType))
+        {
+            rtpMaps.emplace_back(makeRtpMap(video, payloadType));
+        }
     }
 
     const auto feedbackRtpMap = rtpMaps.size() > 1 ? rtpMaps[1] : RtpMap();
@@ -1005,6 +1038,29 @@ httpd::Response recordEndpoint(ActionContext* context,
     return response;
 }
 
+httpd::Response dumpEndpointPackets(ActionContext* context,
+    RequestLogger& requestLogger,
+    const std::string& conferenceId,
+    const std::string& endpointId)
+{
+    Mixer* mixer;
+    auto scopedMixerLock = getConferenceMixer(context, conferenceId, mixer);
+
+    bool dumped = false;
+    if (!mixer->dumpPacketRecords(endpointId, dumped))
+    {
+        throw httpd::RequestErrorException(httpd::StatusCode::NOT_FOUND,
+            utils::format("Endpoint '%s' has no bundle transport", endpointId.c_str()));
+    }
+
+    nlohmann::json responseBody;
+    responseBody["dumped"] = dumped;
+    auto response = httpd::Response(httpd::StatusCode::OK, responseBody.dump());
+    response.headers["Content-type"] = "text/json";
+    requestLogger.setResponse(response);
+    return response;
+}
+
 httpd::Response expireEndpoint(ActionContext* context,
     RequestLogger& requestLogger,
     const std::string& conferenceId,
@@ -1030,13 +1086,14 @@ httpd::Response processEndpointPutRequest(ActionContext* context,
     const std::string& conferenceId,
     const std::string& endpointId)
 {
-    const auto requestBodyJson = nlohmann::json::parse(request.body.getSpan());
-    const auto actionJsonItr = requestBodyJson.find("action");
-    if (actionJsonItr == requestBodyJson.end())
+    const auto requestBody = request.body.getSpan();
+    const json::reader::Document requestDocument(requestBody.data(), requestBody.size());
+    const auto requestBodyJson = getRequestJson(requestDocument);
+    std::string action;
+    if (!requestBodyJson.find("action").getString(action))
     {
         throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST, "Missing required json property: action");
     }
-    const auto& action = actionJsonItr->get<std::string>();
 
     if (action.compare("configure") == 0)
     {
@@ -1053,24 +1110,142 @@ httpd::Response processEndpointPutRequest(ActionContext* context,
         const auto recording = api::Parser::parseRecording(requestBodyJson);
         return recordEndpoint(context, requestLogger, recording, conferenceId);
     }
+    else if (action.compare("dump-packets") == 0)
+    {
+        return dumpEndpointPackets(context, requestLogger, conferenceId, endpointId);
+    }
 
     throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST,
         utils::format("Action '%s' is not supported", action.c_str()));
 }
 
+httpd::Response allocateEndpoints(ActionContext* context,
+    RequestLogger& requestLogger,
+    const httpd::Request& request,
+    const std::string& conferenceId)
+{
+    const auto requestBody = request.body.getSpan();
+    const json::reader::Document requestDocument(requestBody.data(), requestBody.size());
+    const auto requestBodyJson = getRequestJson(requestDocument);
+    if (!requestBodyJson.find("action").equals("allocate"))
+    {
+        throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST, "Expected json property: action allocate");
+    }
+
+    const auto endpointsJson = requestBodyJson.find("endpoints");
+    if (!endpointsJson.isArray())
+    {
+        throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST, "Missing required json array: endpoints");
+    }
+
+    const auto endpointsArray = endpointsJson.getElements();
+    const auto endpointCount = endpointsJson.getElementCount();
+    std::vector<api::AllocateEndpoint> allocateChannels;
+    std::vector<Mixer::BundledEndpointAllocation> allocations;
+    allocateChannels.reserve(endpointCount);
+    allocations.reserve(endpointCount);
+    for (const auto& endpointJson : endpointsArray)
+    {
+        Mixer::BundledEndpointAllocation allocation;
+        if (!endpointJson.find("endpoint-id").getString(allocation.endpointId))
+        {
+            throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST,
+                "Missing required json property: endpoint-id");
+        }
+        if (allocation.endpointId.size() > GUUID_LENGTH)
+        {
+            throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST,
+                "Endpoint id must be less in length than a GUUID excluding curly braces");
+        }
+
+        const auto allocateChannel = api::Parser::parseAllocateEndpoint(endpointJson);
+        if (!allocateChannel.bundleTransport.isSet() || !allocateChannel.bundleTransport.get().ice)
+        {
+            throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST,
+                "Bulk allocation requires bundle transports with ICE");
+        }
+
+        const auto& bundleTransport = allocateChannel.bundleTransport.get();
+        allocation.iceRole = bundleTransport.iceControlling.isSet() && !bundleTransport.iceControlling.get()
+            ? ice::IceRole::CONTROLLED
+            : ice::IceRole::CONTROLLING;
+        allocation.usePrivatePort = bundleTransport.privatePort;
+        allocation.idleTimeoutSeconds = allocateChannel.idleTimeoutSeconds;
+        if (allocateChannel.audio.isSet())
+        {
+            allocation.audio.set(allocateChannel.audio.get().getMediaMode());
+        }
+        if (allocateChannel.video.isSet())
+        {
+            allocation.videoSsrcRewrite.set(allocateChannel.video.get().relayType.compare("ssrc-rewrite") == 0);
+        }
+        allocation.data = allocateChannel.data.isSet();
+
+        allocations.push_back(std::move(allocation));
+        allocateChannels.push_back(allocateChannel);
+    }
+
+    Mixer* mixer;
+    auto scopedMixerLock = getConferenceMixer(context, conferenceId, mixer);
+
+    if (!mixer->addBundledEndpoints(allocations))
+    {
+        throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST,
+            "It was not possible to add the endpoints. Usually happens due to an already existing endpoint or an "
+            "endpoint without media");
+    }
+
+    // all transports gather candidates concurrently, one wait covers the whole batch
+    uint32_t totalSleepTimeMs = 0;
+    while (!isGatheringComplete(*mixer, allocations) && totalSleepTimeMs < gatheringCompleteMaxWaitMs)
+    {
+        totalSleepTimeMs += gatheringCompleteWaitMs;
+        usleep(gatheringCompleteWaitMs * 1000);
+    }
+
+    if (!isGatheringComplete(*mixer, allocations))
+    {
+        logger::error("Allocate %zu endpoints, mixer %s, gathering did not complete in time",
+            "RequestHandler",
+            allocations.size(),
+            conferenceId.c_str());
+
+        mixer->removeBundledEndpoints(allocations);
+        throw httpd::RequestErrorException(httpd::StatusCode::INTERNAL_SERVER_ERROR, "Candidates gathering timeout");
+    }
+
+    std::vector<api::EndpointDescription> endpointDescriptions;
+    endpointDescriptions.reserve(allocations.size());
+    for (size_t i = 0; i < allocations.size(); ++i)
+    {
+        endpointDescriptions.push_back(makeAllocateEndpointDescription(context,
+            allocateChannels[i],
+            *mixer,
+            conferenceId,
+            allocations[i].endpointId));
+    }
+
+    auto response = httpd::Response(httpd::StatusCode::OK,
+        api::Generator::generateAllocateEndpointsResponse(endpointDescriptions));
+    response.headers["Content-type"] = "text/json";
+    requestLogger.setResponse(response);
+    return response;
+}
+
 httpd::Response processEndpointPostRequest(ActionContext* context,
     RequestLogger& requestLogger,
     const httpd::Request& request,
     const std::string& conferenceId,
     const std::string& endpointId)
 {
-    const auto requestBodyJson = nlohmann::json::parse(request.body.getSpan());
-    const auto actionJsonItr = requestBodyJson.find("action");
-    if (actionJsonItr == requestBodyJson.end())
+    const auto requestBody = request.body.getSpan();
+    const json::reader::Document requestDocument(requestBody.data(), requestBody.size());
+    const auto requestBodyJson = getRequestJson(requestDocument);
+    std::string action;
+    if (!requestBodyJson.find("action").getString(action))
     {
         throw httpd::RequestErrorException(httpd::StatusCode::BAD_REQUEST, "Missing required json property: action");
     }
-    const auto& action = actionJsonItr->get<std::string>();
 
     if (action.compare("allocate") == 0)
     {
@@ -37,6 +37,7 @@ httpd::Response fetchBriefConferenceList(ActionContext* context, RequestLogger&
             nlohmann::json mixJson = {{"id", mixerId}};
             auto endpoints = mixer->getEndpoints();
             mixJson["usercount"] = endpoints.size();
+            mixJson["cpuTimeMs"] = mixer->getCpuTime() / utils::Time::ms;
             mixJson["users"] = nlohmann::json::array();
             auto& endpointArray = mixJson["users"];
             for (auto& uid : endpoints)
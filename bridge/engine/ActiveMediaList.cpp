@@ -7,9 +7,10 @@
 #include "bridge/engine/SsrcRewrite.h"
 #include "logger/Logger.h"
 #include "math/helpers.h"
-#include "memory/PartialSortExtractor.h"
 #include "utils/ScopedInvariantChecker.h"
 #include "utils/ScopedReentrancyBlocker.h"
+#include <algorithm>
+#include <functional>
 namespace bridge
 {
 
@@ -110,6 +111,7 @@ ActiveMediaList::ActiveMediaList(size_t instanceId,
       _audioSsrcRewriteMap(SsrcRewrite::ssrcArraySize * 2),
       _dominantSpeaker(0),
       _nominatedSpeaker(0),
+      _liveSpeakerCount(0),
       _videoParticipants(videoSsrcs.empty() ? 0 : maxParticipants),
       _videoSsrcs(videoSsrcs.empty() ? 0 : SsrcRewrite::ssrcArraySize * 2),
       _videoFeedbackSsrcLookupMap(videoSsrcs.empty() ? 0 : SsrcRewrite::ssrcArraySize * 2),
@@ -167,7 +169,13 @@ bool ActiveMediaList::addBarbellAudioParticipant(const size_t endpointIdHash,
         return false;
     }
 
-    _audioParticipants.emplace(endpointIdHash, AudioParticipant(endpointId, noiseLevel, recentLevel));
+    auto emplaceResult =
+        _audioParticipants.emplace(endpointIdHash, AudioParticipant(endpointId, noiseLevel, recentLevel));
+    auto& audioParticipant = emplaceResult.first->second;
+    if (audioParticipant.maxRecentLevel != 0)
+    {
+        makeLive(endpointIdHash, audioParticipant);
+    }
     return onAudioParticipantAdded(endpointIdHash, endpointId);
 }
 
@@ -223,6 +231,19 @@ bool ActiveMediaList::removeAudioParticipant(const size_t endpointIdHash)
     utils::ScopedInvariantChecker<ActiveMediaList> invariantChecker(*this);
 #endif
 
+    const auto* audioParticipant = _audioParticipants.getItem(endpointIdHash);
+    if (audioParticipant && audioParticipant->live)
+    {
+        for (size_t i = 0; i < _liveSpeakerCount; ++i)
+        {
+            if (_liveSpeakers[i] == endpointIdHash)
+            {
+                _liveSpeakers[i] = _liveSpeakers[--_liveSpeakerCount];
+                break;
+            }
+        }
+    }
+
     _audioParticipants.erase(endpointIdHash);
     const auto audioSsrcRewriteMapItr = _audioSsrcRewriteMap.find(endpointIdHash);
     if (audioSsrcRewriteMapItr != _audioSsrcRewriteMap.end())
@@ -377,33 +398,47 @@ bool ActiveMediaList::removeVideoParticipant(const size_t endpointIdHash)
 }
 
 // note that zero level is mainly produced by muted participants. All unmuted produce non zero level.
+// Muted participants and those that stopped sending have zero levels that no update changes, so only live
+// participants are updated until they go silent, and the rest are revived by their next non zero level.
 void ActiveMediaList::updateLevels(const uint64_t timestamp)
 {
-    for (auto& audioParticipantEntry : _audioParticipants)
+    size_t liveCount = 0;
+    for (size_t i = 0; i < _liveSpeakerCount; ++i)
     {
-        auto& audioParticipant = audioParticipantEntry.second;
+        const auto endpointIdHash = _liveSpeakers[i];
+        auto* audioParticipant = _audioParticipants.getItem(endpointIdHash);
+        assert(audioParticipant);
+
         // Decay old max level over time (assuming process function called on average every 10ms)
-        if (audioParticipant.maxRecentLevel > audioParticipant.noiseLevel)
+        if (audioParticipant->maxRecentLevel > audioParticipant->noiseLevel)
         {
-            audioParticipant.maxRecentLevel -=
-                (audioParticipant.maxRecentLevel - audioParticipant.noiseLevel) * AudioParticipant::MAX_LEVEL_DECAY;
+            audioParticipant->maxRecentLevel -=
+                (audioParticipant->maxRecentLevel - audioParticipant->noiseLevel) * AudioParticipant::MAX_LEVEL_DECAY;
         }
 
         const bool audioOutage =
-            utils::Time::diffGT(audioParticipant.history.getUpdateTime(), timestamp, utils::Time::ms * 200);
-        if (audioParticipant.history.allNonZero() && !audioOutage)
+            utils::Time::diffGT(audioParticipant->history.getUpdateTime(), timestamp, utils::Time::ms * 200);
+        if (audioParticipant->history.allNonZero() && !audioOutage)
         {
             // Move old min level over time towards mean about 3dB per 3 seconds
-            audioParticipant.noiseLevel = std::max(audioParticipant.noiseLevel + AudioParticipant::NOISE_RAMPUP,
+            audioParticipant->noiseLevel = std::max(audioParticipant->noiseLevel + AudioParticipant::NOISE_RAMPUP,
                 static_cast<float>(AudioParticipant::MIN_NOISE));
         }
 
         if (audioOutage)
         {
-            audioParticipant.maxRecentLevel = 0; // assume muted
-            audioParticipant.audioLevel = 0;
+            audioParticipant->maxRecentLevel = 0; // assume muted
+            audioParticipant->audioLevel = 0;
+        }
+
+        if (audioParticipant->maxRecentLevel == 0 && audioParticipant->audioLevel == 0)
+        {
+            audioParticipant->live = false;
+            continue;
         }
+        _liveSpeakers[liveCount++] = endpointIdHash;
     }
+    _liveSpeakerCount = liveCount;
 
     for (AudioLevelEntry levelEntry; _incomingAudioLevels.pop(levelEntry);)
     {
@@ -421,29 +456,76 @@ void ActiveMediaList::updateLevels(const uint64_t timestamp)
         {
             audioParticipant.noiseLevel = std::min(audioParticipant.noiseLevel, audioParticipant.history.average());
         }
+
+        if (!audioParticipant.live && audioParticipant.maxRecentLevel != 0)
+        {
+            makeLive(levelEntry.participant, audioParticipant);
+        }
     }
 }
 
+void ActiveMediaList::makeLive(const size_t endpointIdHash, AudioParticipant& audioParticipant)
+{
+    assert(_liveSpeakerCount < _liveSpeakers.size());
+    audioParticipant.live = true;
+    _liveSpeakers[_liveSpeakerCount++] = endpointIdHash;
+}
+
 // recently unmuted participants have some advantage because the score is higher as the
 // noise level is likely lower than unmuted.
+// Live speakers are sorted into 1 dB score buckets, highest first, and only the buckets covering the audio last-n are
+// then sorted exactly. Cost grows with the number of live speakers, not with the number of participants.
 size_t ActiveMediaList::rankSpeakers()
 {
+    std::array<uint32_t, SCORE_BUCKETS> bucketSizes = {0};
     size_t speakerCount = 0;
-    for (auto& audioParticipantEntry : _audioParticipants)
+    for (size_t i = 0; i < _liveSpeakerCount; ++i)
     {
-        const auto& audioParticipant = audioParticipantEntry.second;
-        if (audioParticipant.maxRecentLevel == 0)
+        const auto* audioParticipant = _audioParticipants.getItem(_liveSpeakers[i]);
+        if (audioParticipant->maxRecentLevel == 0)
         {
             continue; // muted
         }
 
-        const float participantScore = audioParticipant.getScore();
-
-        _highestScoringSpeakers[speakerCount++] = AudioParticipantScore{audioParticipantEntry.first,
+        const float participantScore = audioParticipant->getScore();
+        _speakerScores[speakerCount++] = AudioParticipantScore{_liveSpeakers[i],
             participantScore,
-            std::max(0.0f, audioParticipant.noiseLevel)};
+            std::max(0.0f, audioParticipant->noiseLevel)};
+        ++bucketSizes[std::min(SCORE_BUCKETS - 1, static_cast<size_t>(participantScore))];
     }
 
+    if (speakerCount == 0)
+    {
+        return 0;
+    }
+
+    // bucket offsets in descending score order
+    std::array<uint32_t, SCORE_BUCKETS> bucketOffsets;
+    const size_t topCount = std::max(size_t(1), std::min(_audioLastN, speakerCount));
+    size_t topBucketsEnd = 0;
+    uint32_t offset = 0;
+    for (size_t bucket = SCORE_BUCKETS; bucket-- > 0;)
+    {
+        bucketOffsets[bucket] = offset;
+        offset += bucketSizes[bucket];
+        if (topBucketsEnd < topCount)
+        {
+            topBucketsEnd = offset;
+        }
+    }
+
+    for (size_t i = 0; i < speakerCount; ++i)
+    {
+        const auto& speakerScore = _speakerScores[i];
+        const auto bucket = std::min(SCORE_BUCKETS - 1, static_cast<size_t>(speakerScore.score));
+        _highestScoringSpeakers[bucketOffsets[bucket]++] = speakerScore;
+    }
+
+    std::partial_sort(_highestScoringSpeakers.begin(),
+        _highestScoringSpeakers.begin() + topCount,
+        _highestScoringSpeakers.begin() + topBucketsEnd,
+        std::greater<AudioParticipantScore>());
+
     return speakerCount;
 }
 
@@ -524,15 +606,12 @@ void ActiveMediaList::process(const uint64_t timestamp,
 
     const auto* dominantSpeaker = _audioParticipants.getItem(_dominantSpeaker);
 
-    memory::PartialSortExtractor<AudioParticipantScore> heap(_highestScoringSpeakers.begin(),
-        _highestScoringSpeakers.begin() + speakerCount);
-
-    auto nominatedSpeaker = heap.top();
+    const auto nominatedSpeaker = _highestScoringSpeakers[0];
 
     TActiveTalkersSnapshot activeTalkersSnapshot;
-    for (size_t i = 0; i < _audioLastN && !heap.empty(); ++i)
+    for (size_t i = 0; i < _audioLastN && i < speakerCount; ++i)
     {
-        const auto& top = heap.top();
+        const auto& top = _highestScoringSpeakers[i];
         outAudioMapChanged |= updateActiveAudioList(top.participant);
         auto const& curParticipant = _audioParticipants.find(top.participant);
 
@@ -544,7 +623,6 @@ void ActiveMediaList::process(const uint64_t timestamp,
                 (uint8_t)top.noiseLevel};
             activeTalkersSnapshot.activeTalker[activeTalkersSnapshot.count++] = talker;
         }
-        heap.pop();
     }
     _activeTalkerSnapshot.write(activeTalkersSnapshot);
 
@@ -168,6 +168,7 @@ public:
 
 private:
     static const size_t INTERVAL_MS = 10;
+    static const size_t SCORE_BUCKETS = 128; // 1 dB each
     // Only allow a new switch after 2s
     static const uint64_t minSpotlightDuration = 2000 * utils::Time::ms;
 
@@ -216,6 +217,7 @@ private:
         bool ptt;
         EndpointIdString endpointId;
         const bool isLocal;
+        bool live = false; // in _liveSpeakers
     };
 
     struct AudioLevelEntry
@@ -284,6 +286,10 @@ private:
 
     std::atomic_size_t _dominantSpeaker;
     size_t _nominatedSpeaker;
+    // participants with recent non zero level. Only these are decayed and ranked each interval.
+    std::array<size_t, maxParticipants> _liveSpeakers;
+    size_t _liveSpeakerCount;
+    std::array<AudioParticipantScore, maxParticipants> _speakerScores;
     std::array<AudioParticipantScore, maxParticipants> _highestScoringSpeakers;
 
     concurrency::MpmcHashmap32<size_t, VideoParticipant> _videoParticipants;
@@ -308,6 +314,7 @@ private:
 
     size_t rankSpeakers();
     void updateLevels(const uint64_t timestampMs);
+    void makeLive(const size_t endpointIdHash, AudioParticipant& audioParticipant);
     bool updateActiveAudioList(size_t endpointIdHash);
     bool updateActiveVideoList(const size_t endpointIdHash);
     void addToVideoRewriteMap(size_t endpointIdHash, api::SimulcastGroup simulcastGroup);
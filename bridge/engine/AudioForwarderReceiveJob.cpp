@@ -65,7 +65,7 @@ int AudioForwarderReceiveJob::computeOpusAudioLevel(const memory::Packet& opusPa
             _ssrcContext.ssrc,
             _engineMixer.getLoggableId().c_str(),
             _sender->getLoggableId().c_str());
-        _ssrcContext.opusDecoder.reset(new codec::OpusDecoder());
+        _ssrcContext.opusDecoder = _engineMixer.getOpusCodecPool().acquireDecoder();
         _ssrcContext.opusPacketRate.reset(new utils::AvgRateTracker(0.1));
     }
 
@@ -176,7 +176,8 @@ void AudioForwarderReceiveJob::run()
                     std::make_unique<codec::AudioReceivePipeline>(_ssrcContext.rtpMap.sampleRate,
                         20,
                         100,
-                        _ssrcContext.rtpMap.audioLevelExtId.valueOr(255));
+                        _ssrcContext.rtpMap.audioLevelExtId.valueOr(255),
+                        _engineMixer.getOpusCodecPool().acquireDecoder());
                 _ssrcContext.hasAudioReceivePipe = true;
             }
             if (isSsrcUsed)
@@ -2,7 +2,7 @@
 #include "bridge/engine/EngineMixer.h"
 #include "bridge/engine/SsrcOutboundContext.h"
 #include "codec/AudioLevel.h"
-#include "codec/OpusEncoder.h"
+#include "codec/OpusCodecPool.h"
 #include "memory/Packet.h"
 #include "rtp/RtpHeader.h"
 
@@ -12,11 +12,13 @@ namespace bridge
 EncodeJob::EncodeJob(memory::UniqueAudioPacket packet,
     SsrcOutboundContext& outboundContext,
     transport::Transport& transport,
+    codec::OpusCodecPool& opusCodecPool,
     const uint64_t rtpTimestamp)
     : jobmanager::CountedJob(transport.getJobCounter()),
       _packet(std::move(packet)),
       _outboundContext(outboundContext),
       _transport(transport),
+      _opusCodecPool(opusCodecPool),
       _rtpTimestamp(rtpTimestamp)
 {
     assert(_packet);
@@ -40,7 +42,7 @@ void EncodeJob::run()
 
     if (!_outboundContext.opusEncoder)
     {
-        _outboundContext.opusEncoder = std::make_unique<codec::OpusEncoder>();
+        _outboundContext.opusEncoder = _opusCodecPool.acquireEncoder();
     }
 
     auto opusPacket = memory::makeUniquePacket(_outboundContext.allocator);
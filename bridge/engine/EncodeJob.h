@@ -4,6 +4,11 @@
 #include "memory/AudioPacketPoolAllocator.h"
 #include <cstdint>
 
+namespace codec
+{
+class OpusCodecPool;
+}
+
 namespace transport
 {
 class Transport;
@@ -20,6 +25,7 @@ public:
     EncodeJob(memory::UniqueAudioPacket packet,
         SsrcOutboundContext& outboundContext,
         transport::Transport& transport,
+        codec::OpusCodecPool& opusCodecPool,
         const uint64_t rtpTimestamp);
 
     void run() override;
@@ -28,6 +34,7 @@ private:
     memory::UniqueAudioPacket _packet;
     SsrcOutboundContext& _outboundContext;
     transport::Transport& _transport;
+    codec::OpusCodecPool& _opusCodecPool;
     uint64_t _rtpTimestamp;
 };
 
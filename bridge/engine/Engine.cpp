@@ -77,10 +77,15 @@ void Engine::run()
         }
         pacer.tick(timestamp);
 
+        // each mixer is charged the time until the next mixer starts
+        uint64_t costStart = utils::Time::getAbsoluteTime();
         for (auto mixerEntry = _mixers.head(); mixerEntry; mixerEntry = mixerEntry->_next)
         {
             assert(mixerEntry->_data);
             mixerEntry->_data->run(timestamp);
+            const auto costEnd = utils::Time::getAbsoluteTime();
+            mixerEntry->_data->getEngineCost().add(costEnd - costStart);
+            costStart = costEnd;
         }
 
         if (++_tickCounter % STATS_UPDATE_TICKS == 0)
@@ -97,10 +102,14 @@ void Engine::run()
             // forward packets every ms
             if (toSleep < nextForwardCycle && toSleep >= static_cast<int64_t>(utils::Time::ms))
             {
+                uint64_t costStart = timestamp;
                 for (auto mixerEntry = _mixers.head(); mixerEntry; mixerEntry = mixerEntry->_next)
                 {
                     assert(mixerEntry->_data);
                     mixerEntry->_data->forwardPackets(timestamp);
+                    const auto costEnd = utils::Time::getAbsoluteTime();
+                    mixerEntry->_data->getEngineCost().add(costEnd - costStart, 0);
+                    costStart = costEnd;
                 }
                 nextForwardCycle -= utils::Time::ms;
             }
@@ -127,30 +136,42 @@ void Engine::run()
 /* @return true if there are pending tasks */
 bool Engine::processTasks(uint32_t maxCount)
 {
-    for (uint32_t jobCount = 0; jobCount < maxCount; ++jobCount)
+    uint32_t jobCount = 0;
+    for (; jobCount < maxCount; ++jobCount)
     {
         utils::Function job;
-        if (_tasks.pop(job))
+        if (!_tasks.pop(job))
         {
-            job();
+            break;
         }
-        else
+        job();
+    }
+
+    if (jobCount > 0)
+    {
+        // tasks may have reconfigured any mixer
+        for (auto mixerEntry = _mixers.head(); mixerEntry; mixerEntry = mixerEntry->_next)
         {
-            return false;
+            mixerEntry->_data->wakeUp();
         }
     }
 
-    return !_tasks.empty();
+    return jobCount == maxCount && !_tasks.empty();
 }
 
 void Engine::updateStats(uint64_t& statsPollTime, EngineStats::EngineStats& currentStatSample, const uint64_t timestamp)
 {
     uint64_t pollTime = utils::Time::getAbsoluteTime();
     currentStatSample.activeMixers = EngineStats::MixerStats();
+    currentStatSample.hibernatingMixers = 0;
 
     for (auto mixerEntry = _mixers.head(); mixerEntry; mixerEntry = mixerEntry->_next)
     {
         currentStatSample.activeMixers += mixerEntry->_data->gatherStats(timestamp);
+        if (mixerEntry->_data->isHibernating())
+        {
+            ++currentStatSample.hibernatingMixers;
+        }
     }
 
     currentStatSample.pollPeriodMs =
@@ -4,6 +4,7 @@
 #include "concurrency/MpmcPublish.h"
 #include "concurrency/MpmcQueue.h"
 #include "concurrency/SynchronizationContext.h"
+#include "concurrency/ThreadUtils.h"
 #include "config/Config.h"
 #include "memory/List.h"
 #include "utils/Trackers.h"
@@ -33,6 +34,7 @@ public:
     virtual void setMessageListener(MixerManagerAsync* messageListener);
     void stop();
     void run();
+    bool setAffinity(const concurrency::CpuList& cpus) { return concurrency::setAffinity(_thread, cpus); }
 
     virtual bool post(utils::Function&& task) { return _tasks.push(std::move(task)); }
 
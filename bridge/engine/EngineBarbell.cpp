@@ -1,4 +1,5 @@
 #include "EngineBarbell.h"
+#include "bridge/BarbellTrunk.h"
 #include "transport/RtcTransport.h"
 
 namespace bridge
@@ -11,12 +12,17 @@ EngineBarbell::EngineBarbell(const std::string& barbellId,
     const std::vector<uint32_t>& audioSsrcs,
     RtpMap& audioRtpMap,
     RtpMap& videoRtpMap,
-    RtpMap& videoFeedbackRtpMap)
+    RtpMap& videoFeedbackRtpMap,
+    BarbellTrunk* barbellTrunk,
+    const std::string& dataChannelLabel)
     : id(barbellId),
       idHash(utils::hash<std::string>{}(barbellId)),
       ssrcOutboundContexts(128),
       transport(rtcTransport),
-      dataChannel(rtcTransport.getLoggableId().getInstanceId(), rtcTransport),
+      trunk(barbellTrunk),
+      dataChannel(rtcTransport.getLoggableId().getInstanceId(),
+          barbellTrunk ? static_cast<webrtc::DataStreamTransport&>(*barbellTrunk) : rtcTransport),
+      dataChannelLabel(dataChannelLabel),
       audioRtpMap(audioRtpMap),
       videoRtpMap(videoRtpMap),
       videoFeedbackRtpMap(videoFeedbackRtpMap),
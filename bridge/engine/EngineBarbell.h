@@ -16,6 +16,7 @@ class RtcTransport;
 
 namespace bridge
 {
+class BarbellTrunk;
 
 struct EngineBarbell
 {
@@ -25,7 +26,9 @@ struct EngineBarbell
         const std::vector<uint32_t>& audioSsrcs,
         RtpMap& audioRtpMap,
         RtpMap& videoRtpMap,
-        RtpMap& videoFeedbackRtpMap);
+        RtpMap& videoFeedbackRtpMap,
+        BarbellTrunk* barbellTrunk,
+        const std::string& dataChannelLabel);
 
     utils::Optional<uint32_t> getMainSsrcFor(uint32_t feedbackSsrc);
     utils::Optional<uint32_t> getFeedbackSsrcFor(uint32_t ssrc);
@@ -37,7 +40,9 @@ struct EngineBarbell
     concurrency::MpmcHashmap32<uint32_t, SsrcOutboundContext> ssrcOutboundContexts;
 
     transport::RtcTransport& transport;
+    BarbellTrunk* trunk; // transport is shared with other conferences and owned by the trunk if set
     webrtc::WebRtcDataStream dataChannel;
+    std::string dataChannelLabel;
 
     // map for ssrc to user id endpointIdHash to be used in activemediaList, that we update from data channel
     // messages
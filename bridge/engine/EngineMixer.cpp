@@ -36,6 +36,7 @@ EngineMixer::EngineMixer(const std::string& id,
     const config::Config& config,
     memory::PacketPoolAllocator& sendAllocator,
     memory::AudioPacketPoolAllocator& audioAllocator,
+    codec::OpusCodecPool& opusCodecPool,
     memory::PacketPoolAllocator& mainAllocator,
     const std::vector<uint32_t>& audioSsrcs,
     const std::vector<api::SimulcastGroup>& videoSsrcs,
@@ -46,23 +47,26 @@ EngineMixer::EngineMixer(const std::string& id,
       _engineSyncContext(engineSyncContext),
       _messageListener(messageListener),
       _incomingBarbellSctp(128),
-      _incomingForwarderAudioRtp(maxPendingPackets),
-      _incomingRtcp(videoSsrcs.empty() ? maxPendingRtcpPacketsVideoDisabled : maxPendingRtcpPackets),
-      _incomingForwarderVideoRtp(videoSsrcs.empty() ? 0 : maxPendingPackets),
-      _engineAudioStreams(maxStreamsPerModality),
-      _engineVideoStreams(videoSsrcs.empty() ? 0 : maxStreamsPerModality),
-      _engineDataStreams(maxStreamsPerModality),
+      _incomingForwarderAudioRtp(initialPendingPackets, maxPendingPackets),
+      _incomingRtcp(initialPendingRtcpPackets,
+          videoSsrcs.empty() ? maxPendingRtcpPacketsVideoDisabled : maxPendingRtcpPackets),
+      _incomingForwarderVideoRtp(initialPendingPackets, videoSsrcs.empty() ? 0 : maxPendingPackets),
+      _engineAudioStreams(initialStreamsPerModality, maxStreamsPerModality),
+      _engineVideoStreams(initialStreamsPerModality, videoSsrcs.empty() ? 0 : maxStreamsPerModality),
+      _engineDataStreams(initialStreamsPerModality, maxStreamsPerModality),
       _engineRecordingStreams(maxRecordingStreams),
       _engineBarbells(maxNumBarbells),
-      _neighbourMemberships(ActiveMediaList::maxParticipants),
-      _ssrcInboundContexts(videoSsrcs.empty() ? maxSsrcsVideoDisabled : maxSsrcs),
-      _allSsrcInboundContexts(videoSsrcs.empty() ? maxSsrcsVideoDisabled : maxSsrcs),
-      _audioSsrcToUserIdMap(ActiveMediaList::maxParticipants),
+      _neighbourMemberships(initialStreamsPerModality, ActiveMediaList::maxParticipants),
+      _ssrcInboundContexts(initialSsrcs, videoSsrcs.empty() ? maxSsrcsVideoDisabled : maxSsrcs),
+      _allSsrcInboundContexts(initialSsrcs, videoSsrcs.empty() ? maxSsrcsVideoDisabled : maxSsrcs),
+      _audioSsrcToUserIdMap(initialStreamsPerModality, ActiveMediaList::maxParticipants),
+      _videoFecSsrcs(SsrcRewrite::ssrcArraySize),
       _localVideoSsrc(localVideoSsrc),
       _rtpTimestampSource(1000),
       _mainAllocator(mainAllocator),
       _sendAllocator(sendAllocator),
       _audioAllocator(audioAllocator),
+      _opusCodecPool(opusCodecPool),
       _lastStartedIterationTimestamp(utils::Time::getAbsoluteTime()),
       _lastReceiveTimeOnRegularTransports(_lastStartedIterationTimestamp),
       _lastReceiveTimeOnBarbellTransports(_lastStartedIterationTimestamp),
@@ -85,9 +89,10 @@ EngineMixer::EngineMixer(const std::string& id,
       _numMixedAudioStreams(0),
       _lastVideoBandwidthCheck(0),
       _lastVideoPacketProcessed(0),
-      _lastTickJobStartTimestamp(0),
       _hasSentTimeout(false),
       _probingVideoStreams(false),
+      _hibernating(false),
+      _lastMaintenanceRun(_lastStartedIterationTimestamp),
       _minUplinkEstimate(0),
       _backgroundJobQueue(backgroundJobQueue),
       _lastRecordingAckProcessed(_lastStartedIterationTimestamp),
@@ -96,6 +101,14 @@ EngineMixer::EngineMixer(const std::string& id,
     assert(audioSsrcs.size() <= SsrcRewrite::ssrcArraySize);
     assert(videoSsrcs.size() <= SsrcRewrite::ssrcArraySize);
 
+    for (const auto& videoSsrc : videoSsrcs)
+    {
+        if (videoSsrc.size() > 0 && videoSsrc[0].fec != 0)
+        {
+            _videoFecSsrcs.emplace(videoSsrc[0].main, videoSsrc[0].fec);
+        }
+    }
+
     std::memset(_mixedData, 0, sizeof(_mixedData));
     _iceReceivedOnRegularTransport.test_and_set();
     _iceReceivedOnBarbellTransport.test_and_set();
@@ -190,6 +203,10 @@ void EngineMixer::flush()
 
 void EngineMixer::forwardPackets(const uint64_t engineTimestamp)
 {
+    if (isHibernating())
+    {
+        return;
+    }
     processIncomingRtpPackets(engineTimestamp);
 }
 
@@ -198,6 +215,15 @@ void EngineMixer::run(const uint64_t engineIterationStartTimestamp)
     _rtpTimestampSource += framesPerIteration1kHz;
     _lastStartedIterationTimestamp = engineIterationStartTimestamp;
 
+    if (isHibernating() &&
+        !utils::Time::diffGE(_lastMaintenanceRun,
+            engineIterationStartTimestamp,
+            _config.hibernation.maintenanceIntervalMs * utils::Time::ms))
+    {
+        return;
+    }
+    _lastMaintenanceRun = engineIterationStartTimestamp;
+
     // 1. Process all incoming packets
     processBarbellSctp(engineIterationStartTimestamp);
     processIncomingRtpPackets(engineIterationStartTimestamp);
@@ -231,13 +257,70 @@ void EngineMixer::run(const uint64_t engineIterationStartTimestamp)
     // 5. Check if Transports are alive
     removeIdleStreams(engineIterationStartTimestamp);
 
-    // 6. Maintain transports.
-    runTransportTicks(engineIterationStartTimestamp);
-
     if (!_hasSentTimeout && isIdle(engineIterationStartTimestamp))
     {
         _hasSentTimeout = _messageListener.asyncMixerTimedOut(*this);
     }
+
+    checkHibernation(engineIterationStartTimestamp);
+}
+
+/**
+ * Wakes the mixer from hibernation. May be called from any thread after an item has been put on one of the
+ * incoming queues or when the engine has run tasks that may have changed the mixer.
+ */
+void EngineMixer::wakeUp()
+{
+    // pairs with the fence in checkHibernation so the push is visible before the flag is read
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_hibernating.load(std::memory_order_relaxed))
+    {
+        _hibernating.store(false);
+    }
+}
+
+bool EngineMixer::hasPendingIncoming() const
+{
+    return !_incomingBarbellSctp.empty() || !_incomingForwarderAudioRtp.empty() || !_incomingRtcp.empty() ||
+        !_incomingForwarderVideoRtp.empty();
+}
+
+bool EngineMixer::canHibernate(const uint64_t timestamp) const
+{
+    const auto idleTimeout = _config.hibernation.idleTimeoutMs * utils::Time::ms;
+    return _config.hibernation.enable && _numMixedAudioStreams == 0 && _engineRecordingStreams.empty() &&
+        !_probingVideoStreams && utils::Time::diffGE(_lastReceiveTimeOnRegularTransports, timestamp, idleTimeout) &&
+        utils::Time::diffGE(_lastReceiveTimeOnBarbellTransports, timestamp, idleTimeout);
+}
+
+void EngineMixer::checkHibernation(const uint64_t timestamp)
+{
+    if (isHibernating())
+    {
+        if (!canHibernate(timestamp))
+        {
+            wakeUp();
+        }
+        return;
+    }
+
+    if (!canHibernate(timestamp) || hasPendingIncoming())
+    {
+        return;
+    }
+
+    // Producers push before they wake us up. Setting the flag before re-checking the queues ensures that a packet
+    // pushed concurrently is either seen here or clears the flag afterwards. The store and the queue reads must not be
+    // reordered, nor the push and the flag read in wakeUp, hence the full fences on both sides.
+    _hibernating.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (hasPendingIncoming())
+    {
+        _hibernating.store(false);
+        return;
+    }
+
+    logger::debug("hibernating", _loggableId.c_str());
 }
 
 void EngineMixer::runDominantSpeakerCheck(const uint64_t engineIterationStartTimestamp)
@@ -445,6 +528,9 @@ EngineStats::MixerStats EngineMixer::gatherStats(const uint64_t iterationStartTi
     EngineStats::MixerStats stats;
     uint64_t idleTimestamp = iterationStartTime - utils::Time::sec * 2;
 
+    stats.containerMemory = getContainerMemoryUsage();
+    stats.maxContainerMemory = stats.containerMemory;
+
     stats.audioInQueues = 0;
     stats.audioInQueueSamples = 0;
     stats.maxAudioInQueueSamples = 0;
@@ -514,6 +600,17 @@ EngineStats::MixerStats EngineMixer::gatherStats(const uint64_t iterationStartTi
     return stats;
 }
 
+size_t EngineMixer::getContainerMemoryUsage() const
+{
+    return _incomingBarbellSctp.getAllocatedBytes() + _incomingForwarderAudioRtp.getAllocatedBytes() +
+        _incomingRtcp.getAllocatedBytes() + _incomingForwarderVideoRtp.getAllocatedBytes() +
+        _engineAudioStreams.getAllocatedBytes() + _engineVideoStreams.getAllocatedBytes() +
+        _engineDataStreams.getAllocatedBytes() + _engineRecordingStreams.getAllocatedBytes() +
+        _engineBarbells.getAllocatedBytes() + _neighbourMemberships.getAllocatedBytes() +
+        _ssrcInboundContexts.getAllocatedBytes() + _allSsrcInboundContexts.getAllocatedBytes() +
+        _audioSsrcToUserIdMap.getAllocatedBytes();
+}
+
 void EngineMixer::onConnected(transport::RtcTransport* sender)
 {
     logger::debug("transport connected", sender->getLoggableId().c_str());
@@ -651,7 +748,7 @@ void EngineMixer::onSctpEstablished(transport::RtcTransport* sender)
         logger::debug("opening barbell webrtc data channel on %s",
             _loggableId.c_str(),
             sender->getLoggableId().c_str());
-        barbell->dataChannel.open("barbell");
+        barbell->dataChannel.open(barbell->dataChannelLabel);
     }
 }
 
@@ -674,6 +771,7 @@ void EngineMixer::onSctpMessage(transport::RtcTransport* sender,
     if (EngineBarbell::isFromBarbell(sender->getTag()))
     {
         _incomingBarbellSctp.push(IncomingSctpMessageInfo(std::move(buffer), sender));
+        wakeUp();
         return;
     }
 
@@ -702,6 +800,7 @@ void EngineMixer::onRtpPacketReceived(transport::RtcTransport* sender,
     if (!ssrcContext)
     {
         logger::warn("could not acquire inbound ssrc context ssrc %u", _loggableId.c_str(), ssrc);
+        sender->rejectInboundSsrc(ssrc);
         return;
     }
 
@@ -763,6 +862,7 @@ void EngineMixer::onRtcpPacketDecoded(transport::RtcTransport* sender,
     {
         logger::warn("rtcp queue full", _loggableId.c_str());
     }
+    wakeUp();
 }
 
 SsrcOutboundContext* EngineMixer::obtainOutboundSsrcContext(size_t endpointIdHash,
@@ -1131,6 +1231,10 @@ void EngineMixer::processIncomingRtcpPackets(const uint64_t timestamp)
             {
             case rtp::RtcpPacketType::RECEIVER_REPORT:
             case rtp::RtcpPacketType::SENDER_REPORT:
+                if (_config.flexfec.enable)
+                {
+                    processIncomingReportBlocks(packetInfo.transport()->getEndpointIdHash(), rtcpPacket);
+                }
                 break;
             case rtp::RtcpPacketType::PAYLOADSPECIFIC_FB:
                 processIncomingPayloadSpecificRtcpPacket(packetInfo.transport()->getEndpointIdHash(),
@@ -1169,6 +1273,42 @@ void EngineMixer::processIceActivity(const uint64_t timestamp)
     }
 }
 
+void EngineMixer::processIncomingReportBlocks(const size_t rtcpSenderEndpointIdHash, const rtp::RtcpHeader& rtcpPacket)
+{
+    auto* videoStream = _engineVideoStreams.getItem(rtcpSenderEndpointIdHash);
+    if (!videoStream)
+    {
+        return;
+    }
+
+    const rtp::ReportBlock* reportBlocks = nullptr;
+    if (rtcpPacket.packetType == rtp::RtcpPacketType::SENDER_REPORT)
+    {
+        const auto* senderReport = rtp::RtcpSenderReport::fromPtr(&rtcpPacket, rtcpPacket.size());
+        reportBlocks = senderReport ? senderReport->reportBlocks : nullptr;
+    }
+    else
+    {
+        const auto* receiverReport = rtp::RtcpReceiverReport::fromPtr(&rtcpPacket, rtcpPacket.size());
+        reportBlocks = receiverReport ? receiverReport->reportBlocks : nullptr;
+    }
+
+    if (!reportBlocks)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < rtcpPacket.fmtCount; ++i)
+    {
+        auto* outboundContext = videoStream->ssrcOutboundContexts.getItem(reportBlocks[i].ssrc.get());
+        if (outboundContext)
+        {
+            outboundContext->reportedFractionLost =
+                static_cast<uint8_t>(std::min(255.0, reportBlocks[i].loss.getFractionLost() * 256));
+        }
+    }
+}
+
 void EngineMixer::processIncomingPayloadSpecificRtcpPacket(const size_t rtcpSenderEndpointIdHash,
     const rtp::RtcpHeader& rtcpPacket,
     const uint64_t timestamp)
@@ -1632,19 +1772,6 @@ void EngineMixer::removeIdleStreams(const uint64_t timestamp)
     ::bridge::removeIdleStreams<EngineDataStream>(_engineDataStreams, this, timestamp);
 }
 
-void EngineMixer::runTransportTicks(const uint64_t timestamp)
-{
-    if (utils::Time::diffLT(_lastTickJobStartTimestamp, timestamp, utils::Time::ms * 60))
-    {
-        return;
-    }
-    _lastTickJobStartTimestamp = timestamp;
-    for (auto videoIt : _engineVideoStreams)
-    {
-        videoIt.second->transport.runTick(timestamp);
-    }
-}
-
 size_t EngineMixer::getDominantSpeakerId() const
 {
     return _activeMediaList->getDominantSpeaker();
@@ -1701,5 +1828,6 @@ void EngineMixer::onIceReceived(transport::RtcTransport* transport, uint64_t tim
     {
         _iceReceivedOnRegularTransport.clear();
     }
+    wakeUp();
 }
 } // namespace bridge
@@ -4,9 +4,12 @@
 #include "bridge/engine/ActiveTalker.h"
 #include "bridge/engine/BarbellEndpointMap.h"
 #include "bridge/engine/EngineStats.h"
+#include "bridge/engine/InboundPacketMetadata.h"
 #include "bridge/engine/NeighbourMembership.h"
 #include "bridge/engine/SimulcastStream.h"
 #include "bridge/engine/SsrcInboundContext.h"
+#include "concurrency/CounterWait.h"
+#include "concurrency/GrowingMpmcQueue.h"
 #include "concurrency/MpmcHashmap.h"
 #include "concurrency/SynchronizationContext.h"
 #include "memory/AudioPacketPoolAllocator.h"
@@ -14,6 +17,8 @@
 #include "memory/PacketPoolAllocator.h"
 #include "memory/PoolBuffer.h"
 #include "transport/RtcTransport.h"
+#include "utils/Trackers.h"
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <map>
@@ -87,6 +92,12 @@ public:
     static constexpr size_t maxStreamsPerModality = 4096;
     static constexpr size_t maxRecordingStreams = 8;
 
+    // Engine containers start at these sizes and grow on demand up to the max sizes above
+    static constexpr size_t initialPendingPackets = 256;
+    static constexpr size_t initialPendingRtcpPackets = 64;
+    static constexpr size_t initialSsrcs = 64;
+    static constexpr size_t initialStreamsPerModality = 16;
+
     EngineMixer(const std::string& id,
         jobmanager::JobManager& jobManager,
         const concurrency::SynchronizationContext& engineSyncContext,
@@ -96,6 +107,7 @@ public:
         const config::Config& config,
         memory::PacketPoolAllocator& sendAllocator,
         memory::AudioPacketPoolAllocator& audioAllocator,
+        codec::OpusCodecPool& opusCodecPool,
         memory::PacketPoolAllocator& mainAllocator,
         const std::vector<uint32_t>& audioSsrcs,
         const std::vector<api::SimulcastGroup>& videoSsrcs,
@@ -114,10 +126,17 @@ public:
     EngineStats::MixerStats gatherStats(const uint64_t engineIterationStartTimestamp);
 
     void run(const uint64_t engineIterationStartTimestamp);
+    void wakeUp();
+    bool isHibernating() const { return _hibernating.load(std::memory_order_relaxed); }
+    // Engine thread time spent in run and forwardPackets
+    utils::CostTracker& getEngineCost() { return _engineCost; }
+    const utils::CostTracker& getEngineCost() const { return _engineCost; }
     // --
 
     memory::PacketPoolAllocator& getMainAllocator() { return _mainAllocator; }
+    const config::Config& getConfig() const { return _config; }
     memory::AudioPacketPoolAllocator& getAudioAllocator() { return _audioAllocator; }
+    codec::OpusCodecPool& getOpusCodecPool() { return _opusCodecPool; }
     size_t getDominantSpeakerId() const;
     std::map<size_t, ActiveTalker> getActiveTalkers() const;
     utils::Optional<uint32_t> getC9UserId(const size_t ssrc) const;
@@ -151,7 +170,8 @@ public:
         const uint32_t extendedSequenceNumber);
     void onForwarderVideoRtpPacketDecrypted(SsrcInboundContext& inboundContext,
         memory::UniquePacket packet,
-        const uint32_t extendedSequenceNumber);
+        const uint32_t extendedSequenceNumber,
+        const InboundPacketMetadata& metadata);
     void onIceReceived(transport::RtcTransport* transport, uint64_t timestamp) override;
 
     void onRtcpPacketDecoded(transport::RtcTransport* sender, memory::UniquePacket packet, uint64_t timestamp) override;
@@ -300,11 +320,26 @@ protected:
             lockOwner();
         }
 
+        IncomingPacketAggregate(PacketT packet,
+            SsrcInboundContext* inboundContext,
+            const uint32_t extendedSequenceNumber,
+            const InboundPacketMetadata& metadata)
+            : _packet(std::move(packet)),
+              _inboundContext(inboundContext),
+              _transport(inboundContext->sender),
+              _extendedSequenceNumber(extendedSequenceNumber),
+              _metadata(metadata)
+        {
+            assert(_packet);
+            lockOwner();
+        }
+
         explicit IncomingPacketAggregate(IncomingPacketAggregate&& rhs)
             : _packet(std::move(rhs._packet)),
               _inboundContext(std::exchange(rhs._inboundContext, nullptr)),
               _transport(std::exchange(rhs._transport, nullptr)),
-              _extendedSequenceNumber(rhs._extendedSequenceNumber)
+              _extendedSequenceNumber(rhs._extendedSequenceNumber),
+              _metadata(rhs._metadata)
         {
         }
 
@@ -316,6 +351,7 @@ protected:
             _inboundContext = std::exchange(rhs._inboundContext, nullptr);
             _transport = std::exchange(rhs._transport, nullptr);
             _extendedSequenceNumber = rhs._extendedSequenceNumber;
+            _metadata = rhs._metadata;
             return *this;
         }
 
@@ -329,6 +365,7 @@ protected:
         inline PacketT& packet() { return _packet; }
         inline const PacketT& packet() const { return _packet; }
         inline uint32_t extendedSequenceNumber() const { return _extendedSequenceNumber; }
+        inline const InboundPacketMetadata& metadata() const { return _metadata; }
 
     private:
         void release()
@@ -336,10 +373,10 @@ protected:
             if (_transport)
             {
 #if DEBUG
-                const auto decreased = --_transport->getJobCounter();
+                const auto decreased = concurrency::decrementAndNotify(_transport->getJobCounter());
                 assert(decreased < 0xFFFFFFFF); // detecting going below zero
 #else
-                --_transport->getJobCounter();
+                concurrency::decrementAndNotify(_transport->getJobCounter());
 #endif
                 _transport = nullptr;
             }
@@ -357,6 +394,7 @@ protected:
         SsrcInboundContext* _inboundContext;
         transport::RtcTransport* _transport;
         uint32_t _extendedSequenceNumber;
+        InboundPacketMetadata _metadata;
     };
 
     using IncomingPacketInfo = IncomingPacketAggregate<memory::UniquePacket>;
@@ -369,10 +407,10 @@ protected:
     concurrency::SynchronizationContext _engineSyncContext;
     MixerManagerAsync& _messageListener;
 
-    concurrency::MpmcQueue<IncomingSctpMessageInfo> _incomingBarbellSctp;
-    concurrency::MpmcQueue<IncomingPacketInfo> _incomingForwarderAudioRtp;
-    concurrency::MpmcQueue<IncomingPacketInfo> _incomingRtcp;
-    concurrency::MpmcQueue<IncomingPacketInfo> _incomingForwarderVideoRtp;
+    concurrency::GrowingMpmcQueue<IncomingSctpMessageInfo> _incomingBarbellSctp;
+    concurrency::GrowingMpmcQueue<IncomingPacketInfo> _incomingForwarderAudioRtp;
+    concurrency::GrowingMpmcQueue<IncomingPacketInfo> _incomingRtcp;
+    concurrency::GrowingMpmcQueue<IncomingPacketInfo> _incomingForwarderVideoRtp;
 
     concurrency::MpmcHashmap32<size_t, EngineAudioStream*> _engineAudioStreams;
     concurrency::MpmcHashmap32<size_t, EngineVideoStream*> _engineVideoStreams;
@@ -387,6 +425,8 @@ protected:
     // active and decommissioned contexts
     concurrency::MpmcHashmap32<uint32_t, SsrcInboundContext> _allSsrcInboundContexts;
     concurrency::MpmcHashmap32<uint32_t, uint32_t> _audioSsrcToUserIdMap;
+    // rewritten video ssrc -> FlexFEC repair ssrc announced to the clients
+    concurrency::MpmcHashmap32<uint32_t, uint32_t> _videoFecSsrcs;
 
     uint32_t _localVideoSsrc;
 
@@ -396,6 +436,7 @@ protected:
     memory::PacketPoolAllocator& _mainAllocator;
     memory::PacketPoolAllocator& _sendAllocator;
     memory::AudioPacketPoolAllocator& _audioAllocator;
+    codec::OpusCodecPool& _opusCodecPool;
 
     // Useful to avoid get time when a precise time is not needed and we can rely on last/current iteration start time
     uint64_t _lastStartedIterationTimestamp;
@@ -418,9 +459,11 @@ protected:
 
     uint64_t _lastVideoBandwidthCheck;
     uint64_t _lastVideoPacketProcessed;
-    uint64_t _lastTickJobStartTimestamp;
     bool _hasSentTimeout;
     bool _probingVideoStreams;
+    std::atomic_bool _hibernating;
+    uint64_t _lastMaintenanceRun;
+    utils::CostTracker _engineCost;
     uint32_t _minUplinkEstimate;
     jobmanager::JobManager& _backgroundJobQueue; // to non-real time world
 
@@ -428,6 +471,10 @@ protected:
     bool _slidesPresent;
 
     bool isIdle(uint64_t timestamp) const;
+    bool hasPendingIncoming() const;
+    bool canHibernate(uint64_t timestamp) const;
+    size_t getContainerMemoryUsage() const;
+    void checkHibernation(uint64_t timestamp);
 
     uint32_t getMinRemoteClientDownlinkBandwidth() const;
     void reportMinRemoteClientDownlinkBandwidthToBarbells(const uint32_t minUplinkEstimate) const;
@@ -450,6 +497,7 @@ protected:
     void processIncomingPayloadSpecificRtcpPacket(const size_t rtcpSenderEndpointIdHash,
         const rtp::RtcpHeader& rtcpPacket,
         uint64_t timestamp);
+    void processIncomingReportBlocks(const size_t rtcpSenderEndpointIdHash, const rtp::RtcpHeader& rtcpPacket);
 
     void processIncomingBarbellFbRtcpPacket(EngineBarbell& barbell,
         const rtp::RtcpFeedback& rtcpFeedback,
@@ -458,7 +506,6 @@ protected:
         const rtp::RtcpHeader& rtcpPacket,
         const uint64_t timestamp);
     void checkVideoBandwidth(const uint64_t timestamp);
-    void runTransportTicks(const uint64_t timestamp);
     void removeIdleStreams(const uint64_t timestamp);
 
     void processAudioStreams();
@@ -516,8 +563,8 @@ protected:
     void sendVideoStreamToRecording(const EngineVideoStream& videoStream, bool isAdded);
     void removeVideoSsrcFromRecording(const EngineVideoStream& videoStream, uint32_t ssrc);
 
-    void processEngineMissingPackets(bridge::SsrcInboundContext& ssrcInboundContext);
-    void processBarbellMissingPackets(bridge::SsrcInboundContext& ssrcInboundContext);
+    bool processEngineMissingPackets(bridge::SsrcInboundContext& ssrcInboundContext);
+    bool processBarbellMissingPackets(bridge::SsrcInboundContext& ssrcInboundContext);
     void processRecordingUnackedPackets(const uint64_t timestamp);
     void startProbingVideoStream(EngineVideoStream&);
     void stopProbingVideoStream(const EngineVideoStream&);
@@ -573,6 +620,7 @@ protected:
 
     bool setPacketSourceEndpointIdHash(memory::Packet& packet, size_t barbellIdHash, uint32_t ssrc, bool isAudio);
     utils::Optional<uint32_t> findBarbellMainSsrc(size_t barbellIdHash, uint32_t feedbackSsrc);
+    uint32_t findFecSsrc(const EngineVideoStream& videoStream, uint32_t ssrc) const;
 };
 
 } // namespace bridge
@@ -82,6 +82,7 @@ void EngineMixer::addAudioStream(EngineAudioStream* engineAudioStream)
         engineAudioStream->isMixed() ? 't' : 'f');
 
     _engineAudioStreams.emplace(endpointIdHash, engineAudioStream);
+    engineAudioStream->transport.clearRejectedInboundSsrcs();
     if (engineAudioStream->isMixed())
     {
         _numMixedAudioStreams++;
@@ -196,6 +197,7 @@ void EngineMixer::reconfigureAudioStream(const transport::RtcTransport& transpor
         sendAudioStreamToRecording(*engineAudioStream, false);
     }
 
+    engineAudioStream->transport.clearRejectedInboundSsrcs();
     if (remoteSsrc != 0)
     {
         engineAudioStream->remoteSsrc.set(remoteSsrc);
@@ -290,6 +292,7 @@ void EngineMixer::onForwarderAudioRtpPacketDecrypted(SsrcInboundContext& inbound
         logger::error("Failed to push incoming forwarder audio packet onto queue", getLoggableId().c_str());
         assert(false);
     }
+    wakeUp();
 }
 
 void EngineMixer::forwardAudioRtpPacket(IncomingPacketInfo& packetInfo, uint64_t timestamp)
@@ -474,6 +477,7 @@ void EngineMixer::processAudioStreams()
             audioStream->transport.getJobQueue().addJob<EncodeJob>(std::move(audioPacket),
                 *ssrcContext,
                 audioStream->transport,
+                _opusCodecPool,
                 _rtpTimestampSource);
         }
     }
@@ -1,5 +1,6 @@
 #include "api/DataChannelMessage.h"
 #include "api/DataChannelMessageParser.h"
+#include "bridge/BarbellTrunk.h"
 #include "bridge/MixerManagerAsync.h"
 #include "bridge/engine/ActiveMediaList.h"
 #include "bridge/engine/AudioForwarderRewriteAndSendJob.h"
@@ -111,6 +112,13 @@ void EngineMixer::addBarbell(EngineBarbell* barbell)
         idHash);
 
     _engineBarbells.emplace(idHash, barbell);
+    barbell->transport.clearRejectedInboundSsrcs();
+
+    // a trunk shared with other conferences may have established its SCTP association long ago
+    if (barbell->trunk && barbell->trunk->isSctpEstablished() && barbell->transport.isDtlsClient())
+    {
+        barbell->dataChannel.open(barbell->dataChannelLabel);
+    }
 }
 
 // executed on transport thread context
@@ -137,7 +145,10 @@ void EngineMixer::removeBarbell(size_t idHash)
         return;
     }
 
-    barbell->transport.stop();
+    if (!barbell->trunk)
+    {
+        barbell->transport.stop();
+    }
 
     for (const auto& videoStream : barbell->videoStreams)
     {
@@ -246,6 +257,7 @@ void EngineMixer::onBarbellUserMediaMap(size_t barbellIdHash, const char* messag
     }
 
     const auto mapRevision = _activeMediaList->getMapRevision();
+    bool ssrcsMapped = false;
 
     // remove video
     for (const auto& entry : videoSsrcs)
@@ -300,6 +312,7 @@ void EngineMixer::onBarbellUserMediaMap(size_t barbellIdHash, const char* messag
                 }
                 videoStream->endpointIdHash.set(entry.first);
                 videoStream->endpointId.set(item.endpointId);
+                ssrcsMapped = true;
             }
 
             _activeMediaList->addBarbellVideoParticipant(entry.first, primary, secondary, item.endpointId);
@@ -367,6 +380,7 @@ void EngineMixer::onBarbellUserMediaMap(size_t barbellIdHash, const char* messag
 
             audioStream->endpointIdHash.set(entry.first);
             audioStream->endpointId.set(item.endpointId);
+            ssrcsMapped = true;
             _activeMediaList->addBarbellAudioParticipant(entry.first,
                 item.endpointId,
                 item.noiseLevel,
@@ -388,6 +402,12 @@ void EngineMixer::onBarbellUserMediaMap(size_t barbellIdHash, const char* messag
         _activeMediaList->logAudioList();
     }
 
+    if (ssrcsMapped)
+    {
+        // ssrcs rejected before they were mapped must be accepted now
+        barbell->transport.clearRejectedInboundSsrcs();
+    }
+
     if (mapRevision != _activeMediaList->getMapRevision())
     {
         // only update local users
@@ -580,7 +600,7 @@ utils::Optional<uint32_t> EngineMixer::findBarbellMainSsrc(size_t barbellIdHash,
     return videoStream->stream.getMainSsrcFor(feedbackSsrc);
 }
 
-void EngineMixer::processBarbellMissingPackets(bridge::SsrcInboundContext& ssrcInboundContext)
+bool EngineMixer::processBarbellMissingPackets(bridge::SsrcInboundContext& ssrcInboundContext)
 {
     const auto barbell = _engineBarbells.getItem(ssrcInboundContext.sender->getEndpointIdHash());
     if (barbell)
@@ -589,12 +609,13 @@ void EngineMixer::processBarbellMissingPackets(bridge::SsrcInboundContext& ssrcI
         auto videoStream = barbell->videoSsrcMap.getItem(ssrcInboundContext.ssrc);
         if (videoStream)
         {
-            barbell->transport.getJobQueue().addJob<bridge::ProcessMissingVideoPacketsJob>(ssrcInboundContext,
+            return barbell->transport.getJobQueue().addJob<bridge::ProcessMissingVideoPacketsJob>(ssrcInboundContext,
                 REPORTER_SSRC,
                 barbell->transport,
                 _sendAllocator);
         }
     }
+    return false;
 }
 
 void EngineMixer::processIncomingBarbellFbRtcpPacket(EngineBarbell& barbell,
@@ -854,6 +875,7 @@ void EngineMixer::forwardVideoRtpPacketOverBarbell(IncomingPacketInfo& packetInf
                 std::move(packet),
                 barbell.transport,
                 packetInfo.extendedSequenceNumber(),
+                packetInfo.metadata(),
                 _messageListener,
                 barbell.idHash,
                 *this,
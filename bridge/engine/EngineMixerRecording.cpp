@@ -471,6 +471,7 @@ void EngineMixer::forwardVideoRtpPacketRecording(IncomingPacketInfo& packetInfo,
                     std::move(packet),
                     transportEntry.second,
                     packetInfo.extendedSequenceNumber(),
+                    packetInfo.metadata(),
                     _messageListener,
                     transportEntry.first,
                     *this,
@@ -74,6 +74,7 @@ void EngineMixer::addVideoStream(EngineVideoStream* engineVideoStream)
             engineVideoStream->transport.getLoggableId().c_str(),
             endpointIdHash);
     }
+    engineVideoStream->transport.clearRejectedInboundSsrcs();
 
     if (engineVideoStream->simulcastStream.numLevels > 0)
     {
@@ -247,6 +248,8 @@ void EngineMixer::reconfigureVideoStream(const transport::RtcTransport& transpor
         ssrcWhitelist.ssrcs[0],
         ssrcWhitelist.ssrcs[1]);
 
+    engineVideoStream->transport.clearRejectedInboundSsrcs();
+
     memory::Array<uint32_t, 12> decommissionedSsrcs;
 
     const auto mapRevision = _activeMediaList->getMapRevision();
@@ -369,13 +372,21 @@ void EngineMixer::processMissingPackets(const uint64_t timestamp)
             continue;
         }
 
-        if (EngineBarbell::isFromBarbell(ssrcInboundContext.sender->getTag()))
+        // streams without loss post no job
+        auto processTime = ssrcInboundContext.missingPacketsProcessTime.load();
+        if (processTime == 0 || utils::Time::diffGT(timestamp, processTime, 0) ||
+            !ssrcInboundContext.missingPacketsProcessTime.compare_exchange_strong(processTime, 0))
         {
-            processBarbellMissingPackets(ssrcInboundContext);
+            continue;
         }
-        else
+
+        const bool posted = EngineBarbell::isFromBarbell(ssrcInboundContext.sender->getTag())
+            ? processBarbellMissingPackets(ssrcInboundContext)
+            : processEngineMissingPackets(ssrcInboundContext);
+        if (!posted)
         {
-            processEngineMissingPackets(ssrcInboundContext);
+            uint64_t noProcessTime = 0;
+            ssrcInboundContext.missingPacketsProcessTime.compare_exchange_strong(noProcessTime, processTime);
         }
     }
 
@@ -521,15 +532,17 @@ void EngineMixer::pinEndpoint(const size_t endpointIdHash, const size_t targetEn
 
 void EngineMixer::onForwarderVideoRtpPacketDecrypted(SsrcInboundContext& inboundContext,
     memory::UniquePacket packet,
-    const uint32_t extendedSequenceNumber)
+    const uint32_t extendedSequenceNumber,
+    const InboundPacketMetadata& metadata)
 {
     assert(packet);
     if (!_incomingForwarderVideoRtp.push(
-            IncomingPacketInfo(std::move(packet), &inboundContext, extendedSequenceNumber)))
+            IncomingPacketInfo(std::move(packet), &inboundContext, extendedSequenceNumber, metadata)))
     {
         logger::error("Failed to push incoming forwarder video packet onto queue", getLoggableId().c_str());
         assert(false);
     }
+    wakeUp();
 }
 
 void EngineMixer::forwardVideoRtpPacket(IncomingPacketInfo& packetInfo, const uint64_t timestamp)
@@ -625,6 +638,11 @@ void EngineMixer::forwardVideoRtpPacket(IncomingPacketInfo& packetInfo, const ui
                 ssrc,
                 videoStream->rtpMap,
                 bridge::RtpMap::EMPTY);
+
+            if (ssrcOutboundContext && _config.flexfec.enable && ssrcOutboundContext->fecSsrc == 0)
+            {
+                ssrcOutboundContext->fecSsrc = findFecSsrc(*videoStream, ssrc);
+            }
         }
         else
         {
@@ -656,6 +674,7 @@ void EngineMixer::forwardVideoRtpPacket(IncomingPacketInfo& packetInfo, const ui
                 std::move(packet),
                 videoStream->transport,
                 packetInfo.extendedSequenceNumber(),
+                packetInfo.metadata(),
                 _messageListener,
                 videoStream->endpointIdHash,
                 *this,
@@ -668,6 +687,16 @@ void EngineMixer::forwardVideoRtpPacket(IncomingPacketInfo& packetInfo, const ui
     }
 }
 
+uint32_t EngineMixer::findFecSsrc(const EngineVideoStream& videoStream, const uint32_t ssrc) const
+{
+    const auto* fecSsrc = _videoFecSsrcs.getItem(ssrc);
+    if (!fecSsrc)
+    {
+        fecSsrc = videoStream.pinFecSsrcs.getItem(ssrc);
+    }
+    return fecSsrc ? *fecSsrc : 0;
+}
+
 // This method is called after a video stream has been reconfigured. That has led to streams being removed and then
 // added again to ActiveMediaList and EngineStreamDirector. If the ssrc is an active inbound ssrc, we will set the
 // stream state again in EngineStreamDirector.
@@ -729,16 +758,17 @@ void EngineMixer::markAssociatedVideoOutboundContextsForDeletion(const EngineVid
     }
 }
 
-void EngineMixer::processEngineMissingPackets(bridge::SsrcInboundContext& ssrcInboundContext)
+bool EngineMixer::processEngineMissingPackets(bridge::SsrcInboundContext& ssrcInboundContext)
 {
     auto* videoStream = _engineVideoStreams.getItem(ssrcInboundContext.sender->getEndpointIdHash());
     if (videoStream)
     {
-        videoStream->transport.getJobQueue().addJob<bridge::ProcessMissingVideoPacketsJob>(ssrcInboundContext,
+        return videoStream->transport.getJobQueue().addJob<bridge::ProcessMissingVideoPacketsJob>(ssrcInboundContext,
             videoStream->localSsrc,
             videoStream->transport,
             _sendAllocator);
     }
+    return false;
 }
 
 void EngineMixer::checkVideoBandwidth(const uint64_t timestamp)
@@ -3,6 +3,7 @@
 #include "transport/PacketCounters.h"
 #include "transport/TransportStats.h"
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 
 namespace bridge
@@ -36,6 +37,9 @@ struct MixerStats
     double opusDecodePacketsPerSecond = 0;
     uint32_t audioLevelExtensionStreamCount = 0;
 
+    size_t containerMemory = 0; // bytes allocated by engine containers
+    size_t maxContainerMemory = 0; // largest single mixer
+
     MixerStats& operator+=(const MixerStats& b)
     {
         audioInQueueSamples += b.audioInQueueSamples;
@@ -54,6 +58,8 @@ struct MixerStats
         rtxPacingQueue += b.rtxPacingQueue;
         opusDecodePacketsPerSecond += b.opusDecodePacketsPerSecond;
         audioLevelExtensionStreamCount += b.audioLevelExtensionStreamCount;
+        containerMemory += b.containerMemory;
+        maxContainerMemory = std::max(maxContainerMemory, b.maxContainerMemory);
 
         return *this;
     }
@@ -68,6 +74,7 @@ struct EngineStats
     uint32_t pollPeriodMs = 1;
 
     MixerStats activeMixers;
+    uint32_t hibernatingMixers = 0;
 };
 
 } // namespace EngineStats
@@ -45,6 +45,7 @@ struct EngineVideoStream
           ssrcWhitelist(whitelist),
           ssrcRewrite(ssrcRewrite),
           videoPinSsrcs(SsrcRewrite::ssrcArraySize),
+          pinFecSsrcs(SsrcRewrite::ssrcArraySize),
           idleTimeoutSeconds(idleTimeoutSeconds),
           createdAt(utils::Time::getAbsoluteTime())
     {
@@ -53,6 +54,10 @@ struct EngineVideoStream
         for (const auto& videoSsrc : pinSsrcs)
         {
             videoPinSsrcs.push({videoSsrc.main, videoSsrc.feedback, false});
+            if (videoSsrc.fec != 0)
+            {
+                pinFecSsrcs.emplace(videoSsrc.main, videoSsrc.fec);
+            }
         }
     }
 
@@ -93,6 +98,7 @@ struct EngineVideoStream
 
     concurrency::MpmcQueue<SimulcastLevel> videoPinSsrcs;
     utils::Optional<SimulcastLevel> pinSsrc;
+    concurrency::MpmcHashmap32<uint32_t, uint32_t> pinFecSsrcs;
     const uint32_t idleTimeoutSeconds;
     const uint64_t createdAt;
 };
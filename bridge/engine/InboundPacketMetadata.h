@@ -0,0 +1,36 @@
+#pragma once
+
+#include "bridge/RtpMap.h"
+#include "codec/H264Header.h"
+#include "codec/Vp8Header.h"
+#include "memory/Packet.h"
+#include "rtp/RtpHeader.h"
+
+namespace bridge
+{
+
+// Facts about a decrypted inbound packet. Parsed once by the receive job and handed to the send job of every
+// recipient instead of each of them parsing the payload again.
+struct InboundPacketMetadata
+{
+    bool isKeyFrame = false;
+
+    static InboundPacketMetadata fromVideoPacket(const memory::Packet& packet, const RtpMap::Format format)
+    {
+        InboundPacketMetadata metadata;
+        const auto rtpHeader = rtp::RtpHeader::fromPacket(packet);
+        if (!rtpHeader)
+        {
+            return metadata;
+        }
+
+        const auto payload = rtpHeader->getPayload();
+        const auto payloadSize = packet.getLength() - rtpHeader->headerLength();
+        metadata.isKeyFrame = format == RtpMap::Format::H264
+            ? codec::H264Header::isKeyFrame(payload, payloadSize)
+            : codec::Vp8Header::isKeyFrame(payload, codec::Vp8Header::getPayloadDescriptorSize(payload, payloadSize));
+        return metadata;
+    }
+};
+
+} // namespace bridge
@@ -35,6 +35,8 @@ void ProcessMissingVideoPacketsJob::run()
     const auto numMissingSequenceNumbers = _ssrcContext.videoMissingPacketsTracker->process(timestamp,
         _ssrcContext.sender->getRtt(),
         missingSequenceNumbers);
+    _ssrcContext.missingPacketsProcessTime =
+        _ssrcContext.videoMissingPacketsTracker->getNextProcessTime(_ssrcContext.sender->getRtt());
 
     if (numMissingSequenceNumbers == 0)
     {
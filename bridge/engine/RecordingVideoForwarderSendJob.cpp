@@ -3,8 +3,6 @@
 #include "bridge/engine/PacketCache.h"
 #include "bridge/engine/SsrcInboundContext.h"
 #include "bridge/engine/SsrcOutboundContext.h"
-#include "codec/H264Header.h"
-#include "codec/Vp8Header.h"
 #include "transport/Transport.h"
 #include "utils/Function.h"
 
@@ -16,6 +14,7 @@ RecordingVideoForwarderSendJob::RecordingVideoForwarderSendJob(SsrcOutboundConte
     memory::UniquePacket packet,
     transport::Transport& transport,
     const uint32_t extendedSequenceNumber,
+    const InboundPacketMetadata& metadata,
     MixerManagerAsync& mixerManager,
     size_t endpointIdHash,
     EngineMixer& mixer,
@@ -26,6 +25,7 @@ RecordingVideoForwarderSendJob::RecordingVideoForwarderSendJob(SsrcOutboundConte
       _packet(std::move(packet)),
       _transport(transport),
       _extendedSequenceNumber(extendedSequenceNumber),
+      _metadata(metadata),
       _mixerManager(mixerManager),
       _endpointIdHash(endpointIdHash),
       _mixer(mixer),
@@ -70,12 +70,7 @@ void RecordingVideoForwarderSendJob::run()
         return;
     }
 
-    const auto payload = rtpHeader->getPayload();
-    const auto payloadSize = _packet->getLength() - rtpHeader->headerLength();
-
-    const auto isKeyFrame = _outboundContext.rtpMap.format == RtpMap::Format::H264
-        ? codec::H264Header::isKeyFrame(payload, payloadSize)
-        : codec::Vp8Header::isKeyFrame(payload, codec::Vp8Header::getPayloadDescriptorSize(payload, payloadSize));
+    const bool isKeyFrame = _metadata.isKeyFrame;
 
     const auto ssrc = rtpHeader->ssrc.get();
     if (ssrc != _outboundContext.getOriginalSsrc())
@@ -4,7 +4,7 @@
 #include "bridge/engine/PliScheduler.h"
 #include "bridge/engine/VideoMissingPacketsTracker.h"
 #include "codec/AudioReceivePipeline.h"
-#include "codec/OpusDecoder.h"
+#include "codec/OpusCodecPool.h"
 #include "jobmanager/JobQueue.h"
 #include "transport/RtcTransport.h"
 #include "utils/Optional.h"
@@ -54,6 +54,7 @@ class SsrcInboundContext
           isSsrcUsed(true),
           endpointIdHash(sender ? sender->getEndpointIdHash() : 0),
           shouldDropPackets(false),
+          missingPacketsProcessTime(0),
           hasAudioLevelExtension(true),
           opusDecodePacketRate(0),
           hasAudioReceivePipe(false),
@@ -114,7 +115,7 @@ public:
     uint32_t lastUnprotectedExtendedSequenceNumber;
     uint32_t rocOffset; // srtp packets with roc=0 were lost
     std::shared_ptr<VideoMissingPacketsTracker> videoMissingPacketsTracker;
-    std::unique_ptr<codec::OpusDecoder> opusDecoder; // used for missing audio level
+    codec::OpusCodecPool::DecoderPtr opusDecoder; // used for missing audio level
     std::unique_ptr<utils::AvgRateTracker> opusPacketRate; // pkt/s
 
     // engine variables ==============================================
@@ -128,6 +129,9 @@ public:
     /** If an inbound stream is considered unstable, we can, in a simulcast scenario, decide to drop an inbound stream
      * early to avoid toggling between quality levels. If this is set to true, all incoming packets will be dropped. */
     std::atomic_bool shouldDropPackets;
+    // When videoMissingPacketsTracker has NACKs due, 0 if nothing is missing. Set by transport, taken by engine when it
+    // posts ProcessMissingVideoPacketsJob.
+    std::atomic_uint64_t missingPacketsProcessTime;
     std::atomic_bool hasAudioLevelExtension;
     std::atomic<double> opusDecodePacketRate;
 
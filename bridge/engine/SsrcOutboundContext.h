@@ -1,8 +1,9 @@
 #pragma once
 
 #include "bridge/RtpMap.h"
-#include "codec/OpusEncoder.h"
+#include "codec/OpusCodecPool.h"
 #include "memory/PacketPoolAllocator.h"
+#include "rtp/FlexFecEncoder.h"
 #include "utils/Optional.h"
 #include "utils/Time.h"
 #include <atomic>
@@ -42,6 +43,8 @@ public:
           lastSendTime(utils::Time::getAbsoluteTime()),
           markedForDeletion(false),
           recordingOutboundDecommissioned(false),
+          reportedFractionLost(0),
+          fecSsrc(0),
           _originalSsrc(~0u)
     {
     }
@@ -73,7 +76,8 @@ public:
     const bridge::RtpMap& telephoneEventRtpMap;
 
     // the following are access only from Transport Jobs
-    std::unique_ptr<codec::OpusEncoder> opusEncoder;
+    codec::OpusCodecPool::EncoderPtr opusEncoder;
+    std::unique_ptr<rtp::FlexFecEncoder> fecEncoder;
 
     bool needsKeyframe;
     uint32_t lastKeyFrameSequenceNumber;
@@ -95,6 +99,12 @@ public:
     // Retain rec OutboundSsrc before marking for deletion to sustain retransmissions longer.
     bool recordingOutboundDecommissioned;
 
+    /// ==== both Engine and Transport
+    // Latest RTCP fraction lost (0-255) reported by the receiver of this ssrc
+    std::atomic_uint8_t reportedFractionLost;
+    // FlexFEC repair ssrc announced to the receiver as FEC-FR, 0 if none. Set by Engine for rewritten video ssrcs.
+    std::atomic_uint32_t fecSsrc;
+
 private:
     void doRtpHeaderExtensionRewriteForAudio(rtp::RtpHeader& rtpHeader,
         const bridge::SsrcInboundContext& senderInboundContext);
@@ -1,8 +1,6 @@
 #include "bridge/engine/VideoForwarderReceiveJob.h"
 #include "bridge/engine/EngineMixer.h"
 #include "bridge/engine/SendPliJob.h"
-#include "codec/H264Header.h"
-#include "codec/Vp8Header.h"
 #include "logger/Logger.h"
 #include "memory/Packet.h"
 #include "memory/PacketPoolAllocator.h"
@@ -61,11 +59,8 @@ void VideoForwarderReceiveJob::run()
     }
 
     const auto sequenceNumber = rtpHeader->sequenceNumber.get();
-    const auto payload = rtpHeader->getPayload();
-    const auto payloadSize = _packet->getLength() - rtpHeader->headerLength();
-    const auto isKeyFrame = _ssrcContext.rtpMap.format == RtpMap::Format::H264
-        ? codec::H264Header::isKeyFrame(payload, payloadSize)
-        : codec::Vp8Header::isKeyFrame(payload, codec::Vp8Header::getPayloadDescriptorSize(payload, payloadSize));
+    const auto metadata = InboundPacketMetadata::fromVideoPacket(*_packet, _ssrcContext.rtpMap.format);
+    const bool isKeyFrame = metadata.isKeyFrame;
 
     if (!_ssrcContext.videoMissingPacketsTracker)
     {
@@ -184,10 +179,15 @@ void VideoForwarderReceiveJob::run()
         }
 
         _ssrcContext.lastReceivedExtendedSequenceNumber = _extendedSequenceNumber;
+        _ssrcContext.missingPacketsProcessTime =
+            _ssrcContext.videoMissingPacketsTracker->getNextProcessTime(_sender->getRtt());
     }
 
     assert(rtpHeader->payloadType == utils::checkedCast<uint16_t>(_ssrcContext.rtpMap.payloadType));
-    _engineMixer.onForwarderVideoRtpPacketDecrypted(_ssrcContext, std::move(_packet), _extendedSequenceNumber);
+    _engineMixer.onForwarderVideoRtpPacketDecrypted(_ssrcContext,
+        std::move(_packet),
+        _extendedSequenceNumber,
+        metadata);
 }
 
 } // namespace bridge
@@ -1,10 +1,10 @@
 #include "bridge/engine/VideoForwarderRewriteAndSendJob.h"
 #include "bridge/MixerManagerAsync.h"
+#include "bridge/engine/EngineMixer.h"
 #include "bridge/engine/PacketCache.h"
 #include "bridge/engine/SsrcInboundContext.h"
 #include "bridge/engine/SsrcOutboundContext.h"
-#include "codec/H264Header.h"
-#include "codec/Vp8Header.h"
+#include "config/Config.h"
 #include "transport/Transport.h"
 #include "utils/Function.h"
 
@@ -16,6 +16,7 @@ VideoForwarderRewriteAndSendJob::VideoForwarderRewriteAndSendJob(SsrcOutboundCon
     memory::UniquePacket packet,
     transport::Transport& transport,
     const uint32_t extendedSequenceNumber,
+    const InboundPacketMetadata& metadata,
     MixerManagerAsync& mixerManager,
     size_t endpointIdHash,
     EngineMixer& mixer,
@@ -26,6 +27,7 @@ VideoForwarderRewriteAndSendJob::VideoForwarderRewriteAndSendJob(SsrcOutboundCon
       _packet(std::move(packet)),
       _transport(transport),
       _extendedSequenceNumber(extendedSequenceNumber),
+      _metadata(metadata),
       _mixerManager(mixerManager),
       _endpointIdHash(endpointIdHash),
       _mixer(mixer),
@@ -65,11 +67,7 @@ void VideoForwarderRewriteAndSendJob::run()
         _mixerManager.asyncAllocateVideoPacketCache(_mixer, _outboundContext.ssrc, _endpointIdHash);
     }
 
-    const auto payloadSize = _packet->getLength() - rtpHeader->headerLength();
-    const auto payload = rtpHeader->getPayload();
-    const auto isKeyFrame = _outboundContext.rtpMap.format == RtpMap::Format::H264
-        ? codec::H264Header::isKeyFrame(payload, payloadSize)
-        : codec::Vp8Header::isKeyFrame(payload, codec::Vp8Header::getPayloadDescriptorSize(payload, payloadSize));
+    const bool isKeyFrame = _metadata.isKeyFrame;
 
     const auto ssrc = rtpHeader->ssrc.get();
     if (ssrc != _outboundContext.getOriginalSsrc())
@@ -134,7 +132,39 @@ void VideoForwarderRewriteAndSendJob::run()
         }
     }
 
+    auto repairPacket = protectWithFec();
     _transport.protectAndSend(std::move(_packet));
+    if (repairPacket)
+    {
+        _transport.protectAndSend(std::move(repairPacket));
+    }
+}
+
+memory::UniquePacket VideoForwarderRewriteAndSendJob::protectWithFec()
+{
+    const auto& fecConfig = _mixer.getConfig().flexfec;
+    const uint32_t fecSsrc = _outboundContext.fecSsrc.load();
+    if (!fecConfig.enable || fecSsrc == 0)
+    {
+        return nullptr;
+    }
+
+    const auto fractionLost = _outboundContext.reportedFractionLost.load();
+    if (!_outboundContext.fecEncoder)
+    {
+        if (fractionLost == 0)
+        {
+            return nullptr;
+        }
+
+        _outboundContext.fecEncoder = std::make_unique<rtp::FlexFecEncoder>(fecSsrc,
+            _outboundContext.ssrc,
+            fecConfig.payloadType,
+            fecConfig.minGroupSize);
+    }
+
+    _outboundContext.fecEncoder->onReportedLoss(fractionLost);
+    return _outboundContext.fecEncoder->addPacket(*_packet, _outboundContext.allocator);
 }
 
 } // namespace bridge
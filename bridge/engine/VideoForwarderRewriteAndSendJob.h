@@ -1,5 +1,6 @@
 #pragma once
 
+#include "bridge/engine/InboundPacketMetadata.h"
 #include "jobmanager/Job.h"
 #include "memory/PacketPoolAllocator.h"
 
@@ -23,6 +24,7 @@ public:
         memory::UniquePacket packet,
         transport::Transport& transport,
         const uint32_t extendedSequenceNumber,
+        const InboundPacketMetadata& metadata,
         MixerManagerAsync& mixerManager,
         size_t endpointIdHash,
         EngineMixer& mixer,
@@ -31,11 +33,14 @@ public:
     void run() override;
 
 private:
+    memory::UniquePacket protectWithFec();
+
     SsrcOutboundContext& _outboundContext;
     SsrcInboundContext& _senderInboundContext;
     memory::UniquePacket _packet;
     transport::Transport& _transport;
     uint32_t _extendedSequenceNumber;
+    const InboundPacketMetadata _metadata;
     MixerManagerAsync& _mixerManager;
     size_t _endpointIdHash;
     EngineMixer& _mixer;
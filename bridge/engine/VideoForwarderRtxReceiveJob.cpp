@@ -82,7 +82,11 @@ void VideoForwarderRtxReceiveJob::run()
         return;
     }
 
-    _engineMixer.onForwarderVideoRtpPacketDecrypted(_mainSsrcContext, std::move(_packet), extendedSequenceNumber);
+    const auto metadata = InboundPacketMetadata::fromVideoPacket(*_packet, _mainSsrcContext.rtpMap.format);
+    _engineMixer.onForwarderVideoRtpPacketDecrypted(_mainSsrcContext,
+        std::move(_packet),
+        extendedSequenceNumber,
+        metadata);
 }
 
 } // namespace bridge
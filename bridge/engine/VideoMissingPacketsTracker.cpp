@@ -19,6 +19,15 @@ namespace bridge
 {
 const uint64_t delayFirstNack = 30 * utils::Time::ms;
 
+namespace
+{
+// Add 10 ms, since incoming packets are processed with 10 ms intervals in EngineMixer
+uint64_t getRetryDelay(const uint32_t rttNs)
+{
+    return std::max(rttNs + 10 * utils::Time::ms, 100 * utils::Time::ms);
+}
+} // namespace
+
 VideoMissingPacketsTracker::VideoMissingPacketsTracker()
     : _loggableId("VideoMissingPacketsTracker")
 #if DEBUG
@@ -88,8 +97,7 @@ size_t VideoMissingPacketsTracker::process(const uint64_t timestamp,
 
     size_t missingCount = 0;
 
-    // Add 10 ms, since incoming packets are processed with 10 ms intervals in EngineMixer
-    const uint64_t retryDelay = std::max(rttNs + 10 * utils::Time::ms, 100 * utils::Time::ms);
+    const uint64_t retryDelay = getRetryDelay(rttNs);
 
     for (auto& entryIt : _missingPackets)
     {
@@ -119,4 +127,35 @@ size_t VideoMissingPacketsTracker::process(const uint64_t timestamp,
     return missingCount;
 }
 
+uint64_t VideoMissingPacketsTracker::getNextProcessTime(const uint32_t rttNs) const
+{
+    const uint64_t retryDelay = getRetryDelay(rttNs);
+
+    uint64_t nextProcessTime = 0;
+    bool hasMissingPackets = false;
+    for (const auto& entryIt : _missingPackets)
+    {
+        const auto& entry = entryIt.second;
+        // process requires the delays to be exceeded
+        uint64_t dueTime = entry.timestamp + delayFirstNack + 1;
+        const uint64_t retryTime = entry.lastSentNackTimestamp + retryDelay + 1;
+        if (utils::Time::diffGT(dueTime, retryTime, 0))
+        {
+            dueTime = retryTime;
+        }
+
+        if (!hasMissingPackets || utils::Time::diffLT(nextProcessTime, dueTime, 0))
+        {
+            nextProcessTime = dueTime;
+            hasMissingPackets = true;
+        }
+    }
+
+    if (hasMissingPackets && nextProcessTime == 0)
+    {
+        return 1;
+    }
+    return nextProcessTime;
+}
+
 } // namespace bridge
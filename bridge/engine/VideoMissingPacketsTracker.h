@@ -25,6 +25,9 @@ public:
         const uint32_t rttNs,
         std::array<uint16_t, maxMissingPackets>& outMissingSequenceNumbers);
 
+    // Earliest time process will send a NACK, 0 if no packets are missing
+    uint64_t getNextProcessTime(const uint32_t rttNs) const;
+
 private:
     static const uint32_t maxRetries = 4;
 
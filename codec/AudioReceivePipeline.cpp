@@ -45,12 +45,14 @@ AudioReceivePipeline::ReceiveBox::~ReceiveBox()
 AudioReceivePipeline::AudioReceivePipeline(uint32_t rtpFrequency,
     uint32_t ptime,
     uint32_t maxPackets,
-    int audioLevelExtensionId)
+    int audioLevelExtensionId,
+    OpusCodecPool::DecoderPtr decoder)
     : _ssrc(0),
       _rtpFrequency(rtpFrequency),
       _samplesPerPacket(ptime * rtpFrequency / 1000),
       _estimator(rtpFrequency),
       _audioLevelExtensionId(audioLevelExtensionId),
+      _decoder(decoder ? std::move(decoder) : OpusCodecPool::DecoderPtr(new OpusDecoder())),
       _targetDelay(0),
       _bufferAtTwoFrames(0),
       _pcmData(7 * _config.channels * _samplesPerPacket, _config.channels * _samplesPerPacket),
@@ -85,16 +87,16 @@ size_t AudioReceivePipeline::decodePacket(uint32_t extendedSequenceNumber,
     const auto header = rtp::RtpHeader::fromPacket(packet);
     const int16_t* originalAudioStart = audioData;
 
-    if (_decoder.hasDecoded() && extendedSequenceNumber != _decoder.getExpectedSequenceNumber())
+    if (_decoder->hasDecoded() && extendedSequenceNumber != _decoder->getExpectedSequenceNumber())
     {
-        const int32_t lossCount = static_cast<int32_t>(extendedSequenceNumber - _decoder.getExpectedSequenceNumber());
+        const int32_t lossCount = static_cast<int32_t>(extendedSequenceNumber - _decoder->getExpectedSequenceNumber());
         if (lossCount <= 0)
         {
             logger::debug("%u Old opus packet sequence %u expected %u, discarding",
                 "AudioReceivePipeline",
                 _ssrc,
                 extendedSequenceNumber,
-                _decoder.getExpectedSequenceNumber());
+                _decoder->getExpectedSequenceNumber());
             return 0;
         }
 
@@ -102,12 +104,12 @@ size_t AudioReceivePipeline::decodePacket(uint32_t extendedSequenceNumber,
             "AudioReceivePipeline",
             _ssrc,
             extendedSequenceNumber,
-            _decoder.getExpectedSequenceNumber());
+            _decoder->getExpectedSequenceNumber());
 
-        const auto concealCount = std::min(2u, extendedSequenceNumber - _decoder.getExpectedSequenceNumber() - 1);
+        const auto concealCount = std::min(2u, extendedSequenceNumber - _decoder->getExpectedSequenceNumber() - 1);
         for (uint32_t i = 0; concealCount > 1 && i < concealCount - 1; ++i)
         {
-            const auto decodedFrames = _decoder.conceal(reinterpret_cast<uint8_t*>(audioData));
+            const auto decodedFrames = _decoder->conceal(reinterpret_cast<uint8_t*>(audioData));
             if (decodedFrames > 0)
             {
                 audioData += _config.channels * decodedFrames;
@@ -116,14 +118,14 @@ size_t AudioReceivePipeline::decodePacket(uint32_t extendedSequenceNumber,
 
         const auto opusPayloadLength = packet.getLength() - header->headerLength();
         const auto decodedFrames =
-            _decoder.conceal(header->getPayload(), opusPayloadLength, reinterpret_cast<uint8_t*>(audioData));
+            _decoder->conceal(header->getPayload(), opusPayloadLength, reinterpret_cast<uint8_t*>(audioData));
         if (decodedFrames > 0)
         {
             audioData += _config.channels * decodedFrames;
         }
     }
 
-    const auto decodedFrames = _decoder.decode(extendedSequenceNumber,
+    const auto decodedFrames = _decoder->decode(extendedSequenceNumber,
         header->getPayload(),
         packet.getLength() - header->headerLength(),
         reinterpret_cast<uint8_t*>(audioData),
@@ -484,7 +486,7 @@ void AudioReceivePipeline::process(const uint64_t timestamp)
         if (isDiscardedPacket(*packet))
         {
             decodedSamples = std::max(480u, _metrics.receivedRtpCyclesPerPacket);
-            _decoder.onUnusedPacketReceived(extendedSequenceNumber);
+            _decoder->onUnusedPacketReceived(extendedSequenceNumber);
             std::fill(audioData, std::next(audioData, decodedSamples * _config.channels), int16_t(0));
         }
         else
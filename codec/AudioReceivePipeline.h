@@ -1,6 +1,6 @@
 #pragma once
 #include "codec/NoiseFloor.h"
-#include "codec/OpusDecoder.h"
+#include "codec/OpusCodecPool.h"
 #include "codec/SpscAudioBuffer.h"
 #include "rtp/JitterBufferList.h"
 #include "rtp/JitterEstimator.h"
@@ -53,7 +53,12 @@ class AudioReceivePipeline
     const Config _config;
 
 public:
-    AudioReceivePipeline(uint32_t rtpFrequency, uint32_t ptime, uint32_t maxPackets, int audioLevelExtensionId = 255);
+    // Creates its own decoder if none is provided
+    AudioReceivePipeline(uint32_t rtpFrequency,
+        uint32_t ptime,
+        uint32_t maxPackets,
+        int audioLevelExtensionId = 255,
+        OpusCodecPool::DecoderPtr decoder = nullptr);
 
     // called from same thread context
     bool onRtpPacket(uint32_t extendedSequenceNumber, memory::UniquePacket packet, uint64_t receiveTime);
@@ -92,7 +97,7 @@ private:
     rtp::JitterEstimator _estimator;
 
     const int _audioLevelExtensionId;
-    codec::OpusDecoder _decoder;
+    OpusCodecPool::DecoderPtr _decoder;
     codec::NoiseFloor _noiseFloor;
 
     uint32_t _targetDelay;
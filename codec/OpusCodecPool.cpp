@@ -0,0 +1,104 @@
+#include "codec/OpusCodecPool.h"
+#include <algorithm>
+
+namespace codec
+{
+
+void OpusCodecPool::Recycler::operator()(OpusEncoder* encoder) const
+{
+    if (_pool)
+    {
+        _pool->recycle(encoder);
+        return;
+    }
+    delete encoder;
+}
+
+void OpusCodecPool::Recycler::operator()(OpusDecoder* decoder) const
+{
+    if (_pool)
+    {
+        _pool->recycle(decoder);
+        return;
+    }
+    delete decoder;
+}
+
+OpusCodecPool::OpusCodecPool(uint32_t warmCount, uint32_t maxCount)
+    : _idleEncoders(maxCount),
+      _idleDecoders(maxCount),
+      _hits(0),
+      _misses(0)
+{
+    for (uint32_t i = 0; i < std::min(warmCount, maxCount); ++i)
+    {
+        recycle(new OpusEncoder());
+        recycle(new OpusDecoder());
+    }
+}
+
+OpusCodecPool::~OpusCodecPool()
+{
+    for (OpusEncoder* encoder = nullptr; _idleEncoders.pop(encoder);)
+    {
+        delete encoder;
+    }
+    for (OpusDecoder* decoder = nullptr; _idleDecoders.pop(decoder);)
+    {
+        delete decoder;
+    }
+}
+
+OpusCodecPool::EncoderPtr OpusCodecPool::acquireEncoder()
+{
+    OpusEncoder* encoder = nullptr;
+    if (_idleEncoders.pop(encoder))
+    {
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        return EncoderPtr(encoder, Recycler(this));
+    }
+
+    _misses.fetch_add(1, std::memory_order_relaxed);
+    return EncoderPtr(new OpusEncoder(), Recycler(this));
+}
+
+OpusCodecPool::DecoderPtr OpusCodecPool::acquireDecoder()
+{
+    OpusDecoder* decoder = nullptr;
+    if (_idleDecoders.pop(decoder))
+    {
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        return DecoderPtr(decoder, Recycler(this));
+    }
+
+    _misses.fetch_add(1, std::memory_order_relaxed);
+    return DecoderPtr(new OpusDecoder(), Recycler(this));
+}
+
+void OpusCodecPool::recycle(OpusEncoder* encoder)
+{
+    if (!encoder)
+    {
+        return;
+    }
+
+    if (!encoder->reset() || !_idleEncoders.push(std::move(encoder)))
+    {
+        delete encoder;
+    }
+}
+
+void OpusCodecPool::recycle(OpusDecoder* decoder)
+{
+    if (!decoder)
+    {
+        return;
+    }
+
+    if (!decoder->reset() || !_idleDecoders.push(std::move(decoder)))
+    {
+        delete decoder;
+    }
+}
+
+} // namespace codec
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "codec/OpusDecoder.h"
+#include "codec/OpusEncoder.h"
+#include "concurrency/MpmcQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace codec
+{
+
+/**
+ * Idle Opus encoders and decoders handed out instead of creating new codec state on the media path.
+ * Instances are reset with OPUS_RESET_STATE when returned and kept for reuse up to maxCount per kind.
+ * Returning to a full pool destroys the instance. Thread safe. The pool must outlive all instances it hands out.
+ */
+class OpusCodecPool
+{
+public:
+    class Recycler
+    {
+    public:
+        Recycler() : _pool(nullptr) {}
+        explicit Recycler(OpusCodecPool* pool) : _pool(pool) {}
+
+        void operator()(OpusEncoder* encoder) const;
+        void operator()(OpusDecoder* decoder) const;
+
+    private:
+        OpusCodecPool* _pool;
+    };
+
+    // A default constructed Recycler deletes the instance, which allows owning codecs created outside a pool
+    using EncoderPtr = std::unique_ptr<OpusEncoder, Recycler>;
+    using DecoderPtr = std::unique_ptr<OpusDecoder, Recycler>;
+
+    OpusCodecPool(uint32_t warmCount, uint32_t maxCount);
+    ~OpusCodecPool();
+
+    EncoderPtr acquireEncoder();
+    DecoderPtr acquireDecoder();
+
+    // for instances detached from their EncoderPtr or DecoderPtr
+    void recycle(OpusEncoder* encoder);
+    void recycle(OpusDecoder* decoder);
+
+    uint64_t getHitCount() const { return _hits.load(std::memory_order_relaxed); }
+    uint64_t getMissCount() const { return _misses.load(std::memory_order_relaxed); }
+    size_t getIdleEncoderCount() const { return _idleEncoders.size(); }
+    size_t getIdleDecoderCount() const { return _idleDecoders.size(); }
+
+private:
+    concurrency::MpmcQueue<OpusEncoder*> _idleEncoders;
+    concurrency::MpmcQueue<OpusDecoder*> _idleDecoders;
+    std::atomic_uint64_t _hits;
+    std::atomic_uint64_t _misses;
+};
+
+} // namespace codec
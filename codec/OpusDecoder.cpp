@@ -38,6 +38,18 @@ OpusDecoder::~OpusDecoder()
     delete _state;
 }
 
+bool OpusDecoder::reset()
+{
+    if (!_initialized)
+    {
+        return false;
+    }
+
+    _sequenceNumber = 0;
+    _hasDecodedPacket = false;
+    return opus_decoder_ctl(_state->_state, OPUS_RESET_STATE) == OPUS_OK;
+}
+
 /** @return number of samples decoded
  * */
 int32_t OpusDecoder::decode(uint32_t extendedSequenceNumber,
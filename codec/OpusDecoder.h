@@ -15,6 +15,9 @@ public:
     bool isInitialized() const { return _initialized; }
     bool hasDecoded() const { return _hasDecodedPacket; }
 
+    // Clears the codec state and sequence tracking for reuse on a new stream
+    bool reset();
+
     uint32_t getExpectedSequenceNumber() const { return _sequenceNumber + 1; }
 
     int32_t decode(uint32_t extendedSequenceNumber,
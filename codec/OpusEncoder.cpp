@@ -36,6 +36,16 @@ OpusEncoder::~OpusEncoder()
     delete _state;
 }
 
+bool OpusEncoder::reset()
+{
+    if (!_initialized)
+    {
+        return false;
+    }
+
+    return opus_encoder_ctl(_state->_state, OPUS_RESET_STATE) == OPUS_OK;
+}
+
 int32_t OpusEncoder::encode(const int16_t* decodedData,
     const size_t frames,
     unsigned char* payloadStart,
@@ -15,6 +15,9 @@ public:
 
     bool isInitialized() const { return _initialized; }
 
+    // Clears the codec state for reuse on a new stream, keeping the encoder settings
+    bool reset();
+
     int32_t encode(const int16_t* decodedData,
         const size_t frames,
         unsigned char* payloadStart,
@@ -0,0 +1,79 @@
+#include "concurrency/CounterWait.h"
+#include "utils/Time.h"
+#include <algorithm>
+#ifndef __APPLE__
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace concurrency
+{
+
+namespace
+{
+// threads blocked in waitForZero on any counter
+std::atomic_uint32_t drainWaiters(0);
+
+#ifndef __APPLE__
+static_assert(sizeof(std::atomic_uint32_t) == sizeof(uint32_t), "futex requires a plain 32 bit word");
+
+void futexWait(std::atomic_uint32_t& counter, uint32_t expectedValue, uint64_t timeoutNs)
+{
+    struct timespec timeout;
+    timeout.tv_sec = timeoutNs / utils::Time::sec;
+    timeout.tv_nsec = timeoutNs % utils::Time::sec;
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&counter), FUTEX_WAIT_PRIVATE, expectedValue, &timeout, nullptr, 0);
+}
+
+void futexWakeAll(std::atomic_uint32_t& counter)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&counter), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+#endif
+} // namespace
+
+uint32_t decrementAndNotify(std::atomic_uint32_t& counter)
+{
+    const auto value = --counter;
+    // sequentially consistent with the waiter registering before it reads the counter
+    if (value == 0 && drainWaiters.load() > 0)
+    {
+#ifndef __APPLE__
+        futexWakeAll(counter);
+#endif
+    }
+    return value;
+}
+
+bool waitForZero(std::atomic_uint32_t& counter, const uint64_t timeoutNs)
+{
+    if (counter.load() == 0)
+    {
+        return true;
+    }
+
+    const auto timeoutAt = utils::Time::rawAbsoluteTime() + timeoutNs;
+    ++drainWaiters;
+    bool drained = true;
+    for (auto value = counter.load(); value != 0; value = counter.load())
+    {
+        const auto timeLeft = utils::Time::diff(utils::Time::rawAbsoluteTime(), timeoutAt);
+        if (timeLeft <= 0)
+        {
+            drained = false;
+            break;
+        }
+#ifdef __APPLE__
+        utils::Time::rawNanoSleep(std::min(timeLeft, static_cast<int64_t>(utils::Time::ms)));
+#else
+        // returns immediately if the counter changed since it was read
+        futexWait(counter, value, timeLeft);
+#endif
+    }
+    --drainWaiters;
+    return drained;
+}
+
+} // namespace concurrency
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace concurrency
+{
+
+/**
+ * Wait for an atomic job counter to drain without polling. Threads that decrement the counter use
+ * decrementAndNotify which wakes the waiters when the counter reaches zero. Unless some thread is waiting,
+ * the notification costs one extra load.
+ */
+uint32_t decrementAndNotify(std::atomic_uint32_t& counter);
+
+// returns false on timeout
+bool waitForZero(std::atomic_uint32_t& counter, uint64_t timeoutNs);
+
+} // namespace concurrency
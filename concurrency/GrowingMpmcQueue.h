@@ -0,0 +1,284 @@
+#pragma once
+#include "concurrency/MpmcQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+namespace concurrency
+{
+
+// Mpmc queue that starts with a small capacity and grows on demand by chaining MpmcQueue segments of doubling size
+// up to maxCapacity. Producers push to one segment at a time and only move on to the next segment when it is full, so
+// segments hold elements in push order. Producers go back to the first segment only after a consumer has found the
+// whole queue drained, which keeps FIFO order while reusing the allocated segments. Until then, space freed in earlier
+// segments is not used.
+// Segments are kept until the queue is destroyed, as producers and consumers may hold them without synchronization.
+// Push only waits while a consumer rewinds the queue and allocates only when it has to add a segment.
+template <typename T>
+class GrowingMpmcQueue
+{
+    static constexpr uint32_t maxSegments = 16;
+    static constexpr uint32_t minSegmentCapacity = 8;
+    static constexpr uint32_t rewinding = 0x80000000u;
+
+public:
+    typedef T value_type;
+
+    explicit GrowingMpmcQueue(uint32_t maxCapacity) : GrowingMpmcQueue(maxCapacity, maxCapacity) {}
+
+    GrowingMpmcQueue(uint32_t initialCapacity, uint32_t maxCapacity)
+        : _maxCapacity(maxCapacity),
+          _initialCapacity(std::min(maxCapacity, std::max(initialCapacity, minSegmentCapacity))),
+          _segmentCount(1),
+          _pushIndex(0)
+    {
+        for (auto& segment : _segments)
+        {
+            segment.store(nullptr);
+        }
+        for (auto& pushers : _pushers)
+        {
+            pushers.store(0);
+        }
+        _segments[0].store(new MpmcQueue<T>(_initialCapacity));
+    }
+
+    ~GrowingMpmcQueue()
+    {
+        for (auto& segment : _segments)
+        {
+            delete segment.load();
+        }
+    }
+
+    bool pop(T& target)
+    {
+        return pop([&target](T& item) { target = std::move(item); });
+    }
+
+    template <typename TAction>
+    bool pop(TAction&& action)
+    {
+        // Producers may fill the push segment while later segments are scanned, so the scan stops there. Elements in
+        // segments added after the push index was read are found on the next pop.
+        const uint32_t pushIndex = _pushIndex.load() & ~rewinding;
+        for (uint32_t i = 0; i <= pushIndex; ++i)
+        {
+            if (_segments[i].load(std::memory_order_acquire)->pop(action))
+            {
+                return true;
+            }
+            if (!isDrained(i))
+            {
+                return false;
+            }
+        }
+
+        if (pushIndex > 0)
+        {
+            rewind(pushIndex);
+        }
+        return false;
+    }
+
+    template <typename... U>
+    bool push(U&&... args)
+    {
+        for (;;)
+        {
+            // a rewind only holds the index while it checks that the segments are drained
+            const uint32_t pushIndex = _pushIndex.load();
+            if (pushIndex & rewinding)
+            {
+                continue;
+            }
+
+            auto& pushers = _pushers[pushIndex];
+            ++pushers;
+            if (_pushIndex.load() != pushIndex)
+            {
+                --pushers;
+                continue;
+            }
+
+            const bool pushed = _segments[pushIndex].load(std::memory_order_acquire)->push(std::forward<U>(args)...);
+            --pushers;
+            if (pushed)
+            {
+                return true;
+            }
+
+            if (!advance(pushIndex))
+            {
+                return false;
+            }
+        }
+    }
+
+    // will return correct size if queue is not in motion.
+    size_t size() const
+    {
+        size_t count = 0;
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < segmentCount; ++i)
+        {
+            count += _segments[i].load(std::memory_order_acquire)->size();
+        }
+        return count;
+    }
+
+    bool empty() const
+    {
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < segmentCount; ++i)
+        {
+            if (!_segments[i].load(std::memory_order_acquire)->empty())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool full() const
+    {
+        if (allocatedCapacity() < _maxCapacity)
+        {
+            return false;
+        }
+
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < segmentCount; ++i)
+        {
+            if (!_segments[i].load(std::memory_order_acquire)->full())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void clear()
+    {
+        if (!empty())
+        {
+            T elem;
+            while (pop(elem))
+                ;
+        }
+    }
+
+    // max number of elements the queue can grow to
+    uint32_t capacity() const { return _maxCapacity; }
+
+    uint32_t allocatedCapacity() const
+    {
+        uint32_t allocated = 0;
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < segmentCount; ++i)
+        {
+            allocated += _segments[i].load(std::memory_order_acquire)->capacity();
+        }
+        return allocated;
+    }
+
+    size_t getAllocatedBytes() const
+    {
+        size_t bytes = 0;
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < segmentCount; ++i)
+        {
+            bytes += _segments[i].load(std::memory_order_acquire)->getAllocatedBytes();
+        }
+        return bytes;
+    }
+
+private:
+    // Moves producers from the full segment at pushIndex to the next segment, adding it if needed.
+    // @return false if the queue is full
+    bool advance(uint32_t pushIndex)
+    {
+        const uint32_t next = pushIndex + 1;
+        if (next >= _segmentCount.load(std::memory_order_acquire) && !grow(next))
+        {
+            // the last segment is full, unless the queue has been rewound meanwhile
+            return (_pushIndex.load() & ~rewinding) != pushIndex;
+        }
+
+        _pushIndex.compare_exchange_strong(pushIndex, next);
+        return true;
+    }
+
+    // Sends producers back to the first segment once every segment has drained. The index is marked while the
+    // segments are checked, so no producer can start a push to a segment that is about to be left behind.
+    void rewind(const uint32_t pushIndex)
+    {
+        uint32_t expected = pushIndex;
+        if (!_pushIndex.compare_exchange_strong(expected, pushIndex | rewinding))
+        {
+            return;
+        }
+
+        for (uint32_t i = 0; i <= pushIndex; ++i)
+        {
+            if (!isDrained(i))
+            {
+                _pushIndex = pushIndex;
+                return;
+            }
+        }
+        _pushIndex = 0;
+    }
+
+    // A segment that fails to pop while a producer is still committing to it may hold elements older than those in
+    // later segments.
+    bool isDrained(uint32_t index) const
+    {
+        return _pushers[index].load() == 0 && _segments[index].load(std::memory_order_acquire)->empty();
+    }
+
+    // Adds a segment after segmentCount segments unless another thread already did.
+    // @return false if queue has reached max capacity
+    bool grow(uint32_t segmentCount)
+    {
+        if (_segmentCount.load(std::memory_order_acquire) > segmentCount)
+        {
+            return true;
+        }
+
+        uint32_t allocated = 0;
+        for (uint32_t i = 0; i < segmentCount; ++i)
+        {
+            allocated += _segments[i].load(std::memory_order_acquire)->capacity();
+        }
+
+        if (allocated >= _maxCapacity || segmentCount >= maxSegments)
+        {
+            return false;
+        }
+
+        const uint32_t remaining = _maxCapacity - allocated;
+        uint32_t segmentCapacity = (segmentCount + 1 == maxSegments ? remaining : std::min(allocated, remaining));
+        segmentCapacity = std::max(segmentCapacity, minSegmentCapacity);
+
+        auto* segment = new MpmcQueue<T>(segmentCapacity);
+        MpmcQueue<T>* expected = nullptr;
+        if (!_segments[segmentCount].compare_exchange_strong(expected, segment))
+        {
+            delete segment;
+        }
+
+        _segmentCount.compare_exchange_strong(segmentCount, segmentCount + 1);
+        return true;
+    }
+
+    const uint32_t _maxCapacity;
+    const uint32_t _initialCapacity;
+
+    std::atomic<MpmcQueue<T>*> _segments[maxSegments];
+    std::atomic_uint32_t _segmentCount;
+    std::atomic_uint32_t _pushIndex; // segment producers push to
+    std::atomic_uint32_t _pushers[maxSegments]; // producers currently pushing to each segment
+};
+
+} // namespace concurrency
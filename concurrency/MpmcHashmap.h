@@ -30,6 +30,7 @@ public:
 
     uint32_t removeNext(uint32_t index, uint32_t& position);
     size_t capacity() const { return _index.size(); }
+    size_t getAllocatedBytes() const { return _index.size() * sizeof(Entry); }
 
     // not thread safe
     void reInitialize();
@@ -80,6 +81,9 @@ private:
 // slot is recycled or hashmap is destroyed. This is to reduce risk of
 // bad access when items are removed.
 // If key type or value type requires heap alloc construction, it is no longer wait free
+// The map can start with a smaller initial capacity. It will then grow by chaining segments of doubling size
+// up to maxElements. Segments are not released until the map is destroyed so element addresses remain stable.
+// Growing allocates memory and is not wait-free. Same key must not be emplaced concurrently while the map grows.
 template <typename KeyT, typename T>
 class MpmcHashmap32
 {
@@ -105,6 +109,50 @@ class MpmcHashmap32
         std::pair<KeyT, T> element;
     };
 
+    struct Segment
+    {
+        explicit Segment(uint32_t capacity_) : end(0), count(0), capacity(capacity_), index(capacity_ * 4)
+        {
+            void* mem = memory::page::allocate(memory::page::alignedSpace(capacity * sizeof(Entry)));
+
+            elements = reinterpret_cast<Entry*>(mem);
+            assert(memory::isAligned<std::max_align_t>(elements));
+
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                elements[i].state = State::empty;
+                freeItems.push(&elements[i]);
+            }
+        }
+
+        ~Segment()
+        {
+            for (size_t i = 0; i < end.load(); ++i)
+            {
+                if (elements[i].state.load() != State::empty)
+                {
+                    elements[i].~Entry();
+                }
+            }
+
+            memory::page::free(elements, memory::page::alignedSpace(capacity * sizeof(Entry)));
+        }
+
+        size_t getAllocatedBytes() const
+        {
+            return memory::page::alignedSpace(capacity * sizeof(Entry)) + index.getAllocatedBytes();
+        }
+
+        Entry* elements;
+        std::atomic_uint32_t end;
+        std::atomic_uint32_t count; // lets lookups skip segments that hold no elements
+        const uint32_t capacity;
+        MurmurHashIndex index;
+        LockFreeList freeItems;
+    };
+
+    static constexpr uint32_t maxSegments = 16;
+
 public:
     template <typename ValueType>
     class IterBase
@@ -116,22 +164,40 @@ public:
         using pointer = ValueType*;
         using reference = ValueType&;
 
-        IterBase(Entry* entries, uint32_t pos, uint32_t endPos) : _elements(entries), _pos(pos), _end(endPos) {}
-        IterBase(const IterBase& it) : _elements(it._elements), _pos(it._pos), _end(it._end) {}
+        IterBase(const MpmcHashmap32* map,
+            uint32_t segment,
+            uint32_t segmentCount,
+            Entry* entries,
+            uint32_t pos,
+            uint32_t endPos)
+            : _map(map),
+              _segment(segment),
+              _segmentCount(segmentCount),
+              _elements(entries),
+              _pos(pos),
+              _end(endPos)
+        {
+        }
+
+        IterBase(const IterBase& it)
+            : _map(it._map),
+              _segment(it._segment),
+              _segmentCount(it._segmentCount),
+              _elements(it._elements),
+              _pos(it._pos),
+              _end(it._end)
+        {
+        }
 
         IterBase& operator++()
         {
-            if (_pos == _end)
+            if (isEnd())
             {
                 return *this; // cannot advance a logical end iterator
             }
 
             ++_pos;
-            while (_pos != _end && _elements[_pos].state.load() != State::committed)
-            {
-                ++_pos;
-            }
-
+            seekCommitted();
             return *this;
         }
 
@@ -155,19 +221,49 @@ public:
         ValueType* operator->() { return &_elements[_pos].element; }
         const ValueType& operator*() const { return _elements[_pos].element; }
         const ValueType* operator->() const { return &_elements[_pos].element; }
-        bool operator==(const IterBase& it) const { return _pos == it._pos || (isEnd() && it.isEnd()); }
 
-        bool operator!=(const IterBase& it) const
+        bool operator==(const IterBase& it) const
         {
-            if (!isEnd() && !it.isEnd())
+            if (isEnd() || it.isEnd())
             {
-                return _pos != it._pos;
+                return isEnd() && it.isEnd();
             }
-            return isEnd() != it.isEnd();
+            return _segment == it._segment && _pos == it._pos;
         }
 
+        bool operator!=(const IterBase& it) const { return !(*this == it); }
+
     private:
-        bool isEnd() const { return _pos == _end; }
+        friend class MpmcHashmap32;
+
+        bool isEnd() const { return _pos == _end && _segment + 1 >= _segmentCount; }
+
+        // moves to next committed entry, possibly in a later segment
+        void seekCommitted()
+        {
+            for (;;)
+            {
+                while (_pos != _end && _elements[_pos].state.load() != State::committed)
+                {
+                    ++_pos;
+                }
+
+                if (_pos != _end || _segment + 1 >= _segmentCount)
+                {
+                    return;
+                }
+
+                ++_segment;
+                const auto* segment = _map->_segments[_segment].load(std::memory_order_acquire);
+                _elements = segment->elements;
+                _pos = 0;
+                _end = segment->end.load(std::memory_order_acquire);
+            }
+        }
+
+        const MpmcHashmap32* _map;
+        uint32_t _segment;
+        uint32_t _segmentCount;
         Entry* _elements;
         uint32_t _pos;
         uint32_t _end;
@@ -178,39 +274,29 @@ public:
     typedef std::pair<KeyT, T> value_type;
     using PointerType = typename std::conditional<std::is_pointer<T>::value, T, std::remove_reference_t<T>*>::type;
 
-    explicit MpmcHashmap32(size_t maxElements) : _end(0), _capacity(maxElements), _index(maxElements * 4)
+    explicit MpmcHashmap32(size_t maxElements) : MpmcHashmap32(maxElements, maxElements) {}
+
+    MpmcHashmap32(size_t initialElements, size_t maxElements)
+        : _capacity(maxElements),
+          _initialCapacity(std::max(size_t(1), std::min(initialElements, maxElements))),
+          _segmentCount(0)
     {
-        if (_capacity == 0)
+        for (auto& segment : _segments)
         {
-            _elements = nullptr;
-            return;
+            segment.store(nullptr);
         }
 
-        void* mem = memory::page::allocate(memory::page::alignedSpace(_capacity * sizeof(Entry)));
-
-        _elements = reinterpret_cast<Entry*>(mem);
-        assert(memory::isAligned<std::max_align_t>(_elements));
-
-        for (size_t i = 0; i < _capacity; ++i)
+        if (_capacity > 0)
         {
-            _elements[i].state = State::empty;
-            _freeItems.push(&_elements[i]);
+            grow(0);
         }
     }
 
     ~MpmcHashmap32()
     {
-        for (size_t i = 0; i < _end.load(); ++i)
-        {
-            if (_elements[i].state.load() != State::empty)
-            {
-                _elements[i].~Entry();
-            }
-        }
-
-        if (_capacity)
+        for (auto& segment : _segments)
         {
-            memory::page::free(_elements, memory::page::alignedSpace(_capacity * sizeof(Entry)));
+            delete segment.load();
         }
     }
 
@@ -225,78 +311,113 @@ public:
             }
         }
 
-        Entry* reusedEntry = nullptr;
-        ListItem* listItem = nullptr;
-        if (_freeItems.pop(listItem))
+        for (uint32_t i = 0;; ++i)
         {
-            reusedEntry = reinterpret_cast<Entry*>(listItem);
+            if (i >= _segmentCount.load(std::memory_order_acquire) && !grow(i))
+            {
+                return std::make_pair(end(), false);
+            }
+
+            auto* segment = _segments[i].load(std::memory_order_acquire);
+            ListItem* listItem = nullptr;
+            if (!segment->freeItems.pop(listItem))
+            {
+                continue;
+            }
+
+            auto* reusedEntry = reinterpret_cast<Entry*>(listItem);
             auto state = reusedEntry->state.load();
             if (state == State::empty)
             {
-                _end.fetch_add(1);
+                segment->end.fetch_add(1);
             }
             else if (state == State::tombstone)
             {
                 reusedEntry->~Entry();
             }
-        }
-        else
-        {
-            return std::make_pair(end(), false);
-        }
 
-        const uint32_t pos = std::distance(_elements, reinterpret_cast<Entry*>(reusedEntry));
-        auto entry = new (reusedEntry) Entry(key, std::forward<Args>(args)...);
-        entry->state.store(State::committed);
-        if (!_index.add(utils::hash<KeyT>{}(key), pos + 1))
-        {
-            // index must be full or duplicate key
-            entry->state.store(State::tombstone);
-            _freeItems.push(entry);
+            const uint32_t pos = std::distance(segment->elements, reusedEntry);
+            auto entry = new (reusedEntry) Entry(key, std::forward<Args>(args)...);
+            entry->state.store(State::committed);
+            segment->count.fetch_add(1);
+            if (!segment->index.add(utils::hash<KeyT>{}(key), pos + 1))
+            {
+                // index must be full or duplicate key
+                segment->count.fetch_sub(1);
+                entry->state.store(State::tombstone);
+                segment->freeItems.push(entry);
 
-            auto existingIt = find(key);
-            return std::make_pair(existingIt, false);
-        }
+                auto existingIt = find(key);
+                return std::make_pair(existingIt, false);
+            }
 
-        return std::make_pair(iterator(_elements, pos, pos + 1), true);
+            return std::make_pair(iterator(this, i, i + 1, segment->elements, pos, pos + 1), true);
+        }
     }
 
     bool erase(const KeyT& key)
     {
         const uint64_t key64 = utils::hash<KeyT>{}(key);
-        uint32_t pos = 0;
-        if (!_index.get(key64, pos))
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < segmentCount; ++i)
         {
+            auto* segment = _segments[i].load(std::memory_order_acquire);
+            uint32_t pos = 0;
+            if (segment->count.load() == 0 || !segment->index.get(key64, pos))
+            {
+                continue;
+            }
+            assert(pos > 0);
+
+            if (segment->index.remove(key64))
+            {
+                segment->count.fetch_sub(1);
+                --pos;
+                segment->elements[pos].state.store(State::tombstone);
+                segment->freeItems.push(&segment->elements[pos]);
+                return true;
+            }
+
             return false;
         }
-        assert(pos > 0);
 
-        if (_index.remove(key64))
+        return false;
+    }
+
+    bool contains(const KeyT& key) const
+    {
+        const uint64_t key64 = utils::hash<KeyT>{}(key);
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < segmentCount; ++i)
         {
-            --pos;
-            _elements[pos].state.store(State::tombstone);
-            _freeItems.push(&_elements[pos]);
-            return true;
+            const auto* segment = _segments[i].load(std::memory_order_acquire);
+            if (segment->count.load() != 0 && segment->index.containsKey(key64))
+            {
+                return true;
+            }
         }
-
         return false;
     }
 
-    bool contains(const KeyT& key) const { return _index.containsKey(utils::hash<KeyT>{}(key)); }
-
     iterator find(const KeyT& key)
     {
-        uint32_t pos = 0;
-        if (_index.get(utils::hash<KeyT>{}(key), pos))
+        const uint64_t key64 = utils::hash<KeyT>{}(key);
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < segmentCount; ++i)
         {
-            --pos;
-            if (_elements[pos].state.load() == State::committed)
-            {
-                return iterator(_elements, pos, pos + 1);
-            }
-            else
+            auto* segment = _segments[i].load(std::memory_order_acquire);
+            uint32_t pos = 0;
+            if (segment->count.load() != 0 && segment->index.get(key64, pos))
             {
-                return end();
+                --pos;
+                if (segment->elements[pos].state.load() == State::committed)
+                {
+                    return iterator(this, i, i + 1, segment->elements, pos, pos + 1);
+                }
+                else
+                {
+                    return end();
+                }
             }
         }
         return end();
@@ -312,78 +433,135 @@ public:
     // concurrent version
     void clear()
     {
-        for (size_t i = 0; i < _index.capacity();)
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t s = 0; s < segmentCount; ++s)
         {
-            uint32_t pos;
-            i = _index.removeNext(i, pos);
-            if (pos != 0)
+            auto* segment = _segments[s].load(std::memory_order_acquire);
+            for (size_t i = 0; i < segment->index.capacity();)
             {
-                --pos;
-                _elements[pos].state.store(State::tombstone);
-                _freeItems.push(&_elements[pos]);
+                uint32_t pos;
+                i = segment->index.removeNext(i, pos);
+                if (pos != 0)
+                {
+                    segment->count.fetch_sub(1);
+                    --pos;
+                    segment->elements[pos].state.store(State::tombstone);
+                    segment->freeItems.push(&segment->elements[pos]);
+                }
             }
         }
     }
 
-    // not thread safe
+    // not thread safe. Allocated segments are kept.
     void reInitialize()
     {
-        _index.reInitialize();
-        ListItem* item = nullptr;
-        while (_freeItems.pop(item))
-        {
-        }
-
-        for (size_t i = 0; i < _capacity; ++i)
+        const uint32_t segmentCount = _segmentCount.load();
+        for (uint32_t s = 0; s < segmentCount; ++s)
         {
-            if (_elements[i].state.load() != State::empty)
+            auto* segment = _segments[s].load();
+            segment->index.reInitialize();
+            segment->count.store(0);
+            ListItem* item = nullptr;
+            while (segment->freeItems.pop(item))
             {
-                _elements[i].~Entry();
             }
 
-            _elements[i].state.store(State::empty);
-            _freeItems.push(&_elements[i]);
+            for (size_t i = 0; i < segment->capacity; ++i)
+            {
+                if (segment->elements[i].state.load() != State::empty)
+                {
+                    segment->elements[i].~Entry();
+                }
+
+                segment->elements[i].state.store(State::empty);
+                segment->freeItems.push(&segment->elements[i]);
+            }
+            segment->end = 0;
         }
-        _end = 0;
     }
 
+    // max number of elements the map can grow to
     size_t capacity() const { return _capacity; }
-    size_t size() const { return _capacity - _freeItems.size(); }
-    bool empty() const { return _capacity == _freeItems.size(); }
 
-    const_iterator cbegin() const
+    size_t allocatedCapacity() const
+    {
+        size_t allocated = 0;
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < segmentCount; ++i)
+        {
+            allocated += _segments[i].load(std::memory_order_acquire)->capacity;
+        }
+        return allocated;
+    }
+
+    size_t getAllocatedBytes() const
+    {
+        size_t bytes = 0;
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < segmentCount; ++i)
+        {
+            bytes += _segments[i].load(std::memory_order_acquire)->getAllocatedBytes();
+        }
+        return bytes;
+    }
+
+    size_t size() const
     {
-        uint32_t first = 0;
-        const uint32_t theEnd = _end.load(std::memory_order_acquire);
-        while (first != theEnd && _elements[first].state.load() != State::committed)
+        size_t count = 0;
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < segmentCount; ++i)
         {
-            ++first;
+            const auto* segment = _segments[i].load(std::memory_order_acquire);
+            count += segment->capacity - segment->freeItems.size();
         }
-        return const_iterator(_elements, first, theEnd);
+        return count;
     }
 
-    const_iterator cend() const
+    bool empty() const
     {
-        const uint32_t currentEnd = _end.load(std::memory_order_acquire);
-        return const_iterator(_elements, currentEnd, currentEnd);
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < segmentCount; ++i)
+        {
+            const auto* segment = _segments[i].load(std::memory_order_acquire);
+            if (segment->capacity != segment->freeItems.size())
+            {
+                return false;
+            }
+        }
+        return true;
     }
 
+    const_iterator cbegin() const { return const_cast<MpmcHashmap32<KeyT, T>&>(*this).begin(); }
+    const_iterator cend() const { return const_cast<MpmcHashmap32<KeyT, T>&>(*this).end(); }
+
     const_iterator begin() const { return cbegin(); }
     const_iterator end() const { return cend(); }
+
     iterator begin()
     {
-        uint32_t first = 0;
-        const uint32_t theEnd = _end.load(std::memory_order_acquire);
-        while (first != theEnd && _elements[first].state.load() != State::committed)
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        if (segmentCount == 0)
         {
-            ++first;
+            return iterator(this, 0, 0, nullptr, 0, 0);
         }
-        return iterator(_elements, first, theEnd);
+
+        auto* segment = _segments[0].load(std::memory_order_acquire);
+        iterator it(this, 0, segmentCount, segment->elements, 0, segment->end.load(std::memory_order_acquire));
+        it.seekCommitted();
+        return it;
     }
+
     iterator end()
     {
-        const uint32_t currentEnd = _end.load(std::memory_order_acquire);
-        return iterator(_elements, currentEnd, currentEnd);
+        const uint32_t segmentCount = _segmentCount.load(std::memory_order_acquire);
+        if (segmentCount == 0)
+        {
+            return iterator(this, 0, 0, nullptr, 0, 0);
+        }
+
+        auto* segment = _segments[segmentCount - 1].load(std::memory_order_acquire);
+        const uint32_t currentEnd = segment->end.load(std::memory_order_acquire);
+        return iterator(this, segmentCount - 1, segmentCount, segment->elements, currentEnd, currentEnd);
     }
 
     PointerType getItem(const KeyT& key)
@@ -399,13 +577,48 @@ public:
     const PointerType getItem(const KeyT& key) const { return const_cast<MpmcHashmap32<KeyT, T>&>(*this).getItem(key); }
 
 private:
-    Entry* _elements;
-    std::atomic_uint32_t _end;
+    // Adds a segment after segmentCount segments unless another thread already did.
+    // @return false if map has reached max capacity
+    bool grow(uint32_t segmentCount)
+    {
+        if (_segmentCount.load(std::memory_order_acquire) > segmentCount)
+        {
+            return true;
+        }
+
+        size_t allocated = 0;
+        for (uint32_t i = 0; i < segmentCount; ++i)
+        {
+            allocated += _segments[i].load(std::memory_order_acquire)->capacity;
+        }
+
+        if (allocated >= _capacity || segmentCount >= maxSegments)
+        {
+            return false;
+        }
+
+        size_t segmentCapacity = (segmentCount == 0 ? _initialCapacity : allocated);
+        if (segmentCount + 1 == maxSegments)
+        {
+            segmentCapacity = _capacity - allocated;
+        }
+        segmentCapacity = std::min(segmentCapacity, _capacity - allocated);
 
-    const uint32_t _capacity;
+        auto* segment = new Segment(segmentCapacity);
+        Segment* expected = nullptr;
+        if (!_segments[segmentCount].compare_exchange_strong(expected, segment))
+        {
+            delete segment;
+        }
+
+        _segmentCount.compare_exchange_strong(segmentCount, segmentCount + 1);
+        return true;
+    }
 
-    MurmurHashIndex _index;
+    const size_t _capacity;
+    const size_t _initialCapacity;
 
-    LockFreeList _freeItems;
+    std::atomic<Segment*> _segments[maxSegments];
+    std::atomic_uint32_t _segmentCount;
 };
 } // namespace concurrency
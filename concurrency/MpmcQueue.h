@@ -265,6 +265,7 @@ public:
     }
 
     uint32_t capacity() const { return _capacity; }
+    size_t getAllocatedBytes() const { return _capacity == 0 ? 0 : calculateBlockSize(_capacity); }
 
 private:
     bool isWritable(const VersionedIndex& index) const
@@ -3,11 +3,68 @@
 #include <mach/mach_time.h>
 #include <mach/thread_act.h>
 #else
+#include <dirent.h>
 #include <pthread.h>
+#include <sched.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
 #endif
 #include "logger/Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+namespace
+{
+#ifdef __APPLE__
+const unsigned long maxCpuCount = 1024;
+#else
+const unsigned long maxCpuCount = CPU_SETSIZE;
+#endif
+
+// strtoul would accept white space, a sign and wrap negative numbers
+bool parseCpu(const char*& cursor, unsigned long& cpu)
+{
+    if (!std::isdigit(static_cast<unsigned char>(*cursor)))
+    {
+        return false;
+    }
+
+    char* end = nullptr;
+    errno = 0;
+    cpu = std::strtoul(cursor, &end, 10);
+    if (errno != 0 || cpu >= maxCpuCount)
+    {
+        return false;
+    }
+    cursor = end;
+    return true;
+}
+
+bool setLowPriority(pthread_t threadId)
+{
+    sched_param param;
+#ifdef __APPLE__
+    int policy = 0;
+    pthread_getschedparam(threadId, &policy, &param);
+    param.sched_priority = sched_get_priority_min(policy);
+#else
+    // Idle threads get the smallest scheduler weight, below nice 19, so they mostly run on cpu time the other threads
+    // leave. Lowering the policy requires no privileges. SCHED_BATCH would keep the normal weight.
+    const int policy = SCHED_IDLE;
+    param.sched_priority = 0;
+#endif
+    const auto rc = pthread_setschedparam(threadId, policy, &param);
+    if (rc != 0)
+    {
+        logger::warn("Failed to set low thread priority %d", "", rc);
+    }
+    return rc == 0;
+}
+} // namespace
+
 namespace concurrency
 {
 bool setPriority(std::thread& thread, Priority priority)
@@ -17,6 +74,10 @@ bool setPriority(std::thread& thread, Priority priority)
         return true;
     }
     auto threadId = thread.native_handle();
+    if (priority == Priority::Low)
+    {
+        return setLowPriority(threadId);
+    }
 
 #ifdef __APPLE__
     struct mach_timebase_info machTimeBase({});
@@ -122,4 +183,128 @@ void getThreadName(pthread_t threadId, char* name, size_t& length)
     }
     length = rc;
 }
+
+bool parseCpuList(const std::string& text, CpuList& cpus)
+{
+    cpus.clear();
+    const char* cursor = text.c_str();
+    while (*cursor)
+    {
+        unsigned long first = 0;
+        if (!parseCpu(cursor, first))
+        {
+            return false;
+        }
+
+        auto last = first;
+        if (*cursor == '-')
+        {
+            if (!parseCpu(++cursor, last) || last < first)
+            {
+                return false;
+            }
+        }
+
+        for (auto cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(static_cast<uint32_t>(cpu));
+        }
+
+        if (*cursor == ',' && cursor[1])
+        {
+            ++cursor;
+        }
+        else if (*cursor)
+        {
+            return false;
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return true;
+}
+
+std::string formatCpuList(const CpuList& cpus)
+{
+    std::string result;
+    for (size_t i = 0; i < cpus.size();)
+    {
+        size_t last = i;
+        while (last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1)
+        {
+            ++last;
+        }
+
+        if (!result.empty())
+        {
+            result += ",";
+        }
+        result += std::to_string(cpus[i]);
+        if (last > i)
+        {
+            result += "-" + std::to_string(cpus[last]);
+        }
+        i = last + 1;
+    }
+    return result;
+}
+
+bool setAffinity(std::thread& thread, const CpuList& cpus)
+{
+    if (cpus.empty() || !thread.joinable())
+    {
+        return false;
+    }
+
+#ifdef __APPLE__
+    // mac only takes affinity tags as hints
+    return false;
+#else
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (const auto cpu : cpus)
+    {
+        if (cpu >= CPU_SETSIZE)
+        {
+            return false;
+        }
+        CPU_SET(cpu, &cpuSet);
+    }
+
+    const auto rc = pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet);
+    if (rc != 0)
+    {
+        logger::warn("Failed to set thread affinity to %s, %d", "", formatCpuList(cpus).c_str(), rc);
+    }
+    return rc == 0;
+#endif
+}
+
+int getNumaNode(uint32_t cpu)
+{
+#ifdef __APPLE__
+    return -1;
+#else
+    char folderName[64];
+    std::snprintf(folderName, sizeof(folderName), "/sys/devices/system/cpu/cpu%u", cpu);
+    auto folderHandle = opendir(folderName);
+    if (!folderHandle)
+    {
+        return -1;
+    }
+
+    int node = -1;
+    for (auto entry = readdir(folderHandle); entry != nullptr; entry = readdir(folderHandle))
+    {
+        if (0 == std::strncmp(entry->d_name, "node", 4) && std::isdigit(entry->d_name[4]))
+        {
+            node = std::atoi(entry->d_name + 4);
+            break;
+        }
+    }
+    closedir(folderHandle);
+    return node;
+#endif
+}
 } // namespace concurrency
@@ -1,9 +1,13 @@
 #pragma once
+#include <cstdint>
+#include <string>
 #include <thread>
+#include <vector>
 namespace concurrency
 {
 enum class Priority
 {
+    Low,
     Normal,
     RealTime
 };
@@ -12,4 +16,14 @@ void setThreadName(const char* name);
 
 void getThreadName(char* name, size_t& length);
 void getThreadName(pthread_t threadId, char* name, size_t& length);
+
+typedef std::vector<uint32_t> CpuList;
+// kernel cpu list format, "0-3,8,10-11"
+bool parseCpuList(const std::string& text, CpuList& cpus);
+std::string formatCpuList(const CpuList& cpus);
+
+// restricts the thread to the cpus. Not supported on mac
+bool setAffinity(std::thread& thread, const CpuList& cpus);
+// NUMA node of the cpu, -1 if not known
+int getNumaNode(uint32_t cpu);
 } // namespace concurrency
@@ -28,6 +28,7 @@ public:
 
     CFG_PROP(uint32_t, maxDefaultLevelBandwidthKbps, 3000);
     CFG_PROP(uint32_t, rtpForwardInterval, 10); // ms
+    CFG_PROP(bool, tscClock, false); // read time from invariant TSC if the cpu has one
 
     CFG_GROUP()
     CFG_PROP(uint32_t, decommissionTimeout, 300); // s
@@ -35,6 +36,14 @@ public:
     CFG_PROP(uint32_t, dropAfterIdleTransitions, 3);
     CFG_GROUP_END(idleInbound);
 
+    CFG_GROUP()
+    // Mixers that have received nothing during idleTimeout and have no pending work are only run at the
+    // maintenance interval until the next packet or task wakes them up.
+    CFG_PROP(bool, enable, false);
+    CFG_PROP(uint32_t, idleTimeoutMs, 2000);
+    CFG_PROP(uint32_t, maintenanceIntervalMs, 200);
+    CFG_GROUP_END(hibernation);
+
     CFG_GROUP()
     // Value between 0 and 127, where 127 is the lowest audio level and 0 the highest.
     // Default is 126 to make possible simulate silence with 127.
@@ -45,6 +54,12 @@ public:
     CFG_PROP(uint32_t, activeTalkerSilenceThresholdDb, 18);
     CFG_GROUP_END(audio);
 
+    CFG_GROUP()
+    // idle opus encoders and decoders created at start and kept for reuse, per kind
+    CFG_PROP(uint32_t, warmCount, 32);
+    CFG_PROP(uint32_t, maxCount, 1024);
+    CFG_GROUP_END(opusPool);
+
     CFG_GROUP()
     // fix SCTP port to 5000 to support old CS
     CFG_PROP(bool, fixedPort, true);
@@ -63,6 +78,7 @@ public:
     CFG_PROP(uint16_t, udpPortRangeHigh, 26000);
     CFG_PROP(uint32_t, sharedPorts, 1);
     CFG_PROP(uint32_t, maxCandidateCount, 5 * 3);
+    CFG_PROP(bool, consentFastPath, true); // answer consent checks on selected pair from receive thread
 
     CFG_GROUP()
     CFG_PROP(bool, enable, false);
@@ -93,6 +109,16 @@ public:
     CFG_GROUP()
     CFG_PROP(uint16_t, singlePort, 10500);
     CFG_PROP(uint32_t, sharedPorts, 1);
+
+    CFG_GROUP()
+    // Write recording streams to segment files in directory instead of sending them to a remote recorder
+    CFG_PROP(bool, enable, false);
+    CFG_PROP(std::string, directory, "/tmp/smb-recordings");
+    CFG_PROP(uint32_t, blockSize, 64 * 1024);
+    CFG_PROP(uint32_t, maxSegmentSizeMB, 256);
+    CFG_PROP(uint32_t, flushIntervalMs, 200);
+    CFG_PROP(uint32_t, queueSize, 16 * 1024);
+    CFG_GROUP_END(local)
     CFG_GROUP_END(recording)
 
     CFG_GROUP()
@@ -124,6 +150,8 @@ public:
 
     CFG_GROUP()
     CFG_PROP(int64_t, userMapPeriodicSendingInterval, -1); // in seconds. Disabled by default
+    // Conferences allocating barbells with the same trunk id share one transport towards the remote bridge
+    CFG_PROP(bool, trunking, false);
     CFG_GROUP_END(barbell)
 
     CFG_GROUP()
@@ -131,6 +159,67 @@ public:
     CFG_PROP(uint64_t, reportInterval, utils::Time::ms * 2500);
     CFG_GROUP_END(recordingRtcp)
 
+    CFG_GROUP()
+    // FlexFEC repair packets on outbound video, protection scaled with loss reported by receivers.
+    // Each rewritten outbound video ssrc gets a repair ssrc, announced as FEC-FR ssrc-group together with the
+    // flexfec-03 payload type. Forwarded (non rewritten) ssrcs belong to the sender and are not protected.
+    CFG_PROP(bool, enable, false);
+    CFG_PROP(uint8_t, payloadType, 118);
+    CFG_PROP(uint32_t, minGroupSize, 4); // at most one repair packet per 4 media packets
+    CFG_GROUP_END(flexfec)
+
+    CFG_GROUP()
+    // Inbound RTP admission on the receive thread, before packets are queued on the transport and decrypted.
+    // Small packets are charged as 200 bytes. Ssrcs refused by the engine rejectedSsrcHits times within
+    // rejectedSsrcWindowMs are dropped until the timeout.
+    CFG_PROP(bool, enable, false);
+    CFG_PROP(uint32_t, transportKbps, 50000);
+    CFG_PROP(uint32_t, sourceKbps, 30000);
+    CFG_PROP(uint32_t, burstMs, 250);
+    CFG_PROP(uint32_t, rejectedSsrcTimeoutMs, 2000);
+    CFG_PROP(uint32_t, rejectedSsrcHits, 10);
+    CFG_PROP(uint32_t, rejectedSsrcWindowMs, 1000);
+    CFG_GROUP_END(ingress)
+
+    CFG_GROUP()
+    // DTLS handshakes run on low priority worker threads. New handshakes beyond the rate or while the handshake queue
+    // is deep are dropped and admitted on the peer's retransmission.
+    CFG_PROP(bool, handshakePool, true);
+    CFG_PROP(uint32_t, handshakeThreads, 2);
+    CFG_PROP(uint32_t, handshakesPerSecond, 200);
+    CFG_PROP(uint32_t, handshakeBurst, 100);
+    CFG_PROP(uint32_t, maxQueuedJobs, 4096);
+    CFG_GROUP_END(dtls)
+
+    CFG_GROUP()
+    // Ring of the most recent packets per transport, written in packet log format to the directory on request or when
+    // an inbound stream stalls with packet loss, receivers report a loss spike or PLIs arrive in a burst.
+    // Files are written by a background thread and only the maxFiles most recent are kept.
+    CFG_PROP(bool, enable, false);
+    CFG_PROP(uint32_t, packetCount, 2048);
+    CFG_PROP(std::string, directory, "/tmp"); // must exist
+    CFG_PROP(uint32_t, maxFiles, 16);
+    CFG_PROP(uint32_t, minDumpIntervalSec, 60); // per transport
+    CFG_PROP(uint32_t, stallMs, 1000);
+    CFG_PROP(uint32_t, lossSpikePercent, 20);
+    CFG_PROP(uint32_t, pliBurstCount, 10); // PLIs received within a second
+    CFG_GROUP_END(flightRecorder)
+
+    CFG_GROUP()
+    // UNIX socket path. A starting bridge takes over the shared media ports and TCP port of the bridge serving the
+    // path. That bridge shuts down first and its conferences are not taken over, clients have to reconnect.
+    CFG_PROP(std::string, path, "");
+    CFG_GROUP_END(handover)
+
+    CFG_GROUP()
+    // Cpus the threads are pinned to, in kernel cpu list format "0-3,8". Workers get one cpu each, round robin.
+    // Packet pools are moved to the NUMA node of the first engine cpu, or worker cpu. Empty leaves it to the OS.
+    CFG_PROP(std::string, engine, "");
+    CFG_PROP(std::string, rtce, "");
+    CFG_PROP(std::string, workers, "");
+    CFG_PROP(std::string, timers, "");
+    CFG_GROUP_END(placement)
+
     CFG_PROP(uint32_t, mtu, 1480);
     CFG_PROP(uint32_t, ipOverhead, 20 + 14);
 
@@ -2,6 +2,9 @@
 #include <array>
 #include <cassert>
 #include <cstring>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 #if OPENSSL_VERSION_MAJOR >= 3
 #include <openssl/core_names.h>
 #include <openssl/params.h>
@@ -17,6 +20,132 @@ unsigned char reverse(unsigned char b)
     b = (b & 0xAA) >> 1 | (b & 0x55) << 1;
     return b;
 }
+
+const uint32_t CRC32_IEEE_POLYNOMIAL = 0x04C11DB7u;
+const uint32_t CRC32C_POLYNOMIAL = 0x1EDC6F41u;
+
+#if defined(__x86_64__)
+// Below this size the setup of the folding registers costs more than the table lookups
+const size_t PCLMUL_MIN_LENGTH = 64;
+
+__attribute__((target("sse4.2"))) uint32_t crc32cSse42(uint32_t crc, const uint8_t* data, size_t length)
+{
+    uint64_t crc64 = crc;
+    for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t), data += sizeof(uint64_t))
+    {
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        crc64 = _mm_crc32_u64(crc64, value);
+    }
+
+    crc = static_cast<uint32_t>(crc64);
+    for (; length > 0; --length)
+    {
+        crc = _mm_crc32_u8(crc, *data++);
+    }
+    return crc;
+}
+
+// Folding of the reflected IEEE 802.3 polynomial using carry-less multiplication, followed by Barrett reduction.
+// See Intel "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction".
+// Length must be at least 64 and a multiple of 16.
+__attribute__((target("pclmul,sse4.1"))) uint32_t crc32Pclmul(uint32_t crc, const uint8_t* data, size_t length)
+{
+    alignas(16) static const uint64_t k1k2[] = {0x0154442bd4ull, 0x01c6e41596ull};
+    alignas(16) static const uint64_t k3k4[] = {0x01751997d0ull, 0x00ccaa009eull};
+    alignas(16) static const uint64_t k5k0[] = {0x0163cd6124ull, 0x0000000000ull};
+    alignas(16) static const uint64_t poly[] = {0x01db710641ull, 0x01f7011641ull};
+
+    assert(length >= PCLMUL_MIN_LENGTH && length % 16 == 0);
+
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00));
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10));
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20));
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    data += 64;
+    length -= 64;
+
+    // fold 4 x 128 bits in parallel
+    for (; length >= 64; data += 64, length -= 64)
+    {
+        const __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        const __m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+        const __m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+        const __m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30)));
+    }
+
+    // fold into 128 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    for (; length >= 16; data += 16, length -= 16)
+    {
+        x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data))), x5);
+    }
+
+    // fold 128 bits to 64 bits
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+#endif
+
+crypto::Crc32Polynomial::Acceleration selectCrcAcceleration(uint32_t polynomial)
+{
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (polynomial == CRC32C_POLYNOMIAL && __builtin_cpu_supports("sse4.2"))
+    {
+        return crypto::Crc32Polynomial::Acceleration::Sse42;
+    }
+    if (polynomial == CRC32_IEEE_POLYNOMIAL && __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1"))
+    {
+        return crypto::Crc32Polynomial::Acceleration::Pclmul;
+    }
+#endif
+    return crypto::Crc32Polynomial::Acceleration::None;
+}
 } // namespace
 
 namespace crypto
@@ -176,7 +305,8 @@ void MD5::reset()
     EVP_DigestInit_ex(_ctx, EVP_md5(), nullptr);
 }
 
-Crc32Polynomial::Crc32Polynomial(uint32_t polynomial)
+Crc32Polynomial::Crc32Polynomial(uint32_t polynomial, bool allowHardwareAcceleration)
+    : _acceleration(allowHardwareAcceleration ? selectCrcAcceleration(polynomial) : Acceleration::None)
 {
     uint32_t revPolynomial = 0;
     for (size_t i = 0; i < sizeof(uint32_t); ++i)
@@ -200,8 +330,17 @@ Crc32Polynomial::Crc32Polynomial(uint32_t polynomial)
                 remainder = (remainder >> 1);
             }
         }
-        _table[static_cast<size_t>(b)] = remainder;
+        _table[0][static_cast<size_t>(b)] = remainder;
     } while (0 != ++b);
+
+    for (size_t i = 0; i < 256; ++i)
+    {
+        for (size_t slice = 1; slice < 8; ++slice)
+        {
+            const uint32_t prev = _table[slice - 1][i];
+            _table[slice][i] = (prev >> 8) ^ _table[0][prev & 0xFFu];
+        }
+    }
 }
 
 Crc32::Crc32(const Crc32Polynomial& polynomial) : _polynomial(polynomial), _crc(0xFFFFFFFFul) {}
@@ -213,12 +352,59 @@ void Crc32::reset()
 
 void Crc32::add(const void* data, int length)
 {
-    int i;
+    if (length <= 0)
+    {
+        return;
+    }
+
     auto p = reinterpret_cast<const uint8_t*>(data);
-    for (i = 0; i < length; i++)
+    size_t remaining = static_cast<size_t>(length);
+#if defined(__x86_64__)
+    switch (_polynomial._acceleration)
+    {
+    case Crc32Polynomial::Acceleration::Sse42:
+        _crc = crc32cSse42(_crc, p, remaining);
+        return;
+    case Crc32Polynomial::Acceleration::Pclmul:
+        if (remaining >= PCLMUL_MIN_LENGTH)
+        {
+            const size_t foldLength = remaining & ~size_t(15);
+            _crc = crc32Pclmul(_crc, p, foldLength);
+            p += foldLength;
+            remaining -= foldLength;
+        }
+        break;
+    case Crc32Polynomial::Acceleration::None:
+        break;
+    }
+#endif
+
+    addSliced(p, remaining);
+}
+
+// slicing-by-8, processes 8 bytes per iteration with independent table lookups
+void Crc32::addSliced(const uint8_t* p, size_t length)
+{
+    const auto& table = _polynomial._table;
+    uint32_t crc = _crc;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; length >= 8; length -= 8, p += 8)
+    {
+        uint32_t low;
+        uint32_t high;
+        std::memcpy(&low, p, sizeof(low));
+        std::memcpy(&high, p + 4, sizeof(high));
+        low ^= crc;
+        crc = table[7][low & 0xFFu] ^ table[6][(low >> 8) & 0xFFu] ^ table[5][(low >> 16) & 0xFFu] ^
+            table[4][low >> 24] ^ table[3][high & 0xFFu] ^ table[2][(high >> 8) & 0xFFu] ^
+            table[1][(high >> 16) & 0xFFu] ^ table[0][high >> 24];
+    }
+#endif
+    for (; length > 0; --length)
     {
-        _crc = _polynomial[*p++ ^ (_crc & 0xff)] ^ (_crc >> 8);
+        crc = table[0][*p++ ^ (crc & 0xFFu)] ^ (crc >> 8);
     }
+    _crc = crc;
 }
 
 uint32_t Crc32::compute() const
@@ -71,12 +71,26 @@ private:
 class Crc32Polynomial
 {
 public:
-    explicit Crc32Polynomial(uint32_t polynomial);
-    inline uint32_t operator[](uint8_t pos) const { return _table[pos]; }
+    enum class Acceleration
+    {
+        None,
+        Sse42, // crc32 instruction, CRC32C only
+        Pclmul // carry-less multiplication folding, IEEE 802.3 only
+    };
+
+    explicit Crc32Polynomial(uint32_t polynomial, bool allowHardwareAcceleration = true);
+    inline uint32_t operator[](uint8_t pos) const { return _table[0][pos]; }
+
+    Acceleration getAcceleration() const { return _acceleration; }
 
 private:
-    uint32_t _table[256];
+    friend class Crc32;
+
+    // slicing-by-8 tables. _table[0] is the classic byte-at-a-time table.
+    uint32_t _table[8][256];
+    Acceleration _acceleration;
 };
+
 class Crc32
 {
 public:
@@ -93,6 +107,8 @@ public:
     }
 
 private:
+    void addSliced(const uint8_t* data, size_t length);
+
     const Crc32Polynomial& _polynomial;
     uint32_t _crc;
 };
@@ -19,6 +19,7 @@ class JobQueue
 public:
     explicit JobQueue(JobManager& jobManager, size_t poolSize = 4096)
         : _jobManager(jobManager),
+          _executor(&jobManager),
           _jobCount(0),
           _running(true),
           _jobQueue(poolSize),
@@ -95,11 +96,18 @@ public:
 
     JobManager& getJobManager() { return _jobManager; }
     size_t getCount() const { return _jobQueue.size(); }
+    // Time spent running the queued jobs, charged per worker step
+    const utils::CostTracker& getCost() const { return _cost; }
+
+    // Runs the queued jobs on the worker threads of another job manager until reset. Jobs stay serialized and timers
+    // are still handled by the job manager.
+    void setExecutor(JobManager& executor) { _executor = &executor; }
+    void resetExecutor() { _executor = &_jobManager; }
 
 private:
     void startProcessing()
     {
-        if (!_jobManager.addJob<RunJob>(*this))
+        if (!_executor.load()->addJob<RunJob>(*this))
         {
             _noNeedToRecover.clear();
         }
@@ -121,11 +129,13 @@ private:
 
         bool runStep() override
         {
+            const auto startTime = utils::Time::getAbsoluteTime();
             if (_actualWork)
             {
                 auto runAgain = _actualWork->runStep();
                 if (runAgain)
                 {
+                    chargeOwner(startTime);
                     return true;
                 }
                 freeJob();
@@ -136,6 +146,7 @@ private:
                 auto runAgain = _actualWork->runStep();
                 if (runAgain)
                 {
+                    chargeOwner(startTime);
                     return true;
                 }
                 else
@@ -156,6 +167,8 @@ private:
                 }
             }
 
+            // owner may be deleted once the count is released
+            chargeOwner(startTime);
             auto count = _owner._jobCount.fetch_sub(_processedCount);
             if (count > _processedCount)
             {
@@ -166,6 +179,11 @@ private:
         }
 
     private:
+        void chargeOwner(const uint64_t startTime)
+        {
+            _owner._cost.add(utils::Time::getAbsoluteTime() - startTime);
+        }
+
         void freeJob()
         {
             _actualWork->~MultiStepJob();
@@ -199,6 +217,7 @@ private:
     static const auto maxJobSize = JobManager::maxJobSize;
 
     JobManager& _jobManager;
+    std::atomic<JobManager*> _executor;
 
     std::atomic_flag _noNeedToRecover = ATOMIC_FLAG_INIT;
     std::atomic_uint32_t _jobCount;
@@ -206,6 +225,7 @@ private:
 
     concurrency::MpmcQueue<MultiStepJob*> _jobQueue;
     memory::PoolAllocator<maxJobSize> _jobPool;
+    utils::CostTracker _cost;
 };
 
 } // namespace jobmanager
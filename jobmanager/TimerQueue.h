@@ -1,5 +1,6 @@
 #pragma once
 #include "concurrency/MpmcQueue.h"
+#include "concurrency/ThreadUtils.h"
 #include <thread>
 #include <vector>
 namespace jobmanager
@@ -20,6 +21,7 @@ public:
     void abortTimers(uint32_t groupId);
     bool replaceTimer(uint32_t groupId, uint32_t id, uint64_t timeoutNs, MultiStepJob& job, JobManager& jobManager);
     void stop();
+    bool setAffinity(const concurrency::CpuList& cpus) { return concurrency::setAffinity(_thread, cpus); }
 
 private:
     struct TimerEntry
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "concurrency/ThreadUtils.h"
 #include "jobmanager/Job.h"
 #include <thread>
 #include <vector>
@@ -15,6 +16,8 @@ public:
     ~WorkerThread();
 
     void stop();
+    bool setPriority(concurrency::Priority priority) { return concurrency::setPriority(_thread, priority); }
+    bool setAffinity(const concurrency::CpuList& cpus) { return concurrency::setAffinity(_thread, cpus); }
 
     static double getWaitTime(); // ms
     static double getWorkTime(); // ms
@@ -0,0 +1,173 @@
+#include "logger/PacketFlightRecorder.h"
+#include "concurrency/ThreadUtils.h"
+#include "logger/Logger.h"
+#include "utils/Time.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+const uint32_t minQueueCapacity = 8; // smallest MpmcQueue
+
+uint32_t roundUpToPowerOfTwo(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+} // namespace
+
+namespace logger
+{
+
+PacketFlightRecorderWriter::PacketFlightRecorderWriter(const std::string& directory,
+    const uint32_t packetCount,
+    const uint32_t maxFiles)
+    : _directory(directory),
+      _packetCount(roundUpToPowerOfTwo(std::max(packetCount, 2u))),
+      _maxFiles(std::max(maxFiles, 1u)),
+      _freeDumps(minQueueCapacity),
+      _pendingDumps(minQueueCapacity),
+      _writtenCount(0),
+      _running(true)
+{
+    for (uint32_t i = 0; i < maxPendingDumps; ++i)
+    {
+        _dumps[i].items.reset(new PacketLogItem[_packetCount]);
+        _freeDumps.push(i);
+    }
+    _thread = std::make_unique<std::thread>([this] { this->run(); });
+}
+
+PacketFlightRecorderWriter::~PacketFlightRecorderWriter()
+{
+    stop();
+}
+
+void PacketFlightRecorderWriter::stop()
+{
+    if (!_running.exchange(false))
+    {
+        return;
+    }
+
+    _thread->join();
+}
+
+bool PacketFlightRecorderWriter::post(const PacketFlightRecorder& recorder,
+    const char* name,
+    const uint32_t dumpNumber,
+    const char* reason)
+{
+    uint32_t index = 0;
+    if (!_freeDumps.pop(index))
+    {
+        return false;
+    }
+
+    auto& dump = _dumps[index];
+    dump.count = recorder.snapshot(dump.items.get(), _packetCount);
+    dump.dumpNumber = dumpNumber;
+    dump.reason = reason;
+    std::strncpy(dump.name, name, sizeof(dump.name) - 1);
+    dump.name[sizeof(dump.name) - 1] = '\0';
+    _pendingDumps.push(index);
+    return true;
+}
+
+void PacketFlightRecorderWriter::run()
+{
+    concurrency::setThreadName("FlightRecorder");
+    for (;;)
+    {
+        uint32_t index = 0;
+        if (_pendingDumps.pop(index))
+        {
+            write(_dumps[index]);
+            _freeDumps.push(index);
+            continue;
+        }
+
+        if (!_running.load(std::memory_order_relaxed))
+        {
+            break;
+        }
+        utils::Time::nanoSleep(100 * utils::Time::ms);
+    }
+}
+
+void PacketFlightRecorderWriter::write(Dump& dump)
+{
+    const auto fileName = _directory + "/" + dump.name + "-" + std::to_string(dump.dumpNumber);
+    auto* file = ::fopen(fileName.c_str(), "wb");
+    if (!file)
+    {
+        logger::warn("failed to open %s for packet dump", "PacketFlightRecorder", fileName.c_str());
+        return;
+    }
+
+    ::fwrite(dump.items.get(), sizeof(PacketLogItem), dump.count, file);
+    ::fclose(file);
+    ++_writtenCount;
+
+    logger::info("dumped %zu packets to %s, reason %s",
+        "PacketFlightRecorder",
+        dump.count,
+        fileName.c_str(),
+        dump.reason);
+
+    _files.push_back(fileName);
+    if (_files.size() > _maxFiles)
+    {
+        ::remove(_files.front().c_str());
+        _files.pop_front();
+    }
+}
+
+PacketFlightRecorder::PacketFlightRecorder(const uint32_t capacity,
+    const std::string& name,
+    const uint64_t minDumpInterval,
+    PacketFlightRecorderWriter& writer)
+    : _indexMask(roundUpToPowerOfTwo(std::max(capacity, 2u)) - 1),
+      _ring(new PacketLogItem[_indexMask + 1]),
+      _writeIndex(0),
+      _name(name),
+      _minDumpInterval(minDumpInterval),
+      _writer(writer),
+      _lastDumpTimestamp(0),
+      _dumpCount(0)
+{
+}
+
+size_t PacketFlightRecorder::snapshot(PacketLogItem* target, const size_t maxCount) const
+{
+    const uint64_t end = _writeIndex.load(std::memory_order_relaxed);
+    const uint64_t capacity = _indexMask + 1;
+    const uint64_t count = std::min(std::min(end, capacity), static_cast<uint64_t>(maxCount));
+
+    for (uint64_t index = end - count; index != end; ++index)
+    {
+        *target++ = _ring[index & _indexMask];
+    }
+    return count;
+}
+
+bool PacketFlightRecorder::dump(const char* reason, const uint64_t timestamp)
+{
+    auto lastDump = _lastDumpTimestamp.load();
+    if (_dumpCount.load() > 0 && utils::Time::diffLT(lastDump, timestamp, _minDumpInterval))
+    {
+        return false;
+    }
+    if (!_lastDumpTimestamp.compare_exchange_strong(lastDump, timestamp))
+    {
+        return false;
+    }
+    return _writer.post(*this, _name.c_str(), ++_dumpCount, reason);
+}
+
+} // namespace logger
@@ -0,0 +1,113 @@
+#pragma once
+#include "concurrency/MpmcQueue.h"
+#include "logger/PacketLogger.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace logger
+{
+class PacketFlightRecorder;
+
+/**
+ * Writes flight recorder dumps to files on its own thread. A dump is copied into one of a few preallocated buffers and
+ * dropped if all buffers are waiting to be written. Only the maxFiles most recent dump files are kept, older ones are
+ * deleted.
+ */
+class PacketFlightRecorderWriter
+{
+public:
+    PacketFlightRecorderWriter(const std::string& directory, uint32_t packetCount, uint32_t maxFiles);
+    ~PacketFlightRecorderWriter();
+
+    // Copies the ring of the recorder for writing to <directory>/<name>-<dumpNumber>. No file io or allocation.
+    bool post(const PacketFlightRecorder& recorder, const char* name, uint32_t dumpNumber, const char* reason);
+    void stop();
+
+    uint32_t getWrittenCount() const { return _writtenCount.load(); }
+
+private:
+    static const uint32_t maxPendingDumps = 4;
+
+    struct Dump
+    {
+        std::unique_ptr<PacketLogItem[]> items;
+        size_t count = 0;
+        uint32_t dumpNumber = 0;
+        const char* reason = nullptr;
+        char name[64];
+    };
+
+    void run();
+    void write(Dump& dump);
+
+    const std::string _directory;
+    const uint32_t _packetCount;
+    const uint32_t _maxFiles;
+    Dump _dumps[maxPendingDumps];
+    concurrency::MpmcQueue<uint32_t> _freeDumps;
+    concurrency::MpmcQueue<uint32_t> _pendingDumps;
+    std::deque<std::string> _files; // writer thread only
+    std::atomic_uint32_t _writtenCount;
+    std::atomic_bool _running;
+    std::unique_ptr<std::thread> _thread;
+};
+
+/**
+ * Always on ring of the most recent packets of a transport. Recording a packet is a reservation of a slot and a few
+ * stores, no formatting and no system calls. The ring is handed to the writer thread, which writes it to a packet log
+ * file readable by PacketLogReader, only when dump is called on request or by a trigger. Dumps are rate limited so a
+ * trigger that keeps firing does not cause repeated file writes.
+ * Packets can be recorded from several threads. Records written while a dump copies the ring may be torn.
+ */
+class PacketFlightRecorder
+{
+public:
+    PacketFlightRecorder(uint32_t capacity,
+        const std::string& name,
+        uint64_t minDumpInterval,
+        PacketFlightRecorderWriter& writer);
+
+    void record(PacketDirection direction,
+        uint32_t ssrc,
+        uint16_t sequenceNumber,
+        uint32_t size,
+        uint32_t transmitTimestamp,
+        uint64_t timestamp,
+        PacketDropReason dropReason = PacketDropReason::None)
+    {
+        auto& item = _ring[_writeIndex.fetch_add(1, std::memory_order_relaxed) & _indexMask];
+        item.receiveTimestamp = timestamp;
+        item.transmitTimestamp = transmitTimestamp;
+        item.ssrc = ssrc;
+        item.sequenceNumber = sequenceNumber;
+        item.size = static_cast<uint16_t>(size);
+        item.direction = direction;
+        item.dropReason = dropReason;
+    }
+
+    // Posts the ring to the writer. False if a dump was made less than minDumpInterval ago or the writer is busy.
+    bool dump(const char* reason, uint64_t timestamp);
+
+    uint32_t getCapacity() const { return _indexMask + 1; }
+    uint32_t getDumpCount() const { return _dumpCount.load(); }
+
+    // copies the recorded packets, oldest first
+    size_t snapshot(PacketLogItem* target, size_t maxCount) const;
+
+private:
+    const uint32_t _indexMask;
+    std::unique_ptr<PacketLogItem[]> _ring;
+    std::atomic_uint64_t _writeIndex;
+
+    const std::string _name;
+    const uint64_t _minDumpInterval;
+    PacketFlightRecorderWriter& _writer;
+    std::atomic_uint64_t _lastDumpTimestamp;
+    std::atomic_uint32_t _dumpCount;
+};
+
+} // namespace logger
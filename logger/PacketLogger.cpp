@@ -5,9 +5,23 @@
 
 namespace logger
 {
-PacketLogItem::PacketLogItem() : receiveTimestamp(0), transmitTimestamp(0), ssrc(0), sequenceNumber(0), size(0) {}
+PacketLogItem::PacketLogItem()
+    : receiveTimestamp(0),
+      transmitTimestamp(0),
+      ssrc(0),
+      sequenceNumber(0),
+      size(0),
+      direction(PacketDirection::Inbound),
+      dropReason(PacketDropReason::None),
+      reserved(0)
+{
+}
 
-PacketLogItem::PacketLogItem(const memory::Packet& packet, uint64_t receiveTime) : receiveTimestamp(receiveTime)
+PacketLogItem::PacketLogItem(const memory::Packet& packet, uint64_t receiveTime)
+    : receiveTimestamp(receiveTime),
+      direction(PacketDirection::Inbound),
+      dropReason(PacketDropReason::None),
+      reserved(0)
 {
     auto* header = rtp::RtpHeader::fromPacket(packet);
     if (!header)
@@ -9,17 +9,35 @@ class Packet;
 
 namespace logger
 {
+enum class PacketDirection : uint8_t
+{
+    Inbound = 0,
+    Outbound
+};
+
+enum class PacketDropReason : uint8_t
+{
+    None = 0,
+    IngressLimit,
+    NotConnected
+};
+
 struct PacketLogItem
 {
     PacketLogItem();
     PacketLogItem(const memory::Packet& packet, uint64_t receiveTime);
 
-    uint64_t receiveTimestamp;
+    uint64_t receiveTimestamp; // send time for outbound packets
     uint32_t transmitTimestamp; // 24 bit
     uint32_t ssrc;
     uint16_t sequenceNumber;
     uint16_t size;
+    // stored in what used to be padding, logs written before these were added hold undefined values here
+    PacketDirection direction;
+    PacketDropReason dropReason;
+    uint16_t reserved;
 };
+static_assert(sizeof(PacketLogItem) == 24, "packet log file format");
 
 class PacketLoggerThread
 {
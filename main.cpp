@@ -5,6 +5,7 @@
 #include "git_version.h"
 #include "logger/Logger.h"
 #include "utils/Time.h"
+#include "utils/TscTimeSource.h"
 #include <execinfo.h>
 #include <iostream>
 #include <memory>
@@ -147,6 +148,11 @@ int main(int argc, char** argv)
     }
 
     utils::Time::initialize();
+    if (config->tscClock && utils::TscTimeSource::isInvariantTscAvailable())
+    {
+        static utils::TscTimeSource tscTimeSource;
+        utils::Time::initialize(tscTimeSource);
+    }
     logger::setup(config->logFile.get().c_str(), config->logStdOut, config->logStdErr, parseLogLevel(config->logLevel), 4 * 1024 * 1024);
     logger::info("Starting httpd on port %u", "main", config->port.get());
     logger::info("Configured udp port range: %s  %u - %u",
@@ -172,6 +178,7 @@ int main(int argc, char** argv)
 
         if (environment.isInitialized())
         {
+            environment.startHandoverServer([]() { running->post(); });
             running->wait();
         }
     }
@@ -5,6 +5,9 @@
 #include <cstdint>
 #include <sys/mman.h>
 #include <unistd.h>
+#ifndef __APPLE__
+#include <sys/syscall.h>
+#endif
 
 // set DISABLE_MMAP to disable direct page allocation mapping.
 // Disabling this can be use full to run tools to leak detection that can't track mmap, like heaptrack
@@ -54,6 +57,26 @@ inline void free(void* mem, size_t size)
 #endif
 }
 
+// Moves the pages to the NUMA node and keeps them there. No libnuma dependency, the policy constants are from the
+// kernel ABI. Only for memory from page::allocate. Without mmap the pages belong to the heap and would keep the policy
+// after free.
+inline bool bindToNode(void* mem, size_t size, int node)
+{
+#if defined(__APPLE__) || DISABLE_MMAP
+    return false;
+#else
+    const int bindPolicy = 2; // MPOL_BIND
+    const unsigned movePages = 1u << 1; // MPOL_MF_MOVE
+    const auto pageMask = getPageSize() - 1;
+    if (node < 0 || node >= 64 || (reinterpret_cast<uintptr_t>(mem) & pageMask) != 0 || (size & pageMask) != 0)
+    {
+        return false;
+    }
+    const unsigned long nodeMask = 1ul << node;
+    return 0 == ::syscall(SYS_mbind, mem, size, bindPolicy, &nodeMask, sizeof(nodeMask) * 8 + 1, movePages);
+#endif
+}
+
 inline size_t alignedSpace(size_t space)
 {
     const size_t pageSize = getPageSize();
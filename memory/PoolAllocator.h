@@ -110,6 +110,8 @@ public:
     PoolAllocator& operator=(PoolAllocator&&) = delete;
     const std::string& getName() const { return _name; }
 
+    bool bindToNumaNode(int node) { return memory::page::bindToNode(_elements, _size, node); }
+
     size_t size() const { return _count.load(std::memory_order_relaxed); }
     size_t countAllocatedItems() const { return _originalElementCount - size(); }
     size_t getElementSize() const { return ELEMENT_SIZE; }
@@ -0,0 +1,247 @@
+#include "rtp/FlexFecEncoder.h"
+#include "rtp/RtpHeader.h"
+#include "utils/ByteOrder.h"
+#include <algorithm>
+#include <cstring>
+
+namespace rtp
+{
+
+namespace
+{
+const size_t fixedRtpHeaderSize = 12;
+const size_t repairRtpHeaderSize = fixedRtpHeaderSize + sizeof(uint32_t); // one CSRC carrying the protected SSRC
+
+// Below ~1% loss retransmissions are cheaper than continuous repair packets
+const uint8_t minFractionLost = 3;
+
+struct FecHeader
+{
+    uint8_t byte0; // R F P X CC
+    uint8_t byte1; // M PT
+    nwuint16_t lengthRecovery;
+    nwuint32_t timestampRecovery;
+    nwuint16_t sequenceNumberBase;
+    nwuint16_t mask; // k bit followed by 15 mask bits
+};
+static_assert(sizeof(FecHeader) == FlexFecEncoder::fecHeaderSize, "FEC header size mismatch");
+
+inline uint16_t maskBit(uint16_t offset)
+{
+    return 1u << (14 - offset);
+}
+
+void xorInto(uint8_t* target, const uint8_t* source, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        target[i] ^= source[i];
+    }
+}
+} // namespace
+
+FlexFecEncoder::FlexFecEncoder(uint32_t fecSsrc, uint32_t protectedSsrc, uint8_t payloadType, uint32_t minGroupSize)
+    : _fecSsrc(fecSsrc),
+      _protectedSsrc(protectedSsrc),
+      _payloadType(payloadType),
+      _minGroupSize(std::max(2u, std::min(minGroupSize, maxGroupSize))),
+      _groupSize(0),
+      _sequenceNumber(0)
+{
+    _payloadRecovery.clear();
+}
+
+void FlexFecEncoder::onReportedLoss(const uint8_t fractionLost)
+{
+    if (fractionLost < minFractionLost)
+    {
+        _groupSize = 0;
+        return;
+    }
+
+    // one repair packet per group recovers single losses, aim for well below one loss per group
+    _groupSize = std::max(_minGroupSize, std::min(maxGroupSize, 64u / fractionLost));
+}
+
+memory::UniquePacket FlexFecEncoder::addPacket(const memory::Packet& packet, memory::PacketPoolAllocator& allocator)
+{
+    if (_groupSize == 0)
+    {
+        if (_group.count > 0)
+        {
+            resetGroup();
+        }
+        return nullptr;
+    }
+
+    const auto* rtpHeader = RtpHeader::fromPacket(packet);
+    if (!rtpHeader || packet.getLength() < fixedRtpHeaderSize)
+    {
+        return nullptr;
+    }
+
+    memory::UniquePacket repairPacket;
+    const uint16_t sequenceNumber = rtpHeader->sequenceNumber.get();
+    if (_group.count > 0)
+    {
+        const uint16_t offset = sequenceNumber - _group.sequenceNumberBase;
+        if (offset >= maxGroupSize || (_group.mask & maskBit(offset)))
+        {
+            // gap or reordering beyond what the mask can describe, close the group early
+            repairPacket = _group.count > 1 ? buildRepairPacket(allocator) : nullptr;
+            resetGroup();
+        }
+    }
+
+    if (_group.count == 0)
+    {
+        _group.sequenceNumberBase = sequenceNumber;
+    }
+
+    const auto* data = packet.get();
+    const size_t payloadLength = packet.getLength() - fixedRtpHeaderSize;
+    if (repairRtpHeaderSize + fecHeaderSize + payloadLength > memory::Packet::size)
+    {
+        return repairPacket;
+    }
+
+    _group.mask |= maskBit(static_cast<uint16_t>(sequenceNumber - _group.sequenceNumberBase));
+    _group.byte0 ^= data[0];
+    _group.byte1 ^= data[1];
+    _group.lengthRecovery ^= static_cast<uint16_t>(payloadLength);
+    _group.timestampRecovery ^= rtpHeader->timestamp.get();
+    _group.lastTimestamp = rtpHeader->timestamp.get();
+    _group.payloadLength = std::max(_group.payloadLength, payloadLength);
+    xorInto(_payloadRecovery.get(), data + fixedRtpHeaderSize, payloadLength);
+    ++_group.count;
+
+    if (!repairPacket && _group.count >= _groupSize)
+    {
+        repairPacket = buildRepairPacket(allocator);
+        resetGroup();
+    }
+
+    return repairPacket;
+}
+
+memory::UniquePacket FlexFecEncoder::buildRepairPacket(memory::PacketPoolAllocator& allocator)
+{
+    auto packet = memory::makeUniquePacket(allocator);
+    if (!packet)
+    {
+        return nullptr;
+    }
+
+    auto* rtpHeader = RtpHeader::create(*packet);
+    rtpHeader->csrcCount = 1;
+    rtpHeader->payloadType = _payloadType;
+    rtpHeader->sequenceNumber = _sequenceNumber++;
+    rtpHeader->timestamp = _group.lastTimestamp;
+    rtpHeader->ssrc = _fecSsrc;
+    rtpHeader->csrc[0] = _protectedSsrc;
+
+    auto* fecHeader = reinterpret_cast<FecHeader*>(packet->get() + repairRtpHeaderSize);
+    fecHeader->byte0 = _group.byte0 & 0x3F; // R = 0, F = 0
+    fecHeader->byte1 = _group.byte1;
+    fecHeader->lengthRecovery = _group.lengthRecovery;
+    fecHeader->timestampRecovery = _group.timestampRecovery;
+    fecHeader->sequenceNumberBase = _group.sequenceNumberBase;
+    fecHeader->mask = 0x8000u | _group.mask;
+
+    std::memcpy(packet->get() + repairRtpHeaderSize + fecHeaderSize, _payloadRecovery.get(), _group.payloadLength);
+    packet->setLength(repairRtpHeaderSize + fecHeaderSize + _group.payloadLength);
+    return packet;
+}
+
+void FlexFecEncoder::resetGroup()
+{
+    std::memset(_payloadRecovery.get(), 0, _group.payloadLength);
+    _group = Group();
+}
+
+memory::UniquePacket recoverFlexFecPacket(const memory::Packet& repairPacket,
+    const memory::Packet* const* receivedPackets,
+    const size_t receivedCount,
+    memory::PacketPoolAllocator& allocator)
+{
+    const auto* repairHeader = RtpHeader::fromPacket(repairPacket);
+    if (!repairHeader || repairHeader->csrcCount != 1 ||
+        repairPacket.getLength() < repairRtpHeaderSize + FlexFecEncoder::fecHeaderSize)
+    {
+        return nullptr;
+    }
+
+    const auto& fecHeader = *reinterpret_cast<const FecHeader*>(repairPacket.get() + repairRtpHeaderSize);
+    const uint32_t protectedSsrc = repairHeader->csrc[0].get();
+    const uint16_t sequenceNumberBase = fecHeader.sequenceNumberBase.get();
+    const uint16_t mask = fecHeader.mask.get() & 0x7FFF;
+
+    uint16_t receivedMask = 0;
+    uint8_t byte0 = fecHeader.byte0;
+    uint8_t byte1 = fecHeader.byte1;
+    uint16_t lengthRecovery = fecHeader.lengthRecovery.get();
+    uint32_t timestampRecovery = fecHeader.timestampRecovery.get();
+
+    auto packet = memory::makeUniquePacket(allocator);
+    if (!packet)
+    {
+        return nullptr;
+    }
+    const size_t recoveryLength = repairPacket.getLength() - repairRtpHeaderSize - FlexFecEncoder::fecHeaderSize;
+    std::memcpy(packet->get() + fixedRtpHeaderSize,
+        repairPacket.get() + repairRtpHeaderSize + FlexFecEncoder::fecHeaderSize,
+        recoveryLength);
+
+    for (size_t i = 0; i < receivedCount; ++i)
+    {
+        const auto* received = receivedPackets[i];
+        const auto* rtpHeader = RtpHeader::fromPacket(*received);
+        if (!rtpHeader || rtpHeader->ssrc.get() != protectedSsrc)
+        {
+            continue;
+        }
+
+        const uint16_t offset = rtpHeader->sequenceNumber.get() - sequenceNumberBase;
+        if (offset >= FlexFecEncoder::maxGroupSize || !(mask & maskBit(offset)) || (receivedMask & maskBit(offset)))
+        {
+            continue;
+        }
+
+        const size_t payloadLength = received->getLength() - fixedRtpHeaderSize;
+        if (payloadLength > recoveryLength)
+        {
+            return nullptr;
+        }
+
+        receivedMask |= maskBit(offset);
+        byte0 ^= received->get()[0];
+        byte1 ^= received->get()[1];
+        lengthRecovery ^= static_cast<uint16_t>(payloadLength);
+        timestampRecovery ^= rtpHeader->timestamp.get();
+        xorInto(packet->get() + fixedRtpHeaderSize, received->get() + fixedRtpHeaderSize, payloadLength);
+    }
+
+    const uint16_t missingMask = mask & ~receivedMask;
+    if (missingMask == 0 || (missingMask & (missingMask - 1)) != 0 || lengthRecovery > recoveryLength)
+    {
+        return nullptr;
+    }
+
+    uint16_t missingOffset = 0;
+    while (!(missingMask & maskBit(missingOffset)))
+    {
+        ++missingOffset;
+    }
+
+    auto* data = packet->get();
+    data[0] = 0x80 | (byte0 & 0x3F);
+    data[1] = byte1;
+    auto* rtpHeader = reinterpret_cast<RtpHeader*>(data);
+    rtpHeader->sequenceNumber = static_cast<uint16_t>(sequenceNumberBase + missingOffset);
+    rtpHeader->timestamp = timestampRecovery;
+    rtpHeader->ssrc = protectedSsrc;
+    packet->setLength(fixedRtpHeaderSize + lengthRecovery);
+    return packet;
+}
+
+} // namespace rtp
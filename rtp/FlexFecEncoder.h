@@ -0,0 +1,62 @@
+#pragma once
+
+#include "memory/PacketPoolAllocator.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace rtp
+{
+
+// FlexFEC (RFC 8627) encoder for a single protected SSRC using the flexible mask, non-retransmission format.
+// Consecutive source packets are grouped and one XOR repair packet is produced per group. The group size adapts to
+// the loss the receiver reports, from no protection at low loss down to minGroupSize packets per repair packet.
+class FlexFecEncoder
+{
+public:
+    static constexpr size_t fecHeaderSize = 12; // R/F/P/X/CC/M/PT, length, TS recovery, SN base, k + 15 bit mask
+    static constexpr uint32_t maxGroupSize = 15;
+
+    FlexFecEncoder(uint32_t fecSsrc, uint32_t protectedSsrc, uint8_t payloadType, uint32_t minGroupSize);
+
+    // fractionLost as carried in RTCP report blocks, 0-255
+    void onReportedLoss(uint8_t fractionLost);
+    uint32_t getGroupSize() const { return _groupSize; }
+    uint32_t getFecSsrc() const { return _fecSsrc; }
+
+    // Feed an outbound rewritten RTP packet. Returns a repair packet when a group is complete.
+    memory::UniquePacket addPacket(const memory::Packet& packet, memory::PacketPoolAllocator& allocator);
+
+private:
+    memory::UniquePacket buildRepairPacket(memory::PacketPoolAllocator& allocator);
+    void resetGroup();
+
+    const uint32_t _fecSsrc;
+    const uint32_t _protectedSsrc;
+    const uint8_t _payloadType;
+    const uint32_t _minGroupSize;
+    uint32_t _groupSize;
+    uint16_t _sequenceNumber;
+
+    struct Group
+    {
+        uint32_t count = 0;
+        uint16_t sequenceNumberBase = 0;
+        uint16_t mask = 0;
+        uint8_t byte0 = 0;
+        uint8_t byte1 = 0;
+        uint16_t lengthRecovery = 0;
+        uint32_t timestampRecovery = 0;
+        uint32_t lastTimestamp = 0;
+        size_t payloadLength = 0;
+    } _group;
+    memory::Packet _payloadRecovery;
+};
+
+// Receiver side recovery of a single missing packet protected by a FlexFEC repair packet.
+// Returns nullptr if zero or more than one protected packet is missing from receivedPackets.
+memory::UniquePacket recoverFlexFecPacket(const memory::Packet& repairPacket,
+    const memory::Packet* const* receivedPackets,
+    size_t receivedCount,
+    memory::PacketPoolAllocator& allocator);
+
+} // namespace rtp
@@ -1,31 +1,10 @@
 #include "rtp/JitterBufferList.h"
 #include "rtp/RtpHeader.h"
-#include <queue>
 
 namespace rtp
 {
 
-JitterBufferList::JitterBufferList() : _freeItems(nullptr), _head(nullptr), _tail(nullptr), _count(0)
-{
-    for (size_t i = 0; i < SIZE; ++i)
-    {
-        _itemStore[i].next = _freeItems;
-        _freeItems = &_itemStore[i];
-    }
-}
-
-JitterBufferList::ListItem* JitterBufferList::allocItem()
-{
-    if (!_freeItems)
-    {
-        return nullptr;
-    }
-
-    auto item = _freeItems;
-    _freeItems = item->next;
-    item->next = nullptr;
-    return item;
-}
+JitterBufferList::JitterBufferList() : _headSequenceNumber(0), _tailSequenceNumber(0), _count(0) {}
 
 bool JitterBufferList::add(memory::UniquePacket packet)
 {
@@ -35,108 +14,110 @@ bool JitterBufferList::add(memory::UniquePacket packet)
         return false; // corrupt
     }
 
-    auto newItem = allocItem();
-    if (!newItem)
+    if (_count >= SIZE)
     {
         return false; // full
     }
 
-    newItem->packet = std::move(packet);
-    ++_count;
+    if (_count == 0)
+    {
+        _headSequenceNumber = newHeader->sequenceNumber.get();
+        _tailSequenceNumber = _headSequenceNumber;
+        slot(_headSequenceNumber) = std::move(packet);
+        _count = 1;
+        return true;
+    }
+
+    const uint32_t extendedSequenceNumber = _tailSequenceNumber +
+        static_cast<int16_t>(newHeader->sequenceNumber.get() - static_cast<uint16_t>(_tailSequenceNumber));
 
-    if (_tail)
+    if (static_cast<int32_t>(extendedSequenceNumber - _tailSequenceNumber) > 0)
     {
-        const auto tailHeader = RtpHeader::fromPacket(*_tail->packet);
-        if (static_cast<int16_t>(newHeader->sequenceNumber.get() - tailHeader->sequenceNumber.get()) >= 0)
+        if (extendedSequenceNumber - _headSequenceNumber >= RING_SIZE)
         {
-            _tail->next = newItem;
-            _tail = newItem;
-            return true;
+            return false; // too far ahead of head
         }
+        _tailSequenceNumber = extendedSequenceNumber;
     }
-    else
+    else if (static_cast<int32_t>(extendedSequenceNumber - _headSequenceNumber) < 0)
     {
-        _head = newItem;
-        _tail = newItem;
-        return true;
-    }
-
-    for (ListItem** itemPtr = &_head; *itemPtr; itemPtr = &(*itemPtr)->next)
-    {
-        auto item = *itemPtr;
-        const auto itemHeader = RtpHeader::fromPacket(*item->packet);
-        if (static_cast<int16_t>(itemHeader->sequenceNumber.get() - newHeader->sequenceNumber.get()) > 0)
+        if (_tailSequenceNumber - extendedSequenceNumber >= RING_SIZE)
         {
-            newItem->next = item;
-            *itemPtr = newItem;
-            return true;
+            return false; // too far behind tail
         }
+        _headSequenceNumber = extendedSequenceNumber;
+    }
+    else if (slot(extendedSequenceNumber))
+    {
+        return false; // duplicate
     }
 
-    return false;
+    slot(extendedSequenceNumber) = std::move(packet);
+    ++_count;
+    return true;
 }
 
 memory::UniquePacket JitterBufferList::pop()
 {
-    if (!_head)
+    if (_count == 0)
     {
         return nullptr;
     }
 
-    auto item = _head;
-    _head = item->next;
-    if (_tail == item)
+    auto packet = std::move(slot(_headSequenceNumber));
+    --_count;
+    if (_count > 0)
     {
-        _tail = nullptr;
+        // skip the gap of missing packets, bounded by the ring size
+        do
+        {
+            ++_headSequenceNumber;
+        } while (!slot(_headSequenceNumber));
     }
-
-    item->next = _freeItems;
-    _freeItems = item;
-    --_count;
-    return std::move(item->packet);
+    return packet;
 }
 
 uint32_t JitterBufferList::getRtpDelay() const
 {
-    if (!_tail)
+    if (_count == 0)
     {
         return 0;
     }
 
-    const auto headHeader = rtp::RtpHeader::fromPacket(*_head->packet);
-    const auto tailHeader = rtp::RtpHeader::fromPacket(*_tail->packet);
+    const auto headHeader = rtp::RtpHeader::fromPacket(*slot(_headSequenceNumber));
+    const auto tailHeader = rtp::RtpHeader::fromPacket(*slot(_tailSequenceNumber));
     return tailHeader->timestamp.get() - headHeader->timestamp.get();
 }
 
 int32_t JitterBufferList::getRtpDelay(uint32_t rtpTimestamp) const
 {
-    if (!_tail)
+    if (_count == 0)
     {
         return 0;
     }
 
-    const auto tailHeader = rtp::RtpHeader::fromPacket(*_tail->packet);
+    const auto tailHeader = rtp::RtpHeader::fromPacket(*slot(_tailSequenceNumber));
     return static_cast<int32_t>(tailHeader->timestamp.get() - rtpTimestamp);
 }
 
 const rtp::RtpHeader* JitterBufferList::getFrontRtp() const
 {
-    if (!_head)
+    if (_count == 0)
     {
         return nullptr;
     }
 
-    return rtp::RtpHeader::fromPacket(*_head->packet);
+    return rtp::RtpHeader::fromPacket(*slot(_headSequenceNumber));
 }
 
 const rtp::RtpHeader* JitterBufferList::getTailRtp() const
 {
-    if (!_tail)
+    if (_count == 0)
     {
         return nullptr;
     }
 
-    return rtp::RtpHeader::fromPacket(*_tail->packet);
+    return rtp::RtpHeader::fromPacket(*slot(_tailSequenceNumber));
 }
 
 } // namespace rtp
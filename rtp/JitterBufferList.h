@@ -1,12 +1,15 @@
 #pragma once
 #include "memory/PacketPoolAllocator.h"
+#include <array>
 
 namespace rtp
 {
 struct RtpHeader;
 /**
- * Effective jitter buffer. Packets are stored in linked list. Ordered packets are quickly added to the end of the list.
- * Rarely occurring out of order packets have to be inserted in the list after a quick scan.
+ * Effective jitter buffer. Packets are stored in a ring indexed by extended sequence number. In order and out of
+ * order packets are written directly to their slot. Head and tail are the lowest and highest sequence number held.
+ * The sequence number span from head to tail is limited by the ring size and the packet count by SIZE.
+ * Duplicates are rejected.
  */
 
 class JitterBufferList
@@ -26,22 +29,26 @@ public:
     const rtp::RtpHeader* getFrontRtp() const;
     const rtp::RtpHeader* getTailRtp() const;
 
-    bool empty() const { return !_head; }
+    bool empty() const { return _count == 0; }
     uint32_t count() const { return _count; }
 
 private:
-    struct ListItem
-    {
-        memory::UniquePacket packet;
-        ListItem* next = nullptr;
-    };
+    static constexpr uint32_t RING_SIZE = 512;
+    static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "ring size must be a power of two");
+    static_assert(RING_SIZE >= SIZE, "ring must hold SIZE consecutive packets");
 
-    ListItem* allocItem();
+    memory::UniquePacket& slot(uint32_t extendedSequenceNumber)
+    {
+        return _ring[extendedSequenceNumber & (RING_SIZE - 1)];
+    }
+    const memory::UniquePacket& slot(uint32_t extendedSequenceNumber) const
+    {
+        return _ring[extendedSequenceNumber & (RING_SIZE - 1)];
+    }
 
-    ListItem* _freeItems;
-    ListItem _itemStore[SIZE];
-    ListItem* _head;
-    ListItem* _tail;
+    std::array<memory::UniquePacket, RING_SIZE> _ring;
+    uint32_t _headSequenceNumber;
+    uint32_t _tailSequenceNumber;
     uint32_t _count;
 };
 } // namespace rtp
@@ -0,0 +1,173 @@
+#include "api/Generator.h"
+#include "api/BarbellDescription.h"
+#include "api/EndpointDescription.h"
+#include "api/Parser.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+api::Transport makeTransport()
+{
+    api::Transport transport;
+    transport.rtcpMux = true;
+
+    api::Ice ice;
+    ice.ufrag = "ufrag";
+    ice.pwd = "pwd";
+    api::Candidate candidate;
+    candidate.generation = 0;
+    candidate.component = 1;
+    candidate.protocol = "udp";
+    candidate.port = 10000;
+    candidate.ip = "10.0.0.1";
+    candidate.foundation = "1";
+    candidate.priority = 2130706431;
+    candidate.type = "host";
+    candidate.network = 1;
+    ice.candidates.push_back(candidate);
+    candidate.type = "srflx";
+    candidate.relPort.set(10000);
+    candidate.relAddr.set("10.0.0.1");
+    ice.candidates.push_back(candidate);
+    transport.ice.set(ice);
+
+    api::Dtls dtls;
+    dtls.type = "sha-256";
+    dtls.hash = "AB:CD";
+    dtls.setup = "active";
+    transport.dtls.set(dtls);
+    return transport;
+}
+
+api::PayloadType makeOpus()
+{
+    api::PayloadType opus;
+    opus.id = 111;
+    opus.name = "opus";
+    opus.clockRate = 48000;
+    opus.channels.set(2);
+    opus.parameters.emplace_back("minptime", "10");
+    opus.parameters.emplace_back("useinbandfec", "1");
+    opus.rtcpFeedbacks.emplace_back("transport-cc", utils::Optional<std::string>());
+    return opus;
+}
+
+api::EndpointDescription makeEndpointDescription(const std::string& endpointId)
+{
+    api::EndpointDescription description;
+    description.endpointId = endpointId;
+    description.bundleTransport.set(makeTransport());
+
+    api::Audio audio;
+    audio.ssrcs.push_back(3455980998u);
+    audio.payloadTypes.push_back(makeOpus());
+    audio.rtpHeaderExtensions.emplace_back(1, "urn:ietf:params:rtp-hdrext:ssrc-audio-level");
+    description.audio.set(audio);
+
+    api::Video video;
+    api::VideoStream stream;
+    stream.sources.push_back({1, 2, 5});
+    stream.sources.push_back({3, 0});
+    stream.content = api::VideoStream::videoContent;
+    video.streams.push_back(stream);
+    api::PayloadType vp8;
+    vp8.id = 100;
+    vp8.name = "VP8";
+    vp8.clockRate = 90000;
+    vp8.rtcpFeedbacks.emplace_back("nack", utils::Optional<std::string>("pli"));
+    video.payloadTypes.push_back(vp8);
+    description.video.set(video);
+
+    api::Data data;
+    data.port = 5000;
+    data.maxMessageSize = 2048;
+    description.data.set(data);
+    return description;
+}
+} // namespace
+
+TEST(ApiGeneratorTest, allocateEndpointResponse)
+{
+    const auto body = api::Generator::generateAllocateEndpointResponse(makeEndpointDescription("ep"));
+    const auto json = nlohmann::json::parse(body);
+
+    const auto& bundleTransport = json["bundle-transport"];
+    EXPECT_EQ(true, bundleTransport["rtcp-mux"].get<bool>());
+    EXPECT_EQ("ufrag", bundleTransport["ice"]["ufrag"]);
+    ASSERT_EQ(2, bundleTransport["ice"]["candidates"].size());
+    EXPECT_EQ(0, bundleTransport["ice"]["candidates"][0].count("rel-port"));
+    EXPECT_EQ(10000, bundleTransport["ice"]["candidates"][1]["rel-port"]);
+    EXPECT_EQ(2130706431u, bundleTransport["ice"]["candidates"][1]["priority"]);
+    EXPECT_EQ("active", bundleTransport["dtls"]["setup"]);
+
+    const auto& audio = json["audio"];
+    EXPECT_EQ(3455980998u, audio["ssrcs"][0]);
+    EXPECT_EQ("10", audio["payload-types"][0]["parameters"]["minptime"]);
+    EXPECT_EQ(2, audio["payload-types"][0]["channels"]);
+    EXPECT_EQ(0, audio["payload-types"][0]["rtcp-fbs"][0].count("subtype"));
+
+    const auto& video = json["video"];
+    EXPECT_EQ(2, video["streams"][0]["sources"][0]["feedback"]);
+    EXPECT_EQ(0, video["streams"][0]["sources"][1].count("feedback"));
+    EXPECT_EQ(5, video["streams"][0]["sources"][0]["fec"]);
+    EXPECT_EQ(0, video["streams"][0]["sources"][1].count("fec"));
+    EXPECT_TRUE(video["payload-types"][0]["parameters"].is_object());
+    EXPECT_EQ("pli", video["payload-types"][0]["rtcp-fbs"][0]["subtype"]);
+    EXPECT_EQ(0, video.count("transport"));
+
+    EXPECT_EQ(2048, json["data"]["max-message-size"]);
+    EXPECT_EQ(0, json.count("endpoint-id"));
+}
+
+TEST(ApiGeneratorTest, roundTrip)
+{
+    const auto body = api::Generator::generateAllocateEndpointResponse(makeEndpointDescription("ep"));
+    const json::reader::Document document(body.c_str(), body.size());
+    ASSERT_TRUE(document.isValid());
+
+    const auto parsed = api::Parser::parsePatchEndpoint(document.getRoot(), "ep");
+    const auto& ice = parsed.bundleTransport.get().ice.get();
+    ASSERT_EQ(2, ice.candidates.size());
+    EXPECT_EQ("10.0.0.1", ice.candidates[1].relAddr.get());
+    EXPECT_EQ("AB:CD", parsed.bundleTransport.get().dtls.get().hash);
+
+    const auto& opus = parsed.audio.get().payloadTypes[0];
+    EXPECT_EQ(2, opus.parameters.size());
+    EXPECT_EQ("transport-cc", opus.rtcpFeedbacks[0].first);
+    EXPECT_EQ(3, parsed.video.get().streams[0].sources[1].main);
+    EXPECT_EQ(5, parsed.video.get().streams[0].sources[0].fec);
+    EXPECT_EQ(0, parsed.video.get().streams[0].sources[1].fec);
+    EXPECT_EQ(5000, parsed.data.get().port);
+}
+
+TEST(ApiGeneratorTest, allocateEndpointsResponse)
+{
+    std::vector<api::EndpointDescription> descriptions;
+    descriptions.push_back(makeEndpointDescription("ep\"1"));
+    descriptions.push_back(makeEndpointDescription("ep2"));
+
+    const auto json = nlohmann::json::parse(api::Generator::generateAllocateEndpointsResponse(descriptions));
+    ASSERT_EQ(2, json["endpoints"].size());
+    EXPECT_EQ("ep\"1", json["endpoints"][0]["endpoint-id"]);
+    EXPECT_EQ("ep2", json["endpoints"][1]["endpoint-id"]);
+    EXPECT_EQ("ufrag", json["endpoints"][1]["bundle-transport"]["ice"]["ufrag"]);
+}
+
+TEST(ApiGeneratorTest, allocateBarbellResponse)
+{
+    api::BarbellDescription description;
+    description.transport = makeTransport();
+    description.audio.payloadTypes.push_back(makeOpus());
+    description.data.port = 5000;
+
+    auto json = nlohmann::json::parse(api::Generator::generateAllocateBarbellResponse(description));
+    EXPECT_EQ("pwd", json["bundle-transport"]["ice"]["pwd"]);
+    EXPECT_TRUE(json["audio"]["ssrcs"].empty());
+    EXPECT_EQ(0, json.count("video"));
+    EXPECT_EQ(5000, json["data"]["port"]);
+
+    description.video = makeEndpointDescription("ep").video.get();
+    json = nlohmann::json::parse(api::Generator::generateAllocateBarbellResponse(description));
+    EXPECT_EQ(1, json["video"]["streams"].size());
+    EXPECT_EQ("VP8", json["video"]["payload-types"][0]["name"]);
+}
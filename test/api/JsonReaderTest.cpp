@@ -0,0 +1,163 @@
+#include "api/JsonReader.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace json::reader;
+
+TEST(JsonReaderTest, readValues)
+{
+    const std::string text = R"(
+        {
+            "name" : "some value",
+            "obj": {
+                "empty" : "",
+                "integer" : -3,
+                "double" : -3.1415926,
+                "null" : null,
+                "true": true,
+                "inner": {"bigInteger" : 9223372036854775807, "tooBig" : 9223372036854775808, "exp" : 0.154e-10},
+                "false" : false
+            },
+            "last": 7
+        }
+    )";
+
+    const Document document(text.c_str(), text.size());
+    ASSERT_TRUE(document.isValid());
+    const auto root = document.getRoot();
+
+    std::string value;
+    EXPECT_TRUE(root["name"].getString(value));
+    EXPECT_EQ("some value", value);
+    EXPECT_TRUE(root["name"].equals("some value"));
+    EXPECT_FALSE(root["name"].getInt().isSet());
+
+    const auto obj = root["obj"];
+    EXPECT_TRUE(obj.isObject());
+    EXPECT_TRUE(obj["empty"].getString(value));
+    EXPECT_TRUE(value.empty());
+    EXPECT_EQ(-3, obj["integer"].getInt().get());
+    EXPECT_FALSE(obj["double"].getInt().isSet());
+    EXPECT_EQ("-3.1415926", std::string(obj["double"].getText(), obj["double"].getTextLength()));
+    EXPECT_EQ(Type::Null, obj["null"].getType());
+    EXPECT_TRUE(obj["true"].getBool().get());
+    EXPECT_FALSE(obj["false"].getBool().get());
+    EXPECT_FALSE(obj["integer"].getBool().isSet());
+    EXPECT_EQ(INT64_MAX, obj["inner"]["bigInteger"].getInt().get());
+    EXPECT_FALSE(obj["inner"]["tooBig"].getInt().isSet());
+    EXPECT_EQ(Type::Number, obj["inner"]["exp"].getType());
+
+    // lookups skip nested objects
+    EXPECT_EQ(7, root["last"].getInt().get());
+    EXPECT_TRUE(root["bigInteger"].isNone());
+    EXPECT_TRUE(root["missing"]["deeper"].isNone());
+    EXPECT_FALSE(root.exists("inner"));
+    EXPECT_TRUE(obj.exists("inner"));
+}
+
+TEST(JsonReaderTest, unescapeStrings)
+{
+    const std::string text = R"({"a": "q\"b\\s\/n\nt\t", "u": "\u00e5\u20ac\ud83d\ude00", "k\"ey": 1})";
+    const Document document(text.c_str(), text.size());
+    ASSERT_TRUE(document.isValid());
+
+    std::string value;
+    EXPECT_TRUE(document.getRoot()["a"].getString(value));
+    EXPECT_EQ("q\"b\\s/n\nt\t", value);
+    EXPECT_TRUE(document.getRoot()["u"].getString(value));
+    EXPECT_EQ("\xc3\xa5\xe2\x82\xac\xf0\x9f\x98\x80", value);
+    EXPECT_FALSE(document.getRoot()["a"].equals("q\"b\\s/n\nt\t"));
+    EXPECT_TRUE(document.getRoot()["k\"ey"].isNone());
+
+    std::vector<std::string> names;
+    document.getRoot().forEachProperty([&names](const Value& name, const Value& value) {
+        names.emplace_back();
+        name.getString(names.back());
+    });
+    ASSERT_EQ(3, names.size());
+    EXPECT_EQ("k\"ey", names[2]);
+}
+
+TEST(JsonReaderTest, iterateArrays)
+{
+    const std::string text = R"([1, [2, 3], {"a": [4]}, "5", [], {}])";
+    const Document document(text.c_str(), text.size());
+    ASSERT_TRUE(document.isValid());
+
+    const auto root = document.getRoot();
+    EXPECT_EQ(6, root.getElementCount());
+    std::vector<Type> types;
+    for (const auto& element : root.getElements())
+    {
+        types.push_back(element.getType());
+    }
+    const std::vector<Type> expected =
+        {Type::Number, Type::Array, Type::Object, Type::String, Type::Array, Type::Object};
+    EXPECT_EQ(expected, types);
+
+    EXPECT_EQ(0, root["a"].getElementCount());
+    auto it = root.getElements().begin();
+    ++it;
+    EXPECT_EQ(2, (*it).getElementCount());
+    ++it;
+    EXPECT_EQ(4, (*(*it)["a"].getElements().begin()).getInt().get());
+}
+
+TEST(JsonReaderTest, largeDocument)
+{
+    std::string text = "[";
+    for (int i = 0; i < 5000; ++i)
+    {
+        text.append(i == 0 ? "" : ",").append(std::to_string(i));
+    }
+    text.append("]");
+
+    const Document document(text.c_str(), text.size());
+    ASSERT_TRUE(document.isValid());
+    EXPECT_EQ(5001, document.getTokenCount());
+
+    int64_t sum = 0;
+    for (const auto& element : document.getRoot().getElements())
+    {
+        sum += element.getInt().get();
+    }
+    EXPECT_EQ(4999 * 5000 / 2, sum);
+}
+
+TEST(JsonReaderTest, invalidDocuments)
+{
+    const char* invalid[] = {"",
+        "{",
+        "{\"a\" 1}",
+        "{\"a\": 1,}",
+        "[1, 2,]",
+        "{\"a\": tru}",
+        "{\"a\": \"unterminated}",
+        "{\"a\": \"bad \\x escape\"}",
+        "{\"a\": \"\\u12g4\"}",
+        "{\"a\": -}",
+        "{\"a\": 1.}",
+        "{\"a\": 1e}",
+        "{\"a\": 01}",
+        "[-00]",
+        "{a: 1}",
+        "{\"a\": 1} trailing",
+        "\"control \n char\""};
+
+    for (const auto* text : invalid)
+    {
+        EXPECT_FALSE(Document(text, std::strlen(text)).isValid()) << text;
+        EXPECT_TRUE(Document(text, std::strlen(text)).getRoot().isNone());
+    }
+
+    const std::string zeros = "[0, -0, 0.5, 10]";
+    EXPECT_TRUE(Document(zeros.c_str(), zeros.size()).isValid());
+
+    std::string deep(64, '[');
+    deep.append(64, ']');
+    EXPECT_TRUE(Document(deep.c_str(), deep.size()).isValid());
+    deep = std::string(65, '[') + std::string(65, ']');
+    EXPECT_FALSE(Document(deep.c_str(), deep.size()).isValid());
+}
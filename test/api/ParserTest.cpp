@@ -1,11 +1,16 @@
 #include "api/Parser.h"
+#include "logger/Logger.h"
 #include "test/ResourceLoader.h"
+#include "utils/Time.h"
 #include <gtest/gtest.h>
 
 TEST(ParserTest, patchNoIceCandidates)
 {
-    auto patchBody = ResourceLoader::loadAsJson("api-patch-no-ice-candidates.json");
-    api::EndpointDescription endpointDescription = api::Parser::parsePatchEndpoint(patchBody, "endpointId-0");
+    const auto patchBody = ResourceLoader::loadAsString("api-patch-no-ice-candidates.json");
+    const json::reader::Document document(patchBody.c_str(), patchBody.size());
+    ASSERT_TRUE(document.isValid());
+    api::EndpointDescription endpointDescription =
+        api::Parser::parsePatchEndpoint(document.getRoot(), "endpointId-0");
 
     ASSERT_EQ("endpointId-0", endpointDescription.endpointId);
 
@@ -22,8 +27,11 @@ TEST(ParserTest, patchNoIceCandidates)
 
 TEST(ParserTest, patchEmptyIceCandidates)
 {
-    auto patchBody = ResourceLoader::loadAsJson("api-patch-empty-ice-candidates.json");
-    api::EndpointDescription endpointDescription = api::Parser::parsePatchEndpoint(patchBody, "endpointId-0");
+    const auto patchBody = ResourceLoader::loadAsString("api-patch-empty-ice-candidates.json");
+    const json::reader::Document document(patchBody.c_str(), patchBody.size());
+    ASSERT_TRUE(document.isValid());
+    api::EndpointDescription endpointDescription =
+        api::Parser::parsePatchEndpoint(document.getRoot(), "endpointId-0");
 
     ASSERT_EQ("endpointId-0", endpointDescription.endpointId);
 
@@ -37,3 +45,199 @@ TEST(ParserTest, patchEmptyIceCandidates)
     ASSERT_EQ("gb4ISfk9Ppy6M5zYcZdtqldd", ice.pwd);
     ASSERT_EQ(0, ice.candidates.size());
 }
+
+TEST(ParserTest, patchMedia)
+{
+    const auto patchBody = ResourceLoader::loadAsString("api-patch-no-ice-candidates.json");
+    const json::reader::Document document(patchBody.c_str(), patchBody.size());
+    ASSERT_TRUE(document.isValid());
+    const auto endpointDescription = api::Parser::parsePatchEndpoint(document.getRoot(), "endpointId-0");
+
+    const auto& dtls = endpointDescription.bundleTransport.get().dtls.get();
+    EXPECT_EQ("active", dtls.setup);
+    EXPECT_EQ("sha-256", dtls.type);
+    EXPECT_EQ(95, dtls.hash.size());
+
+    ASSERT_TRUE(endpointDescription.audio.isSet());
+    const auto& audio = endpointDescription.audio.get();
+    ASSERT_EQ(1, audio.ssrcs.size());
+    EXPECT_EQ(3455980998u, audio.ssrcs[0]);
+    ASSERT_EQ(1, audio.payloadTypes.size());
+    const auto& opus = audio.payloadTypes[0];
+    EXPECT_EQ(111, opus.id);
+    EXPECT_EQ("opus", opus.name);
+    EXPECT_EQ(48000, opus.clockRate);
+    EXPECT_EQ(2, opus.channels.get());
+    ASSERT_EQ(2, opus.parameters.size());
+    EXPECT_EQ("minptime", opus.parameters[0].first);
+    EXPECT_EQ("10", opus.parameters[0].second);
+    EXPECT_EQ("useinbandfec", opus.parameters[1].first);
+    EXPECT_TRUE(opus.rtcpFeedbacks.empty());
+    ASSERT_EQ(1, audio.rtpHeaderExtensions.size());
+    EXPECT_EQ(1, audio.rtpHeaderExtensions[0].first);
+    EXPECT_EQ("urn:ietf:params:rtp-hdrext:ssrc-audio-level", audio.rtpHeaderExtensions[0].second);
+
+    ASSERT_TRUE(endpointDescription.video.isSet());
+    const auto& video = endpointDescription.video.get();
+    ASSERT_EQ(2, video.payloadTypes.size());
+    const auto& vp8 = video.payloadTypes[0];
+    EXPECT_TRUE(vp8.parameters.empty());
+    ASSERT_EQ(4, vp8.rtcpFeedbacks.size());
+    EXPECT_EQ("goog-remb", vp8.rtcpFeedbacks[0].first);
+    EXPECT_FALSE(vp8.rtcpFeedbacks[0].second.isSet());
+    EXPECT_EQ("ccm", vp8.rtcpFeedbacks[1].first);
+    EXPECT_EQ("fir", vp8.rtcpFeedbacks[1].second.get());
+    EXPECT_EQ("apt", video.payloadTypes[1].parameters[0].first);
+    EXPECT_EQ("100", video.payloadTypes[1].parameters[0].second);
+    EXPECT_EQ(3, video.rtpHeaderExtensions[0].first);
+
+    ASSERT_TRUE(endpointDescription.data.isSet());
+    EXPECT_EQ(5000, endpointDescription.data.get().port);
+    EXPECT_FALSE(endpointDescription.neighbours.isSet());
+}
+
+TEST(ParserTest, patchCandidatesAndStreams)
+{
+    const std::string patchBody = R"({
+        "action": "configure",
+        "bundle-transport": {
+            "rtcp-mux": true,
+            "ice": {
+                "ufrag": "u\"f\\rag",
+                "pwd": "pwd",
+                "candidates": [
+                    {"generation": 0, "component": 1, "protocol": "udp", "port": 10000, "ip": "192.168.0.1",
+                     "foundation": "1", "priority": 2130706431, "type": "host"},
+                    {"generation": 0, "component": 1, "protocol": "udp", "port": 10001, "ip": "1.2.3.4",
+                     "rel-port": 10000, "rel-addr": "192.168.0.1", "foundation": "2", "priority": 1694498815,
+                     "type": "srflx", "network": 1}
+                ]
+            }
+        },
+        "video": {
+            "streams": [
+                {"sources": [{"main": 1, "feedback": 2}, {"main": 3}], "content": "video"},
+                {"sources": [{"main": 5}], "content": "slides"}
+            ],
+            "ssrc-whitelist": [1, 3]
+        },
+        "neighbours": {"groups": ["g1", "g\u00e5"]}
+    })";
+
+    const json::reader::Document document(patchBody.c_str(), patchBody.size());
+    ASSERT_TRUE(document.isValid());
+    const auto endpointDescription = api::Parser::parsePatchEndpoint(document.getRoot(), "endpointId-0");
+
+    const auto& ice = endpointDescription.bundleTransport.get().ice.get();
+    EXPECT_EQ("u\"f\\rag", ice.ufrag);
+    ASSERT_EQ(2, ice.candidates.size());
+    EXPECT_EQ(10000, ice.candidates[0].port);
+    EXPECT_FALSE(ice.candidates[0].relPort.isSet());
+    EXPECT_EQ(0, ice.candidates[0].network);
+    EXPECT_EQ(2130706431u, ice.candidates[0].priority);
+    EXPECT_EQ("srflx", ice.candidates[1].type);
+    EXPECT_EQ(10000, ice.candidates[1].relPort.get());
+    EXPECT_EQ("192.168.0.1", ice.candidates[1].relAddr.get());
+    EXPECT_EQ(1, ice.candidates[1].network);
+
+    const auto& video = endpointDescription.video.get();
+    ASSERT_EQ(2, video.streams.size());
+    ASSERT_EQ(2, video.streams[0].sources.size());
+    EXPECT_EQ(2, video.streams[0].sources[0].feedback);
+    EXPECT_EQ(3, video.streams[0].sources[1].main);
+    EXPECT_EQ(0, video.streams[0].sources[1].feedback);
+    EXPECT_TRUE(video.streams[1].isSlides());
+    EXPECT_EQ(2, video.ssrcWhitelist.get().size());
+
+    const auto& neighbours = endpointDescription.neighbours.get();
+    ASSERT_EQ(2, neighbours.size());
+    EXPECT_EQ("g\xc3\xa5", neighbours[1]);
+}
+
+TEST(ParserTest, allocateEndpoint)
+{
+    const std::string allocateBody = R"({
+        "action": "allocate",
+        "bundle-transport": {"ice": true, "ice-controlling": "false", "dtls": true},
+        "audio": {"relay-type": "ssrc-rewrite"},
+        "video": {"relay-type": "forwarder"},
+        "data": {},
+        "idleTimeout": 30
+    })";
+
+    const json::reader::Document document(allocateBody.c_str(), allocateBody.size());
+    ASSERT_TRUE(document.isValid());
+    const auto allocateEndpoint = api::Parser::parseAllocateEndpoint(document.getRoot());
+    const auto& transport = allocateEndpoint.bundleTransport.get();
+    EXPECT_TRUE(transport.ice);
+    EXPECT_FALSE(transport.iceControlling.get());
+    EXPECT_TRUE(transport.dtls);
+    EXPECT_FALSE(transport.sdes);
+    EXPECT_FALSE(transport.privatePort);
+    EXPECT_EQ(bridge::MediaMode::SSRC_REWRITE, allocateEndpoint.audio.get().getMediaMode());
+    EXPECT_EQ(bridge::MediaMode::FORWARD, allocateEndpoint.video.get().getMediaMode());
+    EXPECT_TRUE(allocateEndpoint.data.isSet());
+    EXPECT_EQ(30, allocateEndpoint.idleTimeoutSeconds.get());
+}
+
+TEST(ParserTest, invalidRequests)
+{
+    const std::string missingPort = R"({"data": {}})";
+    const json::reader::Document missingPortDocument(missingPort.c_str(), missingPort.size());
+    EXPECT_THROW(api::Parser::parsePatchEndpoint(missingPortDocument.getRoot(), "ep"), nlohmann::detail::exception);
+
+    const std::string wrongType = R"({"audio": {"ssrcs": ["1"]}})";
+    const json::reader::Document wrongTypeDocument(wrongType.c_str(), wrongType.size());
+    EXPECT_THROW(api::Parser::parsePatchEndpoint(wrongTypeDocument.getRoot(), "ep"), nlohmann::detail::exception);
+
+    const std::string missingRecording = R"({"action": "record"})";
+    const json::reader::Document missingRecordingDocument(missingRecording.c_str(), missingRecording.size());
+    EXPECT_THROW(api::Parser::parseRecording(missingRecordingDocument.getRoot()), nlohmann::detail::exception);
+
+    const std::string truncated = R"({"action": "configure", "audio": {"ssrcs": [1, 2)";
+    EXPECT_FALSE(json::reader::Document(truncated.c_str(), truncated.size()).isValid());
+}
+
+// the previous parser walked a nlohmann tree, building the tree alone costs more than the in place parsing
+TEST(ParserTest, perfAgainstJsonTree)
+{
+#ifdef NOPERF_TEST
+    GTEST_SKIP();
+#endif
+    const std::string bodies[] = {ResourceLoader::loadAsString("api-patch-no-ice-candidates.json"),
+        ResourceLoader::loadAsString("api-patch-empty-ice-candidates.json")};
+    const int iterations = 20000;
+
+    size_t count = 0;
+    const auto treeStart = utils::Time::getAbsoluteTime();
+    for (int i = 0; i < iterations; ++i)
+    {
+        for (const auto& body : bodies)
+        {
+            const auto json = nlohmann::json::parse(body);
+            count += json.size();
+        }
+    }
+    const auto treeTime = utils::Time::getAbsoluteTime() - treeStart;
+
+    const auto streamStart = utils::Time::getAbsoluteTime();
+    for (int i = 0; i < iterations; ++i)
+    {
+        for (const auto& body : bodies)
+        {
+            const json::reader::Document document(body.c_str(), body.size());
+            ASSERT_TRUE(document.isValid());
+            const auto endpointDescription = api::Parser::parsePatchEndpoint(document.getRoot(), "ep");
+            count += endpointDescription.audio.get().payloadTypes.size();
+        }
+    }
+    const auto streamTime = utils::Time::getAbsoluteTime() - streamStart;
+
+    logger::info("%d requests, json tree %" PRIu64 "us, in place parsing %" PRIu64 "us, %zu",
+        "ParserTest",
+        iterations * 2,
+        treeTime / utils::Time::us,
+        streamTime / utils::Time::us,
+        count);
+    EXPECT_LT(streamTime, treeTime);
+}
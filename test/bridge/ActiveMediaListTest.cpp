@@ -751,3 +751,64 @@ TEST_F(ActiveMediaListTest, mutedOutage)
 
     EXPECT_EQ(5, audioRewriteMap.size());
 }
+
+TEST_F(ActiveMediaListTest, rankingCostFollowsSpeakers)
+{
+    for (const size_t memberCount : {50, 2000})
+    {
+        auto activeMediaList =
+            std::make_unique<bridge::ActiveMediaList>(1, _audioSsrcs, _videoSsrcs, defaultLastN, audioLastN, 18);
+        for (size_t i = 1; i <= memberCount; ++i)
+        {
+            activeMediaList->addAudioParticipant(i, std::to_string(i).c_str());
+        }
+
+        // all make a sound when joining, then only 1-4 keep talking
+        for (size_t i = 1; i <= memberCount; ++i)
+        {
+            activeMediaList->onNewAudioLevel(i, 60, false);
+        }
+
+        uint64_t timestamp = utils::Time::sec;
+        uint64_t processTime = 0;
+        for (int i = 0; i < 500; ++i)
+        {
+            timestamp += 10 * utils::Time::ms;
+            if (i & 1)
+            {
+                activeMediaList->onNewAudioLevel(1, 20, false);
+                activeMediaList->onNewAudioLevel(2, 30, false);
+                activeMediaList->onNewAudioLevel(3, 40, false);
+                activeMediaList->onNewAudioLevel(4, 30, false);
+            }
+            if (i == 300)
+            {
+                activeMediaList->removeAudioParticipant(4);
+            }
+
+            bool dominantSpeakerChanged = false;
+            bool videoMapChanged = false;
+            bool audioMapChanged = false;
+            const auto start = utils::Time::getAbsoluteTime();
+            activeMediaList->process(timestamp, dominantSpeakerChanged, videoMapChanged, audioMapChanged);
+            processTime += utils::Time::getAbsoluteTime() - start;
+        }
+
+        logger::info("%zu participants, %" PRIu64 "ns per process",
+            "ActiveMediaListTest",
+            memberCount,
+            processTime / 500);
+
+        const auto activeTalkers = activeMediaList->getActiveTalkers();
+        EXPECT_EQ(3, activeTalkers.size());
+        EXPECT_NE(activeTalkers.end(), activeTalkers.find(1));
+        EXPECT_NE(activeTalkers.end(), activeTalkers.find(2));
+        EXPECT_NE(activeTalkers.end(), activeTalkers.find(3));
+        EXPECT_EQ(1, activeMediaList->getDominantSpeaker());
+
+        const auto& audioRewriteMap = activeMediaList->getAudioSsrcRewriteMap();
+        EXPECT_NE(audioRewriteMap.end(), audioRewriteMap.find(1));
+        EXPECT_NE(audioRewriteMap.end(), audioRewriteMap.find(2));
+        EXPECT_NE(audioRewriteMap.end(), audioRewriteMap.find(3));
+    }
+}
@@ -5,6 +5,7 @@
 #include "mocks/EngineMixerSpy.h"
 #include "mocks/MixerManagerSpy.h"
 #include "mocks/RtcTransportMock.h"
+#include "nlohmann/json.hpp"
 #include "transport/ProbeServer.h"
 #include "transport/dtls/SslDtls.h"
 #include <gtest/gtest.h>
@@ -495,3 +496,138 @@ TEST_F(ApiRequestHandlerTest, allocateEndpointWithoutPrivateShouldPassFlagToFact
     EXPECT_EQ(httpd::StatusCode::OK, response1.statusCode);
     EXPECT_EQ(false, response1.body.empty());
 }
+
+namespace
+{
+nlohmann::json makeBulkEndpoint(const std::string& endpointId, bool audio, bool video)
+{
+    nlohmann::json endpointJson;
+    endpointJson["endpoint-id"] = endpointId;
+    endpointJson["bundle-transport"] = {{"ice", true}, {"dtls", true}};
+    if (audio)
+    {
+        endpointJson["audio"] = {{"relay-type", "ssrc-rewrite"}};
+    }
+    if (video)
+    {
+        endpointJson["video"] = {{"relay-type", "ssrc-rewrite"}};
+    }
+    return endpointJson;
+}
+
+httpd::Request makeBulkAllocateRequest(const std::string& urlPath, const nlohmann::json& endpointsJson)
+{
+    nlohmann::json bodyJson;
+    bodyJson["action"] = "allocate";
+    bodyJson["endpoints"] = endpointsJson;
+    const auto body = bodyJson.dump();
+
+    httpd::Request request("POST", urlPath.c_str());
+    request.body.append(body.c_str(), body.size());
+    return request;
+}
+
+bool hasBundleTransport(Mixer& mixer, const std::string& endpointId)
+{
+    TransportDescription transportDescription;
+    return mixer.getTransportBundleDescription(endpointId, transportDescription);
+}
+} // namespace
+
+TEST_F(ApiRequestHandlerTest, allocateEndpointsInBulk)
+{
+    auto requestHandler = createApiRequestHandler();
+
+    const auto conferenceId = createConference(requestHandler, R"({
+     "last-n": 9,
+     "enable-video": true
+     })");
+
+    const size_t endpointCount = 10;
+    nlohmann::json endpointsJson = nlohmann::json::array();
+    for (size_t i = 0; i < endpointCount; ++i)
+    {
+        endpointsJson.push_back(makeBulkEndpoint("bulk" + std::to_string(i), true, true));
+    }
+
+    EXPECT_CALL(*_mixerManagerSpyResources->transportFactoryMock, create(_, _, _, _, _, _, _, _))
+        .Times(endpointCount);
+
+    const auto urlPath = std::string("/conferences/").append(conferenceId);
+    auto request = makeBulkAllocateRequest(urlPath, endpointsJson);
+    const auto response = requestHandler.onRequest(request);
+
+    ASSERT_EQ(httpd::StatusCode::OK, response.statusCode);
+    const auto responseJson = response.getBodyAsJson();
+    const auto& endpointsResponse = responseJson["endpoints"];
+    ASSERT_EQ(endpointCount, endpointsResponse.size());
+    for (size_t i = 0; i < endpointCount; ++i)
+    {
+        EXPECT_EQ("bulk" + std::to_string(i), endpointsResponse[i]["endpoint-id"].get<std::string>());
+        EXPECT_NE(endpointsResponse[i].end(), endpointsResponse[i].find("bundle-transport"));
+        EXPECT_NE(endpointsResponse[i].end(), endpointsResponse[i].find("audio"));
+        EXPECT_NE(endpointsResponse[i].end(), endpointsResponse[i].find("video"));
+    }
+
+    // allocating an existing endpoint again fails the whole batch and leaves the existing endpoints
+    const auto duplicateResponse = requestHandler.onRequest(request);
+    EXPECT_EQ(httpd::StatusCode::BAD_REQUEST, duplicateResponse.statusCode);
+
+    Mixer* mixer = nullptr;
+    auto lock = _mixerManagerSpy->getMixer(conferenceId, mixer);
+    ASSERT_NE(nullptr, mixer);
+    EXPECT_EQ(endpointCount, mixer->getEndpoints().size());
+    EXPECT_TRUE(hasBundleTransport(*mixer, "bulk0"));
+}
+
+TEST_F(ApiRequestHandlerTest, failedBulkAllocationLeavesNoTransport)
+{
+    auto requestHandler = createApiRequestHandler();
+
+    const auto conferenceId = createConference(requestHandler, R"({
+     "last-n": 9,
+     "enable-video": false
+     })");
+    const auto urlPath = std::string("/conferences/").append(conferenceId);
+
+    nlohmann::json endpointsJson = nlohmann::json::array();
+    for (size_t i = 0; i < 4; ++i)
+    {
+        endpointsJson.push_back(makeBulkEndpoint("bulk" + std::to_string(i), true, false));
+    }
+
+    // third transport cannot be created
+    EXPECT_CALL(*_mixerManagerSpyResources->transportFactoryMock, create(_, _, _, _, _, _, _, _))
+        .WillOnce(Return(_transportMock))
+        .WillOnce(Return(_transportMock))
+        .WillOnce(Return(nullptr))
+        .WillRepeatedly(Return(_transportMock));
+
+    auto request = makeBulkAllocateRequest(urlPath, endpointsJson);
+    EXPECT_EQ(httpd::StatusCode::BAD_REQUEST, requestHandler.onRequest(request).statusCode);
+    {
+        Mixer* mixer = nullptr;
+        auto lock = _mixerManagerSpy->getMixer(conferenceId, mixer);
+        ASSERT_NE(nullptr, mixer);
+        EXPECT_EQ(0, mixer->getEndpoints().size());
+        for (size_t i = 0; i < 4; ++i)
+        {
+            EXPECT_FALSE(hasBundleTransport(*mixer, "bulk" + std::to_string(i)));
+        }
+    }
+
+    // video only endpoint has no media in a conference without video
+    auto videoOnlyEndpoints = endpointsJson;
+    videoOnlyEndpoints.push_back(makeBulkEndpoint("videoOnly", false, true));
+    auto videoOnlyRequest = makeBulkAllocateRequest(urlPath, videoOnlyEndpoints);
+    EXPECT_EQ(httpd::StatusCode::BAD_REQUEST, requestHandler.onRequest(videoOnlyRequest).statusCode);
+
+    // same endpoints can be allocated once nothing is left behind
+    EXPECT_EQ(httpd::StatusCode::OK, requestHandler.onRequest(request).statusCode);
+
+    Mixer* mixer = nullptr;
+    auto lock = _mixerManagerSpy->getMixer(conferenceId, mixer);
+    ASSERT_NE(nullptr, mixer);
+    EXPECT_EQ(4, mixer->getEndpoints().size());
+    EXPECT_FALSE(hasBundleTransport(*mixer, "videoOnly"));
+}
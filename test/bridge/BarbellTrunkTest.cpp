@@ -0,0 +1,199 @@
+#include "bridge/BarbellTrunk.h"
+#include "jobmanager/JobManager.h"
+#include "memory/PacketPoolAllocator.h"
+#include "rtp/RtcpFeedback.h"
+#include "rtp/RtpHeader.h"
+#include "test/bridge/DummyRtcTransport.h"
+#include "webrtc/DataChannel.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+class ReceiverStub : public transport::DataReceiver
+{
+public:
+    void onRtpPacketReceived(transport::RtcTransport* sender,
+        memory::UniquePacket packet,
+        uint32_t extendedSequenceNumber,
+        uint64_t timestamp) override
+    {
+        rtpSsrcs.push_back(rtp::RtpHeader::fromPacket(*packet)->ssrc.get());
+    }
+
+    void onRtcpPacketDecoded(transport::RtcTransport* sender, memory::UniquePacket packet, uint64_t timestamp) override
+    {
+        ++rtcpPackets;
+    }
+
+    void onConnected(transport::RtcTransport* sender) override {}
+    bool onSctpConnectionRequest(transport::RtcTransport* sender, uint16_t remotePort) override { return true; }
+    void onSctpEstablished(transport::RtcTransport* sender) override { ++sctpEstablished; }
+    void onSctpMessage(transport::RtcTransport* sender,
+        uint16_t streamId,
+        uint16_t streamSequenceNumber,
+        uint32_t payloadProtocol,
+        const void* data,
+        size_t length) override
+    {
+        sctpStreams.push_back(streamId);
+    }
+
+    void onRecControlReceived(transport::RecordingTransport* sender,
+        memory::UniquePacket packet,
+        uint64_t timestamp) override
+    {
+    }
+    void onIceReceived(transport::RtcTransport* transport, uint64_t timestamp) override {}
+
+    std::vector<uint32_t> rtpSsrcs;
+    std::vector<uint16_t> sctpStreams;
+    uint32_t rtcpPackets = 0;
+    uint32_t sctpEstablished = 0;
+};
+
+} // namespace
+
+class BarbellTrunkTest : public ::testing::Test
+{
+    void SetUp() override
+    {
+        _timers = std::make_unique<jobmanager::TimerQueue>(4096);
+        _jobManager = std::make_unique<jobmanager::JobManager>(*_timers);
+        _jobQueue = std::make_unique<jobmanager::JobQueue>(*_jobManager);
+        _allocator = std::make_unique<memory::PacketPoolAllocator>(64, "BarbellTrunkTest");
+        _transport = std::make_shared<DummyRtcTransport>(*_jobQueue, *_allocator);
+        _trunk = std::make_unique<bridge::BarbellTrunk>("trunk-1", _transport);
+    }
+
+    void TearDown() override
+    {
+        _trunk.reset();
+        _transport.reset();
+
+        auto thread = std::make_unique<jobmanager::WorkerThread>(*_jobManager, true);
+        _jobQueue.reset();
+        _timers->stop();
+        _jobManager->stop();
+        thread->stop();
+        _jobManager.reset();
+    }
+
+protected:
+    memory::UniquePacket makeRtpPacket(uint32_t ssrc)
+    {
+        auto packet = memory::makeUniquePacket(*_allocator);
+        auto* rtpHeader = rtp::RtpHeader::create(*packet);
+        rtpHeader->ssrc = ssrc;
+        packet->setLength(rtpHeader->headerLength() + 100);
+        return packet;
+    }
+
+    void receiveDataChannelOpen(uint16_t streamId, const std::string& label)
+    {
+        char data[sizeof(webrtc::DataChannelOpenMessage) + 64];
+        auto& openMessage = webrtc::DataChannelOpenMessage::create(data, label);
+        _trunk->onSctpMessage(_transport.get(),
+            streamId,
+            0,
+            webrtc::DataChannelPpid::WEBRTC_ESTABLISH,
+            data,
+            openMessage.size());
+    }
+
+    std::unique_ptr<jobmanager::TimerQueue> _timers;
+    std::unique_ptr<jobmanager::JobManager> _jobManager;
+    std::unique_ptr<jobmanager::JobQueue> _jobQueue;
+    std::unique_ptr<memory::PacketPoolAllocator> _allocator;
+    std::shared_ptr<transport::RtcTransport> _transport;
+    std::unique_ptr<bridge::BarbellTrunk> _trunk;
+};
+
+TEST_F(BarbellTrunkTest, routesRtpOnSsrc)
+{
+    ReceiverStub conferenceA;
+    ReceiverStub conferenceB;
+    EXPECT_TRUE(_trunk->attach("a", conferenceA, {100, 101}));
+    EXPECT_TRUE(_trunk->attach("b", conferenceB, {200}));
+
+    _trunk->onRtpPacketReceived(_transport.get(), makeRtpPacket(101), 1, 0);
+    _trunk->onRtpPacketReceived(_transport.get(), makeRtpPacket(200), 1, 0);
+    _trunk->onRtpPacketReceived(_transport.get(), makeRtpPacket(300), 1, 0);
+    _trunk->onRtpPacketReceived(_transport.get(), makeRtpPacket(100), 1, 0);
+
+    EXPECT_EQ(std::vector<uint32_t>({101, 100}), conferenceA.rtpSsrcs);
+    EXPECT_EQ(std::vector<uint32_t>({200}), conferenceB.rtpSsrcs);
+
+    _trunk->detach("a");
+    _trunk->onRtpPacketReceived(_transport.get(), makeRtpPacket(100), 1, 0);
+    EXPECT_EQ(2, conferenceA.rtpSsrcs.size());
+    EXPECT_EQ(1, _trunk->getMemberCount());
+}
+
+TEST_F(BarbellTrunkTest, rejectsSsrcCollision)
+{
+    ReceiverStub conferenceA;
+    ReceiverStub conferenceB;
+    EXPECT_TRUE(_trunk->attach("a", conferenceA, {100, 101}));
+    EXPECT_FALSE(_trunk->attach("b", conferenceB, {200, 101}));
+    EXPECT_FALSE(_trunk->attach("a", conferenceB, {300}));
+    EXPECT_EQ(1, _trunk->getMemberCount());
+}
+
+TEST_F(BarbellTrunkTest, detachedSsrcsCanBeReattached)
+{
+    ReceiverStub conferenceA;
+    ReceiverStub conferenceB;
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_TRUE(_trunk->attach("a", conferenceA, {100, 101}));
+        _trunk->detach("a");
+    }
+    EXPECT_TRUE(_trunk->attach("b", conferenceB, {100}));
+
+    _trunk->onRtpPacketReceived(_transport.get(), makeRtpPacket(100), 1, 0);
+    _trunk->onRtpPacketReceived(_transport.get(), makeRtpPacket(101), 1, 0);
+    EXPECT_TRUE(conferenceA.rtpSsrcs.empty());
+    EXPECT_EQ(std::vector<uint32_t>({100}), conferenceB.rtpSsrcs);
+}
+
+TEST_F(BarbellTrunkTest, routesDataChannelOnLabel)
+{
+    ReceiverStub conferenceA;
+    ReceiverStub conferenceB;
+    _trunk->attach("a", conferenceA, {100});
+    _trunk->attach("b", conferenceB, {200});
+
+    _trunk->onSctpEstablished(_transport.get());
+    EXPECT_EQ(1, conferenceA.sctpEstablished);
+    EXPECT_EQ(1, conferenceB.sctpEstablished);
+    EXPECT_TRUE(_trunk->isSctpEstablished());
+
+    receiveDataChannelOpen(4, bridge::BarbellTrunk::makeDataChannelLabel("b"));
+    receiveDataChannelOpen(6, bridge::BarbellTrunk::makeDataChannelLabel("unknown"));
+    const char message[] = "{}";
+    _trunk->onSctpMessage(_transport.get(), 4, 1, webrtc::DataChannelPpid::WEBRTC_STRING, message, 2);
+    _trunk->onSctpMessage(_transport.get(), 6, 1, webrtc::DataChannelPpid::WEBRTC_STRING, message, 2);
+
+    EXPECT_TRUE(conferenceA.sctpStreams.empty());
+    EXPECT_EQ(std::vector<uint16_t>({4, 4}), conferenceB.sctpStreams);
+}
+
+TEST_F(BarbellTrunkTest, rtcpFeedbackCopiedToEachConference)
+{
+    ReceiverStub conferenceA;
+    ReceiverStub conferenceB;
+    _trunk->attach("a", conferenceA, {100});
+    _trunk->attach("b", conferenceB, {200});
+
+    auto packet = memory::makeUniquePacket(*_allocator);
+    auto* pliA = rtp::createPLI(packet->get(), 1, 100);
+    auto* pliB = rtp::createPLI(packet->get() + pliA->header.size(), 1, 200);
+    packet->setLength(pliA->header.size() + pliB->header.size());
+
+    _trunk->onRtcpPacketDecoded(_transport.get(), std::move(packet), 0);
+    EXPECT_EQ(1, conferenceA.rtcpPackets);
+    EXPECT_EQ(1, conferenceB.rtcpPackets);
+}
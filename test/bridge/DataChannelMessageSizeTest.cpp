@@ -103,7 +103,8 @@ struct MixerTestScope
           backgroundJobManagerProcessor(timeQueue),
           mainPacketAllocator(128 * 1024, "MainAllocator-test"),
           sendPacketAllocator(32 * 1024, "SendAllocator-test"),
-          audioPacketAllocator(4 * 1024, "AudioAllocator-test")
+          audioPacketAllocator(4 * 1024, "AudioAllocator-test"),
+          opusCodecPool(0, 16)
     {
     }
 
@@ -117,6 +118,7 @@ struct MixerTestScope
     memory::PacketPoolAllocator mainPacketAllocator;
     memory::PacketPoolAllocator sendPacketAllocator;
     memory::AudioPacketPoolAllocator audioPacketAllocator;
+    codec::OpusCodecPool opusCodecPool;
 };
 } // namespace
 
@@ -233,6 +235,7 @@ protected:
             _config,
             _testScope->sendPacketAllocator,
             _testScope->audioPacketAllocator,
+            _testScope->opusCodecPool,
             _testScope->mainPacketAllocator,
             audioSsrcs,
             videoSsrcs,
@@ -28,6 +28,8 @@ public:
     bool unprotectFirstRtp(memory::Packet& packet, uint32_t& roc) override { return true; }
     void removeSrtpLocalSsrc(const uint32_t ssrc) override {}
     bool setSrtpRemoteRolloverCounter(const uint32_t ssrc, const uint32_t rolloverCounter) override { return true; }
+    void rejectInboundSsrc(const uint32_t ssrc) override {}
+    void clearRejectedInboundSsrcs() override {}
     bool isGatheringComplete() const override { return true; }
     ice::IceCandidates getLocalCandidates() override { return ice::IceCandidates(); }
     std::pair<std::string, std::string> getLocalIceCredentials() override
@@ -64,7 +66,6 @@ public:
     bool isIceEnabled() const override { return true; }
 
     void connect() override {}
-    void runTick(uint64_t timestamp) override {}
     jobmanager::JobQueue& getJobQueue() override { return _jobQueue; }
     uint32_t getPacingQueueCount() const override { return 0; }
     uint32_t getRtxPacingQueueCount() const override { return 0; }
@@ -126,6 +127,7 @@ public:
     uint64_t getLastReceivedPacketTimestamp() const override { return 0; }
     void getSdesKeys(std::vector<srtp::AesKey>& sdesKeys) const override {}
     void asyncSetRemoteSdesKey(const srtp::AesKey& key) override {}
+    bool dumpPacketRecords(const char* reason) override { return false; }
 
     logger::LoggableId _loggableId;
     size_t _endpointIdHash;
@@ -0,0 +1,57 @@
+#include "bridge/engine/EngineMixer.h"
+#include "mocks/EngineMixerSpy.h"
+#include "mocks/RtcTransportMock.h"
+#include "utils/Time.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace testing;
+
+class EngineMixerHibernationTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _resources = std::make_unique<test::EngineMixerSpy::EngineMixerResources>();
+        _resources->config.readFromString(R"({"hibernation.enable": true})");
+        _engineMixer = std::make_unique<test::EngineMixerSpy>(*_resources);
+    }
+
+    void TearDown() override
+    {
+        _engineMixer = nullptr;
+        _resources = nullptr;
+    }
+
+    std::unique_ptr<test::EngineMixerSpy::EngineMixerResources> _resources;
+    std::unique_ptr<test::EngineMixerSpy> _engineMixer;
+};
+
+TEST_F(EngineMixerHibernationTest, hibernatesWhenIdleAndWakesOnPacket)
+{
+    auto timestamp = utils::Time::getAbsoluteTime();
+    _engineMixer->run(timestamp);
+    EXPECT_FALSE(_engineMixer->isHibernating());
+
+    timestamp += (_resources->config.hibernation.idleTimeoutMs + 10) * utils::Time::ms;
+    _engineMixer->run(timestamp);
+    EXPECT_TRUE(_engineMixer->isHibernating());
+
+    NiceMock<test::RtcTransportMock> transport;
+    auto packet = memory::makeUniquePacket(_resources->mainAllocator);
+    packet->setLength(100);
+    _engineMixer->onRtcpPacketDecoded(&transport, std::move(packet), timestamp);
+    EXPECT_FALSE(_engineMixer->isHibernating());
+}
+
+TEST_F(EngineMixerHibernationTest, wakeUpLeavesHibernation)
+{
+    const auto timestamp =
+        utils::Time::getAbsoluteTime() + (_resources->config.hibernation.idleTimeoutMs + 10) * utils::Time::ms;
+    _engineMixer->run(timestamp);
+    ASSERT_TRUE(_engineMixer->isHibernating());
+
+    _engineMixer->wakeUp();
+    EXPECT_FALSE(_engineMixer->isHibernating());
+}
@@ -168,7 +168,8 @@ struct MixerTestScope
           wtJobManagerProcessor(timeQueue),
           backgroundJobManagerProcessor(timeQueue),
           mainPacketAllocator(4096, "MixerTestPoolAllocator"),
-          audioPacketAllocator(4096, "MixerTestAudioPoolAllocator")
+          audioPacketAllocator(4096, "MixerTestAudioPoolAllocator"),
+          opusCodecPool(0, 16)
     {
     }
 
@@ -181,6 +182,7 @@ struct MixerTestScope
     JobManagerProcessor backgroundJobManagerProcessor;
     memory::PacketPoolAllocator mainPacketAllocator;
     memory::AudioPacketPoolAllocator audioPacketAllocator;
+    codec::OpusCodecPool opusCodecPool;
 };
 
 } // namespace
@@ -209,6 +211,7 @@ protected:
             _config,
             _testScope->mainPacketAllocator,
             _testScope->audioPacketAllocator,
+            _testScope->opusCodecPool,
             _testScope->mainPacketAllocator,
             audioSsrc,
             videoSsrcs,
@@ -109,6 +109,38 @@ TEST_F(VideoForwarderRtxReceiveJobTest, processRtxPacket)
     ASSERT_EQ(originalRtxSize - 2, incomingPacketInfo.packet()->getLength());
 }
 
+TEST_F(VideoForwarderRtxReceiveJobTest, keyFrameIsDetectedOnce)
+{
+    const uint32_t seqNo = 13;
+    const uint32_t rtxSeqNo = 2;
+    NiceMock<RtcTransportMock> transportMock;
+    EXPECT_CALL(transportMock, unprotectFirstRtp(_, _)).WillRepeatedly(Return(true));
+    EXPECT_CALL(transportMock, unprotect(_)).WillRepeatedly(Return(true));
+
+    auto& incomingQueue = _engineMixerSpy->spyIncomingForwarderVideoRtp();
+    for (const bool keyFrame : {true, false})
+    {
+        _ssrcMainInboundContext->videoMissingPacketsTracker->onMissingPacket(seqNo, 1000);
+        auto packet = makeRtxPacket(rtxSeqNo, seqNo);
+        auto payload = rtp::RtpHeader::fromPacket(*packet)->getPayload();
+        payload[2] = 0x10; // VP8 start of partition 0
+        payload[3] = keyFrame ? 0x00 : 0x01;
+
+        VideoForwarderRtxReceiveJob job(std::move(packet),
+            &transportMock,
+            *_engineMixerSpy,
+            *_ssrcRtxInboundContext,
+            *_ssrcMainInboundContext,
+            _ssrcMainInboundContext->ssrc,
+            1000);
+        job.run();
+
+        EngineMixerSpy::IncomingPacketInfo incomingPacketInfo;
+        ASSERT_TRUE(incomingQueue.pop(incomingPacketInfo));
+        EXPECT_EQ(keyFrame, incomingPacketInfo.metadata().isKeyFrame);
+    }
+}
+
 TEST_F(VideoForwarderRtxReceiveJobTest, shouldDropPaddingPackets)
 {
     const uint32_t seqNo = 13;
@@ -92,3 +92,31 @@ TEST_F(VideoMissingPacketsTrackerTest, doubleRtx)
     _videoMissingPacketsTracker->process(timestamp, rtt, missingSequenceNumbers);
     EXPECT_FALSE(_videoMissingPacketsTracker->onPacketArrived(2));
 }
+
+TEST_F(VideoMissingPacketsTrackerTest, nextProcessTime)
+{
+    const uint64_t rtt = 30 * utils::Time::ms;
+    EXPECT_EQ(0, _videoMissingPacketsTracker->getNextProcessTime(rtt));
+
+    uint64_t timestamp = utils::Time::sec;
+    _videoMissingPacketsTracker->onMissingPacket(1, timestamp);
+    _videoMissingPacketsTracker->onMissingPacket(2, timestamp + 10 * utils::Time::ms);
+
+    std::array<uint16_t, bridge::VideoMissingPacketsTracker::maxMissingPackets> missingSequenceNumbers;
+    const auto nextProcessTime = _videoMissingPacketsTracker->getNextProcessTime(rtt);
+    EXPECT_EQ(0, _videoMissingPacketsTracker->process(nextProcessTime - 1, rtt, missingSequenceNumbers));
+    EXPECT_EQ(1, _videoMissingPacketsTracker->process(nextProcessTime, rtt, missingSequenceNumbers));
+    EXPECT_EQ(1, missingSequenceNumbers[0]);
+
+    // second packet first NACK is due before the retry of the first
+    timestamp = nextProcessTime;
+    EXPECT_EQ(timestamp + 10 * utils::Time::ms, _videoMissingPacketsTracker->getNextProcessTime(rtt));
+    EXPECT_EQ(1, _videoMissingPacketsTracker->process(timestamp + 10 * utils::Time::ms, rtt, missingSequenceNumbers));
+    EXPECT_EQ(2, missingSequenceNumbers[0]);
+
+    EXPECT_TRUE(_videoMissingPacketsTracker->onPacketArrived(2));
+    EXPECT_EQ(timestamp + 100 * utils::Time::ms + 1, _videoMissingPacketsTracker->getNextProcessTime(rtt));
+
+    EXPECT_TRUE(_videoMissingPacketsTracker->onPacketArrived(1));
+    EXPECT_EQ(0, _videoMissingPacketsTracker->getNextProcessTime(rtt));
+}
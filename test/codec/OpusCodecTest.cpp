@@ -1,4 +1,5 @@
 #include "codec/AudioLevel.h"
+#include "codec/OpusCodecPool.h"
 #include "codec/OpusDecoder.h"
 #include "codec/OpusEncoder.h"
 #include "logger/Logger.h"
@@ -144,3 +145,42 @@ TEST_F(OpusTest, seqSkip)
     auto dB = codec::computeAudioLevel(_pcmData, samples);
     EXPECT_EQ(static_cast<int>(-27), -dB);
 }
+
+TEST_F(OpusTest, pooledCodecsAreResetOnReuse)
+{
+    codec::OpusCodecPool pool(1, 2);
+
+    uint32_t sequenceNumber = 10;
+    int16_t decodeBuffer[samples * 2];
+    codec::OpusDecoder* firstDecoder = nullptr;
+    {
+        auto encoder = pool.acquireEncoder();
+        auto decoder = pool.acquireDecoder();
+        firstDecoder = decoder.get();
+        EXPECT_EQ(2, pool.getHitCount());
+        EXPECT_EQ(0, pool.getMissCount());
+
+        const auto opusBytes = encoder->encode(_pcmData, samples, _opusData, samples);
+        EXPECT_GT(opusBytes, 100);
+        EXPECT_EQ(samples,
+            decoder->decode(sequenceNumber,
+                _opusData,
+                opusBytes,
+                reinterpret_cast<unsigned char*>(decodeBuffer),
+                samples));
+        EXPECT_TRUE(decoder->hasDecoded());
+
+        auto extraDecoder = pool.acquireDecoder();
+        EXPECT_EQ(1, pool.getMissCount());
+    }
+    EXPECT_EQ(1, pool.getIdleEncoderCount());
+    EXPECT_EQ(2, pool.getIdleDecoderCount());
+
+    auto decoderA = pool.acquireDecoder();
+    auto decoderB = pool.acquireDecoder();
+    EXPECT_EQ(4, pool.getHitCount());
+    EXPECT_TRUE(decoderA.get() == firstDecoder || decoderB.get() == firstDecoder);
+    EXPECT_FALSE(decoderA->hasDecoded());
+    EXPECT_FALSE(decoderB->hasDecoded());
+    EXPECT_EQ(1, decoderA->getExpectedSequenceNumber());
+}
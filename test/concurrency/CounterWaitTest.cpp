@@ -0,0 +1,51 @@
+#include "concurrency/CounterWait.h"
+#include "utils/ScopedIncrement.h"
+#include "utils/Time.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(CounterWaitTest, wakesWhenDrained)
+{
+    std::atomic_uint32_t counter(2);
+
+    std::thread worker([&counter]() {
+        utils::Time::rawNanoSleep(20 * utils::Time::ms);
+        concurrency::decrementAndNotify(counter);
+        utils::Time::rawNanoSleep(20 * utils::Time::ms);
+        concurrency::decrementAndNotify(counter);
+    });
+
+    const auto start = utils::Time::rawAbsoluteTime();
+    EXPECT_TRUE(concurrency::waitForZero(counter, 5 * utils::Time::sec));
+    const auto waitTime = utils::Time::rawAbsoluteTime() - start;
+    worker.join();
+
+    EXPECT_EQ(0, counter.load());
+    EXPECT_GE(waitTime, 35 * utils::Time::ms);
+    EXPECT_LT(waitTime, 2 * utils::Time::sec);
+}
+
+TEST(CounterWaitTest, timesOut)
+{
+    std::atomic_uint32_t counter(0);
+    EXPECT_TRUE(concurrency::waitForZero(counter, 0));
+
+    utils::ScopedIncrement pendingJob(counter);
+    const auto start = utils::Time::rawAbsoluteTime();
+    EXPECT_FALSE(concurrency::waitForZero(counter, 30 * utils::Time::ms));
+    EXPECT_GE(utils::Time::rawAbsoluteTime() - start, 30 * utils::Time::ms);
+}
+
+TEST(CounterWaitTest, scopedIncrementNotifies)
+{
+    std::atomic_uint32_t counter(0);
+    auto job = std::make_unique<utils::ScopedIncrement>(counter);
+
+    std::thread worker([&job]() {
+        utils::Time::rawNanoSleep(10 * utils::Time::ms);
+        job.reset();
+    });
+
+    EXPECT_TRUE(concurrency::waitForZero(counter, 5 * utils::Time::sec));
+    worker.join();
+}
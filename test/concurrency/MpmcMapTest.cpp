@@ -608,3 +608,83 @@ TEST(MpmcMap, zeroCapacity)
     EXPECT_EQ(0, hmap.capacity());
     EXPECT_EQ(true, hmap.empty());
 }
+
+TEST(MpmcMap, growth)
+{
+    using HMap = concurrency::MpmcHashmap32<uint32_t, RequiresDestruction>;
+    auto hmap = new HMap(8, 100);
+    EXPECT_EQ(100, hmap->capacity());
+    EXPECT_EQ(8, hmap->allocatedCapacity());
+    const auto initialBytes = hmap->getAllocatedBytes();
+
+    std::atomic_int count(0);
+    std::vector<RequiresDestruction*> items;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        auto result = hmap->emplace(i, count);
+        ASSERT_TRUE(result.second);
+        items.push_back(&result.first->second);
+    }
+    EXPECT_FALSE(hmap->emplace(100, count).second);
+    EXPECT_EQ(100, hmap->size());
+    EXPECT_EQ(100, hmap->allocatedCapacity());
+    EXPECT_GT(hmap->getAllocatedBytes(), initialBytes);
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(items[i], hmap->getItem(i)); // elements do not move when map grows
+    }
+
+    for (uint32_t i = 0; i < 100; i += 2)
+    {
+        EXPECT_TRUE(hmap->erase(i));
+    }
+    EXPECT_EQ(50, hmap->size());
+
+    uint32_t iterated = 0;
+    for (auto& item : *hmap)
+    {
+        EXPECT_EQ(1, item.first % 2);
+        ++iterated;
+    }
+    EXPECT_EQ(50, iterated);
+
+    for (uint32_t i = 200; i < 250; ++i)
+    {
+        EXPECT_TRUE(hmap->emplace(i, count).second);
+    }
+    EXPECT_EQ(100, hmap->allocatedCapacity());
+    EXPECT_EQ(100, hmap->size());
+
+    delete hmap;
+    EXPECT_EQ(count, 0);
+}
+
+TEST(MpmcMap, concurrentGrowth)
+{
+    using HMap = concurrency::MpmcHashmap32<uint32_t, uint32_t>;
+    HMap hmap(4, 4096);
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&hmap, t]() {
+            for (uint32_t i = 0; i < 1024; ++i)
+            {
+                EXPECT_TRUE(hmap.emplace(t * 1024 + i, i + 1).second);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(4096, hmap.size());
+    for (uint32_t key = 0; key < 4096; ++key)
+    {
+        auto* value = hmap.getItem(key);
+        ASSERT_NE(nullptr, value);
+        EXPECT_EQ(key % 1024 + 1, *value);
+    }
+}
@@ -1,6 +1,10 @@
+#include "concurrency/GrowingMpmcQueue.h"
 #include "concurrency/MpmcQueue.h"
 #include "TestValues.h"
+#include <atomic>
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 using namespace concurrency;
 
@@ -29,3 +33,172 @@ TEST(MpmcQueue, zeroElements)
     EXPECT_EQ(true, queue.full());
     EXPECT_EQ(true, queue.empty());
 }
+
+TEST(GrowingMpmcQueue, zeroElements)
+{
+    GrowingMpmcQueue<Simple> queue(0);
+
+    Simple v;
+    EXPECT_EQ(0, queue.size());
+    EXPECT_EQ(0, queue.capacity());
+    EXPECT_EQ(true, queue.full());
+    EXPECT_EQ(true, queue.empty());
+    EXPECT_EQ(false, queue.push(v));
+    EXPECT_EQ(false, queue.pop(v));
+}
+
+TEST(GrowingMpmcQueue, growsToMaxCapacity)
+{
+    GrowingMpmcQueue<Simple> queue(16, 1024);
+    EXPECT_EQ(1024, queue.capacity());
+    EXPECT_LE(queue.allocatedCapacity(), 32);
+    const auto initialBytes = queue.getAllocatedBytes();
+
+    uint32_t pushed = 0;
+    while (queue.push(Simple(pushed, 0)))
+    {
+        ++pushed;
+    }
+    EXPECT_GE(pushed, 1024);
+    EXPECT_EQ(pushed, queue.size());
+    EXPECT_EQ(true, queue.full());
+    EXPECT_GT(queue.getAllocatedBytes(), initialBytes);
+
+    Simple v;
+    for (uint32_t i = 0; i < pushed; ++i)
+    {
+        ASSERT_TRUE(queue.pop(v));
+        EXPECT_EQ(i, v.ssrc);
+    }
+    EXPECT_EQ(true, queue.empty());
+    EXPECT_EQ(false, queue.pop(v));
+
+    const auto allocated = queue.allocatedCapacity();
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        EXPECT_TRUE(queue.push(Simple(i, 0)));
+    }
+    EXPECT_EQ(allocated, queue.allocatedCapacity());
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(queue.pop(v));
+    }
+}
+
+TEST(GrowingMpmcQueue, refillKeepsCapacity)
+{
+    GrowingMpmcQueue<Simple> queue(256, 8192);
+
+    Simple v;
+    for (uint32_t round = 0; round < 3; ++round)
+    {
+        uint32_t pushed = 0;
+        while (queue.push(Simple(pushed, round)))
+        {
+            ++pushed;
+        }
+        EXPECT_EQ(8192, pushed);
+        EXPECT_EQ(8192, queue.allocatedCapacity());
+        EXPECT_EQ(true, queue.full());
+
+        // drained segments are not refilled while newer segments still hold elements
+        for (uint32_t i = 0; i < 1000; ++i)
+        {
+            ASSERT_TRUE(queue.pop(v));
+        }
+        EXPECT_FALSE(queue.push(Simple(0, round)));
+
+        uint32_t popped = 1000;
+        while (queue.pop(v))
+        {
+            EXPECT_EQ(popped, v.ssrc);
+            ++popped;
+        }
+        EXPECT_EQ(8192, popped);
+        EXPECT_EQ(true, queue.empty());
+        EXPECT_EQ(8192, queue.allocatedCapacity());
+    }
+}
+
+TEST(GrowingMpmcQueue, keepsOrderAfterSpill)
+{
+    GrowingMpmcQueue<Simple> queue(16, 1024);
+
+    Simple v;
+    uint32_t pushed = 0;
+    uint32_t popped = 0;
+    for (uint32_t round = 0; round < 50; ++round)
+    {
+        // push bursts larger than the first segment while only partially draining between them
+        for (uint32_t i = 0; i < 40 && queue.push(Simple(pushed, 0)); ++i)
+        {
+            ++pushed;
+        }
+        for (uint32_t i = 0; i < 30 && queue.pop(v); ++i)
+        {
+            ASSERT_EQ(popped, v.ssrc);
+            ++popped;
+        }
+    }
+
+    while (queue.pop(v))
+    {
+        ASSERT_EQ(popped, v.ssrc);
+        ++popped;
+    }
+    EXPECT_EQ(pushed, popped);
+    EXPECT_GT(pushed, 1024);
+}
+
+TEST(GrowingMpmcQueue, keepsProducerOrder)
+{
+    GrowingMpmcQueue<SimpleSmall> queue(8, 512);
+    const uint32_t producerCount = 3;
+    const int itemCount = 20000;
+
+    std::atomic_uint32_t runningProducers(producerCount);
+    std::vector<std::thread> producers;
+    for (uint32_t producer = 0; producer < producerCount; ++producer)
+    {
+        producers.emplace_back([&queue, &runningProducers, producer]() {
+            for (int i = 0; i < itemCount;)
+            {
+                if (queue.push(SimpleSmall(producer, i)))
+                {
+                    ++i;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+            --runningProducers;
+        });
+    }
+
+    std::vector<int> nextSeqNo(producerCount, 0);
+    bool inOrder = true;
+    SimpleSmall v;
+    while (runningProducers > 0 || !queue.empty())
+    {
+        if (queue.pop(v))
+        {
+            inOrder = inOrder && nextSeqNo[v.ssrc] == v.seqNo;
+            nextSeqNo[v.ssrc] = v.seqNo + 1;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto& thread : producers)
+    {
+        thread.join();
+    }
+    EXPECT_TRUE(inOrder);
+    for (auto seqNo : nextSeqNo)
+    {
+        EXPECT_EQ(itemCount, seqNo);
+    }
+}
@@ -0,0 +1,71 @@
+#include "concurrency/ThreadUtils.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(ThreadUtilsTest, cpuListRoundTrip)
+{
+    concurrency::CpuList cpus;
+    EXPECT_TRUE(concurrency::parseCpuList("8,0-3,10-11,2", cpus));
+    EXPECT_EQ(concurrency::CpuList({0, 1, 2, 3, 8, 10, 11}), cpus);
+    EXPECT_EQ("0-3,8,10-11", concurrency::formatCpuList(cpus));
+
+    EXPECT_TRUE(concurrency::parseCpuList("", cpus));
+    EXPECT_TRUE(cpus.empty());
+    EXPECT_EQ("", concurrency::formatCpuList(cpus));
+}
+
+TEST(ThreadUtilsTest, invalidCpuList)
+{
+    concurrency::CpuList cpus;
+    EXPECT_FALSE(concurrency::parseCpuList("3-1", cpus));
+    EXPECT_FALSE(concurrency::parseCpuList("1,,2", cpus));
+    EXPECT_FALSE(concurrency::parseCpuList("a", cpus));
+    EXPECT_FALSE(concurrency::parseCpuList("1-", cpus));
+    EXPECT_FALSE(concurrency::parseCpuList("1,", cpus));
+    EXPECT_FALSE(concurrency::parseCpuList("-1", cpus));
+    EXPECT_FALSE(concurrency::parseCpuList("0--1", cpus));
+    EXPECT_FALSE(concurrency::parseCpuList(" 1", cpus));
+    EXPECT_FALSE(concurrency::parseCpuList("+1", cpus));
+    EXPECT_FALSE(concurrency::parseCpuList("0-99999999999999999999", cpus));
+    EXPECT_FALSE(concurrency::parseCpuList("100000", cpus));
+    EXPECT_TRUE(concurrency::parseCpuList("1023", cpus));
+}
+
+TEST(ThreadUtilsTest, pinThread)
+{
+#ifdef __APPLE__
+    GTEST_SKIP();
+#else
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    ASSERT_EQ(0, pthread_getaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet));
+    uint32_t allowedCpu = 0;
+    while (!CPU_ISSET(allowedCpu, &cpuSet))
+    {
+        ++allowedCpu;
+    }
+
+    std::atomic_bool running(true);
+    std::thread thread([&running]() {
+        while (running)
+        {
+            std::this_thread::yield();
+        }
+    });
+
+    EXPECT_TRUE(concurrency::setAffinity(thread, {allowedCpu}));
+    EXPECT_FALSE(concurrency::setAffinity(thread, {}));
+
+    CPU_ZERO(&cpuSet);
+    EXPECT_EQ(0, pthread_getaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet));
+    EXPECT_EQ(1, CPU_COUNT(&cpuSet));
+    EXPECT_TRUE(CPU_ISSET(allowedCpu, &cpuSet));
+
+    running = false;
+    thread.join();
+
+    std::thread notStarted;
+    EXPECT_FALSE(concurrency::setAffinity(notStarted, {allowedCpu}));
+#endif
+}
@@ -23,6 +23,7 @@ struct EngineMixerSpy : public bridge::EngineMixer
               config(),
               senderAllocator(1024, "SenderAllocator-EngineMixerResources"),
               audioAllocator(1024, "AudioAllocator - EngineMixerResources"),
+              opusCodecPool(0, 16),
               mainAllocator(1024, "MainAllocator - EngineMixerResources")
         {
         }
@@ -36,6 +37,7 @@ struct EngineMixerSpy : public bridge::EngineMixer
         config::Config config;
         memory::PacketPoolAllocator senderAllocator;
         memory::AudioPacketPoolAllocator audioAllocator;
+        codec::OpusCodecPool opusCodecPool;
         memory::PacketPoolAllocator mainAllocator;
     };
 
@@ -59,6 +61,7 @@ public:
               resources.config,
               resources.senderAllocator,
               resources.audioAllocator,
+              resources.opusCodecPool,
               resources.mainAllocator,
               {4373732u},
               {api::makeSsrcGroup({{3746438, 363463}, {482473, 754432}, {93232326, 55443221}}),
@@ -78,10 +81,19 @@ public:
     }
 
 public:
-    concurrency::MpmcQueue<IncomingSctpMessagePacketInfo>& spyIncomingBarbellSctp() { return _incomingBarbellSctp; };
-    concurrency::MpmcQueue<IncomingPacketInfo>& spyIncomingForwarderAudioRtp() { return _incomingForwarderAudioRtp; };
-    concurrency::MpmcQueue<IncomingPacketInfo>& spyIncomingRtcp() { return _incomingRtcp; };
-    concurrency::MpmcQueue<IncomingPacketInfo>& spyIncomingForwarderVideoRtp() { return _incomingForwarderVideoRtp; };
+    concurrency::GrowingMpmcQueue<IncomingSctpMessagePacketInfo>& spyIncomingBarbellSctp()
+    {
+        return _incomingBarbellSctp;
+    }
+    concurrency::GrowingMpmcQueue<IncomingPacketInfo>& spyIncomingForwarderAudioRtp()
+    {
+        return _incomingForwarderAudioRtp;
+    }
+    concurrency::GrowingMpmcQueue<IncomingPacketInfo>& spyIncomingRtcp() { return _incomingRtcp; };
+    concurrency::GrowingMpmcQueue<IncomingPacketInfo>& spyIncomingForwarderVideoRtp()
+    {
+        return _incomingForwarderVideoRtp;
+    }
 
     concurrency::MpmcHashmap32<size_t, bridge::EngineAudioStream*>& spyEngineAudioStreams()
     {
@@ -12,6 +12,8 @@ class RtcTransportMock : public TransportMock<transport::RtcTransport>
 public:
     MOCK_METHOD(void, removeSrtpLocalSsrc, (const uint32_t ssrc), (override));
     MOCK_METHOD(bool, setSrtpRemoteRolloverCounter, (const uint32_t ssrc, const uint32_t rolloverCounter), (override));
+    MOCK_METHOD(void, rejectInboundSsrc, (const uint32_t ssrc), (override));
+    MOCK_METHOD(void, clearRejectedInboundSsrcs, (), (override));
 
     MOCK_METHOD(bool, isGatheringComplete, (), (const override));
     MOCK_METHOD(ice::IceCandidates, getLocalCandidates, (), (override));
@@ -76,7 +78,6 @@ public:
         (const uint32_t ssrc, uint32_t* sequenceCounter, const uint16_t payloadType),
         (override));
 
-    MOCK_METHOD(void, runTick, (uint64_t timestamp), (override));
     MOCK_METHOD(ice::IceSession::State, getIceState, (), (const override));
     MOCK_METHOD(transport::SrtpClient::State, getDtlsState, (), (const override));
 
@@ -96,6 +97,7 @@ public:
 
     MOCK_METHOD(void, getSdesKeys, (std::vector<srtp::AesKey> & sdesKeys), (const override));
     MOCK_METHOD(void, asyncSetRemoteSdesKey, (const srtp::AesKey& key), (override));
+    MOCK_METHOD(bool, dumpPacketRecords, (const char* reason), (override));
 };
 
 } // namespace test
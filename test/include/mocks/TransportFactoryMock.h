@@ -70,6 +70,8 @@ public:
         (override));
 
     MOCK_METHOD(EndpointMetrics, getSharedUdpEndpointsMetrics, (), (const override));
+    MOCK_METHOD(transport::IngressDrops, getIngressDrops, (), (const override));
+    MOCK_METHOD(transport::DtlsHandshakeStats, getDtlsHandshakeStats, (), (const override));
     MOCK_METHOD(bool, isGood, (), (const override));
 
     MOCK_METHOD(std::shared_ptr<transport::RtcTransport>,
@@ -499,7 +499,9 @@ TEST_F(IntegrationTest, probing)
         startSimulation();
         logger::debug("%s", "", iceJson.dump(4).c_str());
 
-        api::Ice ice = api::Parser::parseIce(iceJson);
+        const auto iceText = iceJson.dump();
+        const json::reader::Document iceDocument(iceText.c_str(), iceText.size());
+        api::Ice ice = api::Parser::parseIce(iceDocument.getRoot());
         auto candidatesAndCredentials = bridge::getIceCandidatesAndCredentials(ice);
 
         // Setup transport and attempt to connect to trigger ICE probing
@@ -20,6 +20,18 @@ public:
     CFG_PROP(uint16_t, rampup, 0);
     CFG_PROP(uint16_t, max_rampup, 0);
     CFG_PROP(uint16_t, duration, 60);
+
+    // in-process synthetic clients, see test/load
+    CFG_GROUP()
+    CFG_PROP(uint32_t, conferences, 20);
+    CFG_PROP(uint32_t, participants, 10); // per conference
+    CFG_PROP(uint32_t, audioSenders, 2); // per conference
+    CFG_PROP(uint32_t, videoSenders, 2); // per conference
+    CFG_PROP(uint32_t, nacksPerSecond, 2); // per receiving client
+    CFG_PROP(uint32_t, downlinkKbps, 2500);
+    CFG_PROP(uint32_t, generatorThreads, 2);
+    CFG_PROP(uint16_t, duration, 20);
+    CFG_GROUP_END(synthetic);
 };
 
 } // namespace config
@@ -29,6 +29,7 @@
 #include "transport/TransportFactory.h"
 #include "transport/dtls/SrtpClientFactory.h"
 #include "transport/dtls/SslDtls.h"
+#include "utils/Format.h"
 #include "utils/IdGenerator.h"
 #include "utils/MersienneRandom.h"
 #include "utils/StringBuilder.h"
@@ -37,6 +38,8 @@
 #include <complex>
 #include <memory>
 #include <sstream>
+#include <thread>
+#include <unistd.h>
 #include <unordered_set>
 
 namespace config
@@ -525,3 +528,75 @@ TEST_F(RealTimeTest, localVideoMeeting)
 
     group.awaitPendingJobs(utils::Time::sec * 4);
 }
+
+TEST_F(RealTimeTest, socketHandoverBetweenBridges)
+{
+    const auto configJson = utils::format(R"({
+        "ip":"127.0.0.1",
+        "ice.preferredIp":"127.0.0.1",
+        "ice.publicIpv4":"127.0.0.1",
+        "handover.path":"/tmp/smb-handover-realtime-%d",
+        "log.level": "INFO"
+        })",
+        ::getpid());
+
+    _bridgeConfig.readFromString(configJson);
+    initRealBridge(_bridgeConfig);
+    ASSERT_TRUE(_bridge->isInitialized());
+
+    std::atomic_bool handoverRequested(false);
+    _bridge->startHandoverServer([&handoverRequested]() { handoverRequested = true; });
+
+    config::Config newBridgeConfig;
+    newBridgeConfig.readFromString(configJson);
+    std::unique_ptr<bridge::Bridge> newBridge;
+    std::atomic_bool newBridgeInitialized(false);
+    std::thread newProcess([&]() {
+        newBridge = std::make_unique<bridge::Bridge>(newBridgeConfig);
+        newBridge->initialize();
+        newBridgeInitialized = true;
+    });
+
+    for (int i = 0; i < 500 && !handoverRequested; ++i)
+    {
+        utils::Time::nanoSleep(10 * utils::Time::ms);
+    }
+    EXPECT_TRUE(handoverRequested);
+
+    // the new bridge does not touch the ports while the old one is still receiving on them
+    utils::Time::nanoSleep(200 * utils::Time::ms);
+    EXPECT_FALSE(newBridgeInitialized);
+
+    _bridge.reset();
+    newProcess.join();
+    ASSERT_TRUE(newBridge->isInitialized());
+    _bridge = std::move(newBridge);
+
+    // clients of the old bridge reconnect to the new one on the same ports
+    const auto baseUrl = "http://127.0.0.1:8080";
+    GroupCall<SfuClient<Channel>> group(nullptr,
+        _instanceCounter,
+        *_mainPoolAllocator,
+        _audioAllocator,
+        *_clientTransportFactory,
+        *_clientTransportFactory,
+        *_sslDtls,
+        2);
+
+    Conference conf(nullptr);
+    ASSERT_TRUE(group.startConference(conf, baseUrl));
+    CallConfigBuilder cfg(conf.getId());
+    cfg.url(baseUrl).withAudio();
+
+    group.clients[0]->initiateCall(cfg.build());
+    group.clients[1]->joinCall(cfg.build());
+    ASSERT_TRUE(group.connectAll(utils::Time::sec * _clientsConnectionTimeout));
+
+    group.disconnectClients();
+    for (auto& client : group.clients)
+    {
+        client->stopTransports();
+    }
+
+    group.awaitPendingJobs(utils::Time::sec * 4);
+}
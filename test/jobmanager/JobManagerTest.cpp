@@ -4,6 +4,7 @@
 #include "jobmanager/WorkerThread.h"
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <memory>
 #include <random>
@@ -400,3 +401,78 @@ TEST_F(JobManagerTest, jobQueueDeletion)
     // in the ~JobQueue and process the remaining queued jobs.
     utils::Time::nanoSleep(utils::Time::ms * 30);
 }
+
+TEST_F(JobManagerTest, jobQueueExecutor)
+{
+    JobManager otherJobManager(timers);
+    WorkerThread otherWorker(otherJobManager, true, "OtherWorker");
+
+    JobQueue serialJobs(jobManager);
+    atomic_int32_t serialConcurrency(0);
+    atomic_int32_t completed(0);
+    atomic_int32_t onOtherWorker(0);
+    auto runJob = [&]() {
+        EXPECT_EQ(1, ++serialConcurrency);
+        char name[32] = {0};
+        size_t length = sizeof(name);
+        concurrency::getThreadName(name, length);
+        if (strcmp(name, "OtherWorker") == 0)
+        {
+            ++onOtherWorker;
+        }
+        usleep(10);
+        --serialConcurrency;
+        ++completed;
+    };
+
+    serialJobs.setExecutor(otherJobManager);
+    for (int i = 0; i < 100; ++i)
+    {
+        serialJobs.post(runJob);
+    }
+    for (int i = 0; i < 500 && completed < 100; ++i)
+    {
+        usleep(1000);
+    }
+    EXPECT_EQ(100, onOtherWorker.load());
+    usleep(1000); // run job on other worker to finish
+
+    serialJobs.resetExecutor();
+    for (int i = 0; i < 100; ++i)
+    {
+        serialJobs.post(runJob);
+    }
+    for (int i = 0; i < 500 && completed < 200; ++i)
+    {
+        usleep(1000);
+    }
+    EXPECT_EQ(200, completed.load());
+    EXPECT_EQ(100, onOtherWorker.load());
+
+    otherJobManager.stop();
+    otherWorker.stop();
+}
+
+TEST_F(JobManagerTest, jobQueueCost)
+{
+    JobQueue serialJobs(jobManager);
+    EXPECT_EQ(0, serialJobs.getCost().getTime());
+
+    atomic_int32_t completed(0);
+    for (int i = 0; i < 20; ++i)
+    {
+        serialJobs.post([&completed]() {
+            utils::Time::uSleep(1000);
+            ++completed;
+        });
+    }
+    for (int i = 0; i < 500 && completed < 20; ++i)
+    {
+        usleep(1000);
+    }
+    usleep(1000); // last step is charged after the job
+
+    EXPECT_EQ(20, completed.load());
+    EXPECT_GE(serialJobs.getCost().getTime(), 20 * utils::Time::ms);
+    EXPECT_GE(serialJobs.getCost().getCount(), 2);
+}
@@ -0,0 +1,532 @@
+#include "test/load/SyntheticClient.h"
+#include "codec/Opus.h"
+#include "codec/OpusEncoder.h"
+#include "rtp/RtcpFeedback.h"
+#include "rtp/RtcpHeader.h"
+#include "rtp/RtcpNackBuilder.h"
+#include "rtp/RtpHeader.h"
+#include "test/load/SyntheticNetwork.h"
+#include "test/transport/FakeNetwork.h"
+#include "transport/ice/Stun.h"
+#include "utils/Format.h"
+#include "utils/Time.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+const uint8_t audioLevelExtensionId = 1;
+const uint8_t absSendTimeExtensionId = 3;
+const uint32_t vp8PayloadType = 100;
+const uint32_t rtxPayloadType = 96;
+const uint32_t videoFps = 30;
+const uint32_t keyFrameInterval = 5 * videoFps;
+const size_t vp8DescriptorSize = 6;
+const uint64_t reportInterval = utils::Time::sec;
+
+// packets per frame, packet size and width of each simulcast layer
+const struct
+{
+    uint32_t packetsPerFrame;
+    uint32_t packetSize;
+    uint16_t width;
+} layerProfiles[emulator::SyntheticClient::simulcastLayers] = {{1, 300, 320}, {2, 700, 640}, {4, 1100, 1280}};
+
+// Opus TOC for a 20ms fullband CELT frame, used when no encoder is available
+const uint8_t opusSilenceToc = 31 << 3;
+} // namespace
+
+namespace emulator
+{
+
+PreEncodedOpus::PreEncodedOpus()
+{
+    constexpr uint32_t samplesPerPacket = codec::Opus::sampleRate / codec::Opus::packetsPerSecond;
+    int16_t pcm[samplesPerPacket * codec::Opus::channelsPerFrame];
+    uint8_t encoded[memory::Packet::size];
+    double phase = 0;
+
+    codec::OpusEncoder encoder;
+    for (uint32_t i = 0; encoder.isInitialized() && i < codec::Opus::packetsPerSecond; ++i)
+    {
+        for (uint32_t x = 0; x < samplesPerPacket; ++x)
+        {
+            pcm[x * 2] = 5000 * std::sin(phase);
+            pcm[x * 2 + 1] = pcm[x * 2];
+            phase += 2 * M_PI * 600.0 / codec::Opus::sampleRate;
+        }
+
+        const auto encodedLength = encoder.encode(pcm, samplesPerPacket, encoded, sizeof(encoded));
+        // only single frame packets can be rewritten as padded code 3 packets
+        if (encodedLength < 2 || (encoded[0] & 0x3) != 0)
+        {
+            continue;
+        }
+
+        std::vector<uint8_t> frame;
+        frame.reserve(encodedLength + 2 + stampSize);
+        frame.push_back(encoded[0] | 0x3); // code 3, arbitrary number of frames
+        frame.push_back(0x40 | 1); // padding present, one frame
+        frame.push_back(stampSize); // padding length
+        frame.insert(frame.end(), encoded + 1, encoded + encodedLength);
+        frame.resize(frame.size() + stampSize, 0);
+        _frames.push_back(std::move(frame));
+    }
+
+    if (_frames.empty())
+    {
+        // zero length frame is decoded as packet loss concealment
+        _frames.push_back({opusSilenceToc | 0x3, 0x40 | 1, stampSize});
+        _frames.back().resize(_frames.back().size() + stampSize, 0);
+    }
+}
+
+SyntheticClient::SyntheticClient(const uint32_t index,
+    const transport::SocketAddress& address,
+    const Config& config,
+    const PreEncodedOpus& opus,
+    fakenet::Gateway& network,
+    SyntheticReceiveStats& receiveStats)
+    : _endpointId(utils::format("synthetic-%u", index)),
+      _address(address),
+      _config(config),
+      _opus(opus),
+      _network(network),
+      _receiveStats(receiveStats),
+      _iceUfrag(utils::format("s%07x", index)),
+      _icePwd(utils::format("syntheticloadclient%08x", index)),
+      _connected(false),
+      _keyFrameRequested(false),
+      _lastVideoReceived(0),
+      _audioSsrc(0x10000 + index * 8),
+      _audioSequenceNumber(0),
+      _audioPacketCount(0),
+      _audioOctetCount(0),
+      _audioRtpTimestamp(index * 1000),
+      _videoRtpTimestamp(index * 1000),
+      _pictureId(0),
+      _tl0PicIdx(0),
+      _frameCount(0),
+      _nextAudio(0),
+      _nextVideo(0),
+      _nextReport(0),
+      _nextNack(0),
+      _packetsSent(0)
+{
+    _iceHmac.init(_icePwd.c_str(), _icePwd.size());
+
+    for (size_t i = 0; i < simulcastLayers; ++i)
+    {
+        auto& layer = _videoLayers[i];
+        layer.ssrc = _audioSsrc + 1 + i * 2;
+        layer.rtxSsrc = layer.ssrc + 1;
+        layer.packetsPerFrame = layerProfiles[i].packetsPerFrame;
+        layer.packetSize = layerProfiles[i].packetSize;
+    }
+}
+
+nlohmann::json SyntheticClient::buildAllocateRequest() const
+{
+    using namespace nlohmann;
+    return json::object({{"endpoint-id", _endpointId},
+        {"bundle-transport",
+            json::object({{"ice", true},
+                {"ice-controlling", true},
+                {"dtls", false},
+                {"sdes", false},
+                {"rtcp-mux", true}})},
+        {"audio", json::object({{"relay-type", "ssrc-rewrite"}})},
+        {"video", json::object({{"relay-type", "ssrc-rewrite"}})}});
+}
+
+nlohmann::json SyntheticClient::buildConfigureRequest() const
+{
+    using namespace nlohmann;
+    json body = {{"action", "configure"}};
+
+    auto candidates = json::array();
+    candidates.push_back(json::object({{"foundation", "1"},
+        {"component", 1},
+        {"protocol", "udp"},
+        {"priority", 2130706431},
+        {"ip", _address.ipToString()},
+        {"port", _address.getPort()},
+        {"type", "host"},
+        {"generation", 0},
+        {"network", 1}}));
+
+    // no dtls or sdes means null cipher
+    body["bundle-transport"] = json::object({{"rtcp-mux", true},
+        {"ice", json::object({{"ufrag", _iceUfrag}, {"pwd", _icePwd}, {"candidates", candidates}})}});
+
+    auto audioPayloadTypes = json::array();
+    audioPayloadTypes.push_back(json::object({{"id", codec::Opus::payloadType},
+        {"name", "opus"},
+        {"clockrate", codec::Opus::sampleRate},
+        {"channels", codec::Opus::channelsPerFrame},
+        {"parameters", json::object()},
+        {"rtcp-fbs", json::array()}}));
+
+    body["audio"] = json::object({{"payload-types", audioPayloadTypes},
+        {"rtp-hdrexts",
+            json::array({{{"id", audioLevelExtensionId}, {"uri", "urn:ietf:params:rtp-hdrext:ssrc-audio-level"}},
+                {{"id", absSendTimeExtensionId},
+                    {"uri", "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time"}}})},
+        {"ssrcs", json::array({_audioSsrc})}});
+
+    auto videoPayloadTypes = json::array();
+    videoPayloadTypes.push_back(json::object({{"id", vp8PayloadType},
+        {"name", "VP8"},
+        {"clockrate", 90000},
+        {"parameters", json::object()},
+        {"rtcp-fbs",
+            json::array({{{"type", "goog-remb"}},
+                {{"type", "ccm"}, {"subtype", "fir"}},
+                {{"type", "nack"}},
+                {{"type", "nack"}, {"subtype", "pli"}}})}}));
+    videoPayloadTypes.push_back(json::object({{"id", rtxPayloadType},
+        {"name", "rtx"},
+        {"clockrate", 90000},
+        {"rtcp-fbs", json::array()},
+        {"parameters", {{"apt", std::to_string(vp8PayloadType)}}}}));
+
+    auto streams = json::array();
+    if (_config.sendVideo)
+    {
+        auto sources = json::array();
+        for (const auto& layer : _videoLayers)
+        {
+            sources.push_back(json::object({{"main", layer.ssrc}, {"feedback", layer.rtxSsrc}}));
+        }
+        streams.push_back(json::object({{"sources", sources}, {"id", "msid-" + _endpointId}, {"content", "video"}}));
+    }
+
+    body["video"] = json::object({{"payload-types", videoPayloadTypes},
+        {"rtp-hdrexts",
+            json::array({{{"id", absSendTimeExtensionId},
+                {"uri", "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time"}}})},
+        {"streams", streams}});
+
+    return body;
+}
+
+void SyntheticClient::process(const uint64_t timestamp)
+{
+    if (!_connected.load())
+    {
+        return;
+    }
+
+    if (_nextReport == 0)
+    {
+        // spread the clients over the packet intervals
+        const auto offset = (_audioSsrc / 8) % 20 * utils::Time::ms;
+        _nextAudio = timestamp + offset;
+        _nextVideo = timestamp + offset;
+        _nextNack = timestamp + offset + reportInterval;
+        _nextReport = timestamp + offset;
+    }
+
+    if (_config.sendAudio && utils::Time::diffGE(_nextAudio, timestamp, 0))
+    {
+        sendAudio(timestamp);
+        _nextAudio += utils::Time::sec / codec::Opus::packetsPerSecond;
+    }
+
+    if (_config.sendVideo && utils::Time::diffGE(_nextVideo, timestamp, 0))
+    {
+        sendVideoFrame(timestamp);
+        _nextVideo += utils::Time::sec / videoFps;
+    }
+
+    if (utils::Time::diffGE(_nextReport, timestamp, 0))
+    {
+        sendReports(timestamp);
+        _nextReport += reportInterval;
+    }
+
+    if (_config.nacksPerSecond > 0 && utils::Time::diffGE(_nextNack, timestamp, 0))
+    {
+        sendNack(timestamp);
+        _nextNack += utils::Time::sec / _config.nacksPerSecond;
+    }
+}
+
+void SyntheticClient::sendAudio(const uint64_t timestamp)
+{
+    memory::Packet packet;
+    auto rtpHeader = rtp::RtpHeader::create(packet);
+    rtpHeader->payloadType = codec::Opus::payloadType;
+    rtpHeader->sequenceNumber = _audioSequenceNumber++;
+    rtpHeader->ssrc = _audioSsrc;
+    rtpHeader->timestamp = _audioRtpTimestamp;
+    _audioRtpTimestamp += codec::Opus::sampleRate / codec::Opus::packetsPerSecond;
+
+    rtp::RtpHeaderExtension extensionHead;
+    auto cursor = extensionHead.extensions().begin();
+    rtp::GeneralExtension1Byteheader absSendTime(absSendTimeExtensionId, 3);
+    extensionHead.addExtension(cursor, absSendTime);
+    rtp::GeneralExtension1Byteheader audioLevel(audioLevelExtensionId, 1);
+    audioLevel.data[0] = 20 + (_audioSsrc / 8) % 30;
+    extensionHead.addExtension(cursor, audioLevel);
+    rtpHeader->setExtensions(extensionHead);
+
+    const auto& frame = _opus.getFrame(_audioPacketCount);
+    auto payload = rtpHeader->getPayload();
+    std::memcpy(payload, frame.data(), frame.size());
+    std::memcpy(payload + frame.size() - PreEncodedOpus::stampSize, &timestamp, PreEncodedOpus::stampSize);
+    packet.setLength(rtpHeader->headerLength() + frame.size());
+    rtp::setTransmissionTimestamp(packet, absSendTimeExtensionId, timestamp);
+
+    ++_audioPacketCount;
+    _audioOctetCount += frame.size();
+    send(packet, timestamp);
+}
+
+void SyntheticClient::sendVideoFrame(const uint64_t timestamp)
+{
+    const bool keyFrame = (_frameCount % keyFrameInterval == 0) || _keyFrameRequested.exchange(false);
+
+    for (size_t layerIndex = 0; layerIndex < simulcastLayers; ++layerIndex)
+    {
+        auto& layer = _videoLayers[layerIndex];
+        for (uint32_t i = 0; i < layer.packetsPerFrame; ++i)
+        {
+            memory::Packet packet;
+            auto rtpHeader = rtp::RtpHeader::create(packet);
+            rtpHeader->payloadType = vp8PayloadType;
+            rtpHeader->sequenceNumber = layer.sequenceNumber++;
+            rtpHeader->ssrc = layer.ssrc;
+            rtpHeader->timestamp = _videoRtpTimestamp;
+            rtpHeader->marker = (i + 1 == layer.packetsPerFrame);
+
+            rtp::RtpHeaderExtension extensionHead;
+            auto cursor = extensionHead.extensions().begin();
+            rtp::GeneralExtension1Byteheader absSendTime(absSendTimeExtensionId, 3);
+            extensionHead.addExtension(cursor, absSendTime);
+            rtpHeader->setExtensions(extensionHead);
+
+            auto payload = rtpHeader->getPayload();
+            std::memset(payload, 0, layer.packetSize);
+            payload[0] = 0x80 | (i == 0 ? 0x10 : 0); // X, S on first packet, partition 0
+            payload[1] = 0xE0; // I, L, T
+            payload[2] = 0x80 | ((_pictureId >> 8) & 0x7F);
+            payload[3] = _pictureId & 0xFF;
+            payload[4] = _tl0PicIdx;
+            payload[5] = 0; // temporal layer 0
+
+            auto vp8Payload = payload + vp8DescriptorSize;
+            vp8Payload[0] = keyFrame ? 0x00 : 0x01;
+            if (keyFrame && i == 0)
+            {
+                // key frame start code and dimensions
+                vp8Payload[3] = 0x9D;
+                vp8Payload[4] = 0x01;
+                vp8Payload[5] = 0x2A;
+                vp8Payload[6] = layerProfiles[layerIndex].width & 0xFF;
+                vp8Payload[7] = layerProfiles[layerIndex].width >> 8;
+                vp8Payload[8] = (layerProfiles[layerIndex].width * 9 / 16) & 0xFF;
+                vp8Payload[9] = (layerProfiles[layerIndex].width * 9 / 16) >> 8;
+            }
+
+            std::memcpy(payload + layer.packetSize - PreEncodedOpus::stampSize, &timestamp, PreEncodedOpus::stampSize);
+            packet.setLength(rtpHeader->headerLength() + layer.packetSize);
+            rtp::setTransmissionTimestamp(packet, absSendTimeExtensionId, timestamp);
+
+            ++layer.packetCount;
+            layer.octetCount += layer.packetSize;
+            send(packet, timestamp);
+        }
+    }
+
+    _pictureId = (_pictureId + 1) & 0x7FFF;
+    ++_tl0PicIdx;
+    _videoRtpTimestamp += 90000 / videoFps;
+    ++_frameCount;
+}
+
+void SyntheticClient::sendReports(const uint64_t timestamp)
+{
+    memory::Packet packet;
+    size_t length = 0;
+    const auto wallClock = std::chrono::system_clock::now();
+
+    if (_config.sendAudio)
+    {
+        auto senderReport = rtp::RtcpSenderReport::create(packet.get());
+        senderReport->ssrc = _audioSsrc;
+        senderReport->setNtp(wallClock);
+        senderReport->rtpTimestamp = _audioRtpTimestamp;
+        senderReport->packetCount = _audioPacketCount;
+        senderReport->octetCount = _audioOctetCount;
+        length += senderReport->size();
+    }
+
+    if (_config.sendVideo)
+    {
+        for (const auto& layer : _videoLayers)
+        {
+            auto senderReport = rtp::RtcpSenderReport::create(packet.get() + length);
+            senderReport->ssrc = layer.ssrc;
+            senderReport->setNtp(wallClock);
+            senderReport->rtpTimestamp = _videoRtpTimestamp;
+            senderReport->packetCount = layer.packetCount;
+            senderReport->octetCount = layer.octetCount;
+            length += senderReport->size();
+        }
+    }
+
+    if (length == 0)
+    {
+        auto receiverReport = rtp::RtcpReceiverReport::create(packet.get());
+        receiverReport->ssrc = _audioSsrc;
+        length += receiverReport->header.size();
+    }
+
+    auto& remb = rtp::RtcpRembFeedback::create(packet.get() + length, _audioSsrc);
+    remb.setBitrate(_config.downlinkKbps * 1000ull);
+    length += remb.header.size();
+
+    packet.setLength(length);
+    send(packet, timestamp);
+}
+
+void SyntheticClient::sendNack(const uint64_t timestamp)
+{
+    const auto lastVideoReceived = _lastVideoReceived.load();
+    if (lastVideoReceived == 0)
+    {
+        return;
+    }
+
+    // ask for a retransmission of a packet that was received to exercise the bridge packet cache and rtx path
+    rtp::RtcpNackBuilder nackBuilder(_audioSsrc, static_cast<uint32_t>(lastVideoReceived >> 16));
+    nackBuilder.appendSequenceNumber(lastVideoReceived & 0xFFFF);
+    size_t nackSize = 0;
+    const auto nack = nackBuilder.build(nackSize);
+
+    memory::Packet packet;
+    std::memcpy(packet.get(), nack, nackSize);
+    packet.setLength(nackSize);
+    send(packet, timestamp);
+}
+
+void SyntheticClient::send(const memory::Packet& packet, const uint64_t timestamp)
+{
+    _network.onReceive(fakenet::Protocol::UDP, _address, _bridgeAddress, packet.get(), packet.getLength(), timestamp);
+    ++_packetsSent;
+}
+
+void SyntheticClient::onReceive(const transport::SocketAddress& source,
+    const void* data,
+    const size_t length,
+    const uint64_t timestamp)
+{
+    if (ice::isStunMessage(data, length))
+    {
+        respondToIceCheck(source, data, length, timestamp);
+    }
+    else if (rtp::isRtcpPacket(data, length))
+    {
+        onRtcpReceived(data, length);
+    }
+    else if (rtp::isRtpPacket(data, length))
+    {
+        onRtpReceived(data, length, timestamp);
+    }
+}
+
+void SyntheticClient::respondToIceCheck(const transport::SocketAddress& source,
+    const void* data,
+    const size_t length,
+    const uint64_t timestamp)
+{
+    auto request = ice::StunMessage::fromPtr(data);
+    if (!request->header.isRequest() || request->header.getMethod() != ice::StunHeader::BindingRequest)
+    {
+        return;
+    }
+
+    ice::StunMessage response;
+    response.header.transactionId = request->header.transactionId;
+    response.header.setMethod(ice::StunHeader::BindingResponse);
+    response.add(ice::StunXorMappedAddress(source, response.header));
+    response.addMessageIntegrity(_iceHmac);
+    response.addFingerprint();
+    _network.onReceive(fakenet::Protocol::UDP, _address, source, &response, response.size(), timestamp);
+
+    if (!_connected.load())
+    {
+        _bridgeAddress = source;
+        _connected = true;
+    }
+}
+
+void SyntheticClient::onRtcpReceived(const void* data, const size_t length)
+{
+    if (!rtp::CompoundRtcpPacket::isValid(data, length))
+    {
+        return;
+    }
+
+    ++_receiveStats.rtcpPackets;
+    for (const auto& header : rtp::CompoundRtcpPacket(data, length))
+    {
+        if (header.packetType == rtp::RtcpPacketType::PAYLOADSPECIFIC_FB &&
+            (header.fmtCount == rtp::PayloadSpecificFeedbackType::Pli ||
+                header.fmtCount == rtp::PayloadSpecificFeedbackType::Fir))
+        {
+            _keyFrameRequested = true;
+            ++_receiveStats.keyFrameRequests;
+        }
+    }
+}
+
+void SyntheticClient::onRtpReceived(const void* data, const size_t length, uint64_t timestamp)
+{
+    auto rtpHeader = rtp::RtpHeader::fromPtr(data, length);
+    if (!rtpHeader)
+    {
+        return;
+    }
+
+    if (rtpHeader->payloadType == rtxPayloadType)
+    {
+        ++_receiveStats.rtxPackets;
+        return;
+    }
+
+    if (length < rtpHeader->headerLength() + PreEncodedOpus::stampSize)
+    {
+        return;
+    }
+
+    uint64_t sendTime = 0;
+    std::memcpy(&sendTime,
+        reinterpret_cast<const uint8_t*>(data) + length - PreEncodedOpus::stampSize,
+        PreEncodedOpus::stampSize);
+    const auto receiveTime = utils::Time::getAbsoluteTime();
+    const auto latency = utils::Time::diff(sendTime, receiveTime);
+    const bool isValidLatency = latency >= 0 && latency < static_cast<int64_t>(10 * utils::Time::sec);
+
+    if (rtpHeader->payloadType == codec::Opus::payloadType)
+    {
+        ++_receiveStats.audioPackets;
+        if (isValidLatency)
+        {
+            _receiveStats.audioLatency.add(latency);
+        }
+    }
+    else if (rtpHeader->payloadType == vp8PayloadType)
+    {
+        ++_receiveStats.videoPackets;
+        if (isValidLatency)
+        {
+            _receiveStats.videoLatency.add(latency);
+        }
+        _lastVideoReceived = (static_cast<uint64_t>(rtpHeader->ssrc.get()) << 16) | rtpHeader->sequenceNumber.get();
+    }
+}
+
+} // namespace emulator
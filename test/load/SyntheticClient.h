@@ -0,0 +1,135 @@
+#pragma once
+#include "crypto/SslHelper.h"
+#include "memory/Packet.h"
+#include "nlohmann/json.hpp"
+#include "utils/SocketAddress.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fakenet
+{
+class Gateway;
+}
+
+namespace emulator
+{
+class SyntheticReceiveStats;
+
+// Opus frames encoded once and shared by all synthetic clients. The frames are stored as code 3 packets with
+// padding, which leaves room for a send timestamp that decoders ignore.
+class PreEncodedOpus
+{
+public:
+    static constexpr size_t stampSize = sizeof(uint64_t);
+
+    PreEncodedOpus();
+
+    const std::vector<uint8_t>& getFrame(uint32_t index) const { return _frames[index % _frames.size()]; }
+
+private:
+    std::vector<std::vector<uint8_t>> _frames;
+};
+
+/**
+ * Participant for load tests that is cheap enough to run thousands of in one process. It answers the bridge ICE
+ * checks and exchanges plain RTP and RTCP over a null cipher bundle transport instead of running a full transport.
+ * Media is pre-encoded Opus and three layer VP8 simulcast. Every payload ends with the send timestamp so the
+ * receiving client can measure forwarding latency. Receivers send RR, REMB and NACK for forwarded video.
+ *
+ * process() is called from one generator thread and onReceive() from the fake network thread.
+ */
+class SyntheticClient
+{
+public:
+    static constexpr size_t simulcastLayers = 3;
+
+    struct Config
+    {
+        bool sendAudio = false;
+        bool sendVideo = false;
+        uint32_t nacksPerSecond = 0;
+        uint32_t downlinkKbps = 2500;
+    };
+
+    SyntheticClient(uint32_t index,
+        const transport::SocketAddress& address,
+        const Config& config,
+        const PreEncodedOpus& opus,
+        fakenet::Gateway& network,
+        SyntheticReceiveStats& receiveStats);
+
+    // endpoint description for bulk allocation
+    nlohmann::json buildAllocateRequest() const;
+    nlohmann::json buildConfigureRequest() const;
+
+    void process(uint64_t timestamp);
+
+    void onReceive(const transport::SocketAddress& source, const void* data, size_t length, uint64_t timestamp);
+
+    const std::string& getEndpointId() const { return _endpointId; }
+    const transport::SocketAddress& getAddress() const { return _address; }
+    bool isConnected() const { return _connected.load(); }
+    uint64_t getPacketsSent() const { return _packetsSent; }
+
+private:
+    struct VideoLayer
+    {
+        uint32_t ssrc = 0;
+        uint32_t rtxSsrc = 0;
+        uint16_t sequenceNumber = 0;
+        uint32_t packetsPerFrame = 0;
+        uint32_t packetSize = 0;
+        uint32_t packetCount = 0;
+        uint32_t octetCount = 0;
+    };
+
+    void sendAudio(uint64_t timestamp);
+    void sendVideoFrame(uint64_t timestamp);
+    void sendReports(uint64_t timestamp);
+    void sendNack(uint64_t timestamp);
+    void send(const memory::Packet& packet, uint64_t timestamp);
+
+    void respondToIceCheck(const transport::SocketAddress& source, const void* data, size_t length, uint64_t timestamp);
+    void onRtcpReceived(const void* data, size_t length);
+    void onRtpReceived(const void* data, size_t length, uint64_t timestamp);
+
+    const std::string _endpointId;
+    const transport::SocketAddress _address;
+    const Config _config;
+    const PreEncodedOpus& _opus;
+    fakenet::Gateway& _network;
+    SyntheticReceiveStats& _receiveStats;
+
+    const std::string _iceUfrag;
+    const std::string _icePwd;
+    crypto::HMAC _iceHmac;
+
+    // written by the network thread before _connected is set
+    transport::SocketAddress _bridgeAddress;
+    std::atomic_bool _connected;
+    std::atomic_bool _keyFrameRequested;
+    // ssrc << 16 | sequence number of the last forwarded video packet
+    std::atomic_uint64_t _lastVideoReceived;
+
+    // generator thread state
+    const uint32_t _audioSsrc;
+    uint16_t _audioSequenceNumber;
+    uint32_t _audioPacketCount;
+    uint32_t _audioOctetCount;
+    uint32_t _audioRtpTimestamp;
+    std::array<VideoLayer, simulcastLayers> _videoLayers;
+    uint32_t _videoRtpTimestamp;
+    uint16_t _pictureId;
+    uint8_t _tl0PicIdx;
+    uint32_t _frameCount;
+    uint64_t _nextAudio;
+    uint64_t _nextVideo;
+    uint64_t _nextReport;
+    uint64_t _nextNack;
+    uint64_t _packetsSent;
+};
+
+} // namespace emulator
@@ -0,0 +1,365 @@
+#include "bridge/Bridge.h"
+#include "config/Config.h"
+#include "logger/Logger.h"
+#include "nlohmann/json.hpp"
+#include "test/integration/LoadTestConfig.h"
+#include "test/integration/emulator/Conference.h"
+#include "test/integration/emulator/FakeEndpointFactory.h"
+#include "test/integration/emulator/HttpRequests.h"
+#include "test/integration/emulator/Httpd.h"
+#include "test/load/SyntheticClient.h"
+#include "test/load/SyntheticNetwork.h"
+#include "test/transport/FakeNetwork.h"
+#include "utils/Format.h"
+#include "utils/Time.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace config
+{
+extern const char* g_LoadTestConfigFile;
+}
+
+using namespace emulator;
+
+namespace
+{
+const char* smbIp = "35.240.205.93";
+const char* baseUrl = "http://127.0.0.1:8080";
+
+// Drives a share of the synthetic clients from a dedicated thread
+class SyntheticLoadGenerator
+{
+public:
+    SyntheticLoadGenerator() : _running(false), _cpuTime(0) {}
+
+    ~SyntheticLoadGenerator() { stop(); }
+
+    void addClient(SyntheticClient& client) { _clients.push_back(&client); }
+
+    void start()
+    {
+        _running = true;
+        _thread = std::make_unique<std::thread>([this] { run(); });
+    }
+
+    void stop()
+    {
+        _running = false;
+        if (_thread)
+        {
+            _thread->join();
+            _thread.reset();
+        }
+    }
+
+    uint64_t getCpuTime() const { return _cpuTime.load(); }
+
+private:
+    void run()
+    {
+        while (_running)
+        {
+            const auto timestamp = utils::Time::getAbsoluteTime();
+            for (auto* client : _clients)
+            {
+                client->process(timestamp);
+            }
+            _cpuTime = getThreadCpuTime();
+            utils::Time::rawNanoSleep(utils::Time::ms);
+        }
+    }
+
+    std::vector<SyntheticClient*> _clients;
+    std::atomic_bool _running;
+    std::atomic_uint64_t _cpuTime;
+    std::unique_ptr<std::thread> _thread;
+};
+
+struct BridgeStats
+{
+    uint64_t engineSlips = 0;
+};
+
+void logLatency(const char* name, const LatencyHistogram& histogram)
+{
+    logger::info("%s latency p50 %.1fms, p99 %.1fms, max %.1fms over %" PRIu64 " packets",
+        "SyntheticLoadTest",
+        name,
+        histogram.getPercentile(0.5) / static_cast<double>(utils::Time::ms),
+        histogram.getPercentile(0.99) / static_cast<double>(utils::Time::ms),
+        histogram.getMax() / static_cast<double>(utils::Time::ms),
+        histogram.getCount());
+}
+} // namespace
+
+/**
+ * Runs the bridge against thousands of synthetic clients in one process to measure forwarding capacity. The bridge
+ * runs on real time with its own worker threads. Clients are driven by a few generator threads and reached through
+ * one network node on the fake internet. Sizes are taken from the synthetic group in the load test config.
+ */
+class SyntheticLoadTest : public ::testing::Test
+{
+public:
+    SyntheticLoadTest() : _config(std::make_unique<config::LoadTestConfig>())
+    {
+        if (config::g_LoadTestConfigFile != nullptr && !_config->readFromFile(config::g_LoadTestConfigFile))
+        {
+            logger::error("Failed to read load test configuration from %s, using defaults",
+                "SyntheticLoadTest",
+                config::g_LoadTestConfigFile);
+        }
+    }
+
+protected:
+    void SetUp() override
+    {
+        utils::Time::initialize(); // run in real time
+        _httpd = std::make_unique<emulator::HttpdFactory>();
+        _internet = std::make_unique<fakenet::InternetRunner>(100 * utils::Time::us);
+
+        _bridgeConfig.readFromString(utils::format(R"({
+            "ip":"127.0.0.1",
+            "ice.publicIpv4":"%s",
+            "ice.tcp.enable":false,
+            "ice.enableIpv6":false,
+            "enableSrtpNullCipher":true
+            })",
+            smbIp));
+
+        _bridge = std::make_unique<bridge::Bridge>(_bridgeConfig);
+        _bridge->initialize(std::shared_ptr<transport::EndpointFactory>(
+                                new emulator::FakeEndpointFactory(_internet->getNetwork(),
+                                    [](std::shared_ptr<fakenet::NetworkLink>,
+                                        const transport::SocketAddress&,
+                                        const std::string&) {})),
+            *_httpd,
+            {transport::SocketAddress::parse(smbIp)});
+    }
+
+    void TearDown() override
+    {
+        for (auto& generator : _generators)
+        {
+            generator->stop();
+        }
+        _internet->shutdown();
+        _bridge.reset();
+        _network.reset();
+        _clients.clear();
+        _internet.reset();
+    }
+
+    BridgeStats getBridgeStats()
+    {
+        BridgeStats stats;
+        nlohmann::json responseBody;
+        if (awaitResponse<HttpGetRequest>(_httpd.get(),
+                std::string(baseUrl) + "/stats",
+                3 * utils::Time::sec,
+                responseBody) &&
+            responseBody.find("engine_slips") != responseBody.end())
+        {
+            stats.engineSlips = responseBody["engine_slips"].get<uint64_t>();
+        }
+        return stats;
+    }
+
+    bool createConference(const size_t firstClient, const size_t clientCount)
+    {
+        emulator::Conference conference(_httpd.get());
+        conference.create(baseUrl);
+        if (!conference.isSuccess())
+        {
+            return false;
+        }
+
+        nlohmann::json allocateBody = {{"action", "allocate"}, {"endpoints", nlohmann::json::array()}};
+        for (size_t i = firstClient; i < firstClient + clientCount; ++i)
+        {
+            allocateBody["endpoints"].push_back(_clients[i]->buildAllocateRequest());
+        }
+
+        nlohmann::json responseBody;
+        const auto conferenceUrl = utils::format("%s/conferences/%s", baseUrl, conference.getId().c_str());
+        if (!awaitResponse<HttpPostRequest>(_httpd.get(),
+                conferenceUrl,
+                allocateBody.dump(),
+                10 * utils::Time::sec,
+                responseBody))
+        {
+            return false;
+        }
+
+        for (size_t i = firstClient; i < firstClient + clientCount; ++i)
+        {
+            auto& client = *_clients[i];
+            if (!awaitResponse<HttpPutRequest>(_httpd.get(),
+                    conferenceUrl + "/" + client.getEndpointId(),
+                    client.buildConfigureRequest().dump(),
+                    3 * utils::Time::sec,
+                    responseBody))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::unique_ptr<config::LoadTestConfig> _config;
+    config::Config _bridgeConfig;
+    std::unique_ptr<emulator::HttpdFactory> _httpd;
+    std::unique_ptr<fakenet::InternetRunner> _internet;
+    std::unique_ptr<bridge::Bridge> _bridge;
+    std::unique_ptr<SyntheticClientNetwork> _network;
+    PreEncodedOpus _opus;
+    std::vector<std::unique_ptr<SyntheticClient>> _clients;
+    std::vector<std::unique_ptr<SyntheticLoadGenerator>> _generators;
+    SyntheticReceiveStats _receiveStats;
+};
+
+TEST_F(SyntheticLoadTest, forwardingCapacity)
+{
+    const auto& synthetic = _config->synthetic;
+    const size_t participants = synthetic.participants;
+    const size_t clientCount = synthetic.conferences * participants;
+    ASSERT_GT(clientCount, 0u);
+
+    _network = std::make_unique<SyntheticClientNetwork>(_internet->getNetwork());
+    for (size_t i = 0; i < clientCount; ++i)
+    {
+        const auto participantIndex = i % participants;
+        SyntheticClient::Config clientConfig;
+        clientConfig.sendAudio = participantIndex < synthetic.audioSenders;
+        clientConfig.sendVideo = participantIndex < synthetic.videoSenders;
+        clientConfig.nacksPerSecond = synthetic.nacksPerSecond;
+        clientConfig.downlinkKbps = synthetic.downlinkKbps;
+
+        const auto addressIndex = static_cast<uint32_t>(i + 1);
+        const auto address = transport::SocketAddress::parse(utils::format("10.%u.%u.%u",
+                                                                 (addressIndex >> 16) & 0xFF,
+                                                                 (addressIndex >> 8) & 0xFF,
+                                                                 addressIndex & 0xFF),
+            5000);
+
+        _clients.push_back(std::make_unique<SyntheticClient>(i,
+            address,
+            clientConfig,
+            _opus,
+            *_internet->getNetwork(),
+            _receiveStats));
+        _network->addClient(*_clients.back());
+    }
+
+    for (size_t conference = 0; conference < synthetic.conferences; ++conference)
+    {
+        ASSERT_TRUE(createConference(conference * participants, participants));
+    }
+    logger::info("allocated %zu synthetic clients in %u conferences",
+        "SyntheticLoadTest",
+        clientCount,
+        synthetic.conferences.get());
+
+    ASSERT_TRUE(_network->attach());
+    _internet->start();
+
+    const size_t generatorCount = std::max(1u, synthetic.generatorThreads.get());
+    for (size_t i = 0; i < generatorCount; ++i)
+    {
+        _generators.push_back(std::make_unique<SyntheticLoadGenerator>());
+    }
+    for (size_t i = 0; i < clientCount; ++i)
+    {
+        _generators[i % generatorCount]->addClient(*_clients[i]);
+    }
+    for (auto& generator : _generators)
+    {
+        generator->start();
+    }
+
+    const auto connectDeadline = utils::Time::getAbsoluteTime() + 30 * utils::Time::sec;
+    size_t connectedCount = 0;
+    while (utils::Time::diffLT(utils::Time::getAbsoluteTime(), connectDeadline, 0))
+    {
+        connectedCount = std::count_if(_clients.begin(), _clients.end(), [](const auto& client) {
+            return client->isConnected();
+        });
+        if (connectedCount == clientCount)
+        {
+            break;
+        }
+        utils::Time::rawNanoSleep(100 * utils::Time::ms);
+    }
+    logger::info("%zu of %zu synthetic clients connected", "SyntheticLoadTest", connectedCount, clientCount);
+
+    const auto statsBefore = getBridgeStats();
+    const auto packetsReceivedBefore = _receiveStats.audioPackets + _receiveStats.videoPackets +
+        _receiveStats.rtxPackets + _receiveStats.rtcpPackets;
+    uint64_t packetsSentBefore = 0;
+    for (const auto& client : _clients)
+    {
+        packetsSentBefore += client->getPacketsSent();
+    }
+    uint64_t generatorCpuBefore = 0;
+    for (const auto& generator : _generators)
+    {
+        generatorCpuBefore += generator->getCpuTime();
+    }
+    const auto networkCpuBefore = _network->getNetworkThreadCpuTime();
+    const auto processCpuBefore = getProcessCpuTime();
+    const auto start = utils::Time::getAbsoluteTime();
+
+    utils::Time::rawNanoSleep(synthetic.duration * utils::Time::sec);
+
+    const auto elapsed = utils::Time::diff(start, utils::Time::getAbsoluteTime());
+    const auto processCpu = getProcessCpuTime() - processCpuBefore;
+    const auto networkCpu = _network->getNetworkThreadCpuTime() - networkCpuBefore;
+    uint64_t generatorCpu = 0;
+    for (const auto& generator : _generators)
+    {
+        generatorCpu += generator->getCpuTime();
+    }
+    generatorCpu -= generatorCpuBefore;
+    uint64_t packetsSent = 0;
+    for (const auto& client : _clients)
+    {
+        packetsSent += client->getPacketsSent();
+    }
+    packetsSent -= packetsSentBefore;
+    const auto packetsReceived = _receiveStats.audioPackets + _receiveStats.videoPackets + _receiveStats.rtxPackets +
+        _receiveStats.rtcpPackets - packetsReceivedBefore;
+    const auto statsAfter = getBridgeStats();
+
+    // what is left after the clients and the fake internet is the cpu spent by the bridge
+    const auto bridgeCpu = processCpu - std::min(processCpu, generatorCpu + networkCpu);
+    const auto seconds = elapsed / static_cast<double>(utils::Time::sec);
+    const auto packetRate = (packetsSent + packetsReceived) / seconds;
+    const auto bridgeCores = bridgeCpu / static_cast<double>(elapsed);
+
+    logger::info("%zu clients, %.1fs, bridge received %.0f pps, sent %.0f pps, %.0f pps per core",
+        "SyntheticLoadTest",
+        clientCount,
+        seconds,
+        packetsSent / seconds,
+        packetsReceived / seconds,
+        bridgeCores > 0 ? packetRate / bridgeCores : 0.0);
+    logger::info("cpu cores used: bridge %.2f, generators %.2f, network %.2f",
+        "SyntheticLoadTest",
+        bridgeCores,
+        generatorCpu / static_cast<double>(elapsed),
+        networkCpu / static_cast<double>(elapsed));
+    logger::info("engine tick overruns %" PRIu64 ", key frame requests %" PRIu64 ", rtx %" PRIu64,
+        "SyntheticLoadTest",
+        statsAfter.engineSlips - statsBefore.engineSlips,
+        _receiveStats.keyFrameRequests.load(),
+        _receiveStats.rtxPackets.load());
+    logLatency("audio", _receiveStats.audioLatency);
+    logLatency("video", _receiveStats.videoLatency);
+
+    EXPECT_EQ(connectedCount, clientCount);
+    EXPECT_GT(_receiveStats.audioPackets.load(), 0u);
+    EXPECT_GT(packetsReceived, 0u);
+}
@@ -0,0 +1,122 @@
+#include "test/load/SyntheticNetwork.h"
+#include "test/load/SyntheticClient.h"
+#include <algorithm>
+#include <cassert>
+#include <sys/resource.h>
+#include <time.h>
+
+namespace emulator
+{
+
+LatencyHistogram::LatencyHistogram() : _count(0), _max(0)
+{
+    _buckets.fill(0);
+}
+
+void LatencyHistogram::add(const uint64_t latency)
+{
+    ++_buckets[std::min(static_cast<size_t>(latency / bucketWidth), bucketCount)];
+    ++_count;
+    _max = std::max(_max, latency);
+}
+
+uint64_t LatencyHistogram::getPercentile(const double percentile) const
+{
+    const auto threshold = static_cast<uint64_t>(_count * percentile);
+    uint64_t count = 0;
+    for (size_t i = 0; i < _buckets.size(); ++i)
+    {
+        count += _buckets[i];
+        if (count > threshold)
+        {
+            return std::min((i + 1) * bucketWidth, _max);
+        }
+    }
+    return _max;
+}
+
+SyntheticClientNetwork::SyntheticClientNetwork(std::shared_ptr<fakenet::Gateway> internet)
+    : _internet(internet),
+      _attached(false),
+      _networkThreadCpuTime(0)
+{
+}
+
+SyntheticClientNetwork::~SyntheticClientNetwork()
+{
+    if (_attached)
+    {
+        _internet->removeNode(this);
+    }
+}
+
+void SyntheticClientNetwork::addClient(SyntheticClient& client)
+{
+    assert(!_attached);
+    _clients.emplace(client.getAddress(), &client);
+}
+
+bool SyntheticClientNetwork::attach()
+{
+    _attached = _internet->addLocal(this);
+    return _attached;
+}
+
+void SyntheticClientNetwork::onReceive(fakenet::Protocol protocol,
+    const transport::SocketAddress& source,
+    const transport::SocketAddress& target,
+    const void* data,
+    size_t length,
+    uint64_t timestamp)
+{
+    auto it = _clients.find(target);
+    if (it != _clients.end())
+    {
+        it->second->onReceive(source, data, length, timestamp);
+    }
+}
+
+bool SyntheticClientNetwork::hasIp(const transport::SocketAddress& target, fakenet::Protocol protocol) const
+{
+    return protocol == fakenet::Protocol::UDP && _clients.find(target) != _clients.end();
+}
+
+bool SyntheticClientNetwork::hasIpClash(const NetworkNode& node) const
+{
+    for (const auto& client : _clients)
+    {
+        if (node.hasIp(client.first, fakenet::Protocol::UDP))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SyntheticClientNetwork::process(uint64_t timestamp)
+{
+    _networkThreadCpuTime = getThreadCpuTime();
+}
+
+uint64_t getThreadCpuTime()
+{
+    struct timespec cpuTime;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuTime) != 0)
+    {
+        return 0;
+    }
+    return cpuTime.tv_sec * utils::Time::sec + cpuTime.tv_nsec;
+}
+
+uint64_t getProcessCpuTime()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * utils::Time::sec +
+        (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * utils::Time::us;
+}
+
+} // namespace emulator
@@ -0,0 +1,90 @@
+#pragma once
+#include "test/transport/FakeNetwork.h"
+#include "utils/SocketAddress.h"
+#include "utils/Time.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace emulator
+{
+class SyntheticClient;
+
+class LatencyHistogram
+{
+public:
+    static constexpr uint64_t bucketWidth = 100 * utils::Time::us;
+    static constexpr size_t bucketCount = 2000;
+
+    LatencyHistogram();
+
+    void add(uint64_t latency);
+
+    uint64_t getCount() const { return _count; }
+    uint64_t getMax() const { return _max; }
+    // upper bound of the bucket holding the percentile
+    uint64_t getPercentile(double percentile) const;
+
+private:
+    std::array<uint64_t, bucketCount + 1> _buckets;
+    uint64_t _count;
+    uint64_t _max;
+};
+
+// Updated by synthetic clients on the fake network thread only
+class SyntheticReceiveStats
+{
+public:
+    SyntheticReceiveStats() : audioPackets(0), videoPackets(0), rtxPackets(0), rtcpPackets(0), keyFrameRequests(0) {}
+
+    std::atomic_uint64_t audioPackets;
+    std::atomic_uint64_t videoPackets;
+    std::atomic_uint64_t rtxPackets;
+    std::atomic_uint64_t rtcpPackets;
+    std::atomic_uint64_t keyFrameRequests;
+    LatencyHistogram audioLatency;
+    LatencyHistogram videoLatency;
+};
+
+/**
+ * Attaches any number of synthetic clients to the fake internet as one network node. Packets are dispatched to
+ * the client owning the target address with a hash lookup, so the internet routing cost does not grow with the
+ * number of clients. All clients must be added before attach().
+ */
+class SyntheticClientNetwork : public fakenet::NetworkNode
+{
+public:
+    explicit SyntheticClientNetwork(std::shared_ptr<fakenet::Gateway> internet);
+    ~SyntheticClientNetwork();
+
+    void addClient(SyntheticClient& client);
+    bool attach();
+
+    // NetworkNode
+    void onReceive(fakenet::Protocol protocol,
+        const transport::SocketAddress& source,
+        const transport::SocketAddress& target,
+        const void* data,
+        size_t length,
+        uint64_t timestamp) override;
+    bool hasIp(const transport::SocketAddress& target, fakenet::Protocol protocol) const override;
+    bool hasIpClash(const NetworkNode& node) const override;
+    void process(uint64_t timestamp) override;
+    fakenet::Protocol getProtocol() const override { return fakenet::Protocol::UDP; }
+
+    // cpu time spent by the network thread that runs both bridge and client side of the fake internet
+    uint64_t getNetworkThreadCpuTime() const { return _networkThreadCpuTime.load(); }
+
+private:
+    std::shared_ptr<fakenet::Gateway> _internet;
+    std::unordered_map<transport::SocketAddress, SyntheticClient*> _clients;
+    bool _attached;
+    std::atomic_uint64_t _networkThreadCpuTime;
+};
+
+uint64_t getThreadCpuTime();
+uint64_t getProcessCpuTime();
+
+} // namespace emulator
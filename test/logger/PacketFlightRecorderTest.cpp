@@ -0,0 +1,108 @@
+#include "logger/PacketFlightRecorder.h"
+#include "utils/Time.h"
+#include <cstdio>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+
+using namespace logger;
+
+namespace
+{
+bool waitForWrites(const PacketFlightRecorderWriter& writer, uint32_t count)
+{
+    for (int i = 0; i < 100 && writer.getWrittenCount() < count; ++i)
+    {
+        utils::Time::nanoSleep(20 * utils::Time::ms);
+    }
+    return writer.getWrittenCount() == count;
+}
+
+bool fileExists(const std::string& fileName)
+{
+    return ::access(fileName.c_str(), F_OK) == 0;
+}
+} // namespace
+
+TEST(PacketFlightRecorderTest, keepsMostRecent)
+{
+    PacketFlightRecorderWriter writer("/tmp", 128, 1);
+    PacketFlightRecorder recorder(100, "unused", utils::Time::sec, writer);
+    ASSERT_EQ(128, recorder.getCapacity());
+
+    const uint64_t start = 1000 * utils::Time::sec;
+    for (uint32_t i = 0; i < 300; ++i)
+    {
+        recorder.record(i % 2 ? PacketDirection::Outbound : PacketDirection::Inbound,
+            1234,
+            i,
+            1000 + i,
+            i * 3,
+            start + i * utils::Time::ms,
+            i == 299 ? PacketDropReason::IngressLimit : PacketDropReason::None);
+    }
+
+    PacketLogItem items[200];
+    ASSERT_EQ(128, recorder.snapshot(items, 200));
+    EXPECT_EQ(300 - 128, items[0].sequenceNumber);
+    EXPECT_EQ(start + (300 - 128) * utils::Time::ms, items[0].receiveTimestamp);
+    EXPECT_EQ(PacketDirection::Inbound, items[0].direction);
+    EXPECT_EQ(PacketDirection::Outbound, items[1].direction);
+    EXPECT_EQ(299, items[127].sequenceNumber);
+    EXPECT_EQ(1299, items[127].size);
+    EXPECT_EQ(299 * 3, items[127].transmitTimestamp);
+    EXPECT_EQ(PacketDropReason::IngressLimit, items[127].dropReason);
+    EXPECT_EQ(PacketDropReason::None, items[126].dropReason);
+
+    ASSERT_EQ(10, recorder.snapshot(items, 10));
+    EXPECT_EQ(290, items[0].sequenceNumber);
+}
+
+TEST(PacketFlightRecorderTest, dumpIsReadableAndRateLimited)
+{
+    char directory[] = "/tmp/PacketFlightRecorderTest-XXXXXX";
+    ASSERT_NE(nullptr, ::mkdtemp(directory));
+    const auto fileName = std::string(directory) + "/transport";
+
+    PacketFlightRecorderWriter writer(directory, 64, 2);
+    PacketFlightRecorder recorder(64, "transport", 10 * utils::Time::sec, writer);
+
+    uint64_t timestamp = 1000 * utils::Time::sec;
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        recorder.record(PacketDirection::Inbound, 5678, i, 200, 0, timestamp + i);
+    }
+
+    EXPECT_TRUE(recorder.dump("test", timestamp));
+    EXPECT_FALSE(recorder.dump("test", timestamp + utils::Time::sec));
+    EXPECT_EQ(1, recorder.getDumpCount());
+    ASSERT_TRUE(waitForWrites(writer, 1));
+
+    PacketLogReader reader(::fopen((fileName + "-1").c_str(), "r"));
+    ASSERT_TRUE(reader.isOpen());
+    PacketLogItem item;
+    uint32_t count = 0;
+    while (reader.getNext(item))
+    {
+        EXPECT_EQ(5678, item.ssrc);
+        EXPECT_EQ(count, item.sequenceNumber);
+        ++count;
+    }
+    EXPECT_EQ(20, count);
+
+    // only the two most recent files are kept
+    EXPECT_TRUE(recorder.dump("test", timestamp + 11 * utils::Time::sec));
+    ASSERT_TRUE(waitForWrites(writer, 2));
+    EXPECT_TRUE(recorder.dump("test", timestamp + 22 * utils::Time::sec));
+    ASSERT_TRUE(waitForWrites(writer, 3));
+    EXPECT_EQ(3, recorder.getDumpCount());
+    EXPECT_FALSE(fileExists(fileName + "-1"));
+    EXPECT_TRUE(fileExists(fileName + "-2"));
+    EXPECT_TRUE(fileExists(fileName + "-3"));
+
+    writer.stop();
+    ::remove((fileName + "-2").c_str());
+    ::remove((fileName + "-3").c_str());
+    ::rmdir(directory);
+}
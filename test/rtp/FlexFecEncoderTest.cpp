@@ -0,0 +1,150 @@
+#include "rtp/FlexFecEncoder.h"
+#include "rtp/RtpHeader.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+const uint32_t mediaSsrc = 4711;
+const uint32_t fecSsrc = 4712;
+const uint8_t fecPayloadType = 118;
+
+memory::UniquePacket makeRtpPacket(memory::PacketPoolAllocator& allocator,
+    uint16_t sequenceNumber,
+    size_t payloadLength,
+    bool marker)
+{
+    auto packet = memory::makeUniquePacket(allocator);
+    auto* rtpHeader = rtp::RtpHeader::create(*packet);
+    rtpHeader->payloadType = 100;
+    rtpHeader->marker = marker;
+    rtpHeader->sequenceNumber = sequenceNumber;
+    rtpHeader->timestamp = 90000 + sequenceNumber / 3 * 3000;
+    rtpHeader->ssrc = mediaSsrc;
+    auto* payload = rtpHeader->getPayload();
+    for (size_t i = 0; i < payloadLength; ++i)
+    {
+        payload[i] = static_cast<uint8_t>(sequenceNumber * 7 + i);
+    }
+    packet->setLength(rtpHeader->headerLength() + payloadLength);
+    return packet;
+}
+} // namespace
+
+class FlexFecEncoderTest : public ::testing::Test
+{
+public:
+    FlexFecEncoderTest() : _allocator(64, "FlexFecEncoderTest") {}
+
+protected:
+    memory::PacketPoolAllocator _allocator;
+};
+
+TEST_F(FlexFecEncoderTest, noProtectionWithoutLoss)
+{
+    rtp::FlexFecEncoder encoder(fecSsrc, mediaSsrc, fecPayloadType, 4);
+    encoder.onReportedLoss(0);
+    EXPECT_EQ(0, encoder.getGroupSize());
+
+    for (uint16_t i = 0; i < 30; ++i)
+    {
+        auto packet = makeRtpPacket(_allocator, i, 500, false);
+        EXPECT_EQ(nullptr, encoder.addPacket(*packet, _allocator));
+    }
+}
+
+TEST_F(FlexFecEncoderTest, groupSizeAdaptsToLoss)
+{
+    rtp::FlexFecEncoder encoder(fecSsrc, mediaSsrc, fecPayloadType, 4);
+    encoder.onReportedLoss(5); // 2%
+    const auto lowLossGroupSize = encoder.getGroupSize();
+    encoder.onReportedLoss(26); // 10%
+    const auto highLossGroupSize = encoder.getGroupSize();
+    encoder.onReportedLoss(128);
+
+    EXPECT_LE(lowLossGroupSize, rtp::FlexFecEncoder::maxGroupSize);
+    EXPECT_GT(lowLossGroupSize, highLossGroupSize);
+    EXPECT_EQ(4, encoder.getGroupSize());
+}
+
+TEST_F(FlexFecEncoderTest, recoversEachSinglePacketLossInGroup)
+{
+    rtp::FlexFecEncoder encoder(fecSsrc, mediaSsrc, fecPayloadType, 4);
+    encoder.onReportedLoss(128);
+    ASSERT_EQ(4, encoder.getGroupSize());
+
+    std::vector<memory::UniquePacket> media;
+    memory::UniquePacket repairPacket;
+    const size_t payloadSizes[] = {900, 120, 1100, 37};
+    for (uint16_t i = 0; i < 4; ++i)
+    {
+        media.push_back(makeRtpPacket(_allocator, 65534 + i, payloadSizes[i], i == 3));
+        repairPacket = encoder.addPacket(*media.back(), _allocator);
+        if (i < 3)
+        {
+            EXPECT_EQ(nullptr, repairPacket);
+        }
+    }
+    ASSERT_NE(nullptr, repairPacket);
+
+    const auto* repairHeader = rtp::RtpHeader::fromPacket(*repairPacket);
+    ASSERT_NE(nullptr, repairHeader);
+    EXPECT_EQ(fecSsrc, repairHeader->ssrc.get());
+    EXPECT_EQ(fecPayloadType, repairHeader->payloadType);
+    EXPECT_EQ(1, repairHeader->csrcCount);
+    EXPECT_EQ(mediaSsrc, repairHeader->csrc[0].get());
+
+    for (size_t lost = 0; lost < media.size(); ++lost)
+    {
+        std::vector<const memory::Packet*> received;
+        for (size_t i = 0; i < media.size(); ++i)
+        {
+            if (i != lost)
+            {
+                received.push_back(media[i].get());
+            }
+        }
+
+        auto recovered = rtp::recoverFlexFecPacket(*repairPacket, received.data(), received.size(), _allocator);
+        ASSERT_NE(nullptr, recovered);
+        ASSERT_EQ(media[lost]->getLength(), recovered->getLength());
+        EXPECT_EQ(0, std::memcmp(media[lost]->get(), recovered->get(), recovered->getLength()));
+    }
+}
+
+TEST_F(FlexFecEncoderTest, cannotRecoverTwoLosses)
+{
+    rtp::FlexFecEncoder encoder(fecSsrc, mediaSsrc, fecPayloadType, 4);
+    encoder.onReportedLoss(128);
+
+    std::vector<memory::UniquePacket> media;
+    memory::UniquePacket repairPacket;
+    for (uint16_t i = 0; i < 4; ++i)
+    {
+        media.push_back(makeRtpPacket(_allocator, 100 + i, 400, false));
+        repairPacket = encoder.addPacket(*media.back(), _allocator);
+    }
+    ASSERT_NE(nullptr, repairPacket);
+
+    const memory::Packet* received[] = {media[0].get(), media[3].get()};
+    EXPECT_EQ(nullptr, rtp::recoverFlexFecPacket(*repairPacket, received, 2, _allocator));
+}
+
+TEST_F(FlexFecEncoderTest, sequenceGapClosesGroup)
+{
+    rtp::FlexFecEncoder encoder(fecSsrc, mediaSsrc, fecPayloadType, 4);
+    encoder.onReportedLoss(128);
+
+    auto first = makeRtpPacket(_allocator, 10, 300, false);
+    auto second = makeRtpPacket(_allocator, 11, 300, false);
+    auto afterGap = makeRtpPacket(_allocator, 40, 300, false);
+    EXPECT_EQ(nullptr, encoder.addPacket(*first, _allocator));
+    EXPECT_EQ(nullptr, encoder.addPacket(*second, _allocator));
+    auto repairPacket = encoder.addPacket(*afterGap, _allocator);
+    ASSERT_NE(nullptr, repairPacket);
+
+    const memory::Packet* received[] = {first.get()};
+    auto recovered = rtp::recoverFlexFecPacket(*repairPacket, received, 1, _allocator);
+    ASSERT_NE(nullptr, recovered);
+    EXPECT_EQ(0, std::memcmp(second->get(), recovered->get(), second->getLength()));
+}
@@ -499,3 +499,83 @@ TEST_F(SctpTransferTestFixture, sctpReorder)
     EXPECT_NE(sack3, nullptr);
     EXPECT_NE(openAck, nullptr);
 }
+
+TEST_F(SctpTransferTestFixture, bundleSmallMessages)
+{
+    using namespace sctptest;
+    SctpEndpoint A(5000, _config, _timestamp, 1000);
+    SctpEndpoint B(5001, _config, _timestamp, 1000);
+
+    establishConnection(A, B);
+
+    std::array<uint8_t, 60> data;
+    std::memset(data.data(), 0xbb, data.size());
+    const auto packetsSentA = A.sentPacketCount;
+    const auto packetsSentB = B.sentPacketCount;
+
+    const int MESSAGE_COUNT = 40;
+    for (int i = 0; i < MESSAGE_COUNT; ++i)
+    {
+        memory::PoolBuffer<memory::PacketPoolAllocator> buffer(_mainPacketAllocator, data.data(), data.size());
+        A._session->sendMessage(A.getStreamId(), webrtc::DataChannelPpid::WEBRTC_BINARY, buffer, _timestamp);
+    }
+
+    for (int i = 0; i < 200 && B.getReceivedMessageCount() < MESSAGE_COUNT; ++i)
+    {
+        _timestamp += 1 * utils::Time::ms;
+        A.process();
+        B.process();
+        A.forwardPackets(B);
+        B.forwardPackets(A);
+    }
+
+    EXPECT_EQ(B.getReceivedMessageCount(), MESSAGE_COUNT);
+    EXPECT_EQ(B.getReceivedSize(), MESSAGE_COUNT * data.size());
+    // first message goes out immediately, the rest is bundled into few packets
+    EXPECT_LE(A.sentPacketCount - packetsSentA, 5u);
+    EXPECT_LE(B.sentPacketCount - packetsSentB, 5u);
+}
+
+TEST_F(SctpTransferTestFixture, bundleFillsPacket)
+{
+    using namespace sctptest;
+    SctpEndpoint A(5000, _config, _timestamp, 1000);
+    SctpEndpoint B(5001, _config, _timestamp, 1000);
+
+    establishConnection(A, B);
+
+    std::array<uint8_t, 60> data;
+    std::memset(data.data(), 0xbb, data.size());
+
+    // first message goes out immediately and stays in flight
+    memory::PoolBuffer<memory::PacketPoolAllocator> firstBuffer(_mainPacketAllocator, data.data(), data.size());
+    A._session->sendMessage(A.getStreamId(), webrtc::DataChannelPpid::WEBRTC_BINARY, firstBuffer, _timestamp);
+    ASSERT_EQ(1u, A._sendQueue.count());
+    A._sendQueue.pop();
+
+    const size_t chunkSize = sctp::PayloadDataChunk::HEADER_SIZE + data.size();
+    const size_t chunksPerPacket = (A._session->getScptMTU() - sctp::SctpPacketW::HEADER_SIZE) / chunkSize;
+    size_t queuedCount = 0;
+    while (A._sendQueue.empty() && queuedCount < 2 * chunksPerPacket)
+    {
+        memory::PoolBuffer<memory::PacketPoolAllocator> buffer(_mainPacketAllocator, data.data(), data.size());
+        A._session->sendMessage(A.getStreamId(), webrtc::DataChannelPpid::WEBRTC_BINARY, buffer, _timestamp);
+        ++queuedCount;
+    }
+
+    // held until a full packet is pending, which then carries as many chunks as fit
+    EXPECT_GE(queuedCount, chunksPerPacket);
+    EXPECT_LE(queuedCount, chunksPerPacket + 1);
+    ASSERT_FALSE(A._sendQueue.empty());
+    auto packet = A._sendQueue.pop();
+    sctp::SctpPacket sctpPacket(packet->get(), packet->getLength());
+    size_t dataChunkCount = 0;
+    for (auto& chunk : sctpPacket.chunks())
+    {
+        if (chunk.header.type == sctp::ChunkType::DATA)
+        {
+            ++dataChunkCount;
+        }
+    }
+    EXPECT_EQ(chunksPerPacket, dataChunkCount);
+}
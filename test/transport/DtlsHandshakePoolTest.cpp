@@ -0,0 +1,103 @@
+#include "transport/DtlsHandshakePool.h"
+#include "config/Config.h"
+#include "jobmanager/JobManager.h"
+#include "jobmanager/TimerQueue.h"
+#include "utils/Time.h"
+#include <gtest/gtest.h>
+
+using namespace transport;
+
+class DtlsHandshakePoolTest : public ::testing::Test
+{
+public:
+    DtlsHandshakePoolTest() : _timers(64), _jobManager(_timers) {}
+
+    void SetUp() override
+    {
+        _config.readFromString(R"({
+            "dtls.handshakesPerSecond": 100,
+            "dtls.handshakeBurst": 10,
+            "dtls.maxQueuedJobs": 4
+        })");
+    }
+
+    void TearDown() override
+    {
+        _jobManager.stop();
+        _timers.stop();
+    }
+
+protected:
+    config::Config _config;
+    jobmanager::TimerQueue _timers;
+    jobmanager::JobManager _jobManager;
+    uint64_t _timestamp = 1000 * utils::Time::sec;
+};
+
+TEST_F(DtlsHandshakePoolTest, admissionRateIsLimited)
+{
+    DtlsHandshakePool pool(_config, _jobManager);
+
+    uint32_t admitted = 0;
+    for (int i = 0; i < 20; ++i)
+    {
+        admitted += pool.tryAcquire(_timestamp) ? 1 : 0;
+    }
+    EXPECT_EQ(10, admitted);
+
+    _timestamp += 50 * utils::Time::ms;
+    admitted = 0;
+    for (int i = 0; i < 20; ++i)
+    {
+        admitted += pool.tryAcquire(_timestamp) ? 1 : 0;
+    }
+    EXPECT_EQ(5, admitted);
+
+    auto stats = pool.getStats();
+    EXPECT_EQ(15, stats.active);
+    EXPECT_EQ(15, stats.admitted);
+    EXPECT_EQ(25, stats.rejected);
+
+    for (int i = 0; i < 15; ++i)
+    {
+        pool.release();
+    }
+    EXPECT_EQ(0, pool.getStats().active);
+}
+
+TEST_F(DtlsHandshakePoolTest, deepQueueIsNotAdmitted)
+{
+    DtlsHandshakePool pool(_config, _jobManager);
+
+    // no worker threads, jobs stay queued
+    for (int i = 0; i < 4; ++i)
+    {
+        _jobManager.post([]() {});
+    }
+
+    EXPECT_FALSE(pool.tryAcquire(_timestamp));
+    EXPECT_EQ(4, pool.getStats().queueDepth);
+    EXPECT_EQ(1, pool.getStats().rejected);
+
+    for (auto* job = _jobManager.pop(); job; job = _jobManager.pop())
+    {
+        _jobManager.freeJob(job);
+    }
+    EXPECT_TRUE(pool.tryAcquire(_timestamp));
+    pool.release();
+}
+
+TEST_F(DtlsHandshakePoolTest, latency)
+{
+    DtlsHandshakePool pool(_config, _jobManager);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        pool.onRecordProcessed(_timestamp, _timestamp + 4 * utils::Time::ms);
+    }
+    pool.onRecordProcessed(_timestamp, _timestamp + 40 * utils::Time::ms);
+
+    const auto stats = pool.getStats();
+    EXPECT_NEAR(5.0, stats.avgLatencyMs, 1.5);
+    EXPECT_NEAR(40.0, stats.maxLatencyMs, 0.1);
+}
@@ -0,0 +1,87 @@
+#include "transport/EgressPacer.h"
+#include "utils/Time.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace transport;
+
+namespace
+{
+class PacedSender : public EgressPacer::IPacedSender
+{
+public:
+    void onPacingReleaseDue(uint64_t timestamp) override
+    {
+        releaseTime = timestamp;
+        ++releaseCount;
+    }
+
+    std::atomic_uint64_t releaseTime = {0};
+    std::atomic_uint32_t releaseCount = {0};
+};
+
+bool waitForRelease(const std::vector<PacedSender>& senders, uint64_t timeout)
+{
+    const auto start = utils::Time::getAbsoluteTime();
+    while (utils::Time::diffLT(start, utils::Time::getAbsoluteTime(), timeout))
+    {
+        bool allReleased = true;
+        for (auto& sender : senders)
+        {
+            allReleased &= sender.releaseCount > 0;
+        }
+        if (allReleased)
+        {
+            return true;
+        }
+        utils::Time::rawNanoSleep(utils::Time::ms);
+    }
+    return false;
+}
+} // namespace
+
+TEST(EgressPacerTest, releasesAtScheduledTime)
+{
+    EgressPacer pacer(128);
+    std::vector<PacedSender> senders(3);
+
+    const auto start = utils::Time::getAbsoluteTime();
+    const uint64_t delays[] = {0, 20 * utils::Time::ms, 5 * utils::Time::ms};
+    for (size_t i = 0; i < senders.size(); ++i)
+    {
+        EXPECT_TRUE(pacer.schedule(senders[i], start + delays[i]));
+    }
+
+    ASSERT_TRUE(waitForRelease(senders, utils::Time::sec));
+    for (size_t i = 0; i < senders.size(); ++i)
+    {
+        EXPECT_EQ(1, senders[i].releaseCount);
+        EXPECT_GE(senders[i].releaseTime + EgressPacer::slotDuration, start + delays[i]);
+    }
+    EXPECT_LT(senders[2].releaseTime.load(), senders[1].releaseTime.load());
+    EXPECT_EQ(0, pacer.getScheduledCount());
+}
+
+TEST(EgressPacerTest, releaseBeyondCalendarRound)
+{
+    EgressPacer pacer(128);
+    std::vector<PacedSender> senders(1);
+
+    const auto start = utils::Time::getAbsoluteTime();
+    const auto delay = (EgressPacer::slotCount + 10) * EgressPacer::slotDuration;
+    EXPECT_TRUE(pacer.schedule(senders[0], start + delay));
+
+    ASSERT_TRUE(waitForRelease(senders, 2 * utils::Time::sec));
+    EXPECT_GE(senders[0].releaseTime + EgressPacer::slotDuration, start + delay);
+}
+
+TEST(EgressPacerTest, pendingSchedulesReleasedOnDestruction)
+{
+    std::vector<PacedSender> senders(1);
+    {
+        EgressPacer pacer(128);
+        EXPECT_TRUE(pacer.schedule(senders[0], utils::Time::getAbsoluteTime() + utils::Time::sec * 10));
+    }
+    EXPECT_EQ(1, senders[0].releaseCount);
+}
@@ -0,0 +1,190 @@
+#include "transport/IngressLimiter.h"
+#include "config/Config.h"
+#include "utils/Time.h"
+#include <gtest/gtest.h>
+
+using namespace transport;
+
+namespace
+{
+// transport 100kB/s with 10kB burst, source 50kB/s with 5kB burst
+const char* limiterConfig = R"({
+    "ingress.transportKbps": 800,
+    "ingress.sourceKbps": 400,
+    "ingress.enable": true,
+    "ingress.burstMs": 100,
+    "ingress.rejectedSsrcTimeoutMs": 500,
+    "ingress.rejectedSsrcHits": 3,
+    "ingress.rejectedSsrcWindowMs": 100
+})";
+
+void rejectRepeatedly(IngressLimiter& limiter, uint32_t ssrc, uint32_t count, uint64_t timestamp)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        limiter.rejectSsrc(ssrc, timestamp);
+    }
+}
+
+uint32_t admitBurst(IngressLimiter& limiter,
+    const SocketAddress& source,
+    uint32_t ssrc,
+    size_t length,
+    uint32_t count,
+    uint64_t timestamp)
+{
+    uint32_t admitted = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        admitted += limiter.admit(source, ssrc, length, timestamp) ? 1 : 0;
+    }
+    return admitted;
+}
+} // namespace
+
+class IngressLimiterTest : public ::testing::Test
+{
+public:
+    IngressLimiterTest()
+        : _sourceA(SocketAddress::parse("10.0.0.1", 5000)),
+          _sourceB(SocketAddress::parse("10.0.0.2", 5000)),
+          _sourceC(SocketAddress::parse("10.0.0.3", 5000))
+    {
+    }
+
+    void SetUp() override { _config.readFromString(limiterConfig); }
+
+protected:
+    config::Config _config;
+    IngressDropCounters _counters;
+    SocketAddress _sourceA;
+    SocketAddress _sourceB;
+    SocketAddress _sourceC;
+    uint64_t _timestamp = 1000 * utils::Time::sec;
+};
+
+TEST_F(IngressLimiterTest, tokenBucketRefills)
+{
+    utils::TokenBucket bucket(1000, 100);
+    EXPECT_TRUE(bucket.consume(_timestamp, 100));
+    EXPECT_FALSE(bucket.consume(_timestamp, 1));
+
+    _timestamp += 50 * utils::Time::ms;
+    EXPECT_EQ(50, bucket.getTokens(_timestamp));
+
+    // refill is capped at burst size
+    _timestamp += 10 * utils::Time::sec;
+    EXPECT_EQ(100, bucket.getTokens(_timestamp));
+    EXPECT_FALSE(bucket.consume(_timestamp, 101));
+}
+
+TEST_F(IngressLimiterTest, sourceBurstIsLimited)
+{
+    IngressLimiter limiter(_config, _counters);
+
+    EXPECT_EQ(5, admitBurst(limiter, _sourceA, 1, 1000, 10, _timestamp));
+    EXPECT_EQ(5, _counters.snapshot().sourceRate);
+
+    // other source has its own bucket
+    EXPECT_EQ(5, admitBurst(limiter, _sourceB, 1, 1000, 5, _timestamp));
+
+    _timestamp += 20 * utils::Time::ms;
+    EXPECT_EQ(1, admitBurst(limiter, _sourceA, 1, 1000, 2, _timestamp));
+    EXPECT_EQ(0, _counters.snapshot().transportRate);
+}
+
+TEST_F(IngressLimiterTest, transportBurstIsLimited)
+{
+    IngressLimiter limiter(_config, _counters);
+
+    uint32_t admitted = admitBurst(limiter, _sourceA, 1, 1000, 5, _timestamp);
+    admitted += admitBurst(limiter, _sourceB, 1, 1000, 5, _timestamp);
+    admitted += admitBurst(limiter, _sourceC, 1, 1000, 5, _timestamp);
+
+    EXPECT_EQ(10, admitted);
+    EXPECT_EQ(5, _counters.snapshot().transportRate);
+    EXPECT_EQ(0, _counters.snapshot().sourceRate);
+}
+
+TEST_F(IngressLimiterTest, smallPacketsAreChargedMinimum)
+{
+    IngressLimiter limiter(_config, _counters);
+
+    EXPECT_EQ(25, admitBurst(limiter, _sourceA, 1, 20, 100, _timestamp));
+}
+
+TEST_F(IngressLimiterTest, rejectedSsrcExpires)
+{
+    IngressLimiter limiter(_config, _counters);
+
+    rejectRepeatedly(limiter, 7, 3, _timestamp);
+    EXPECT_FALSE(limiter.admit(_sourceA, 7, 100, _timestamp));
+    EXPECT_TRUE(limiter.admit(_sourceA, 8, 100, _timestamp));
+    EXPECT_EQ(1, _counters.snapshot().rejectedSsrc);
+
+    _timestamp += 400 * utils::Time::ms;
+    EXPECT_FALSE(limiter.admit(_sourceA, 7, 100, _timestamp));
+
+    _timestamp += 200 * utils::Time::ms;
+    EXPECT_TRUE(limiter.admit(_sourceA, 7, 100, _timestamp));
+    EXPECT_EQ(2, _counters.snapshot().rejectedSsrc);
+}
+
+TEST_F(IngressLimiterTest, ssrcIsRejectedOnlyOnRepeatedHitsInWindow)
+{
+    IngressLimiter limiter(_config, _counters);
+
+    rejectRepeatedly(limiter, 7, 2, _timestamp);
+    EXPECT_TRUE(limiter.admit(_sourceA, 7, 100, _timestamp));
+
+    // window restarts, earlier hits do not count
+    _timestamp += 150 * utils::Time::ms;
+    rejectRepeatedly(limiter, 7, 2, _timestamp);
+    EXPECT_TRUE(limiter.admit(_sourceA, 7, 100, _timestamp));
+
+    _timestamp += 50 * utils::Time::ms;
+    limiter.rejectSsrc(7, _timestamp);
+    EXPECT_FALSE(limiter.admit(_sourceA, 7, 100, _timestamp));
+}
+
+TEST_F(IngressLimiterTest, ssrcConfiguredAfterFirstPacket)
+{
+    IngressLimiter limiter(_config, _counters);
+
+    // first packet arrives before the inbound stream is configured
+    EXPECT_TRUE(limiter.admit(_sourceA, 7, 100, _timestamp));
+    limiter.rejectSsrc(7, _timestamp);
+
+    _timestamp += 5 * utils::Time::ms;
+    EXPECT_TRUE(limiter.admit(_sourceA, 7, 100, _timestamp));
+    limiter.rejectSsrc(7, _timestamp);
+
+    // stream gets configured
+    limiter.clearRejectedSsrcs();
+
+    _timestamp += 5 * utils::Time::ms;
+    EXPECT_TRUE(limiter.admit(_sourceA, 7, 100, _timestamp));
+    limiter.rejectSsrc(7, _timestamp);
+    EXPECT_TRUE(limiter.admit(_sourceA, 7, 100, _timestamp));
+    EXPECT_EQ(0, _counters.snapshot().rejectedSsrc);
+}
+
+TEST_F(IngressLimiterTest, clearingRejectionsAdmitsSsrc)
+{
+    IngressLimiter limiter(_config, _counters);
+
+    rejectRepeatedly(limiter, 7, 3, _timestamp);
+    EXPECT_FALSE(limiter.admit(_sourceA, 7, 100, _timestamp));
+
+    limiter.clearRejectedSsrcs();
+    EXPECT_TRUE(limiter.admit(_sourceA, 7, 100, _timestamp));
+}
+
+TEST_F(IngressLimiterTest, disabled)
+{
+    _config.readFromString(R"({"ingress.enable": false, "ingress.sourceKbps": 8})");
+    IngressLimiter limiter(_config, _counters);
+
+    rejectRepeatedly(limiter, 7, 3, _timestamp);
+    EXPECT_EQ(100, admitBurst(limiter, _sourceA, 7, 1000, 100, _timestamp));
+}
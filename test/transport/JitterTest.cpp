@@ -1003,3 +1003,159 @@ TEST_F(JitterBufferTest, reorderedOne)
     header = rtp::RtpHeader::fromPacket(*p);
     EXPECT_EQ(header->sequenceNumber.get(), 100);
 }
+
+TEST_F(JitterBufferTest, duplicateAndWrap)
+{
+    memory::Packet stageArea;
+    {
+        auto header = rtp::RtpHeader::create(stageArea);
+        header->ssrc = 4000;
+        stageArea.setLength(250);
+    }
+
+    for (int i = 0; i < 10; ++i)
+    {
+        auto p = memory::makeUniquePacket(_allocator, stageArea);
+        auto header = rtp::RtpHeader::create(*p);
+        header->sequenceNumber = 65530 + i;
+        header->timestamp = 56000 + i * 960;
+        EXPECT_TRUE(_buffer.add(std::move(p)));
+    }
+
+    auto p = memory::makeUniquePacket(_allocator, stageArea);
+    auto header = rtp::RtpHeader::create(*p);
+    header->sequenceNumber = 2;
+    EXPECT_FALSE(_buffer.add(std::move(p)));
+
+    EXPECT_EQ(_buffer.count(), 10);
+    EXPECT_EQ(_buffer.getRtpDelay(), 960 * 9);
+    EXPECT_EQ(_buffer.getFrontRtp()->sequenceNumber.get(), 65530);
+    EXPECT_EQ(_buffer.getTailRtp()->sequenceNumber.get(), 3);
+
+    uint16_t expectedSequenceNumber = 65530;
+    for (auto packet = _buffer.pop(); packet; packet = _buffer.pop())
+    {
+        EXPECT_EQ(rtp::RtpHeader::fromPacket(*packet)->sequenceNumber.get(), expectedSequenceNumber);
+        ++expectedSequenceNumber;
+    }
+    EXPECT_EQ(expectedSequenceNumber, 4);
+}
+
+TEST_F(JitterBufferTest, gapBeyondRing)
+{
+    memory::Packet stageArea;
+    {
+        auto header = rtp::RtpHeader::create(stageArea);
+        header->ssrc = 4000;
+        stageArea.setLength(250);
+    }
+
+    auto p = memory::makeUniquePacket(_allocator, stageArea);
+    auto header = rtp::RtpHeader::create(*p);
+    header->sequenceNumber = 100;
+    EXPECT_TRUE(_buffer.add(std::move(p)));
+
+    p = memory::makeUniquePacket(_allocator, stageArea);
+    header = rtp::RtpHeader::create(*p);
+    header->sequenceNumber = 100 + 1000;
+    EXPECT_FALSE(_buffer.add(std::move(p)));
+
+    p = memory::makeUniquePacket(_allocator, stageArea);
+    header = rtp::RtpHeader::create(*p);
+    header->sequenceNumber = 100 + 400;
+    EXPECT_TRUE(_buffer.add(std::move(p)));
+    EXPECT_EQ(_buffer.count(), 2);
+
+    EXPECT_EQ(rtp::RtpHeader::fromPacket(*_buffer.pop())->sequenceNumber.get(), 100);
+    EXPECT_EQ(rtp::RtpHeader::fromPacket(*_buffer.pop())->sequenceNumber.get(), 500);
+    EXPECT_TRUE(_buffer.empty());
+}
+
+namespace
+{
+// Feeds the buffer a stream where packets arrive in bursts and some are delayed a few packets. Keeps about
+// targetLevel packets in the buffer as the audio pipeline would.
+uint64_t runJitterBufferLoad(rtp::JitterBufferList& buffer,
+    memory::PacketPoolAllocator& allocator,
+    const uint32_t packetCount,
+    const uint32_t burstSize,
+    const uint32_t reorderPercent,
+    const uint32_t targetLevel)
+{
+    memory::Packet stageArea;
+    {
+        auto header = rtp::RtpHeader::create(stageArea);
+        header->ssrc = 4000;
+        stageArea.setLength(250);
+    }
+
+    std::mt19937 generator(0xfb3b61a);
+    std::vector<uint16_t> arrivalOrder;
+    arrivalOrder.reserve(packetCount);
+    for (uint32_t i = 0; i < packetCount; ++i)
+    {
+        arrivalOrder.push_back(i);
+    }
+    for (uint32_t i = 0; i + 4 < packetCount; ++i)
+    {
+        if (generator() % 100 < reorderPercent)
+        {
+            std::swap(arrivalOrder[i], arrivalOrder[i + 1 + generator() % 3]);
+        }
+    }
+
+    uint64_t popped = 0;
+    uint64_t elapsed = 0;
+    std::vector<memory::UniquePacket> burst;
+    for (uint32_t i = 0; i < packetCount; i += burstSize)
+    {
+        // only the buffer operations are timed
+        for (uint32_t j = i; j < std::min(i + burstSize, packetCount); ++j)
+        {
+            auto p = memory::makeUniquePacket(allocator, stageArea);
+            auto header = rtp::RtpHeader::create(*p);
+            header->sequenceNumber = arrivalOrder[j];
+            header->timestamp = arrivalOrder[j] * 960;
+            burst.push_back(std::move(p));
+        }
+
+        const auto start = utils::Time::getAbsoluteTime();
+        for (auto& p : burst)
+        {
+            buffer.add(std::move(p));
+        }
+        while (buffer.count() > targetLevel)
+        {
+            buffer.pop();
+            ++popped;
+        }
+        elapsed += utils::Time::getAbsoluteTime() - start;
+        burst.clear();
+    }
+    while (buffer.pop())
+    {
+        ++popped;
+    }
+
+    logger::info("%u packets, burst %u, reorder %u%%, level %u: %.1fns per packet",
+        "JitterBufferTest",
+        packetCount,
+        burstSize,
+        reorderPercent,
+        targetLevel,
+        static_cast<double>(elapsed) / packetCount);
+    return popped;
+}
+} // namespace
+
+TEST_F(JitterBufferTest, perfReorderedBursts)
+{
+#ifdef NOPERF_TEST
+    GTEST_SKIP();
+#endif
+    const uint32_t packetCount = 500000;
+    EXPECT_EQ(runJitterBufferLoad(_buffer, _allocator, packetCount, 1, 0, 10), packetCount);
+    EXPECT_EQ(runJitterBufferLoad(_buffer, _allocator, packetCount, 1, 10, 10), packetCount);
+    EXPECT_EQ(runJitterBufferLoad(_buffer, _allocator, packetCount, 25, 10, 50), packetCount);
+    EXPECT_EQ(runJitterBufferLoad(_buffer, _allocator, packetCount, 100, 20, 180), packetCount);
+}
@@ -0,0 +1,175 @@
+#include "transport/RecordingSegmentWriter.h"
+#include "memory/Allocator.h"
+#include "memory/PacketPoolAllocator.h"
+#include "utils/Time.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace transport;
+
+namespace
+{
+
+class WriterEvents : public RecordingSegmentWriter::IEvents
+{
+public:
+    void onEventPersisted(uint16_t sequenceNumber) override
+    {
+        persistedEvents.push_back(sequenceNumber);
+        ++persistedCount;
+    }
+    void onClosed() override { closed = true; }
+
+    bool waitForClose()
+    {
+        for (int i = 0; i < 500 && !closed; ++i)
+        {
+            utils::Time::rawNanoSleep(10 * utils::Time::ms);
+        }
+        return closed;
+    }
+
+    std::vector<uint16_t> persistedEvents;
+    std::atomic_uint32_t persistedCount = {0};
+    std::atomic_bool closed = {false};
+};
+
+std::vector<uint8_t> readFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+memory::UniquePacket makePacket(memory::PacketPoolAllocator& allocator, uint8_t fill, size_t length)
+{
+    auto packet = memory::makeUniquePacket(allocator);
+    std::memset(packet->get(), fill, length);
+    packet->setLength(length);
+    return packet;
+}
+
+} // namespace
+
+class RecordingSegmentWriterTest : public ::testing::Test
+{
+public:
+    RecordingSegmentWriterTest()
+        : _allocator(512, "RecordingSegmentWriterTest"),
+          _directory(std::filesystem::temp_directory_path().string() + "/smbRecordingTest" +
+              std::to_string(::getpid()))
+    {
+    }
+
+    void TearDown() override { std::filesystem::remove_all(_directory); }
+
+protected:
+    memory::PacketPoolAllocator _allocator;
+    std::string _directory;
+};
+
+TEST_F(RecordingSegmentWriterTest, recordsAreReadableFromBlocks)
+{
+    const uint32_t blockSize = 4096;
+    RecordingSegmentWriter writer(_directory, blockSize, 1024 * 1024, 20 * utils::Time::ms, 1024);
+
+    WriterEvents events;
+    const auto fileId = writer.open("1-2", &events);
+    const size_t recordCount = 40;
+    for (size_t i = 0; i < recordCount; ++i)
+    {
+        EXPECT_TRUE(writer.append(fileId, recfile::RecordType::Rtp, makePacket(_allocator, i, 300), 1000 + i));
+    }
+    EXPECT_TRUE(writer.appendEvent(fileId, makePacket(_allocator, 0, 20), 7, 2000));
+    writer.close(fileId);
+
+    ASSERT_TRUE(events.waitForClose());
+    ASSERT_EQ(1, events.persistedEvents.size());
+    EXPECT_EQ(7, events.persistedEvents[0]);
+
+    const auto data = readFile(_directory + "/1-2-00000.smbrec");
+    ASSERT_FALSE(data.empty());
+    ASSERT_EQ(0, data.size() % blockSize);
+
+    size_t rtpRecords = 0;
+    size_t eventRecords = 0;
+    uint64_t previousTimestamp = 0;
+    for (size_t offset = 0; offset < data.size(); offset += blockSize)
+    {
+        auto* header = reinterpret_cast<const recfile::BlockHeader*>(&data[offset]);
+        ASSERT_EQ(recfile::blockMagic, header->magic);
+        ASSERT_LE(header->usedBytes, blockSize);
+        EXPECT_LE(header->firstTimestamp, header->lastTimestamp);
+
+        size_t recordOffset = header->headerSize;
+        for (uint32_t i = 0; i < header->recordCount; ++i)
+        {
+            auto* record = reinterpret_cast<const recfile::RecordHeader*>(&data[offset + recordOffset]);
+            EXPECT_GE(record->timestamp, previousTimestamp);
+            previousTimestamp = record->timestamp;
+            if (record->type == recfile::RecordType::Rtp)
+            {
+                EXPECT_EQ(300, record->length);
+                EXPECT_EQ(rtpRecords & 0xFF, reinterpret_cast<const uint8_t*>(record + 1)[0]);
+                ++rtpRecords;
+            }
+            else if (record->type == recfile::RecordType::Event)
+            {
+                ++eventRecords;
+            }
+            recordOffset += recfile::recordSpace(record->length);
+        }
+        EXPECT_EQ(header->usedBytes, recordOffset);
+    }
+
+    EXPECT_EQ(recordCount, rtpRecords);
+    EXPECT_EQ(1, eventRecords);
+    EXPECT_GT(data.size(), blockSize);
+}
+
+TEST_F(RecordingSegmentWriterTest, segmentsRotate)
+{
+    const uint32_t blockSize = 4096;
+    RecordingSegmentWriter writer(_directory, blockSize, 2 * blockSize, 20 * utils::Time::ms, 1024);
+
+    WriterEvents events;
+    const auto fileId = writer.open("3-4", &events);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        EXPECT_TRUE(writer.append(fileId, recfile::RecordType::Rtp, makePacket(_allocator, i, 500), 1000 + i));
+    }
+    writer.close(fileId);
+    ASSERT_TRUE(events.waitForClose());
+
+    EXPECT_EQ(2 * blockSize, readFile(_directory + "/3-4-00000.smbrec").size());
+    EXPECT_TRUE(std::filesystem::exists(_directory + "/3-4-00001.smbrec"));
+    EXPECT_GE(writer.getWrittenBytes(), 100 * (sizeof(recfile::RecordHeader) + 500));
+}
+
+TEST_F(RecordingSegmentWriterTest, flushWritesOnlyChangedPages)
+{
+    const uint32_t blockSize = 64 * 1024;
+    RecordingSegmentWriter writer(_directory, blockSize, 1024 * 1024, 10 * utils::Time::sec, 1024);
+
+    WriterEvents events;
+    const auto fileId = writer.open("5-6", &events);
+    for (uint16_t i = 0; i < 10; ++i)
+    {
+        EXPECT_TRUE(writer.appendEvent(fileId, makePacket(_allocator, i, 100), i, 1000 + i));
+        // flush interval is long, so the event is only persisted if the writer wakes up on enqueue
+        for (int j = 0; j < 500 && events.persistedCount <= i; ++j)
+        {
+            utils::Time::rawNanoSleep(utils::Time::ms);
+        }
+        ASSERT_EQ(i + 1u, events.persistedCount.load());
+    }
+
+    // each flush writes the one page that changed rather than the whole block
+    EXPECT_EQ(10 * memory::page::getPageSize(), writer.getWrittenBytes());
+    writer.close(fileId);
+    ASSERT_TRUE(events.waitForClose());
+    EXPECT_EQ(blockSize, readFile(_directory + "/5-6-00000.smbrec").size());
+}
@@ -0,0 +1,149 @@
+#include "transport/SocketHandover.h"
+#include "transport/RtcSocket.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace transport;
+
+namespace
+{
+int openBoundUdpSocket(SocketAddress& localPort)
+{
+    const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    auto address = SocketAddress::parse("127.0.0.1", 0);
+    ::bind(fd, address.getSockAddr(), address.getSockAddrSize());
+
+    RawSockAddress boundAddress;
+    socklen_t addressLength = sizeof(boundAddress);
+    ::getsockname(fd, &boundAddress.gen, &addressLength);
+    localPort = SocketAddress(&boundAddress.gen);
+    return fd;
+}
+
+bool receiveDatagram(int fd)
+{
+    timeval timeout = {1, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    char buffer[64];
+    return ::recv(fd, buffer, sizeof(buffer), 0) > 0;
+}
+} // namespace
+
+TEST(SocketHandoverTest, receivedSocketKeepsPort)
+{
+    SocketAddress localPort;
+    const int originalFd = openBoundUdpSocket(localPort);
+
+    int channel[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, channel));
+
+    std::vector<HandoverSocket> sockets;
+    EXPECT_TRUE(handover::sendSockets(channel[0], handover::findBoundSockets({localPort})));
+    EXPECT_TRUE(handover::receiveSockets(channel[1], sockets));
+    ::close(channel[0]);
+    ::close(channel[1]);
+
+    ASSERT_EQ(1, sockets.size());
+    EXPECT_EQ(localPort, sockets[0].localPort);
+    EXPECT_EQ(SOCK_DGRAM, sockets[0].socketType);
+    EXPECT_NE(originalFd, sockets[0].fd);
+
+    // the port stays bound when the sending side closes its handle
+    ::close(originalFd);
+    RtcSocket sender;
+    ASSERT_EQ(0, sender.open(SocketAddress::parse("127.0.0.1"), 0));
+    EXPECT_EQ(0, sender.sendTo("ping", 4, localPort));
+    EXPECT_TRUE(receiveDatagram(sockets[0].fd));
+    ::close(sockets[0].fd);
+}
+
+TEST(SocketHandoverTest, rtcSocketAdoptsInheritedSocket)
+{
+    SocketAddress localPort;
+    const int fd = openBoundUdpSocket(localPort);
+    handover::setInheritedSockets({HandoverSocket{localPort, SOCK_DGRAM, fd}});
+
+    EXPECT_EQ(-1, handover::takeInheritedSocket(localPort, SOCK_STREAM));
+
+    RtcSocket socket;
+    ASSERT_EQ(0, socket.open(localPort, localPort.getPort()));
+    EXPECT_EQ(fd, socket.fd());
+    EXPECT_EQ(localPort, socket.getBoundPort());
+    EXPECT_EQ(0, handover::closeInheritedSockets());
+}
+
+TEST(SocketHandoverTest, serverSendsSocketsWhenOwnerHasStopped)
+{
+    SocketAddress localPort;
+    const int fd = openBoundUdpSocket(localPort);
+    const std::string path = "/tmp/smb-handover-test-" + std::to_string(::getpid());
+
+    std::atomic_bool handoverRequested(false);
+    auto server = std::make_unique<HandoverServer>(
+        path,
+        [localPort]() { return handover::findBoundSockets({localPort}); },
+        [&handoverRequested]() { handoverRequested = true; });
+    ASSERT_TRUE(server->isGood());
+
+    struct stat pathStat;
+    ASSERT_EQ(0, ::stat(path.c_str(), &pathStat));
+    EXPECT_EQ(S_IRUSR | S_IWUSR, pathStat.st_mode & 0777);
+
+    std::atomic_bool fetchDone(false);
+    bool fetched = false;
+    std::vector<HandoverSocket> sockets;
+    std::thread newProcess([&]() {
+        fetched = handover::fetchSockets(path, sockets);
+        fetchDone = true;
+    });
+
+    for (int i = 0; i < 100 && !handoverRequested; ++i)
+    {
+        ::usleep(10000);
+    }
+    ASSERT_TRUE(handoverRequested);
+    EXPECT_TRUE(server->isHandoverRequested());
+    // the path is released for the new process
+    EXPECT_NE(0, ::access(path.c_str(), F_OK));
+
+    // the owner keeps receiving until it stops, the new process gets nothing until then
+    RtcSocket sender;
+    ASSERT_EQ(0, sender.open(SocketAddress::parse("127.0.0.1"), 0));
+    EXPECT_EQ(0, sender.sendTo("ping", 4, localPort));
+    EXPECT_TRUE(receiveDatagram(fd));
+    ::usleep(50000);
+    EXPECT_FALSE(fetchDone);
+
+    // the owner closes its handle as it shuts down, the duplicate keeps the port bound
+    ::close(fd);
+    EXPECT_EQ(0, sender.sendTo("pong", 4, localPort));
+    server.reset();
+    newProcess.join();
+
+    EXPECT_TRUE(fetched);
+    ASSERT_EQ(1, sockets.size());
+    EXPECT_EQ(localPort, sockets[0].localPort);
+    EXPECT_TRUE(receiveDatagram(sockets[0].fd));
+    ::close(sockets[0].fd);
+}
+
+TEST(SocketHandoverTest, stoppedServerRefusesHandover)
+{
+    const std::string path = "/tmp/smb-handover-test-stop-" + std::to_string(::getpid());
+    std::atomic_bool handoverRequested(false);
+    HandoverServer server(
+        path,
+        []() { return std::vector<HandoverSocket>(); },
+        [&handoverRequested]() { handoverRequested = true; });
+    ASSERT_TRUE(server.isGood());
+
+    server.stop();
+    std::vector<HandoverSocket> sockets;
+    EXPECT_FALSE(handover::fetchSockets(path, sockets, 1000));
+    EXPECT_FALSE(handoverRequested);
+    EXPECT_FALSE(server.isHandoverRequested());
+}
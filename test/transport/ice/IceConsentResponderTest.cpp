@@ -0,0 +1,144 @@
+#include "transport/ice/IceConsentResponder.h"
+#include "transport/ice/Stun.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+const std::pair<std::string, std::string> localCredentials("lufr", "localpassword1234567890");
+const char* remotePassword = "remotepassword1234567890";
+
+class CaptureEndpoint : public ice::IceEndpoint
+{
+public:
+    explicit CaptureEndpoint(ice::TransportType transportType) : _transportType(transportType) {}
+
+    void sendStunTo(const transport::SocketAddress& target,
+        ice::Int96 transactionId,
+        const void* data,
+        size_t len,
+        uint64_t timestamp) override
+    {
+        sent.emplace_back(reinterpret_cast<const uint8_t*>(data), reinterpret_cast<const uint8_t*>(data) + len);
+        lastTarget = target;
+    }
+
+    ice::TransportType getTransportType() const override { return _transportType; }
+    transport::SocketAddress getLocalPort() const override
+    {
+        return transport::SocketAddress::parse("10.0.0.1", 10000);
+    }
+    void cancelStunTransaction(ice::Int96 transactionId) override {}
+
+    std::vector<std::vector<uint8_t>> sent;
+    transport::SocketAddress lastTarget;
+
+private:
+    const ice::TransportType _transportType;
+};
+
+void makeRequest(ice::StunMessage& request,
+    const std::string& userName,
+    const std::string& password,
+    uint16_t roleAttribute)
+{
+    ice::StunTransactionIdGenerator idGenerator;
+    request.header.transactionId.set(idGenerator.next());
+    request.header.setMethod(ice::StunHeader::BindingRequest);
+    request.add(ice::StunGenericAttribute(ice::StunAttribute::USERNAME, userName));
+    request.add(ice::StunAttribute64(roleAttribute, 0x1234567890ull));
+    request.add(ice::StunAttribute(ice::StunAttribute::USE_CANDIDATE));
+    crypto::HMAC hmacComputer(password.c_str(), password.size());
+    request.addMessageIntegrity(hmacComputer);
+    request.addFingerprint();
+}
+} // namespace
+
+class IceConsentResponderTest : public ::testing::Test
+{
+public:
+    IceConsentResponderTest()
+        : _endpoint(ice::TransportType::UDP),
+          _peer(transport::SocketAddress::parse("192.168.1.20", 51000)),
+          _responder("slice")
+    {
+    }
+
+    void SetUp() override
+    {
+        _responder.setSelectedPair(&_endpoint, _peer, localCredentials, ice::IceRole::CONTROLLED);
+    }
+
+protected:
+    bool respond(const ice::StunMessage& request, const transport::SocketAddress& source)
+    {
+        return _responder.tryRespond(_endpoint, source, &request, request.size(), 1000);
+    }
+
+    CaptureEndpoint _endpoint;
+    transport::SocketAddress _peer;
+    ice::IceConsentResponder _responder;
+};
+
+TEST_F(IceConsentResponderTest, answersConsentCheck)
+{
+    ice::StunMessage request;
+    makeRequest(request, "lufr:rufr", localCredentials.second, ice::StunAttribute::ICE_CONTROLLING);
+
+    ASSERT_TRUE(respond(request, _peer));
+    ASSERT_EQ(1, _endpoint.sent.size());
+    EXPECT_EQ(_peer, _endpoint.lastTarget);
+
+    const auto* response = ice::StunMessage::fromPtr(_endpoint.sent[0].data());
+    EXPECT_TRUE(response->isValid());
+    EXPECT_EQ(ice::StunHeader::BindingResponse, response->header.getMethod());
+    EXPECT_EQ(request.header.transactionId.get(), response->header.transactionId.get());
+
+    crypto::HMAC hmacComputer(localCredentials.second.c_str(), localCredentials.second.size());
+    EXPECT_TRUE(response->isAuthentic(hmacComputer));
+
+    const auto* mappedAddress =
+        response->getAttribute<ice::StunXorMappedAddress>(ice::StunAttribute::XOR_MAPPED_ADDRESS);
+    ASSERT_NE(nullptr, mappedAddress);
+    EXPECT_EQ(_peer, mappedAddress->getAddress(response->header));
+}
+
+TEST_F(IceConsentResponderTest, declinesOtherPairs)
+{
+    ice::StunMessage request;
+    makeRequest(request, "lufr:rufr", localCredentials.second, ice::StunAttribute::ICE_CONTROLLING);
+
+    EXPECT_FALSE(respond(request, transport::SocketAddress::parse("192.168.1.20", 51002)));
+
+    CaptureEndpoint otherEndpoint(ice::TransportType::UDP);
+    EXPECT_FALSE(_responder.tryRespond(otherEndpoint, _peer, &request, request.size(), 1000));
+
+    _responder.clearSelectedPair();
+    EXPECT_FALSE(respond(request, _peer));
+    EXPECT_TRUE(_endpoint.sent.empty());
+}
+
+TEST_F(IceConsentResponderTest, declinesUnauthenticated)
+{
+    ice::StunMessage wrongPassword;
+    makeRequest(wrongPassword, "lufr:rufr", remotePassword, ice::StunAttribute::ICE_CONTROLLING);
+    EXPECT_FALSE(respond(wrongPassword, _peer));
+
+    ice::StunMessage wrongUser;
+    makeRequest(wrongUser, "other:rufr", localCredentials.second, ice::StunAttribute::ICE_CONTROLLING);
+    EXPECT_FALSE(respond(wrongUser, _peer));
+
+    ice::StunMessage corrupt;
+    makeRequest(corrupt, "lufr:rufr", localCredentials.second, ice::StunAttribute::ICE_CONTROLLING);
+    corrupt.attributes[10] ^= 0x40;
+    EXPECT_FALSE(respond(corrupt, _peer));
+    EXPECT_TRUE(_endpoint.sent.empty());
+}
+
+TEST_F(IceConsentResponderTest, declinesRoleConflict)
+{
+    ice::StunMessage request;
+    makeRequest(request, "lufr:rufr", localCredentials.second, ice::StunAttribute::ICE_CONTROLLED);
+    EXPECT_FALSE(respond(request, _peer));
+    EXPECT_TRUE(_endpoint.sent.empty());
+}
@@ -1,5 +1,43 @@
 #include "crypto/SslHelper.h"
 #include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+uint32_t referenceCrc(const crypto::Crc32Polynomial& polynomial, const uint8_t* data, size_t length)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; ++i)
+    {
+        crc = polynomial[data[i] ^ (crc & 0xFFu)] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void verifyAgainstReference(const crypto::Crc32Polynomial& polynomial)
+{
+    std::vector<uint8_t> data(1600);
+    uint32_t seed = 0x12345678u;
+    for (auto& b : data)
+    {
+        seed = seed * 1103515245u + 12345u;
+        b = static_cast<uint8_t>(seed >> 16);
+    }
+
+    for (size_t offset = 0; offset < 8; ++offset)
+    {
+        for (size_t length = 0; length < data.size() - offset; length += 7)
+        {
+            crypto::Crc32 crc(polynomial);
+            const size_t firstPart = length / 3;
+            crc.add(data.data() + offset, firstPart);
+            crc.add(data.data() + offset + firstPart, length - firstPart);
+            ASSERT_EQ(crc.compute(), referenceCrc(polynomial, data.data() + offset, length))
+                << "offset " << offset << " length " << length;
+        }
+    }
+}
+} // namespace
 
 TEST(Crc32, basic)
 {
@@ -10,6 +48,35 @@ TEST(Crc32, basic)
     EXPECT_EQ(crc.compute(), 0xa3830348u);
 }
 
+TEST(Crc32, checkValues)
+{
+    auto data = reinterpret_cast<const unsigned char*>("123456789");
+    for (bool allowHardware : {true, false})
+    {
+        crypto::Crc32Polynomial ieee(0x04C11DB7, allowHardware);
+        crypto::Crc32 crc(ieee);
+        crc.add(data, 9);
+        EXPECT_EQ(crc.compute(), 0xCBF43926u);
+
+        crypto::Crc32Polynomial castagnoli(0x1EDC6F41u, allowHardware);
+        crypto::Crc32 crcC(castagnoli);
+        crcC.add(data, 9);
+        EXPECT_EQ(crcC.compute(), 0xE3069283u);
+    }
+}
+
+TEST(Crc32, slicedMatchesBytewise)
+{
+    verifyAgainstReference(crypto::Crc32Polynomial(0x04C11DB7, false));
+    verifyAgainstReference(crypto::Crc32Polynomial(0x1EDC6F41u, false));
+}
+
+TEST(Crc32, acceleratedMatchesBytewise)
+{
+    verifyAgainstReference(crypto::Crc32Polynomial(0x04C11DB7));
+    verifyAgainstReference(crypto::Crc32Polynomial(0x1EDC6F41u));
+}
+
 TEST(MD5, msgintegrity)
 {
     const char* userpwd = "user:realm:pass";
@@ -1,5 +1,6 @@
 #include "logger/Logger.h"
 #include "utils/Time.h"
+#include "utils/TscTimeSource.h"
 #include <chrono>
 #include <gtest/gtest.h>
 TEST(DISABLED_TimeSource, Comparison)
@@ -18,3 +19,63 @@ TEST(DISABLED_TimeSource, Comparison)
         "",
         std::chrono::duration_cast<std::chrono::microseconds>(endSteady - startSteady).count());
 }
+
+TEST(TscTimeSource, accuracy)
+{
+    utils::TscTimeSource timeSource(utils::Time::ms * 20);
+    if (!timeSource.isTscUsed())
+    {
+        GTEST_SKIP();
+    }
+
+    uint64_t maxError = 0;
+    auto prevTime = timeSource.getAbsoluteTime();
+    for (int i = 0; i < 300; ++i)
+    {
+        for (int j = 0; j < 1000; ++j)
+        {
+            const auto tscTime = timeSource.getAbsoluteTime();
+            ASSERT_GE(tscTime, prevTime);
+            prevTime = tscTime;
+        }
+
+        const auto tscTime = timeSource.getAbsoluteTime();
+        const auto monotonicTime = utils::Time::rawAbsoluteTime();
+        maxError = std::max(maxError, static_cast<uint64_t>(std::abs(utils::Time::diff(tscTime, monotonicTime))));
+        utils::Time::rawNanoSleep(utils::Time::ms);
+    }
+
+    logger::info("max deviation from monotonic clock %" PRIu64 "ns", "TscTimeSource", maxError);
+    EXPECT_LT(maxError, utils::Time::us * 100);
+}
+
+TEST(TscTimeSource, perfReadTime)
+{
+#ifdef NOPERF_TEST
+    GTEST_SKIP();
+#endif
+    utils::TscTimeSource timeSource;
+    const int count = 10000000;
+    uint64_t sum = 0;
+
+    const auto start = utils::Time::rawAbsoluteTime();
+    for (int i = 0; i < count; ++i)
+    {
+        sum += timeSource.getAbsoluteTime();
+    }
+    const auto tscElapsed = utils::Time::rawAbsoluteTime() - start;
+
+    const auto monotonicStart = utils::Time::rawAbsoluteTime();
+    for (int i = 0; i < count; ++i)
+    {
+        sum += utils::Time::rawAbsoluteTime();
+    }
+    const auto monotonicElapsed = utils::Time::rawAbsoluteTime() - monotonicStart;
+
+    logger::info("tsc %.1fns, clock_gettime %.1fns per read, tsc used %c",
+        "TscTimeSource",
+        static_cast<double>(tscElapsed) / count,
+        static_cast<double>(monotonicElapsed) / count,
+        timeSource.isTscUsed() ? 'y' : 'n');
+    EXPECT_NE(0, sum);
+}
@@ -0,0 +1,71 @@
+#include "transport/DtlsHandshakePool.h"
+#include "concurrency/ScopedSpinLocker.h"
+#include "config/Config.h"
+#include "jobmanager/JobManager.h"
+#include <algorithm>
+#include <cassert>
+
+namespace transport
+{
+
+DtlsHandshakePool::DtlsHandshakePool(const config::Config& config, jobmanager::JobManager& jobManager)
+    : _jobManager(jobManager),
+      _maxQueueDepth(config.dtls.maxQueuedJobs),
+      _rate(config.dtls.handshakesPerSecond, config.dtls.handshakeBurst),
+      _active(0),
+      _admitted(0),
+      _rejected(0),
+      _latency(0.05),
+      _maxLatency(0.01)
+{
+}
+
+bool DtlsHandshakePool::tryAcquire(const uint64_t timestamp)
+{
+    if (static_cast<uint32_t>(_jobManager.getCount()) >= _maxQueueDepth)
+    {
+        ++_rejected;
+        return false;
+    }
+
+    {
+        concurrency::ScopedSpinLocker lock(_lock);
+        if (!_rate.consume(timestamp, 1))
+        {
+            ++_rejected;
+            return false;
+        }
+    }
+
+    ++_active;
+    ++_admitted;
+    return true;
+}
+
+void DtlsHandshakePool::release()
+{
+    assert(_active > 0);
+    --_active;
+}
+
+void DtlsHandshakePool::onRecordProcessed(const uint64_t receiveTimestamp, const uint64_t timestamp)
+{
+    const double latencyMs = static_cast<double>(std::max(int64_t(0), utils::Time::diff(receiveTimestamp, timestamp))) /
+        utils::Time::ms;
+    _latency.update(latencyMs);
+    _maxLatency.update(latencyMs);
+}
+
+DtlsHandshakeStats DtlsHandshakePool::getStats() const
+{
+    DtlsHandshakeStats stats;
+    stats.active = _active.load(std::memory_order_relaxed);
+    stats.queueDepth = std::max(0, _jobManager.getCount());
+    stats.admitted = _admitted.load(std::memory_order_relaxed);
+    stats.rejected = _rejected.load(std::memory_order_relaxed);
+    stats.avgLatencyMs = _latency.get();
+    stats.maxLatencyMs = _maxLatency.get();
+    return stats;
+}
+
+} // namespace transport
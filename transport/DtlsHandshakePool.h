@@ -0,0 +1,64 @@
+#pragma once
+
+#include "utils/TokenBucket.h"
+#include "utils/Trackers.h"
+#include <atomic>
+#include <cstdint>
+
+namespace config
+{
+class Config;
+}
+
+namespace jobmanager
+{
+class JobManager;
+}
+
+namespace transport
+{
+
+struct DtlsHandshakeStats
+{
+    uint32_t active = 0;
+    uint32_t queueDepth = 0;
+    uint64_t admitted = 0;
+    uint64_t rejected = 0;
+    double avgLatencyMs = 0;
+    double maxLatencyMs = 0;
+};
+
+// Low priority worker threads for DTLS handshakes. A transport that is admitted runs its serial job queue here until
+// the handshake is over, so the public key operations of a join storm do not delay media on the real time workers.
+// New handshakes are admitted at a limited rate and while the queue is not too deep. A transport that is refused
+// drops the handshake record and tries again on the peer's retransmission. Thread safe.
+class DtlsHandshakePool
+{
+public:
+    DtlsHandshakePool(const config::Config& config, jobmanager::JobManager& jobManager);
+
+    jobmanager::JobManager& getJobManager() { return _jobManager; }
+
+    bool tryAcquire(uint64_t timestamp);
+    void release();
+
+    // delay from reception of a handshake record until the transport processes it
+    void onRecordProcessed(uint64_t receiveTimestamp, uint64_t timestamp);
+
+    DtlsHandshakeStats getStats() const;
+
+private:
+    jobmanager::JobManager& _jobManager;
+    const uint32_t _maxQueueDepth;
+
+    std::atomic_flag _lock = ATOMIC_FLAG_INIT;
+    utils::TokenBucket _rate;
+
+    std::atomic_uint32_t _active;
+    std::atomic_uint64_t _admitted;
+    std::atomic_uint64_t _rejected;
+    utils::AvgTracker _latency;
+    utils::MaxTracker _maxLatency;
+};
+
+} // namespace transport
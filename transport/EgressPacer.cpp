@@ -0,0 +1,117 @@
+#include "transport/EgressPacer.h"
+#include "concurrency/ThreadUtils.h"
+#include "utils/Time.h"
+
+namespace transport
+{
+
+const uint64_t EgressPacer::slotDuration = utils::Time::ms;
+
+EgressPacer::EgressPacer(size_t maxPendingSchedules)
+    : _running(true),
+      _scheduledCount(0),
+      _incoming(maxPendingSchedules),
+      _slots(slotCount),
+      _currentSlotTime(toSlotTime(utils::Time::getAbsoluteTime())),
+      _thread(new std::thread([this] { this->run(); }))
+{
+}
+
+EgressPacer::~EgressPacer()
+{
+    _running = false;
+    _thread->join();
+
+    // release everything still scheduled so senders can drop their references
+    for (Entry entry; _incoming.pop(entry);)
+    {
+        _due.push_back(entry);
+    }
+    for (auto& slot : _slots)
+    {
+        _due.insert(_due.end(), slot.begin(), slot.end());
+        slot.clear();
+    }
+    const auto timestamp = utils::Time::getAbsoluteTime();
+    for (auto& entry : _due)
+    {
+        entry.sender->onPacingReleaseDue(timestamp);
+    }
+}
+
+bool EgressPacer::schedule(IPacedSender& sender, const uint64_t releaseTime)
+{
+    Entry entry;
+    entry.sender = &sender;
+    entry.releaseTime = releaseTime;
+    if (_incoming.push(std::move(entry)))
+    {
+        _scheduledCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void EgressPacer::run()
+{
+    concurrency::setThreadName("EgressPacer");
+    while (_running)
+    {
+        for (Entry entry; _incoming.pop(entry);)
+        {
+            insert(entry);
+        }
+
+        releaseDue(utils::Time::getAbsoluteTime());
+        utils::Time::rawNanoSleep(slotDuration);
+    }
+}
+
+void EgressPacer::insert(const Entry& entry)
+{
+    const auto slotTime = toSlotTime(entry.releaseTime);
+    if (static_cast<int64_t>(slotTime - _currentSlotTime) <= 0)
+    {
+        _due.push_back(entry);
+        return;
+    }
+
+    _slots[slotTime % slotCount].push_back(entry);
+}
+
+void EgressPacer::releaseDue(const uint64_t timestamp)
+{
+    const auto targetSlotTime = toSlotTime(timestamp);
+    const uint64_t slotsToVisit = targetSlotTime > _currentSlotTime
+        ? std::min(static_cast<uint64_t>(slotCount), targetSlotTime - _currentSlotTime)
+        : 0;
+
+    for (uint64_t i = 1; i <= slotsToVisit; ++i)
+    {
+        auto& slot = _slots[(_currentSlotTime + i) % slotCount];
+        size_t keep = 0;
+        for (auto& entry : slot)
+        {
+            // entries more than one calendar round ahead stay in the slot
+            if (static_cast<int64_t>(toSlotTime(entry.releaseTime) - targetSlotTime) <= 0)
+            {
+                _due.push_back(entry);
+            }
+            else
+            {
+                slot[keep++] = entry;
+            }
+        }
+        slot.resize(keep);
+    }
+    _currentSlotTime = std::max(_currentSlotTime, targetSlotTime);
+
+    for (auto& entry : _due)
+    {
+        _scheduledCount.fetch_sub(1, std::memory_order_relaxed);
+        entry.sender->onPacingReleaseDue(timestamp);
+    }
+    _due.clear();
+}
+
+} // namespace transport
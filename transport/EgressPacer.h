@@ -0,0 +1,61 @@
+#pragma once
+
+#include "concurrency/MpmcQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace transport
+{
+
+// Process wide calendar queue of pacing release times. Transports with packets left in their pacing queues schedule
+// a release time and are called back on the pacer thread when it is due. Only transports with queued packets are
+// visited, so the cost scales with paced packets rather than with the number of transports.
+// The callback runs on the pacer thread and must only hand over work, e.g. post a job on the transport's job queue.
+class EgressPacer
+{
+public:
+    class IPacedSender
+    {
+    public:
+        virtual void onPacingReleaseDue(uint64_t timestamp) = 0;
+    };
+
+    static const uint64_t slotDuration;
+    static const uint32_t slotCount = 512;
+
+    explicit EgressPacer(size_t maxPendingSchedules);
+    ~EgressPacer();
+
+    // thread safe. The sender must stay alive until onPacingReleaseDue has been called
+    bool schedule(IPacedSender& sender, uint64_t releaseTime);
+
+    uint32_t getScheduledCount() const { return _scheduledCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry
+    {
+        IPacedSender* sender = nullptr;
+        uint64_t releaseTime = 0;
+    };
+
+    void run();
+    void insert(const Entry& entry);
+    void releaseDue(uint64_t timestamp);
+    static uint64_t toSlotTime(uint64_t timestamp) { return timestamp / slotDuration; }
+
+    std::atomic_bool _running;
+    std::atomic_uint32_t _scheduledCount;
+    concurrency::MpmcQueue<Entry> _incoming;
+
+    // owned by pacer thread
+    std::vector<std::vector<Entry>> _slots;
+    std::vector<Entry> _due;
+    uint64_t _currentSlotTime;
+
+    std::unique_ptr<std::thread> _thread; // must be last
+};
+
+} // namespace transport
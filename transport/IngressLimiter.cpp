@@ -0,0 +1,156 @@
+#include "transport/IngressLimiter.h"
+#include "concurrency/ScopedSpinLocker.h"
+#include "config/Config.h"
+
+namespace transport
+{
+
+IngressLimiter::IngressLimiter(const config::Config& config, IngressDropCounters& dropCounters)
+    : _enabled(config.ingress.enable),
+      _sourceBytesPerSecond(config.ingress.sourceKbps * 1000ull / 8),
+      _sourceBurst(_sourceBytesPerSecond * config.ingress.burstMs / 1000),
+      _rejectionTimeout(config.ingress.rejectedSsrcTimeoutMs * utils::Time::ms),
+      _rejectionHits(std::max(1u, config.ingress.rejectedSsrcHits.get())),
+      _rejectionWindow(config.ingress.rejectedSsrcWindowMs * utils::Time::ms),
+      _dropCounters(dropCounters),
+      _transportBucket(config.ingress.transportKbps * 1000ull / 8,
+          config.ingress.transportKbps * 1000ull / 8 * config.ingress.burstMs / 1000),
+      _rejectedCount(0),
+      _nextRejectedSlot(0)
+{
+}
+
+bool IngressLimiter::admit(const SocketAddress& source,
+    const uint32_t ssrc,
+    const size_t length,
+    const uint64_t timestamp)
+{
+    if (!_enabled)
+    {
+        return true;
+    }
+
+    concurrency::ScopedSpinLocker lock(_lock);
+    if (_rejectedCount > 0 && isRejected(ssrc, timestamp))
+    {
+        ++_dropCounters.rejectedSsrc;
+        return false;
+    }
+
+    const uint64_t charge = std::max(length, static_cast<size_t>(minimumPacketCharge));
+    if (!getSourceBucket(source, timestamp).consume(timestamp, charge))
+    {
+        ++_dropCounters.sourceRate;
+        return false;
+    }
+
+    if (!_transportBucket.consume(timestamp, charge))
+    {
+        ++_dropCounters.transportRate;
+        return false;
+    }
+
+    return true;
+}
+
+void IngressLimiter::rejectSsrc(const uint32_t ssrc, const uint64_t timestamp)
+{
+    if (!_enabled)
+    {
+        return;
+    }
+
+    concurrency::ScopedSpinLocker lock(_lock);
+    RejectedSsrc* rejected = nullptr;
+    for (auto& entry : _rejectedSsrcs)
+    {
+        if (entry.isSet && entry.ssrc == ssrc)
+        {
+            rejected = &entry;
+            break;
+        }
+    }
+
+    if (!rejected)
+    {
+        // replace the oldest entry when full
+        rejected = &_rejectedSsrcs[_nextRejectedSlot];
+        _nextRejectedSlot = (_nextRejectedSlot + 1) % maxRejectedSsrcs;
+        if (!rejected->isSet)
+        {
+            ++_rejectedCount;
+        }
+        rejected->ssrc = ssrc;
+        rejected->hits = 0;
+        rejected->expires = 0;
+        rejected->isSet = true;
+    }
+
+    if (rejected->hits == 0 || utils::Time::diffGE(rejected->firstHit, timestamp, _rejectionWindow))
+    {
+        rejected->hits = 0;
+        rejected->firstHit = timestamp;
+    }
+
+    ++rejected->hits;
+    if (rejected->hits >= _rejectionHits)
+    {
+        rejected->expires = timestamp + _rejectionTimeout;
+        rejected->hits = 0;
+    }
+}
+
+void IngressLimiter::clearRejectedSsrcs()
+{
+    if (!_enabled)
+    {
+        return;
+    }
+
+    concurrency::ScopedSpinLocker lock(_lock);
+    for (auto& rejected : _rejectedSsrcs)
+    {
+        rejected = RejectedSsrc();
+    }
+    _rejectedCount = 0;
+    _nextRejectedSlot = 0;
+}
+
+bool IngressLimiter::isRejected(const uint32_t ssrc, const uint64_t timestamp) const
+{
+    for (const auto& rejected : _rejectedSsrcs)
+    {
+        if (rejected.isSet && rejected.ssrc == ssrc)
+        {
+            return rejected.expires != 0 && utils::Time::diffGT(timestamp, rejected.expires, 0);
+        }
+    }
+    return false;
+}
+
+utils::TokenBucket& IngressLimiter::getSourceBucket(const SocketAddress& source, const uint64_t timestamp)
+{
+    SourceBucket* nominee = &_sources[0];
+    for (auto& entry : _sources)
+    {
+        if (entry.isSet && entry.address == source)
+        {
+            entry.lastUsed = timestamp;
+            return entry.bucket;
+        }
+
+        if (nominee->isSet && (!entry.isSet || utils::Time::diffGT(entry.lastUsed, nominee->lastUsed, 0)))
+        {
+            nominee = &entry;
+        }
+    }
+
+    // least recently used source is replaced, e.g. after ICE selected another candidate pair
+    nominee->address = source;
+    nominee->bucket = utils::TokenBucket(_sourceBytesPerSecond, _sourceBurst);
+    nominee->lastUsed = timestamp;
+    nominee->isSet = true;
+    return nominee->bucket;
+}
+
+} // namespace transport
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "utils/SocketAddress.h"
+#include "utils/TokenBucket.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace config
+{
+class Config;
+}
+
+namespace transport
+{
+
+struct IngressDrops
+{
+    uint64_t transportRate = 0;
+    uint64_t sourceRate = 0;
+    uint64_t rejectedSsrc = 0;
+};
+
+// Process wide count of inbound RTP dropped before decryption, per reason
+struct IngressDropCounters
+{
+    IngressDropCounters() : transportRate(0), sourceRate(0), rejectedSsrc(0) {}
+
+    IngressDrops snapshot() const
+    {
+        IngressDrops drops;
+        drops.transportRate = transportRate.load(std::memory_order_relaxed);
+        drops.sourceRate = sourceRate.load(std::memory_order_relaxed);
+        drops.rejectedSsrc = rejectedSsrc.load(std::memory_order_relaxed);
+        return drops;
+    }
+
+    std::atomic_uint64_t transportRate;
+    std::atomic_uint64_t sourceRate;
+    std::atomic_uint64_t rejectedSsrc;
+};
+
+// Admission of inbound RTP on the receive thread, before the packet is queued on the transport and decrypted.
+// Applies a bitrate limit to the transport and to each of its most recent source addresses, and drops ssrcs that the
+// engine refused repeatedly a short while ago. Thread safe as a transport can receive on several endpoints.
+class IngressLimiter
+{
+public:
+    IngressLimiter(const config::Config& config, IngressDropCounters& dropCounters);
+
+    bool admit(const SocketAddress& source, uint32_t ssrc, size_t length, uint64_t timestamp);
+
+    // Packets of the ssrc are dropped until the rejection times out, once the ssrc has been refused a number of times
+    // within the rejection window. A single refusal may just be a packet that arrived before its stream was configured.
+    void rejectSsrc(uint32_t ssrc, uint64_t timestamp);
+    // forget all refusals, e.g. when the inbound streams of the transport have changed
+    void clearRejectedSsrcs();
+
+private:
+    static const uint32_t maxSources = 4;
+    static const uint32_t maxRejectedSsrcs = 16;
+    // small packets are charged as this many bytes to also bound the packet rate
+    static const uint32_t minimumPacketCharge = 200;
+
+    struct SourceBucket
+    {
+        SourceBucket() : bucket(0, 0), lastUsed(0), isSet(false) {}
+
+        SocketAddress address;
+        utils::TokenBucket bucket;
+        uint64_t lastUsed;
+        bool isSet;
+    };
+
+    struct RejectedSsrc
+    {
+        uint32_t ssrc = 0;
+        uint32_t hits = 0;
+        uint64_t firstHit = 0;
+        uint64_t expires = 0;
+        bool isSet = false;
+    };
+
+    utils::TokenBucket& getSourceBucket(const SocketAddress& source, uint64_t timestamp);
+    bool isRejected(uint32_t ssrc, uint64_t timestamp) const;
+
+    const bool _enabled;
+    const uint64_t _sourceBytesPerSecond;
+    const uint64_t _sourceBurst;
+    const uint64_t _rejectionTimeout;
+    const uint32_t _rejectionHits;
+    const uint64_t _rejectionWindow;
+    IngressDropCounters& _dropCounters;
+
+    std::atomic_flag _lock = ATOMIC_FLAG_INIT;
+    utils::TokenBucket _transportBucket;
+    std::array<SourceBucket, maxSources> _sources;
+    std::array<RejectedSsrc, maxRejectedSsrcs> _rejectedSsrcs;
+    uint32_t _rejectedCount;
+    uint32_t _nextRejectedSlot;
+};
+
+} // namespace transport
@@ -0,0 +1,121 @@
+#include "transport/LocalRecordingEndpoint.h"
+#include "rtp/RtcpHeader.h"
+#include "rtp/RtpHeader.h"
+#include "transport/recp/RecControlHeader.h"
+#include "transport/recp/RecHeader.h"
+#include "utils/Time.h"
+
+namespace transport
+{
+
+namespace
+{
+SocketAddress makeLocalPort(const SocketAddress& peer)
+{
+    return peer.getFamily() == AF_INET6 ? SocketAddress::createBroadcastIpv6()
+                                        : SocketAddress::createBroadcastIpv4();
+}
+
+std::string makeBaseName(size_t streamIdHash, size_t endpointIdHash)
+{
+    return std::to_string(streamIdHash) + "-" + std::to_string(endpointIdHash);
+}
+} // namespace
+
+LocalRecordingEndpoint::LocalRecordingEndpoint(RecordingSegmentWriter& writer,
+    memory::PacketPoolAllocator& allocator,
+    size_t streamIdHash,
+    size_t endpointIdHash,
+    const SocketAddress& peer)
+    : _name("LocalRecordingEndpoint"),
+      _writer(writer),
+      _allocator(allocator),
+      _peer(peer),
+      _localPort(makeLocalPort(peer)),
+      _fileId(0),
+      _listener(nullptr)
+{
+    _fileId = _writer.open(makeBaseName(streamIdHash, endpointIdHash), this);
+}
+
+void LocalRecordingEndpoint::registerRecordingListener(const SocketAddress& remotePort, IRecordingEvents* listener)
+{
+    assert(remotePort == _peer);
+    _listener = listener;
+}
+
+void LocalRecordingEndpoint::unregisterRecordingListener(IRecordingEvents* listener)
+{
+    assert(_listener == listener);
+    const auto fileId = _fileId.exchange(0);
+    if (fileId != 0)
+    {
+        // listener is notified from writer thread once file is closed
+        _writer.close(fileId);
+    }
+}
+
+void LocalRecordingEndpoint::sendTo(const transport::SocketAddress& target, memory::UniquePacket packet)
+{
+    const auto fileId = _fileId.load();
+    if (fileId == 0 || !packet)
+    {
+        return;
+    }
+
+    const auto timestamp = utils::Time::getAbsoluteTime();
+    if (recp::isRecPacket(*packet))
+    {
+        const uint16_t sequenceNumber = recp::RecHeader::fromPacket(*packet)->sequenceNumber.get();
+        _writer.appendEvent(fileId, std::move(packet), sequenceNumber, timestamp);
+    }
+    else if (rtp::isRtcpPacket(*packet))
+    {
+        _writer.append(fileId, recfile::RecordType::Rtcp, std::move(packet), timestamp);
+    }
+    else if (rtp::isRtpPacket(*packet))
+    {
+        _writer.append(fileId, recfile::RecordType::Rtp, std::move(packet), timestamp);
+    }
+}
+
+void LocalRecordingEndpoint::stop(IStopEvents* listener)
+{
+    if (listener)
+    {
+        listener->onEndpointStopped(this);
+    }
+}
+
+void LocalRecordingEndpoint::onEventPersisted(uint16_t sequenceNumber)
+{
+    auto* listener = _listener.load();
+    if (!listener)
+    {
+        return;
+    }
+
+    auto packet = memory::makeUniquePacket(_allocator);
+    if (!packet)
+    {
+        return;
+    }
+
+    auto* header = recp::RecControlHeader::fromPtr(packet->get(), recp::REC_CONTROL_HEADER_SIZE);
+    header->id = 0x01;
+    header->ackType = recp::AckType::EventAck;
+    header->sequenceNumber = sequenceNumber;
+    packet->setLength(recp::REC_CONTROL_HEADER_SIZE);
+    listener->onRecControlReceived(*this, _peer, _localPort, std::move(packet));
+}
+
+void LocalRecordingEndpoint::onClosed()
+{
+    auto* listener = _listener.exchange(nullptr);
+    if (listener)
+    {
+        listener->onUnregistered(*this);
+    }
+}
+
+} // namespace transport
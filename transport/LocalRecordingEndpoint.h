@@ -0,0 +1,74 @@
+#pragma once
+#include "logger/Logger.h"
+#include "transport/RecordingEndpoint.h"
+#include "transport/RecordingSegmentWriter.h"
+
+namespace transport
+{
+
+// Recording endpoint that persists the protected recording stream to local segment files instead of sending it to
+// a remote recorder. One instance per recording transport. Recording events are acknowledged towards the transport
+// once they have been written to disk, so the transport's event retransmission works as with a remote recorder.
+class LocalRecordingEndpoint final : public RecordingEndpoint, private RecordingSegmentWriter::IEvents
+{
+public:
+    LocalRecordingEndpoint(RecordingSegmentWriter& writer,
+        memory::PacketPoolAllocator& allocator,
+        size_t streamIdHash,
+        size_t endpointIdHash,
+        const SocketAddress& peer);
+
+    void sendStunTo(const transport::SocketAddress& target,
+        ice::Int96 transactionId,
+        const void* data,
+        size_t len,
+        uint64_t timestamp) override
+    {
+        assert(false);
+    }
+
+    void cancelStunTransaction(ice::Int96 transactionId) override { assert(false); }
+
+    void registerListener(const std::string& stunUserName, Endpoint::IEvents* listener) override { assert(false); };
+    void registerListener(const SocketAddress& remotePort, Endpoint::IEvents* listener) override { assert(false); };
+
+    void unregisterListener(Endpoint::IEvents* listener) override { assert(false); };
+    void unregisterListener(const SocketAddress& remotePort, Endpoint::IEvents* listener) override { assert(false); }
+
+    void registerRecordingListener(const SocketAddress& remotePort, IRecordingEvents* listener) override;
+
+    void unregisterRecordingListener(IRecordingEvents* listener) override;
+
+    bool openPort(uint16_t port) override { return false; }
+    bool isGood() const override { return _fileId != 0; }
+    ice::TransportType getTransportType() const override { return ice::TransportType::UDP; }
+    SocketAddress getLocalPort() const override { return _localPort; }
+
+    void sendTo(const transport::SocketAddress& target, memory::UniquePacket packet) override;
+
+    void registerDefaultListener(Endpoint::IEvents* defaultListener) override{};
+
+    void start() override {}
+    void stop(IStopEvents* listener) override;
+
+    bool configureBufferSizes(size_t sendBufferSize, size_t receiveBufferSize) override { return true; }
+
+    const char* getName() const override { return _name.c_str(); }
+    State getState() const override { return _fileId != 0 ? State::CONNECTED : State::CLOSED; }
+
+    EndpointMetrics getMetrics(uint64_t timestamp) const override { return EndpointMetrics(); }
+
+private:
+    void onEventPersisted(uint16_t sequenceNumber) override;
+    void onClosed() override;
+
+    logger::LoggableId _name;
+    RecordingSegmentWriter& _writer;
+    memory::PacketPoolAllocator& _allocator;
+    const SocketAddress _peer;
+    const SocketAddress _localPort;
+    std::atomic_uint32_t _fileId;
+    std::atomic<IRecordingEvents*> _listener;
+};
+
+} // namespace transport
@@ -0,0 +1,453 @@
+#include "transport/RecordingSegmentWriter.h"
+#include "concurrency/ThreadUtils.h"
+#include "logger/Logger.h"
+#include "memory/Allocator.h"
+#include "utils/Time.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <unistd.h>
+
+namespace transport
+{
+
+namespace
+{
+const char* _name = "RecordingSegmentWriter";
+const size_t maxCommandsPerFlushCheck = 256;
+const uint32_t maxIdleTimeoutMs = 1000;
+const uint32_t maxControlWaitMs = 10;
+
+recfile::BlockHeader& getBlockHeader(uint8_t* block)
+{
+    return *reinterpret_cast<recfile::BlockHeader*>(block);
+}
+
+bool writeFully(int fd, const uint8_t* data, size_t length, uint64_t offset)
+{
+    while (length > 0)
+    {
+        const auto written = ::pwrite(fd, data, length, offset);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= written;
+        offset += written;
+    }
+    return true;
+}
+
+bool syncData(int fd)
+{
+#ifdef __APPLE__
+    return ::fsync(fd) == 0;
+#else
+    return ::fdatasync(fd) == 0;
+#endif
+}
+} // namespace
+
+RecordingSegmentWriter::RecordingSegmentWriter(const std::string& directory,
+    uint32_t blockSize,
+    uint64_t maxSegmentSize,
+    uint64_t flushInterval,
+    size_t queueSize)
+    : _directory(directory),
+      _blockSize(memory::page::alignedSpace(std::max(blockSize, 4096u))),
+      _pageSize(memory::page::getPageSize()),
+      _maxSegmentSize(std::max(maxSegmentSize, static_cast<uint64_t>(_blockSize))),
+      _flushInterval(flushInterval),
+      _running(true),
+      _fileIdCounter(0),
+      _writtenBytes(0),
+      _droppedPackets(0),
+      _queue(queueSize),
+      _sleeping(false),
+      _controlWaiters(0)
+{
+    std::error_code errorCode;
+    std::filesystem::create_directories(_directory, errorCode);
+    if (errorCode)
+    {
+        logger::error("failed to create recording directory %s, %s",
+            _name,
+            _directory.c_str(),
+            errorCode.message().c_str());
+    }
+
+    _thread = std::make_unique<std::thread>([this] { this->run(); });
+}
+
+RecordingSegmentWriter::~RecordingSegmentWriter()
+{
+    _running = false;
+    _wakeUpSemaphore.post();
+    _thread->join();
+
+    const auto timestamp = utils::Time::getAbsoluteTime();
+    Command command;
+    while (_queue.pop(command))
+    {
+        processCommand(command, timestamp);
+    }
+
+    while (!_files.empty())
+    {
+        closeFile(_files.begin()->first);
+    }
+}
+
+uint32_t RecordingSegmentWriter::open(const std::string& baseName, IEvents* events)
+{
+    Command command;
+    command.type = Command::Type::Open;
+    command.fileId = _fileIdCounter.fetch_add(1) + 1;
+    command.events = events;
+    command.baseName = std::make_unique<std::string>(baseName);
+    const auto fileId = command.fileId;
+    pushControl(std::move(command));
+    return fileId;
+}
+
+bool RecordingSegmentWriter::append(uint32_t fileId,
+    recfile::RecordType type,
+    memory::UniquePacket packet,
+    uint64_t timestamp)
+{
+    Command command;
+    command.type = Command::Type::Append;
+    command.recordType = type;
+    command.fileId = fileId;
+    command.timestamp = timestamp;
+    command.packet = std::move(packet);
+    if (!_queue.push(std::move(command)))
+    {
+        _droppedPackets.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    wakeUp();
+    return true;
+}
+
+bool RecordingSegmentWriter::appendEvent(uint32_t fileId,
+    memory::UniquePacket packet,
+    uint16_t sequenceNumber,
+    uint64_t timestamp)
+{
+    Command command;
+    command.type = Command::Type::Append;
+    command.recordType = recfile::RecordType::Event;
+    command.eventSequenceNumber = sequenceNumber;
+    command.fileId = fileId;
+    command.timestamp = timestamp;
+    command.packet = std::move(packet);
+    if (!_queue.push(std::move(command)))
+    {
+        _droppedPackets.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    wakeUp();
+    return true;
+}
+
+void RecordingSegmentWriter::close(uint32_t fileId)
+{
+    Command command;
+    command.type = Command::Type::Close;
+    command.fileId = fileId;
+    pushControl(std::move(command));
+}
+
+// Open and close must not be lost or the owner will never be released. Wait for the I/O thread to make room.
+void RecordingSegmentWriter::pushControl(Command&& command)
+{
+    while (!_queue.push(std::move(command)))
+    {
+        ++_controlWaiters;
+        wakeUp();
+        _spaceAvailable.wait(maxControlWaitMs);
+        --_controlWaiters;
+    }
+    wakeUp();
+}
+
+// Pairs with the fence in run. Either the producer sees the I/O thread sleeping, or the I/O thread sees the command.
+void RecordingSegmentWriter::wakeUp()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_sleeping.load(std::memory_order_relaxed) && _sleeping.exchange(false))
+    {
+        _wakeUpSemaphore.post();
+    }
+}
+
+uint32_t RecordingSegmentWriter::getIdleTimeoutMs(const uint64_t timestamp) const
+{
+    uint64_t timeout = maxIdleTimeoutMs * utils::Time::ms;
+    for (auto& it : _files)
+    {
+        auto& file = it.second;
+        if (file.dirty)
+        {
+            const auto timeLeft = std::max(int64_t(0), utils::Time::diff(timestamp, file.lastFlush + _flushInterval));
+            timeout = std::min(timeout, static_cast<uint64_t>(timeLeft));
+        }
+    }
+    return (timeout + utils::Time::ms - 1) / utils::Time::ms;
+}
+
+void RecordingSegmentWriter::run()
+{
+    concurrency::setThreadName("RecWriter");
+    Command command;
+    while (_running)
+    {
+        bool gotCommand = false;
+        auto timestamp = utils::Time::getAbsoluteTime();
+        for (size_t i = 0; i < maxCommandsPerFlushCheck && _queue.pop(command); ++i)
+        {
+            gotCommand = true;
+            processCommand(command, timestamp);
+            command.packet.reset();
+            command.baseName.reset();
+        }
+
+        if (gotCommand && _controlWaiters.load() > 0)
+        {
+            _spaceAvailable.post();
+        }
+
+        timestamp = utils::Time::getAbsoluteTime();
+        flushDueBlocks(timestamp);
+
+        if (!gotCommand)
+        {
+            _sleeping = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_queue.empty() && _running)
+            {
+                _wakeUpSemaphore.wait(getIdleTimeoutMs(timestamp));
+            }
+            _sleeping = false;
+        }
+    }
+}
+
+void RecordingSegmentWriter::processCommand(Command& command, const uint64_t timestamp)
+{
+    switch (command.type)
+    {
+    case Command::Type::Open:
+        openFile(command, timestamp);
+        break;
+    case Command::Type::Append:
+    {
+        auto it = _files.find(command.fileId);
+        if (it != _files.end())
+        {
+            appendRecord(it->second, command);
+        }
+        break;
+    }
+    case Command::Type::Close:
+        closeFile(command.fileId);
+        break;
+    }
+}
+
+void RecordingSegmentWriter::openFile(Command& command, const uint64_t timestamp)
+{
+    auto& file = _files[command.fileId];
+    file.baseName = *command.baseName;
+    file.events = command.events;
+    file.lastFlush = timestamp;
+    file.block = reinterpret_cast<uint8_t*>(memory::page::allocate(_blockSize));
+    resetBlock(file);
+    openSegment(file);
+}
+
+bool RecordingSegmentWriter::openSegment(SegmentFile& file)
+{
+    char fileName[64];
+    std::snprintf(fileName, sizeof(fileName), "-%05u.smbrec", file.segmentNumber);
+    const auto path = _directory + "/" + file.baseName + fileName;
+
+    file.fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (file.fd < 0)
+    {
+        logger::error("failed to open recording segment %s, %s", _name, path.c_str(), std::strerror(errno));
+        return false;
+    }
+
+    logger::info("recording to %s", _name, path.c_str());
+    return true;
+}
+
+void RecordingSegmentWriter::resetBlock(SegmentFile& file)
+{
+    std::memset(file.block, 0, _blockSize);
+    auto& header = getBlockHeader(file.block);
+    header.magic = recfile::blockMagic;
+    header.version = recfile::formatVersion;
+    header.headerSize = sizeof(recfile::BlockHeader);
+    header.usedBytes = sizeof(recfile::BlockHeader);
+    file.flushedBytes = 0;
+    file.dirty = false;
+}
+
+void RecordingSegmentWriter::startNextBlock(SegmentFile& file)
+{
+    resetBlock(file);
+    if (file.fd < 0)
+    {
+        return;
+    }
+
+    file.blockOffset += _blockSize;
+    if (file.blockOffset + _blockSize > _maxSegmentSize)
+    {
+        ::close(file.fd);
+        file.fd = -1;
+        file.blockOffset = 0;
+        ++file.segmentNumber;
+        openSegment(file);
+    }
+}
+
+void RecordingSegmentWriter::appendRecord(SegmentFile& file, Command& command)
+{
+    const auto& packet = *command.packet;
+    const auto space = recfile::recordSpace(packet.getLength());
+    if (space + sizeof(recfile::BlockHeader) > _blockSize)
+    {
+        _droppedPackets.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto* header = &getBlockHeader(file.block);
+    if (header->usedBytes + space > _blockSize)
+    {
+        flushBlock(file, command.timestamp);
+        startNextBlock(file);
+        header = &getBlockHeader(file.block);
+    }
+
+    auto* record = reinterpret_cast<recfile::RecordHeader*>(file.block + header->usedBytes);
+    record->length = packet.getLength();
+    record->type = command.recordType;
+    record->timestamp = command.timestamp;
+    std::memcpy(record + 1, packet.get(), packet.getLength());
+
+    if (header->recordCount == 0)
+    {
+        header->firstTimestamp = command.timestamp;
+    }
+    header->lastTimestamp = command.timestamp;
+    header->usedBytes += space;
+    ++header->recordCount;
+    file.dirty = true;
+
+    if (command.recordType == recfile::RecordType::Event)
+    {
+        file.pendingEvents.push_back(command.eventSequenceNumber);
+    }
+}
+
+void RecordingSegmentWriter::flushBlock(SegmentFile& file, const uint64_t timestamp)
+{
+    file.lastFlush = timestamp;
+    if (!file.dirty)
+    {
+        return;
+    }
+
+    file.dirty = false;
+    if (file.fd < 0)
+    {
+        // Events are not acknowledged so the sender keeps them pending and reports the loss
+        file.pendingEvents.clear();
+        return;
+    }
+
+    // The file is extended by a whole zero filled block first, so readers can always seek to block boundaries. After
+    // that only the pages holding records added since the last flush are written, followed by the first page with the
+    // header that makes them visible.
+    const auto& header = getBlockHeader(file.block);
+    const uint32_t firstPage = file.flushedBytes & ~(_pageSize - 1);
+    const uint32_t dirtyEnd = (header.usedBytes + _pageSize - 1) & ~(_pageSize - 1);
+    bool written = (file.flushedBytes > 0 || ::ftruncate(file.fd, file.blockOffset + _blockSize) == 0) &&
+        writeFully(file.fd, file.block + firstPage, dirtyEnd - firstPage, file.blockOffset + firstPage);
+    uint64_t writtenBytes = dirtyEnd - firstPage;
+    if (written && firstPage > 0)
+    {
+        written = writeFully(file.fd, file.block, _pageSize, file.blockOffset);
+        writtenBytes += _pageSize;
+    }
+
+    // events are acknowledged to the sender, so they must survive a crash of the host
+    if (written && !file.pendingEvents.empty())
+    {
+        written = syncData(file.fd);
+    }
+
+    if (!written)
+    {
+        logger::error("failed to write recording segment %s, %s", _name, file.baseName.c_str(), std::strerror(errno));
+        file.pendingEvents.clear();
+        return;
+    }
+
+    _writtenBytes.fetch_add(writtenBytes, std::memory_order_relaxed);
+    file.flushedBytes = header.usedBytes;
+    for (auto sequenceNumber : file.pendingEvents)
+    {
+        file.events->onEventPersisted(sequenceNumber);
+    }
+    file.pendingEvents.clear();
+}
+
+void RecordingSegmentWriter::flushDueBlocks(const uint64_t timestamp)
+{
+    for (auto& it : _files)
+    {
+        auto& file = it.second;
+        if (file.dirty &&
+            (!file.pendingEvents.empty() || utils::Time::diffGE(file.lastFlush, timestamp, _flushInterval)))
+        {
+            flushBlock(file, timestamp);
+        }
+    }
+}
+
+void RecordingSegmentWriter::closeFile(const uint32_t fileId)
+{
+    auto it = _files.find(fileId);
+    if (it == _files.end())
+    {
+        return;
+    }
+
+    auto& file = it->second;
+    flushBlock(file, utils::Time::getAbsoluteTime());
+    if (file.fd >= 0)
+    {
+        ::close(file.fd);
+    }
+    memory::page::free(file.block, _blockSize);
+
+    auto* events = file.events;
+    _files.erase(it);
+    if (events)
+    {
+        events->onClosed();
+    }
+}
+
+} // namespace transport
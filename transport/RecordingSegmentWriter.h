@@ -0,0 +1,165 @@
+#pragma once
+
+#include "concurrency/MpmcQueue.h"
+#include "concurrency/Semaphore.h"
+#include "memory/PacketPoolAllocator.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace transport
+{
+
+// Segment file format for local recording.
+// A segment file is a sequence of fixed size blocks. Each block starts with a BlockHeader followed by 8 byte aligned
+// records. Records never span blocks, so a reader can seek to any block boundary and binary search blocks on
+// timestamp without parsing the file from the start. Unused space at the end of a block is zero.
+namespace recfile
+{
+constexpr uint32_t blockMagic = 0x524d4253; // "SBMR" little endian
+constexpr uint16_t formatVersion = 1;
+
+enum class RecordType : uint8_t
+{
+    Rtp = 1,
+    Rtcp = 2,
+    Event = 3
+};
+
+struct BlockHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    uint32_t usedBytes; // including header
+    uint32_t recordCount;
+    uint64_t firstTimestamp;
+    uint64_t lastTimestamp;
+};
+static_assert(sizeof(BlockHeader) == 32, "BlockHeader size changed");
+
+struct RecordHeader
+{
+    uint16_t length; // payload bytes following the header
+    RecordType type;
+    uint8_t reserved[5];
+    uint64_t timestamp;
+};
+static_assert(sizeof(RecordHeader) == 16, "RecordHeader size changed");
+
+constexpr size_t recordSpace(size_t payloadLength)
+{
+    return (sizeof(RecordHeader) + payloadLength + 7) & ~size_t(7);
+}
+
+} // namespace recfile
+
+// Writes recording streams to segment files on a dedicated I/O thread. Producers only enqueue packets, so media
+// threads never block on disk. Each flush writes the page aligned part of the block that changed since the previous
+// flush, and the page with the block header. Blocks holding event records are synced to disk before the events are
+// acknowledged. The I/O thread sleeps until a producer enqueues or a flush is due. Segments rotate when they reach the
+// max segment size.
+class RecordingSegmentWriter
+{
+public:
+    class IEvents
+    {
+    public:
+        // Called on the I/O thread when the block holding the event record has been synced to disk
+        virtual void onEventPersisted(uint16_t sequenceNumber) = 0;
+        // Called on the I/O thread after the file has been flushed and closed. No more callbacks after this.
+        virtual void onClosed() = 0;
+    };
+
+    RecordingSegmentWriter(const std::string& directory,
+        uint32_t blockSize,
+        uint64_t maxSegmentSize,
+        uint64_t flushInterval,
+        size_t queueSize);
+    ~RecordingSegmentWriter();
+
+    uint32_t open(const std::string& baseName, IEvents* events);
+    bool append(uint32_t fileId, recfile::RecordType type, memory::UniquePacket packet, uint64_t timestamp);
+    bool appendEvent(uint32_t fileId, memory::UniquePacket packet, uint16_t sequenceNumber, uint64_t timestamp);
+    void close(uint32_t fileId);
+
+    uint64_t getWrittenBytes() const { return _writtenBytes.load(std::memory_order_relaxed); }
+    uint64_t getDroppedPackets() const { return _droppedPackets.load(std::memory_order_relaxed); }
+    const std::string& getDirectory() const { return _directory; }
+
+private:
+    struct Command
+    {
+        enum class Type : uint8_t
+        {
+            Open,
+            Append,
+            Close
+        };
+
+        Type type = Type::Append;
+        recfile::RecordType recordType = recfile::RecordType::Rtp;
+        uint16_t eventSequenceNumber = 0;
+        uint32_t fileId = 0;
+        uint64_t timestamp = 0;
+        IEvents* events = nullptr;
+        memory::UniquePacket packet;
+        std::unique_ptr<std::string> baseName;
+    };
+
+    struct SegmentFile
+    {
+        std::string baseName;
+        IEvents* events = nullptr;
+        int fd = -1;
+        uint32_t segmentNumber = 0;
+        uint64_t blockOffset = 0;
+        uint8_t* block = nullptr;
+        uint32_t flushedBytes = 0; // bytes of the current block already written to disk
+        bool dirty = false;
+        uint64_t lastFlush = 0;
+        std::vector<uint16_t> pendingEvents;
+    };
+
+    void run();
+    void pushControl(Command&& command);
+    void wakeUp();
+    uint32_t getIdleTimeoutMs(uint64_t timestamp) const;
+    void processCommand(Command& command, uint64_t timestamp);
+    void openFile(Command& command, uint64_t timestamp);
+    void appendRecord(SegmentFile& file, Command& command);
+    void closeFile(uint32_t fileId);
+    void flushBlock(SegmentFile& file, uint64_t timestamp);
+    void resetBlock(SegmentFile& file);
+    void startNextBlock(SegmentFile& file);
+    bool openSegment(SegmentFile& file);
+    void flushDueBlocks(uint64_t timestamp);
+
+    const std::string _directory;
+    const uint32_t _blockSize;
+    const uint32_t _pageSize;
+    const uint64_t _maxSegmentSize;
+    const uint64_t _flushInterval;
+
+    std::atomic_bool _running;
+    std::atomic_uint32_t _fileIdCounter;
+    std::atomic_uint64_t _writtenBytes;
+    std::atomic_uint64_t _droppedPackets;
+    concurrency::MpmcQueue<Command> _queue;
+
+    std::atomic_bool _sleeping;
+    concurrency::Semaphore _wakeUpSemaphore;
+    std::atomic_uint32_t _controlWaiters;
+    concurrency::Semaphore _spaceAvailable;
+
+    // owned by I/O thread
+    std::unordered_map<uint32_t, SegmentFile> _files;
+
+    std::unique_ptr<std::thread> _thread; // must be last
+};
+
+} // namespace transport
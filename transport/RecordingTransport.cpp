@@ -1,6 +1,7 @@
 #include "transport/RecordingTransport.h"
 #include "codec/Opus.h"
 #include "codec/Vp8.h"
+#include "concurrency/CounterWait.h"
 #include "config/Config.h"
 #include "rtp/RtcpHeader.h"
 #include "rtp/RtpHeader.h"
@@ -388,7 +389,7 @@ void RecordingTransport::onUnregistered(RecordingEndpoint& endpoint)
     _jobQueue.addJob<ShutdownJob>(_jobCounter);
     _jobQueue.getJobManager().abortTimedJobs(getId());
     _isInitialized = false;
-    --_jobCounter;
+    concurrency::decrementAndNotify(_jobCounter);
 }
 
 void RecordingTransport::onRecControlReceived(RecordingEndpoint& endpoint,
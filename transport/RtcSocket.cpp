@@ -1,5 +1,6 @@
 #include "RtcSocket.h"
 
+#include "transport/SocketHandover.h"
 #include "utils/StdExtensions.h"
 #include <errno.h>
 #include <fcntl.h>
@@ -52,7 +53,9 @@ int RtcSocket::open(const SocketAddress& address, uint16_t port, int socketType)
     SocketAddress ip(address);
     ip.setPort(port);
 
-    _fd = ::socket(ip.getFamily(), socketType, 0);
+    // a socket handed over by the previous process is already bound to the port
+    const int inheritedFd = (port != 0 ? handover::takeInheritedSocket(ip, socketType) : -1);
+    _fd = (inheritedFd != -1 ? inheritedFd : ::socket(ip.getFamily(), socketType, 0));
     if (_fd == -1)
     {
         return errno;
@@ -74,7 +77,7 @@ int RtcSocket::open(const SocketAddress& address, uint16_t port, int socketType)
         return errno;
     }
 
-    if (port != 0 && ::bind(_fd, ip.getSockAddr(), ip.getSockAddrSize()))
+    if (port != 0 && inheritedFd == -1 && ::bind(_fd, ip.getSockAddr(), ip.getSockAddrSize()))
     {
         close();
         return errno;
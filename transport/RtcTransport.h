@@ -34,11 +34,18 @@ namespace jobmanager
 {
 class JobQueue;
 }
+namespace logger
+{
+class PacketFlightRecorderWriter;
+}
 
 namespace transport
 {
 
 class SrtpClientFactory;
+class EgressPacer;
+struct IngressDropCounters;
+class DtlsHandshakePool;
 class Endpoint;
 class ServerEndpoint;
 class TcpEndpointFactory;
@@ -53,6 +60,9 @@ public:
 
     virtual void removeSrtpLocalSsrc(const uint32_t ssrc) = 0;
     virtual bool setSrtpRemoteRolloverCounter(const uint32_t ssrc, const uint32_t rolloverCounter) = 0;
+    // inbound packets with this ssrc are dropped on arrival for a while if it keeps being rejected
+    virtual void rejectInboundSsrc(const uint32_t ssrc) = 0;
+    virtual void clearRejectedInboundSsrcs() = 0;
 
     virtual bool isGatheringComplete() const = 0;
     virtual ice::IceCandidates getLocalCandidates() = 0;
@@ -101,7 +111,6 @@ public:
 
     virtual void setRtxProbeSource(const uint32_t ssrc, uint32_t* sequenceCounter, const uint16_t payloadType) = 0;
 
-    virtual void runTick(uint64_t timestamp) = 0;
     virtual ice::IceSession::State getIceState() const = 0;
     virtual SrtpClient::State getDtlsState() const = 0;
 
@@ -113,6 +122,9 @@ public:
     virtual uint64_t getLastReceivedPacketTimestamp() const = 0;
     virtual void getSdesKeys(std::vector<srtp::AesKey>& sdesKeys) const = 0;
     virtual void asyncSetRemoteSdesKey(const srtp::AesKey& key) = 0;
+
+    // Queues the packet flight recorder for writing to file. False if the recorder is disabled or dumped recently.
+    virtual bool dumpPacketRecords(const char* reason) = 0;
 };
 
 std::shared_ptr<RtcTransport> createTransport(jobmanager::JobManager& jobmanager,
@@ -124,7 +136,10 @@ std::shared_ptr<RtcTransport> createTransport(jobmanager::JobManager& jobmanager
     const bwe::RateControllerConfig& rateControllerConfig,
     const Endpoints& rtpEndPoints,
     const Endpoints& rtcpEndPoints,
-    memory::PacketPoolAllocator& allocator);
+    memory::PacketPoolAllocator& allocator,
+    EgressPacer& egressPacer,
+    IngressDropCounters& ingressDropCounters,
+    DtlsHandshakePool* handshakePool);
 
 std::shared_ptr<RtcTransport> createTransport(jobmanager::JobManager& jobmanager,
     SrtpClientFactory& srtpClientFactory,
@@ -139,6 +154,10 @@ std::shared_ptr<RtcTransport> createTransport(jobmanager::JobManager& jobmanager
     const ServerEndpoints& tcpEndpoints,
     TcpEndpointFactory* tcpEndpointFactory,
     memory::PacketPoolAllocator& allocator,
+    EgressPacer& egressPacer,
+    IngressDropCounters& ingressDropCounters,
+    DtlsHandshakePool* handshakePool,
+    logger::PacketFlightRecorderWriter* flightRecorderWriter,
     size_t expectedInboundStreamCount,
     size_t expectedOutboundStreamCount,
     size_t jobQueueSize,
@@ -41,6 +41,10 @@ public:
     bool add(int fd, RtcePoll::IEventListener* listener) override;
     bool remove(int fd, RtcePoll::IEventListener* listener) override;
     bool isRunning() const override { return _running; }
+    bool setAffinity(const concurrency::CpuList& cpus) override
+    {
+        return _networkThread && concurrency::setAffinity(*_networkThread, cpus);
+    }
 
 private:
     int _kernel_fd;
@@ -1,4 +1,5 @@
 #pragma once
+#include "concurrency/ThreadUtils.h"
 #include <memory>
 namespace transport
 {
@@ -28,6 +29,7 @@ public:
     virtual bool remove(int fd, IEventListener* listener) = 0;
 
     virtual bool isRunning() const = 0;
+    virtual bool setAffinity(const concurrency::CpuList& cpus) = 0;
 };
 
 std::unique_ptr<RtcePoll> createRtcePoll();
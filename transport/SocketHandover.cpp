@@ -0,0 +1,485 @@
+#include "transport/SocketHandover.h"
+#include "concurrency/ThreadUtils.h"
+#include "logger/Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <mutex>
+#include <poll.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace transport
+{
+
+namespace
+{
+const char* logName = "SocketHandover";
+const uint32_t maxHandlesPerMessage = 64;
+
+std::mutex inheritedLock;
+std::vector<HandoverSocket> inheritedSockets;
+
+// udp sockets and listening tcp sockets only
+bool describeSocket(const int fd, HandoverSocket& socket)
+{
+    int socketType = 0;
+    socklen_t optionLength = sizeof(socketType);
+    if (0 != ::getsockopt(fd, SOL_SOCKET, SO_TYPE, &socketType, &optionLength))
+    {
+        return false;
+    }
+
+    if (socketType == SOCK_STREAM)
+    {
+        int listening = 0;
+        optionLength = sizeof(listening);
+        if (0 != ::getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &listening, &optionLength) || !listening)
+        {
+            return false;
+        }
+    }
+    else if (socketType != SOCK_DGRAM)
+    {
+        return false;
+    }
+
+    RawSockAddress address;
+    socklen_t addressLength = sizeof(address);
+    if (0 != ::getsockname(fd, &address.gen, &addressLength) ||
+        (address.gen.sa_family != AF_INET && address.gen.sa_family != AF_INET6))
+    {
+        return false;
+    }
+
+    socket.localPort = SocketAddress(&address.gen);
+    socket.socketType = socketType;
+    socket.fd = fd;
+    return true;
+}
+
+// Sockets are only exchanged with processes of the same user
+bool isPeerSameUser(const int channel)
+{
+#ifdef __APPLE__
+    uid_t uid = 0;
+    gid_t gid = 0;
+    if (0 != ::getpeereid(channel, &uid, &gid))
+    {
+        return false;
+    }
+    const pid_t pid = 0;
+#else
+    ucred credentials = {};
+    socklen_t optionLength = sizeof(credentials);
+    if (0 != ::getsockopt(channel, SOL_SOCKET, SO_PEERCRED, &credentials, &optionLength))
+    {
+        return false;
+    }
+    const uid_t uid = credentials.uid;
+    const pid_t pid = credentials.pid;
+#endif
+
+    if (uid != ::geteuid())
+    {
+        logger::warn("refusing handover with pid %d uid %u",
+            logName,
+            static_cast<int>(pid),
+            static_cast<uint32_t>(uid));
+        return false;
+    }
+    return true;
+}
+
+bool sendBatch(const int channel, const HandoverSocket* sockets, const uint32_t count)
+{
+    uint32_t payload = count;
+    iovec data;
+    data.iov_base = &payload;
+    data.iov_len = sizeof(payload);
+
+    union
+    {
+        cmsghdr header;
+        char buffer[CMSG_SPACE(sizeof(int) * maxHandlesPerMessage)];
+    } control;
+    std::memset(&control, 0, sizeof(control));
+
+    msghdr message = {};
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    if (count > 0)
+    {
+        message.msg_control = control.buffer;
+        message.msg_controllen = CMSG_SPACE(sizeof(int) * count);
+        auto* header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int) * count);
+        auto* handles = reinterpret_cast<int*>(CMSG_DATA(header));
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            handles[i] = sockets[i].fd;
+        }
+    }
+
+    return ::sendmsg(channel, &message, 0) == static_cast<ssize_t>(sizeof(payload));
+}
+} // namespace
+
+namespace handover
+{
+
+bool sendSockets(const int channel, const std::vector<HandoverSocket>& sockets)
+{
+    for (size_t offset = 0; offset < sockets.size(); offset += maxHandlesPerMessage)
+    {
+        const auto count = static_cast<uint32_t>(std::min(sockets.size() - offset, size_t(maxHandlesPerMessage)));
+        if (!sendBatch(channel, sockets.data() + offset, count))
+        {
+            logger::error("failed to send socket handles, err %d", logName, errno);
+            return false;
+        }
+    }
+
+    // empty batch marks the end
+    return sendBatch(channel, nullptr, 0);
+}
+
+bool receiveSockets(const int channel, std::vector<HandoverSocket>& sockets)
+{
+    for (;;)
+    {
+        uint32_t payload = 0;
+        iovec data;
+        data.iov_base = &payload;
+        data.iov_len = sizeof(payload);
+
+        union
+        {
+            cmsghdr header;
+            char buffer[CMSG_SPACE(sizeof(int) * maxHandlesPerMessage)];
+        } control;
+
+        msghdr message = {};
+        message.msg_iov = &data;
+        message.msg_iovlen = 1;
+        message.msg_control = control.buffer;
+        message.msg_controllen = sizeof(control.buffer);
+
+        if (::recvmsg(channel, &message, 0) != static_cast<ssize_t>(sizeof(payload)))
+        {
+            logger::error("failed to receive socket handles, err %d", logName, errno);
+            return false;
+        }
+        if (payload == 0)
+        {
+            return true;
+        }
+
+        for (auto* header = CMSG_FIRSTHDR(&message); header; header = CMSG_NXTHDR(&message, header))
+        {
+            if (header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS)
+            {
+                continue;
+            }
+
+            const auto* handles = reinterpret_cast<const int*>(CMSG_DATA(header));
+            const size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            for (size_t i = 0; i < count; ++i)
+            {
+                HandoverSocket socket;
+                if (describeSocket(handles[i], socket))
+                {
+                    sockets.push_back(socket);
+                }
+                else
+                {
+                    ::close(handles[i]);
+                }
+            }
+        }
+
+        if (message.msg_flags & MSG_CTRUNC)
+        {
+            logger::error("socket handles truncated", logName);
+            return false;
+        }
+    }
+}
+
+bool fetchSockets(const std::string& path, std::vector<HandoverSocket>& sockets, const uint32_t timeoutMs)
+{
+    sockaddr_un address = {};
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        logger::error("handover path too long %s", logName, path.c_str());
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    if (0 != ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)))
+    {
+        // nothing to take over
+        ::close(fd);
+        return false;
+    }
+
+    if (!isPeerSameUser(fd))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // the serving process shuts down before it sends the sockets
+    logger::info("waiting for the bridge at %s to stop", logName, path.c_str());
+    timeval timeout = {static_cast<time_t>(timeoutMs / 1000), static_cast<suseconds_t>((timeoutMs % 1000) * 1000)};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    const bool received = receiveSockets(fd, sockets);
+    ::close(fd);
+    if (received)
+    {
+        logger::info("took over %zu sockets from %s", logName, sockets.size(), path.c_str());
+    }
+    return received;
+}
+
+std::vector<HandoverSocket> findBoundSockets(const std::vector<SocketAddress>& addresses)
+{
+    std::vector<HandoverSocket> sockets;
+    auto* directory = ::opendir("/dev/fd");
+    if (!directory)
+    {
+        return sockets;
+    }
+
+    const int directoryFd = ::dirfd(directory);
+    for (auto* entry = ::readdir(directory); entry; entry = ::readdir(directory))
+    {
+        char* end = nullptr;
+        const long fd = std::strtol(entry->d_name, &end, 10);
+        if (*end != '\0' || end == entry->d_name || fd == directoryFd)
+        {
+            continue;
+        }
+
+        HandoverSocket socket;
+        if (describeSocket(static_cast<int>(fd), socket) &&
+            std::find(addresses.begin(), addresses.end(), socket.localPort) != addresses.end())
+        {
+            sockets.push_back(socket);
+        }
+    }
+    ::closedir(directory);
+    return sockets;
+}
+
+void setInheritedSockets(const std::vector<HandoverSocket>& sockets)
+{
+    std::lock_guard<std::mutex> lock(inheritedLock);
+    inheritedSockets.insert(inheritedSockets.end(), sockets.begin(), sockets.end());
+}
+
+int takeInheritedSocket(const SocketAddress& localPort, const int socketType)
+{
+    std::lock_guard<std::mutex> lock(inheritedLock);
+    for (auto it = inheritedSockets.begin(); it != inheritedSockets.end(); ++it)
+    {
+        if (it->socketType == socketType && it->localPort == localPort)
+        {
+            const int fd = it->fd;
+            inheritedSockets.erase(it);
+            return fd;
+        }
+    }
+    return -1;
+}
+
+size_t closeInheritedSockets()
+{
+    std::lock_guard<std::mutex> lock(inheritedLock);
+    const auto count = inheritedSockets.size();
+    for (auto& socket : inheritedSockets)
+    {
+        logger::info("closing unused inherited socket %s", logName, socket.localPort.toString().c_str());
+        ::close(socket.fd);
+    }
+    inheritedSockets.clear();
+    return count;
+}
+
+} // namespace handover
+
+HandoverServer::HandoverServer(const std::string& path,
+    std::function<std::vector<HandoverSocket>()> getSockets,
+    std::function<void()> onHandoverRequested)
+    : _path(path),
+      _getSockets(std::move(getSockets)),
+      _onHandoverRequested(std::move(onHandoverRequested)),
+      _fd(-1),
+      _channel(-1),
+      _running(true)
+{
+    if (openListener())
+    {
+        _thread = std::make_unique<std::thread>([this] { this->run(); });
+    }
+}
+
+HandoverServer::~HandoverServer()
+{
+    stop();
+
+    const int channel = _channel.exchange(-1);
+    if (channel == -1)
+    {
+        return;
+    }
+
+    if (handover::sendSockets(channel, _pendingSockets))
+    {
+        logger::info("handed over %zu sockets", logName, _pendingSockets.size());
+    }
+    closePendingSockets();
+    ::close(channel);
+}
+
+void HandoverServer::stop()
+{
+    _running = false;
+    if (_thread)
+    {
+        _thread->join();
+        _thread.reset();
+    }
+
+    closeListener();
+}
+
+bool HandoverServer::openListener()
+{
+    sockaddr_un address = {};
+    if (_path.size() >= sizeof(address.sun_path))
+    {
+        logger::error("handover path too long %s", logName, _path.c_str());
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, _path.c_str(), sizeof(address.sun_path) - 1);
+
+    _fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_fd == -1)
+    {
+        return false;
+    }
+
+    // left behind by a process that did not stop cleanly
+    ::unlink(_path.c_str());
+    // connecting requires write permission on the path. Nobody can connect before listen, so there is no window where
+    // the path is open to other users.
+    if (0 != ::bind(_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) ||
+        0 != ::chmod(_path.c_str(), S_IRUSR | S_IWUSR) || 0 != ::listen(_fd, 1))
+    {
+        logger::error("failed to listen for handover on %s, err %d", logName, _path.c_str(), errno);
+        ::close(_fd);
+        ::unlink(_path.c_str());
+        _fd = -1;
+        return false;
+    }
+    return true;
+}
+
+void HandoverServer::closeListener()
+{
+    if (_fd != -1)
+    {
+        ::close(_fd);
+        ::unlink(_path.c_str());
+        _fd = -1;
+    }
+}
+
+void HandoverServer::run()
+{
+    concurrency::setThreadName("Handover");
+    while (_running)
+    {
+        pollfd listenFd = {_fd, POLLIN, 0};
+        if (::poll(&listenFd, 1, 100) <= 0)
+        {
+            continue;
+        }
+
+        const int channel = ::accept(_fd, nullptr, nullptr);
+        if (channel == -1)
+        {
+            continue;
+        }
+
+        if (!isPeerSameUser(channel))
+        {
+            ::close(channel);
+            continue;
+        }
+
+        // the path is released before the new process gets the sockets, so it can serve the path itself
+        closeListener();
+        if (duplicateSockets(_getSockets()))
+        {
+            // the handles are sent by the destructor, once the owner has stopped reading from them
+            logger::info("handover of %zu sockets requested", logName, _pendingSockets.size());
+            _channel = channel;
+            _onHandoverRequested();
+            return;
+        }
+
+        ::close(channel);
+        if (!openListener())
+        {
+            return;
+        }
+    }
+}
+
+// The owner closes its handles as it shuts down. The duplicates keep the ports bound until they are sent.
+bool HandoverServer::duplicateSockets(const std::vector<HandoverSocket>& sockets)
+{
+    for (const auto& socket : sockets)
+    {
+        HandoverSocket duplicate = socket;
+        duplicate.fd = ::dup(socket.fd);
+        if (duplicate.fd == -1)
+        {
+            logger::error("failed to duplicate socket %s, err %d",
+                logName,
+                socket.localPort.toString().c_str(),
+                errno);
+            closePendingSockets();
+            return false;
+        }
+        _pendingSockets.push_back(duplicate);
+    }
+    return true;
+}
+
+void HandoverServer::closePendingSockets()
+{
+    for (auto& socket : _pendingSockets)
+    {
+        ::close(socket.fd);
+    }
+    _pendingSockets.clear();
+}
+
+} // namespace transport
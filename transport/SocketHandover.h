@@ -0,0 +1,90 @@
+#pragma once
+#include "utils/SocketAddress.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+
+namespace transport
+{
+
+struct HandoverSocket
+{
+    SocketAddress localPort;
+    int socketType = SOCK_DGRAM;
+    int fd = -1;
+};
+
+/**
+ * Passing of bound sockets from a running bridge to a newly started one over a UNIX socket. The new process receives
+ * duplicates of the shared UDP ports and listening TCP ports and adopts them when it opens the same ports, so the
+ * ports stay bound and datagrams and TCP connection attempts queue in the kernel while the bridges are switched.
+ * This is not a zero downtime upgrade. ICE, DTLS-SRTP and conference state are not transferred, so clients of the
+ * old process have to reconnect. The old process shuts down before the handles are sent, so the two processes never
+ * read from the same socket.
+ * The path is only accessible to the owner and both sides refuse a peer process of another user.
+ */
+namespace handover
+{
+// Sends the handles over a connected UNIX socket as SCM_RIGHTS. The handles remain open in this process.
+bool sendSockets(int channel, const std::vector<HandoverSocket>& sockets);
+// Received handles are owned by the caller.
+bool receiveSockets(int channel, std::vector<HandoverSocket>& sockets);
+
+// Takes over the sockets of the HandoverServer at path. Blocks until the serving process has shut down, at most
+// timeoutMs. Returns false if no process serves the path.
+bool fetchSockets(const std::string& path, std::vector<HandoverSocket>& sockets, uint32_t timeoutMs = 60000);
+
+// Open UDP sockets and listening TCP sockets of this process that are bound to any of the addresses.
+std::vector<HandoverSocket> findBoundSockets(const std::vector<SocketAddress>& addresses);
+
+// Inherited sockets are adopted by RtcSocket::open instead of binding a new socket to the same address.
+void setInheritedSockets(const std::vector<HandoverSocket>& sockets);
+// Returns the handle of an inherited socket bound to localPort and removes it from the inherited set, or -1.
+int takeInheritedSocket(const SocketAddress& localPort, int socketType);
+// Closes inherited sockets that were not adopted.
+size_t closeInheritedSockets();
+} // namespace handover
+
+/**
+ * Serves the sockets of this process at path. When a new process connects, duplicates of the sockets are taken and
+ * onHandoverRequested is called. The owner is then expected to shut down its receivers and destroy the server, which
+ * sends the duplicates. Until then the new process waits and does not read from the sockets.
+ */
+class HandoverServer
+{
+public:
+    // getSockets and onHandoverRequested are called on the server thread
+    HandoverServer(const std::string& path,
+        std::function<std::vector<HandoverSocket>()> getSockets,
+        std::function<void()> onHandoverRequested);
+    // Sends the sockets if a handover was requested
+    ~HandoverServer();
+
+    bool isGood() const { return _fd != -1 || _channel != -1; }
+    bool isHandoverRequested() const { return _channel != -1; }
+
+    // Stops accepting handover requests. A request already accepted is completed by the destructor.
+    void stop();
+
+private:
+    bool openListener();
+    void closeListener();
+    void run();
+    bool duplicateSockets(const std::vector<HandoverSocket>& sockets);
+    void closePendingSockets();
+
+    const std::string _path;
+    std::function<std::vector<HandoverSocket>()> _getSockets;
+    std::function<void()> _onHandoverRequested;
+    int _fd;
+    std::atomic_int _channel;
+    std::vector<HandoverSocket> _pendingSockets;
+    std::atomic_bool _running;
+    std::unique_ptr<std::thread> _thread;
+};
+
+} // namespace transport
@@ -1,7 +1,10 @@
 #include "transport/TransportFactory.h"
 #include "concurrency/MpmcHashmap.h"
 #include "config/Config.h"
+#include "logger/PacketFlightRecorder.h"
 #include "memory/PacketPoolAllocator.h"
+#include "transport/EgressPacer.h"
+#include "transport/LocalRecordingEndpoint.h"
 #include "transport/RecordingTransport.h"
 #include "transport/RtcTransport.h"
 #include "transport/TcpEndpoint.h"
@@ -12,6 +15,12 @@
 namespace transport
 {
 
+namespace
+{
+// at most one pending pacing release per transport
+const size_t maxPendingPacingReleases = 64 * 1024;
+} // namespace
+
 class TransportFactoryImpl final : public TransportFactory,
                                    public TcpEndpointFactory,
                                    public Endpoint::IStopEvents,
@@ -49,7 +58,8 @@ public:
         const std::vector<SocketAddress>& interfaces,
         transport::RtcePoll& rtcePoll,
         memory::PacketPoolAllocator& mainAllocator,
-        std::shared_ptr<transport::EndpointFactory>& endpointFactory)
+        std::shared_ptr<transport::EndpointFactory>& endpointFactory,
+        DtlsHandshakePool* handshakePool)
         : _deleter(this),
           _jobManager(jobManager),
           _srtpClientFactory(srtpClientFactory),
@@ -66,6 +76,8 @@ public:
           _sharedRecordingEndpointListIndex(0),
           _good(true),
           _endpointFactory(endpointFactory),
+          _egressPacer(maxPendingPacingReleases),
+          _handshakePool(handshakePool),
           _garbageQueue(jobManager)
     {
 #ifdef __APPLE__
@@ -134,7 +146,24 @@ public:
                 }
             }
         }
-        if (config.recording.singlePort != 0)
+        if (config.flightRecorder.enable)
+        {
+            _flightRecorderWriter = std::make_unique<logger::PacketFlightRecorderWriter>(
+                config.flightRecorder.directory,
+                config.flightRecorder.packetCount,
+                config.flightRecorder.maxFiles);
+        }
+
+        if (config.recording.local.enable)
+        {
+            _localRecordingWriter = std::make_unique<RecordingSegmentWriter>(config.recording.local.directory,
+                config.recording.local.blockSize,
+                uint64_t(config.recording.local.maxSegmentSizeMB) * 1024 * 1024,
+                uint64_t(config.recording.local.flushIntervalMs) * utils::Time::ms,
+                config.recording.local.queueSize);
+            logger::info("recording to local directory %s", _name, config.recording.local.directory.get().c_str());
+        }
+        else if (config.recording.singlePort != 0)
         {
             for (uint32_t portOffset = 0; portOffset < std::max(1u, config.recording.sharedPorts.get()); ++portOffset)
             {
@@ -404,6 +433,10 @@ public:
                 _tcpServerEndpoints,
                 this,
                 _mainAllocator,
+                _egressPacer,
+                _ingressDropCounters,
+                _handshakePool,
+                _flightRecorderWriter.get(),
                 expectedInboundStreamCount,
                 expectedOutboundStreamCount,
                 jobQueueSize,
@@ -435,6 +468,10 @@ public:
             _tcpServerEndpoints,
             this,
             _mainAllocator,
+            _egressPacer,
+            _ingressDropCounters,
+            _handshakePool,
+            _flightRecorderWriter.get(),
             expectedInboundStreamCount,
             expectedOutboundStreamCount,
             jobQueueSize,
@@ -469,6 +506,10 @@ public:
             _tcpServerEndpoints,
             this,
             _mainAllocator,
+            _egressPacer,
+            _ingressDropCounters,
+            _handshakePool,
+            _flightRecorderWriter.get(),
             expectedInboundStreamCount,
             expectedOutboundStreamCount,
             jobQueueSize,
@@ -491,7 +532,10 @@ public:
                 _rateControllerConfig,
                 rtpPorts,
                 rtcpPorts,
-                _mainAllocator);
+                _mainAllocator,
+                _egressPacer,
+                _ingressDropCounters,
+                _handshakePool);
         }
 
         return nullptr;
@@ -503,6 +547,25 @@ public:
         const uint8_t aesKey[32],
         const uint8_t salt[12]) override
     {
+        if (_localRecordingWriter)
+        {
+            auto endpoint = std::make_shared<LocalRecordingEndpoint>(*_localRecordingWriter,
+                _mainAllocator,
+                streamHashId,
+                endpointHashId,
+                peer);
+
+            return createRecordingTransport(_jobManager,
+                _config,
+                endpoint,
+                endpointHashId,
+                streamHashId,
+                peer,
+                aesKey,
+                salt,
+                _mainAllocator);
+        }
+
         if (!_sharedRecordingEndpoints.empty())
         {
             const uint32_t initialIndex =
@@ -552,6 +615,13 @@ public:
         return metrics;
     }
 
+    IngressDrops getIngressDrops() const override { return _ingressDropCounters.snapshot(); }
+
+    DtlsHandshakeStats getDtlsHandshakeStats() const override
+    {
+        return _handshakePool ? _handshakePool->getStats() : DtlsHandshakeStats();
+    }
+
     bool isGood() const override { return _good; }
 
     void maintenance(uint64_t timestamp) override
@@ -681,8 +751,13 @@ private:
 
     std::vector<std::vector<std::shared_ptr<RecordingEndpoint>>> _sharedRecordingEndpoints;
     std::atomic_uint32_t _sharedRecordingEndpointListIndex;
+    std::unique_ptr<RecordingSegmentWriter> _localRecordingWriter;
     bool _good;
     std::shared_ptr<transport::EndpointFactory> _endpointFactory;
+    EgressPacer _egressPacer;
+    IngressDropCounters _ingressDropCounters;
+    DtlsHandshakePool* _handshakePool;
+    std::unique_ptr<logger::PacketFlightRecorderWriter> _flightRecorderWriter;
     static const char* _name;
     jobmanager::JobQueue _garbageQueue; // must be last
 };
@@ -699,7 +774,8 @@ std::unique_ptr<TransportFactory> createTransportFactory(jobmanager::JobManager&
     const std::vector<SocketAddress>& interfaces,
     transport::RtcePoll& rtcePoll,
     memory::PacketPoolAllocator& mainAllocator,
-    std::shared_ptr<EndpointFactory> endpointFactory)
+    std::shared_ptr<EndpointFactory> endpointFactory,
+    DtlsHandshakePool* handshakePool)
 {
     return std::make_unique<TransportFactoryImpl>(jobManager,
         srtpClientFactory,
@@ -711,7 +787,8 @@ std::unique_ptr<TransportFactory> createTransportFactory(jobmanager::JobManager&
         interfaces,
         rtcePoll,
         mainAllocator,
-        endpointFactory);
+        endpointFactory,
+        handshakePool);
 }
 
 } // namespace transport
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "memory/PacketPoolAllocator.h"
+#include "transport/DtlsHandshakePool.h"
 #include "transport/Endpoint.h"
 #include "transport/EndpointFactory.h"
 #include "transport/EndpointMetrics.h"
+#include "transport/IngressLimiter.h"
 #include "transport/ice/IceSession.h"
 #include <memory>
 
@@ -79,6 +81,8 @@ public:
         const uint8_t aesKey[32],
         const uint8_t salt[12]) = 0;
     virtual EndpointMetrics getSharedUdpEndpointsMetrics() const = 0;
+    virtual IngressDrops getIngressDrops() const = 0;
+    virtual DtlsHandshakeStats getDtlsHandshakeStats() const = 0;
     virtual bool isGood() const = 0;
 
     virtual std::shared_ptr<RtcTransport> createOnPorts(const ice::IceRole iceRole,
@@ -110,6 +114,7 @@ std::unique_ptr<TransportFactory> createTransportFactory(jobmanager::JobManager&
     const std::vector<SocketAddress>& interfaces,
     transport::RtcePoll& rtcePoll,
     memory::PacketPoolAllocator& mainAllocator,
-    std::shared_ptr<EndpointFactory> endpointFactory);
+    std::shared_ptr<EndpointFactory> endpointFactory,
+    DtlsHandshakePool* handshakePool = nullptr);
 
 } // namespace transport
@@ -2,6 +2,8 @@
 #include "transport/sctp/SctpConfig.h"
 #include "api/utils.h"
 #include "bwe/BandwidthEstimator.h"
+#include "concurrency/CounterWait.h"
+#include "concurrency/ScopedSpinLocker.h"
 #include "config/Config.h"
 #include "dtls/SrtpClient.h"
 #include "dtls/SrtpClientFactory.h"
@@ -9,6 +11,7 @@
 #include "ice/IceSerialize.h"
 #include "ice/IceSession.h"
 #include "logger/Logger.h"
+#include "logger/PacketFlightRecorder.h"
 #include "logger/PacketLogger.h"
 #include "memory/AudioPacketPoolAllocator.h"
 #include "memory/PoolBuffer.h"
@@ -38,6 +41,9 @@
 namespace transport
 {
 constexpr uint32_t Mbps100 = 100000;
+// IceSession learns that the selected pair is alive from media, while consent checks answered on the receive thread
+// bypass it. Without recent media the checks must reach the IceSession.
+constexpr uint64_t consentFastPathMediaTimeout = 2 * utils::Time::sec;
 // we have to serialize operations on srtp client
 // timers, start and receive must be done from same serialized jobmanager.
 
@@ -258,28 +264,23 @@ private:
     std::atomic_uint32_t& _counter;
 };
 
-class RunTickJob : public jobmanager::CountedJob
+class PacingReleaseJob : public jobmanager::CountedJob
 {
 public:
-    RunTickJob(TransportImpl& transport, const uint64_t timestamp)
+    explicit PacingReleaseJob(TransportImpl& transport)
         : CountedJob(transport.getJobCounter()),
-          _transport(transport),
-          _timestamp(timestamp)
+          _transport(transport)
     {
     }
 
     void run() override
     {
-        if (utils::Time::diffLT(_transport._lastTickJobStartTimestamp, _timestamp, utils::Time::ms * 10))
-        {
-            return;
-        }
+        _transport._pacingReleaseScheduled = false;
         _transport.doRunTick(utils::Time::getAbsoluteTime());
     }
 
 private:
     TransportImpl& _transport;
-    uint64_t _timestamp;
 };
 
 std::shared_ptr<RtcTransport> createTransport(jobmanager::JobManager& jobmanager,
@@ -295,6 +296,10 @@ std::shared_ptr<RtcTransport> createTransport(jobmanager::JobManager& jobmanager
     const ServerEndpoints& tcpEndpoints,
     TcpEndpointFactory* tcpEndpointFactory,
     memory::PacketPoolAllocator& allocator,
+    EgressPacer& egressPacer,
+    IngressDropCounters& ingressDropCounters,
+    DtlsHandshakePool* handshakePool,
+    logger::PacketFlightRecorderWriter* flightRecorderWriter,
     size_t expectedInboundStreamCount,
     size_t expectedOutboundStreamCount,
     size_t jobQueueSize,
@@ -314,6 +319,10 @@ std::shared_ptr<RtcTransport> createTransport(jobmanager::JobManager& jobmanager
         tcpEndpoints,
         tcpEndpointFactory,
         allocator,
+        egressPacer,
+        ingressDropCounters,
+        handshakePool,
+        flightRecorderWriter,
         expectedInboundStreamCount,
         expectedOutboundStreamCount,
         jobQueueSize,
@@ -330,7 +339,10 @@ std::shared_ptr<RtcTransport> createTransport(jobmanager::JobManager& jobmanager
     const bwe::RateControllerConfig& rateControllerConfig,
     const Endpoints& rtpEndPoints,
     const Endpoints& rtcpEndPoints,
-    memory::PacketPoolAllocator& allocator)
+    memory::PacketPoolAllocator& allocator,
+    EgressPacer& egressPacer,
+    IngressDropCounters& ingressDropCounters,
+    DtlsHandshakePool* handshakePool)
 {
     return std::make_shared<TransportImpl>(jobmanager,
         srtpClientFactory,
@@ -341,7 +353,10 @@ std::shared_ptr<RtcTransport> createTransport(jobmanager::JobManager& jobmanager
         rateControllerConfig,
         rtpEndPoints,
         rtcpEndPoints,
-        allocator);
+        allocator,
+        egressPacer,
+        ingressDropCounters,
+        handshakePool);
 }
 
 TransportImpl::TransportImpl(jobmanager::JobManager& jobmanager,
@@ -353,7 +368,10 @@ TransportImpl::TransportImpl(jobmanager::JobManager& jobmanager,
     const bwe::RateControllerConfig& rateControllerConfig,
     const Endpoints& rtpEndPoints,
     const Endpoints& rtcpEndPoints,
-    memory::PacketPoolAllocator& allocator)
+    memory::PacketPoolAllocator& allocator,
+    EgressPacer& egressPacer,
+    IngressDropCounters& ingressDropCounters,
+    DtlsHandshakePool* handshakePool)
     : _isInitialized(false),
       _loggableId("Transport"),
       _endpointIdHash(endpointIdHash),
@@ -382,15 +400,18 @@ TransportImpl::TransportImpl(jobmanager::JobManager& jobmanager,
       _rateController(_loggableId.getInstanceId(), rateControllerConfig),
       _rtxProbeSsrc(0),
       _rtxProbeSequenceCounter(nullptr),
-      _pacingInUse(false),
+      _egressPacer(egressPacer),
+      _pacingReleaseScheduled(false),
+      _ingressLimiter(config, ingressDropCounters),
+      _handshakePool(handshakePool),
+      _handshakeSlot(handshakePool ? DtlsHandshakeSlot::Waiting : DtlsHandshakeSlot::Done),
       _iceState(ice::IceSession::State::IDLE),
       _dtlsState(SrtpClient::State::IDLE),
       _isConnected(false),
       _rtcpProducer(_loggableId, _config, _outboundSsrcCounters, _inboundSsrcCounters, _mainAllocator, *this),
       _uplinkEstimationEnabled(false),
       _downlinkEstimationEnabled(false),
-      _lastReceivedPacketTimestamp(0),
-      _lastTickJobStartTimestamp(0)
+      _lastReceivedPacketTimestamp(0)
 {
     assert(endpointIdHash != 0);
     _tag[0] = 0;
@@ -453,6 +474,10 @@ TransportImpl::TransportImpl(jobmanager::JobManager& jobmanager,
     const ServerEndpoints& tcpEndpoints,
     TcpEndpointFactory* tcpEndpointFactory,
     memory::PacketPoolAllocator& allocator,
+    EgressPacer& egressPacer,
+    IngressDropCounters& ingressDropCounters,
+    DtlsHandshakePool* handshakePool,
+    logger::PacketFlightRecorderWriter* flightRecorderWriter,
     const size_t expectedInboundStreamCount,
     const size_t expectedOutboundStreamCount,
     const size_t jobQueueSize,
@@ -486,15 +511,18 @@ TransportImpl::TransportImpl(jobmanager::JobManager& jobmanager,
       _rateController(_loggableId.getInstanceId(), rateControllerConfig),
       _rtxProbeSsrc(0),
       _rtxProbeSequenceCounter(nullptr),
-      _pacingInUse(false),
+      _egressPacer(egressPacer),
+      _pacingReleaseScheduled(false),
+      _ingressLimiter(config, ingressDropCounters),
+      _handshakePool(handshakePool),
+      _handshakeSlot(handshakePool ? DtlsHandshakeSlot::Waiting : DtlsHandshakeSlot::Done),
       _iceState(ice::IceSession::State::IDLE),
       _dtlsState(SrtpClient::State::IDLE),
       _isConnected(false),
       _rtcpProducer(_loggableId, _config, _outboundSsrcCounters, _inboundSsrcCounters, _mainAllocator, *this),
       _uplinkEstimationEnabled(enableUplinkEstimation && _config.rctl.enable),
       _downlinkEstimationEnabled(enableDownlinkEstimation && _config.bwe.enable),
-      _lastReceivedPacketTimestamp(0),
-      _lastTickJobStartTimestamp(0)
+      _lastReceivedPacketTimestamp(0)
 {
     assert(endpointIdHash != 0);
     _tag[0] = 0;
@@ -512,6 +540,7 @@ TransportImpl::TransportImpl(jobmanager::JobManager& jobmanager,
         ice::IceComponent::RTP,
         iceRole,
         this);
+    _iceConsentResponder = std::make_unique<ice::IceConsentResponder>(iceConfig.software);
 
     for (auto& endpoint : sharedEndpoints)
     {
@@ -609,6 +638,14 @@ TransportImpl::TransportImpl(jobmanager::JobManager& jobmanager,
         auto logFile = ::fopen(fileName.c_str(), "wr");
         _packetLogger.reset(new logger::PacketLoggerThread(logFile, 512));
     }
+
+    if (flightRecorderWriter)
+    {
+        _flightRecorder = std::make_unique<logger::PacketFlightRecorder>(_config.flightRecorder.packetCount,
+            _loggableId.c_str(),
+            _config.flightRecorder.minDumpIntervalSec * utils::Time::sec,
+            *flightRecorderWriter);
+    }
 }
 // When ref counter has been assigned, the inbound data from sockets can be handled
 // as received job can be created.
@@ -636,6 +673,7 @@ TransportImpl::~TransportImpl()
             _jobCounter.load(),
             _jobQueue.getCount());
     }
+    releaseDtlsHandshake();
 }
 
 void TransportImpl::stop()
@@ -658,6 +696,11 @@ void TransportImpl::internalShutdown()
     {
         _rtpIceSession->stop();
     }
+    if (_iceConsentResponder)
+    {
+        _iceConsentResponder->clearSelectedPair();
+    }
+    releaseDtlsHandshake();
 
     _selectedRtp = nullptr;
     _srtpClient->stop();
@@ -733,6 +776,27 @@ void TransportImpl::onRtpReceived(Endpoint& endpoint,
     memory::UniquePacket packet,
     const uint64_t timestamp)
 {
+    const auto rtpHeader = rtp::RtpHeader::fromPacket(*packet);
+    if (!rtpHeader)
+    {
+        return;
+    }
+
+    if (!_ingressLimiter.admit(source, rtpHeader->ssrc.get(), packet->getLength(), timestamp))
+    {
+        if (_flightRecorder)
+        {
+            _flightRecorder->record(logger::PacketDirection::Inbound,
+                rtpHeader->ssrc,
+                rtpHeader->sequenceNumber,
+                packet->getLength(),
+                0,
+                timestamp,
+                logger::PacketDropReason::IngressLimit);
+        }
+        return;
+    }
+
     if (!_jobQueue.post(_jobCounter,
             utils::bind(&TransportImpl::internalRtpReceived,
                 this,
@@ -757,6 +821,17 @@ void TransportImpl::internalRtpReceived(Endpoint& endpoint,
     if (!_srtpClient->isConnected())
     {
         logger::debug("RTP received, dtls not connected yet", _loggableId.c_str());
+        const auto* rtpHeader = rtp::RtpHeader::fromPacket(*packet);
+        if (_flightRecorder && rtpHeader)
+        {
+            _flightRecorder->record(logger::PacketDirection::Inbound,
+                rtpHeader->ssrc,
+                rtpHeader->sequenceNumber,
+                packet->getLength(),
+                0,
+                timestamp,
+                logger::PacketDropReason::NotConnected);
+        }
         return;
     }
 
@@ -779,6 +854,20 @@ void TransportImpl::internalRtpReceived(Endpoint& endpoint,
 
     packet->endpointIdHash = _endpointIdHash;
 
+    uint32_t absSendTime = 0;
+    const bool hasAbsSendTime =
+        _absSendTimeExtensionId && rtp::getTransmissionTimestamp(*packet, _absSendTimeExtensionId, absSendTime);
+
+    if (_flightRecorder)
+    {
+        _flightRecorder->record(logger::PacketDirection::Inbound,
+            rtpHeader->ssrc,
+            rtpHeader->sequenceNumber,
+            packet->getLength(),
+            absSendTime,
+            timestamp);
+    }
+
     bool rembReady = false;
     if (_absSendTimeExtensionId)
     {
@@ -786,9 +875,8 @@ void TransportImpl::internalRtpReceived(Endpoint& endpoint,
         {
             _packetLogger->post(*packet, timestamp);
         }
-        uint32_t absSendTime = 0;
 
-        if (rtp::getTransmissionTimestamp(*packet, _absSendTimeExtensionId, absSendTime))
+        if (hasAbsSendTime)
         {
             rembReady = doBandwidthEstimation(timestamp, utils::Optional<uint32_t>(absSendTime), packet->getLength());
         }
@@ -802,6 +890,10 @@ void TransportImpl::internalRtpReceived(Endpoint& endpoint,
     const auto rtpFrequency = _audio.containsPayload(rtpHeader->payloadType) ? _audio.rtpFrequency : 90000;
     auto& ssrcState = getInboundSsrc(ssrc, rtpFrequency);
 
+    if (_flightRecorder)
+    {
+        checkInboundStall(ssrcState, rtpHeader->sequenceNumber, timestamp);
+    }
     ssrcState.onRtpReceived(*packet, timestamp);
     if (ssrcState.getCumulativeSnapshot().packets == 1 && !_downlinkEstimationEnabled)
     {
@@ -839,6 +931,14 @@ void TransportImpl::onDtlsReceived(Endpoint& endpoint,
     memory::UniquePacket packet,
     const uint64_t timestamp)
 {
+    if (packet->get()[0] != DTLSContentType::applicationData && !admitDtlsHandshake(timestamp))
+    {
+        logger::debug("DTLS handshake not admitted, dropping record from %s",
+            _loggableId.c_str(),
+            maybeMasked(source).c_str());
+        return;
+    }
+
     if (!_jobQueue.post(_jobCounter,
             utils::bind(&TransportImpl::internalDtlsReceived,
                 this,
@@ -880,6 +980,10 @@ void TransportImpl::internalDtlsReceived(Endpoint& endpoint,
         {
             onIceCandidateChanged(_rtpIceSession.get(), &endpoint, source);
         }
+        if (_handshakeSlot == DtlsHandshakeSlot::Admitted)
+        {
+            _handshakePool->onRecordProcessed(timestamp, utils::Time::getAbsoluteTime());
+        }
 
         logger::debug("received DTLS protocol message from %s, %zu",
             _loggableId.c_str(),
@@ -971,6 +1075,13 @@ void TransportImpl::onIceReceived(Endpoint& endpoint,
         return;
     }
 
+    if (_config.ice.consentFastPath && _iceConsentResponder &&
+        utils::Time::diffLT(_lastReceivedPacketTimestamp, timestamp, consentFastPathMediaTimeout) &&
+        _iceConsentResponder->tryRespond(endpoint, source, packet->get(), packet->getLength(), timestamp))
+    {
+        return;
+    }
+
     if (!_jobQueue.post(_jobCounter,
             utils::bind(&TransportImpl::internalIceReceived,
                 this,
@@ -1118,7 +1229,7 @@ void TransportImpl::onTcpEndpointStoppedInternal(Endpoint* endpoint)
         _rtpEndpoints.pop_back();
     }
 
-    --_jobCounter;
+    concurrency::decrementAndNotify(_jobCounter);
 }
 
 namespace
@@ -1163,6 +1274,11 @@ void TransportImpl::processRtcpReport(const rtp::RtcpHeader& header,
     uint32_t rttNtp = ~0u;
     uint32_t recvNtp32 = utils::Time::toNtp32(wallClock);
 
+    if (_flightRecorder)
+    {
+        checkPliBurst(header, timestamp);
+    }
+
     if (header.packetType == rtp::RtcpPacketType::SENDER_REPORT)
     {
         const auto senderReport = rtp::RtcpSenderReport::fromPtr(&header, header.size());
@@ -1172,6 +1288,7 @@ void TransportImpl::processRtcpReport(const rtp::RtcpHeader& header,
             timestamp,
             recvNtp32,
             _rateController);
+        checkLossSpike(senderReport->reportBlocks, senderReport->header.fmtCount, timestamp);
 
         if (_uplinkEstimationEnabled)
         {
@@ -1190,6 +1307,7 @@ void TransportImpl::processRtcpReport(const rtp::RtcpHeader& header,
             timestamp,
             recvNtp32,
             _rateController);
+        checkLossSpike(receiverReport->reportBlocks, receiverReport->header.fmtCount, timestamp);
         if (_uplinkEstimationEnabled)
         {
             _outboundMetrics.estimatedKbps = _rateController.getTargetRate();
@@ -1555,6 +1673,17 @@ void TransportImpl::protectAndSend(memory::UniquePacket packet)
         {
             logger::debug("dropping packet, not connected", _loggableId.c_str());
         }
+        if (_flightRecorder && rtp::isRtpPacket(*packet))
+        {
+            const auto* rtpHeader = rtp::RtpHeader::fromPacket(*packet);
+            _flightRecorder->record(logger::PacketDirection::Outbound,
+                rtpHeader->ssrc,
+                rtpHeader->sequenceNumber,
+                packet->getLength(),
+                0,
+                timestamp,
+                logger::PacketDropReason::NotConnected);
+        }
         return;
     }
 
@@ -1660,6 +1789,15 @@ void TransportImpl::protectAndSendRtp(uint64_t timestamp, memory::UniquePacket p
     auto& ssrcState = getOutboundSsrc(rtpHeader->ssrc, rtpFrequency);
 
     ssrcState.onRtpSent(timestamp, *packet);
+    if (_flightRecorder)
+    {
+        _flightRecorder->record(logger::PacketDirection::Outbound,
+            rtpHeader->ssrc,
+            rtpHeader->sequenceNumber,
+            packet->getLength(),
+            0,
+            timestamp);
+    }
     if (_uplinkEstimationEnabled)
     {
         _rateController.onRtpSent(timestamp, rtpHeader->ssrc, rtpHeader->sequenceNumber, packet->getLength());
@@ -1785,6 +1923,16 @@ bool TransportImpl::setSrtpRemoteRolloverCounter(const uint32_t ssrc, const uint
     return false;
 }
 
+void TransportImpl::rejectInboundSsrc(const uint32_t ssrc)
+{
+    _ingressLimiter.rejectSsrc(ssrc, utils::Time::getAbsoluteTime());
+}
+
+void TransportImpl::clearRejectedInboundSsrcs()
+{
+    _ingressLimiter.clearRejectedSsrcs();
+}
+
 bool TransportImpl::isGatheringComplete() const
 {
     return (!_rtpIceSession || _rtpIceSession->getState() != ice::IceSession::State::GATHERING);
@@ -2009,6 +2157,11 @@ void TransportImpl::onIceCandidateChanged(ice::IceSession* session,
             ice::toString(endpoint->getTransportType()).c_str(),
             endpoint->getLocalPort().toFixedString().c_str(),
             maybeMasked(sourcePort).c_str());
+
+        if (_iceState == ice::IceSession::State::CONNECTED)
+        {
+            publishSelectedPair();
+        }
     }
 }
 
@@ -2023,6 +2176,14 @@ void TransportImpl::onIceStateChanged(ice::IceSession* session, const ice::IceSe
 {
     _iceState = state;
     _isConnected = (_selectedRtp && _srtpClient->isConnected());
+    if (state == ice::IceSession::State::CONNECTED)
+    {
+        publishSelectedPair();
+    }
+    else if (_iceConsentResponder)
+    {
+        _iceConsentResponder->clearSelectedPair();
+    }
 
     switch (state)
     {
@@ -2104,6 +2265,26 @@ void TransportImpl::onIceStateChanged(ice::IceSession* session, const ice::IceSe
     }
 }
 
+void TransportImpl::publishSelectedPair()
+{
+    if (!_iceConsentResponder)
+    {
+        return;
+    }
+
+    if (_selectedRtp)
+    {
+        _iceConsentResponder->setSelectedPair(_selectedRtp,
+            _peerRtpPort,
+            _rtpIceSession->getLocalCredentials(),
+            _rtpIceSession->getRole());
+    }
+    else
+    {
+        _iceConsentResponder->clearSelectedPair();
+    }
+}
+
 void TransportImpl::onTransportConnected()
 {
     auto* dataReceiver = _dataReceiver.load();
@@ -2126,6 +2307,10 @@ void TransportImpl::onSrtpStateChange(SrtpClient*, const SrtpClient::State state
 {
     _dtlsState = state;
     _isConnected = (_selectedRtp && _srtpClient->isConnected());
+    if (state == SrtpClient::State::CONNECTED || state == SrtpClient::State::FAILED)
+    {
+        releaseDtlsHandshake();
+    }
 
     logger::info("SRTP %s, transport connected%u",
         getLoggableId().c_str(),
@@ -2145,6 +2330,45 @@ void TransportImpl::onSrtpStateChange(SrtpClient*, const SrtpClient::State state
     }
 }
 
+// Called on receive threads. Once admitted, the job queue runs on the handshake pool until the handshake is over.
+bool TransportImpl::admitDtlsHandshake(const uint64_t timestamp)
+{
+    if (_handshakeSlot != DtlsHandshakeSlot::Waiting)
+    {
+        return true;
+    }
+
+    concurrency::ScopedSpinLocker lock(_handshakeSlotLock);
+    if (_handshakeSlot != DtlsHandshakeSlot::Waiting)
+    {
+        return true;
+    }
+    if (!_handshakePool->tryAcquire(timestamp))
+    {
+        return false;
+    }
+
+    _jobQueue.setExecutor(_handshakePool->getJobManager());
+    _handshakeSlot = DtlsHandshakeSlot::Admitted;
+    return true;
+}
+
+void TransportImpl::releaseDtlsHandshake()
+{
+    if (_handshakeSlot == DtlsHandshakeSlot::Done)
+    {
+        return;
+    }
+
+    concurrency::ScopedSpinLocker lock(_handshakeSlotLock);
+    if (_handshakeSlot == DtlsHandshakeSlot::Admitted)
+    {
+        _jobQueue.resetExecutor();
+        _handshakePool->release();
+    }
+    _handshakeSlot = DtlsHandshakeSlot::Done;
+}
+
 int32_t TransportImpl::sendDtls(const char* buffer, const uint32_t length)
 {
     assert(length >= 0);
@@ -2387,18 +2611,8 @@ void TransportImpl::setRtxProbeSource(const uint32_t ssrc, uint32_t* sequenceCou
     _rateController.setRtpProbingEnabled(!!sequenceCounter);
 }
 
-void TransportImpl::runTick(uint64_t timestamp)
-{
-    if (_pacingInUse.load())
-    {
-        _jobQueue.addJob<RunTickJob>(*this, timestamp);
-    }
-}
-
 void TransportImpl::doRunTick(const uint64_t timestamp)
 {
-    _lastTickJobStartTimestamp = timestamp;
-
     auto drainMode = _uplinkEstimationEnabled && _config.rctl.useUplinkEstimate ? DrainPacingBufferMode::UseBudget
                                                                                 : DrainPacingBufferMode::DrainAll;
 
@@ -2407,9 +2621,47 @@ void TransportImpl::doRunTick(const uint64_t timestamp)
     {
         sendPadding(timestamp);
     }
-    _pacingInUse = !_pacingQueue.empty() || !_rtxPacingQueue.empty();
     _pacingQueueStats.pacingQueueSize = _pacingQueue.size();
     _pacingQueueStats.rtxPacingQueueSize = _rtxPacingQueue.size();
+    schedulePacingRelease(timestamp);
+}
+
+// Asks the egress pacer to run doRunTick when the rate controller budget allows the next queued packet.
+// The job counter is held while scheduled, so the transport cannot be deleted before the pacer calls back.
+void TransportImpl::schedulePacingRelease(const uint64_t timestamp)
+{
+    if (_pacingReleaseScheduled || (_pacingQueue.empty() && _rtxPacingQueue.empty()))
+    {
+        return;
+    }
+
+    const auto& queue = _rtxPacingQueue.empty() ? _pacingQueue : _rtxPacingQueue;
+    const size_t nextPacketSize = queue.back()->getLength() + _config.ipOverhead;
+    const size_t budget = _rateController.getPacingBudget(timestamp);
+    const double rateKbps = std::max(100.0, _rateController.getTargetRate());
+    const uint64_t delay = nextPacketSize > budget
+        ? static_cast<uint64_t>((nextPacketSize - budget) * 8 * utils::Time::ms / rateKbps)
+        : 0;
+
+    ++_jobCounter;
+    _pacingReleaseScheduled = true;
+    if (!_egressPacer.schedule(*this, timestamp + std::max(delay, EgressPacer::slotDuration)))
+    {
+        _pacingReleaseScheduled = false;
+        concurrency::decrementAndNotify(_jobCounter);
+        logger::warn("egress pacer full, pacing queue %zu left until next send",
+            _loggableId.c_str(),
+            _pacingQueue.size() + _rtxPacingQueue.size());
+    }
+}
+
+void TransportImpl::onPacingReleaseDue(const uint64_t timestamp)
+{
+    if (!_jobQueue.addJob<PacingReleaseJob>(*this))
+    {
+        _pacingReleaseScheduled = false;
+    }
+    concurrency::decrementAndNotify(_jobCounter);
 }
 
 memory::UniquePacket TransportImpl::tryFetchPriorityPacket(size_t budget)
@@ -2523,4 +2775,69 @@ void TransportImpl::asyncSetRemoteSdesKey(const srtp::AesKey& key)
     _jobQueue.post(_jobCounter, [this, key]() { _srtpClient->setRemoteKey(key); });
 }
 
+bool TransportImpl::dumpPacketRecords(const char* reason)
+{
+    return _flightRecorder && _flightRecorder->dump(reason, utils::Time::getAbsoluteTime());
+}
+
+// Called from transport serial thread. Counts PLIs received within a second.
+void TransportImpl::checkPliBurst(const rtp::RtcpHeader& header, const uint64_t timestamp)
+{
+    if (header.packetType != rtp::RtcpPacketType::PAYLOADSPECIFIC_FB ||
+        header.fmtCount != rtp::PayloadSpecificFeedbackType::Pli)
+    {
+        return;
+    }
+
+    auto& triggers = _flightRecorderTriggers;
+    if (utils::Time::diffGE(triggers.pliWindowStart, timestamp, utils::Time::sec))
+    {
+        triggers.pliWindowStart = timestamp;
+        triggers.pliCount = 0;
+    }
+
+    if (++triggers.pliCount == _config.flightRecorder.pliBurstCount)
+    {
+        _flightRecorder->dump("pli burst", timestamp);
+    }
+}
+
+// A sender that pauses, on mute or camera off, resumes with the next sequence number. Packets sent during a network
+// stall are lost, so only a pause that ends with a sequence number gap is a stall.
+void TransportImpl::checkInboundStall(const RtpReceiveState& ssrcState,
+    const uint16_t sequenceNumber,
+    const uint64_t timestamp)
+{
+    const auto counters = ssrcState.getCumulativeSnapshot();
+    if (counters.packets == 0 ||
+        utils::Time::diffLE(counters.timestamp, timestamp, _config.flightRecorder.stallMs * utils::Time::ms))
+    {
+        return;
+    }
+
+    const auto extendedSequenceNumber = ssrcState.toExtendedSequenceNumber(sequenceNumber);
+    if (static_cast<int32_t>(extendedSequenceNumber - ssrcState.getExtendedSequenceNumber()) > 1)
+    {
+        _flightRecorder->dump("inbound stall", timestamp);
+    }
+}
+
+void TransportImpl::checkLossSpike(const rtp::ReportBlock* reportBlocks, const int count, const uint64_t timestamp)
+{
+    if (!_flightRecorder)
+    {
+        return;
+    }
+
+    const double lossSpike = _config.flightRecorder.lossSpikePercent / 100.0;
+    for (int i = 0; i < count; ++i)
+    {
+        if (reportBlocks[i].loss.getFractionLost() >= lossSpike)
+        {
+            _flightRecorder->dump("loss spike", timestamp);
+            return;
+        }
+    }
+}
+
 } // namespace transport
@@ -4,12 +4,16 @@
 #include "concurrency/MpmcHashmap.h"
 #include "dtls/SrtpClient.h"
 #include "dtls/SslWriteBioListener.h"
+#include "ice/IceConsentResponder.h"
 #include "ice/IceSession.h"
 #include "logger/Logger.h"
 #include "memory/AudioPacketPoolAllocator.h"
 #include "rtp/SendTimeDial.h"
 #include "sctp/SctpAssociation.h"
 #include "sctp/SctpServerPort.h"
+#include "transport/DtlsHandshakePool.h"
+#include "transport/EgressPacer.h"
+#include "transport/IngressLimiter.h"
 #include "transport/Endpoint.h"
 #include "transport/RtcTransport.h"
 #include "transport/RtcpReportProducer.h"
@@ -26,6 +30,8 @@
 
 namespace logger
 {
+class PacketFlightRecorder;
+class PacketFlightRecorderWriter;
 class PacketLoggerThread;
 }
 
@@ -53,7 +59,8 @@ class TransportImpl : public RtcTransport,
                       public sctp::SctpAssociation::IEvents,
                       public ServerEndpoint::IEvents,
                       private RtcpReportProducer::RtcpSender,
-                      private Endpoint::IStopEvents
+                      private Endpoint::IStopEvents,
+                      private EgressPacer::IPacedSender
 {
 public:
     TransportImpl(jobmanager::JobManager& jobmanager,
@@ -69,6 +76,10 @@ public:
         const ServerEndpoints& tcpEndPoints,
         TcpEndpointFactory* tcpEndpointFactory,
         memory::PacketPoolAllocator& allocator,
+        EgressPacer& egressPacer,
+        IngressDropCounters& ingressDropCounters,
+        DtlsHandshakePool* handshakePool,
+        logger::PacketFlightRecorderWriter* flightRecorderWriter,
         size_t expectedInboundStreamCount,
         size_t expectedOutboundStreamCount,
         size_t jobQueueSize,
@@ -84,7 +95,10 @@ public:
         const bwe::RateControllerConfig& rateControllerConfig,
         const Endpoints& rtpEndPoints,
         const Endpoints& rtcpEndPoints,
-        memory::PacketPoolAllocator& allocator);
+        memory::PacketPoolAllocator& allocator,
+        EgressPacer& egressPacer,
+        IngressDropCounters& ingressDropCounters,
+        DtlsHandshakePool* handshakePool);
 
     ~TransportImpl() override;
 
@@ -106,6 +120,8 @@ public: // Transport
     bool unprotectFirstRtp(memory::Packet& packet, uint32_t& rolloverCounter) override;
     void removeSrtpLocalSsrc(const uint32_t ssrc) override;
     bool setSrtpRemoteRolloverCounter(const uint32_t ssrc, const uint32_t rolloverCounter) override;
+    void rejectInboundSsrc(const uint32_t ssrc) override;
+    void clearRejectedInboundSsrcs() override;
     void setRtxProbeSource(const uint32_t ssrc, uint32_t* sequenceCounter, const uint16_t payloadType) override;
 
     /** Called from httpd threads */
@@ -185,7 +201,6 @@ public: // Transport
     uint16_t allocateOutboundSctpStream() override;
     void setSctp(uint16_t localPort, uint16_t remotePort) override;
     void connectSctp() override;
-    void runTick(uint64_t timestamp) override;
     ice::IceSession::State getIceState() const override { return _iceState; };
     SrtpClient::State getDtlsState() const override { return _dtlsState; };
     utils::Optional<ice::TransportType> getSelectedTransportType() const override { return _transportType.load(); }
@@ -198,6 +213,8 @@ public: // Transport
     void getSdesKeys(std::vector<srtp::AesKey>& sdesKeys) const override;
     void asyncSetRemoteSdesKey(const srtp::AesKey& key) override;
 
+    bool dumpPacketRecords(const char* reason) override;
+
 private: // SslWriteBioListener
     // Called from Transport serial thread
     int32_t sendDtls(const char* buffer, uint32_t length) override;
@@ -305,7 +322,7 @@ private:
     friend class IceSetRemoteJob;
     friend class ConnectJob;
     friend class ConnectSctpJob;
-    friend class RunTickJob;
+    friend class PacingReleaseJob;
     friend class PacketReceiveJob;
 
     enum class DrainPacingBufferMode
@@ -314,6 +331,13 @@ private:
         UseBudget,
     };
 
+    enum class DtlsHandshakeSlot : uint8_t
+    {
+        Waiting,
+        Admitted,
+        Done
+    };
+
     void protectAndSendRtp(uint64_t timestamp, memory::UniquePacket packet);
     void doProtectAndSend(uint64_t timestamp,
         memory::UniquePacket packet,
@@ -351,8 +375,16 @@ private:
     RtpSenderState& getOutboundSsrc(uint32_t ssrc, uint32_t rtpFrequency);
 
     void onTransportConnected();
+    void publishSelectedPair();
+    bool admitDtlsHandshake(uint64_t timestamp);
+    void releaseDtlsHandshake();
     void drainPacingBuffer(uint64_t timestamp, DrainPacingBufferMode);
     memory::UniquePacket tryFetchPriorityPacket(size_t budget);
+    void schedulePacingRelease(uint64_t timestamp);
+    void onPacingReleaseDue(uint64_t timestamp) override;
+    void checkPliBurst(const rtp::RtcpHeader& header, uint64_t timestamp);
+    void checkInboundStall(const RtpReceiveState& ssrcState, uint16_t sequenceNumber, uint64_t timestamp);
+    void checkLossSpike(const rtp::ReportBlock* reportBlocks, int count, uint64_t timestamp);
 
     std::atomic_bool _isInitialized;
     logger::LoggableId _loggableId;
@@ -361,6 +393,7 @@ private:
 
     std::unique_ptr<SrtpClient> _srtpClient;
     std::unique_ptr<ice::IceSession> _rtpIceSession;
+    std::unique_ptr<ice::IceConsentResponder> _iceConsentResponder;
 
     Endpoints _rtpEndpoints;
     Endpoints _rtcpEndpoints;
@@ -456,9 +489,22 @@ private:
     using PacingQueue = memory::RandomAccessBacklog<memory::UniquePacket, 512>;
     PacingQueue _pacingQueue;
     PacingQueue _rtxPacingQueue;
-    std::atomic_bool _pacingInUse;
+    EgressPacer& _egressPacer;
+    std::atomic_bool _pacingReleaseScheduled;
+    IngressLimiter _ingressLimiter;
+    DtlsHandshakePool* const _handshakePool;
+    std::atomic<DtlsHandshakeSlot> _handshakeSlot;
+    std::atomic_flag _handshakeSlotLock = ATOMIC_FLAG_INIT;
 
     std::unique_ptr<logger::PacketLoggerThread> _packetLogger;
+    std::unique_ptr<logger::PacketFlightRecorder> _flightRecorder;
+    struct FlightRecorderTriggers
+    {
+        FlightRecorderTriggers() : pliWindowStart(0), pliCount(0) {}
+
+        uint64_t pliWindowStart;
+        uint32_t pliCount;
+    } _flightRecorderTriggers;
     std::atomic<ice::IceSession::State> _iceState;
     std::atomic<SrtpClient::State> _dtlsState;
     std::atomic<bool> _isConnected;
@@ -475,7 +521,6 @@ public:
     bool _uplinkEstimationEnabled;
     bool _downlinkEstimationEnabled;
     std::atomic_uint64_t _lastReceivedPacketTimestamp;
-    uint64_t _lastTickJobStartTimestamp;
 };
 
 } // namespace transport
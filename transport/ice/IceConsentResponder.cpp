@@ -0,0 +1,100 @@
+#include "IceConsentResponder.h"
+#include "concurrency/ScopedSpinLocker.h"
+#include "transport/ice/Stun.h"
+
+namespace ice
+{
+
+IceConsentResponder::IceConsentResponder(const std::string& software)
+    : _software(software),
+      _endpoint(nullptr),
+      _role(IceRole::CONTROLLED)
+{
+}
+
+void IceConsentResponder::setSelectedPair(IceEndpoint* endpoint,
+    const transport::SocketAddress& remotePort,
+    const std::pair<std::string, std::string>& localCredentials,
+    const IceRole role)
+{
+    concurrency::ScopedSpinLocker lock(_lock);
+    _endpoint = endpoint;
+    _remotePort = remotePort;
+    _localUser = localCredentials.first;
+    _role = role;
+    _hmacComputer.init(localCredentials.second.c_str(), localCredentials.second.size());
+}
+
+void IceConsentResponder::clearSelectedPair()
+{
+    concurrency::ScopedSpinLocker lock(_lock);
+    _endpoint = nullptr;
+}
+
+bool IceConsentResponder::isConsentRequest(const StunMessage& msg) const
+{
+    if (!msg.isValid())
+    {
+        return false;
+    }
+
+    const auto* userName = msg.getAttribute<StunUserName>(StunAttribute::USERNAME);
+    if (!userName || !userName->isTargetUser(_localUser.c_str()))
+    {
+        return false;
+    }
+
+    // a possible role conflict must be resolved by the IceSession
+    if ((_role == IceRole::CONTROLLING && msg.getAttribute(StunAttribute::ICE_CONTROLLING)) ||
+        (_role == IceRole::CONTROLLED && msg.getAttribute(StunAttribute::ICE_CONTROLLED)))
+    {
+        return false;
+    }
+
+    return msg.getAttribute(StunAttribute::MESSAGE_INTEGRITY) != nullptr;
+}
+
+bool IceConsentResponder::tryRespond(IceEndpoint& endpoint,
+    const transport::SocketAddress& source,
+    const void* data,
+    const size_t length,
+    const uint64_t timestamp)
+{
+    if (!isStunMessage(data, length))
+    {
+        return false;
+    }
+
+    const auto* msg = StunMessage::fromPtr(data);
+    if (msg->header.getMethod() != StunHeader::BindingRequest)
+    {
+        return false;
+    }
+
+    StunMessage response;
+    {
+        concurrency::ScopedSpinLocker lock(_lock, std::chrono::nanoseconds(0));
+        if (!lock.hasLock() || _endpoint != &endpoint || endpoint.getTransportType() != TransportType::UDP ||
+            source != _remotePort)
+        {
+            return false;
+        }
+
+        if (!isConsentRequest(*msg) || !msg->isAuthentic(_hmacComputer))
+        {
+            return false;
+        }
+
+        response.header.transactionId = msg->header.transactionId;
+        response.header.setMethod(StunHeader::BindingResponse);
+        response.add(StunGenericAttribute(StunAttribute::SOFTWARE, _software));
+        response.add(StunXorMappedAddress(source, response.header));
+        response.addMessageIntegrity(_hmacComputer);
+        response.addFingerprint();
+    }
+
+    endpoint.sendStunTo(source, response.header.transactionId.get(), &response, response.size(), timestamp);
+    return true;
+}
+
+} // namespace ice
@@ -0,0 +1,44 @@
+#pragma once
+#include "IceSession.h"
+#include "crypto/SslHelper.h"
+#include "utils/SocketAddress.h"
+#include <atomic>
+#include <string>
+
+namespace ice
+{
+
+// Answers consent freshness binding requests on the selected candidate pair directly on the receive thread, instead
+// of queueing them to the IceSession. The owner of the IceSession publishes the selected pair once connected.
+// Requests that may change ICE state, like probes on other pairs or role conflicts, are declined and must be passed
+// on to the IceSession. Also declines if another thread is responding, so the receive thread never waits.
+class IceConsentResponder
+{
+public:
+    explicit IceConsentResponder(const std::string& software);
+
+    void setSelectedPair(IceEndpoint* endpoint,
+        const transport::SocketAddress& remotePort,
+        const std::pair<std::string, std::string>& localCredentials,
+        IceRole role);
+    void clearSelectedPair();
+
+    bool tryRespond(IceEndpoint& endpoint,
+        const transport::SocketAddress& source,
+        const void* data,
+        size_t length,
+        uint64_t timestamp);
+
+private:
+    bool isConsentRequest(const StunMessage& msg) const;
+
+    const std::string _software;
+    std::atomic_flag _lock = ATOMIC_FLAG_INIT;
+    IceEndpoint* _endpoint;
+    transport::SocketAddress _remotePort;
+    std::string _localUser;
+    IceRole _role;
+    crypto::HMAC _hmacComputer;
+};
+
+} // namespace ice
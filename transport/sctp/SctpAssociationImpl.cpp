@@ -143,7 +143,9 @@ SctpAssociationImpl::SentDataChunk::SentDataChunk(uint16_t streamId_,
       fragmentBegin(fragmentBegin_),
       fragmentEnd(fragmentEnd_),
       reserved0(0),
-      reserved1(0)
+      reserved1(0),
+      next(nullptr),
+      previous(nullptr)
 {
     const auto copied = buffer.copyTo(data(), offset, size_);
     assert(copied == size);
@@ -158,7 +160,9 @@ SctpAssociationImpl::ReceivedDataChunk::ReceivedDataChunk(const PayloadDataChunk
       payloadProtocol(chunk.payloadProtocol),
       receiveCount(1),
       fragmentBegin(chunk.isBegin()),
-      fragmentEnd(chunk.isEnd())
+      fragmentEnd(chunk.isEnd()),
+      next(nullptr),
+      previous(nullptr)
 {
     std::memcpy(data(), chunk.data(), chunk.payloadSize());
 }
@@ -198,6 +202,15 @@ SctpAssociationImpl::ConnectionEstablishment::ConnectionEstablishment(const Sctp
 {
 }
 
+SctpAssociationImpl::Sacks::Sacks(const SctpConfig& config)
+    : prepared(false),
+      gapDetected(false),
+      unackedPackets(0),
+      delayTimer(config.sack.delayMs, config.sack.delayMs)
+{
+    pendingAck[0] = 0;
+}
+
 SctpAssociationImpl::CongestionControl::CongestionControl(const SctpConfig& config, const logger::LoggableId& logId)
     : congestionWindow(4 * 1500),
       slowStartThreshold(config.flow.slowStartThreshold),
@@ -316,7 +329,9 @@ SctpAssociationImpl::SctpAssociationImpl(size_t logId,
       _rtt(config),
       _mtu(config.mtu.initial, config.mtu.max),
       _outboundBuffer(config.transmitBufferSize),
+      _bundleTimer(config.bundling.delayMs, config.bundling.delayMs),
       _inboundBuffer(config.receiveBufferSize),
+      _ack(config),
       _flow(config, _loggableId),
       _streamIdCounter(0)
 {
@@ -348,7 +363,9 @@ SctpAssociationImpl::SctpAssociationImpl(size_t logId,
       _rtt(config),
       _mtu(config.mtu.initial, config.mtu.max),
       _outboundBuffer(config.transmitBufferSize),
+      _bundleTimer(config.bundling.delayMs, config.bundling.delayMs),
       _inboundBuffer(config.receiveBufferSize),
+      _ack(config),
       _flow(config, _loggableId),
       _streamIdCounter(1)
 {
@@ -404,6 +421,17 @@ bool SctpAssociationImpl::sendMessage(uint16_t streamId,
     {
         return false;
     }
+
+    // Sizes of unsent chunks include the chunk headers. Pending chunks go out first if the message does not fit in
+    // their packet, so that bundled packets are filled but the message is not split from them into a packet of its own.
+    const size_t packetCapacity = _mtu.current - SctpPacketW::HEADER_SIZE;
+    const size_t unsentSize = getUnsentSize();
+    if (_config.bundling.delayMs > 0 && unsentSize > 0 &&
+        unsentSize + length + pktCount * PayloadDataChunk::HEADER_SIZE > packetCapacity)
+    {
+        processOutboundChunks(timestamp);
+    }
+    const bool hadUnsentData = getUnsentSize() > 0;
     auto& streamState = streamIt->second;
     size_t writtenBytes = 0;
     for (size_t i = 0; i < pktCount; ++i)
@@ -443,7 +471,18 @@ bool SctpAssociationImpl::sendMessage(uint16_t streamId,
         ++_local.tsn;
     }
     ++streamState.sequenceCounter;
-    processOutboundChunks(timestamp);
+
+    // Send immediately if nothing is in flight or we have a full packet. Otherwise hold the message briefly so that a
+    // burst of small messages is bundled into one packet. A SACK arriving meanwhile will also flush the queue.
+    const bool dataInFlight = !_outboundDataChunks.empty() && _outboundDataChunks.front()->transmitCount > 0;
+    if (_config.bundling.delayMs == 0 || (!dataInFlight && !hadUnsentData) || getUnsentSize() >= packetCapacity)
+    {
+        processOutboundChunks(timestamp);
+    }
+    else if (!_bundleTimer.isRunning())
+    {
+        _bundleTimer.startMs(timestamp, _config.bundling.delayMs);
+    }
     return true;
 }
 
@@ -513,6 +552,8 @@ int64_t SctpAssociationImpl::nextTimeout(const uint64_t timestamp)
     minTimeout = std::min(minTimeout, _flow.retransmitTimer.remainingTime(timestamp));
     minTimeout = std::min(minTimeout, _mtu.probeTimer.remainingTime(timestamp));
     minTimeout = std::min(minTimeout, _flow.idleTimer.remainingTime(timestamp));
+    minTimeout = std::min(minTimeout, _bundleTimer.remainingTime(timestamp));
+    minTimeout = std::min(minTimeout, _ack.delayTimer.remainingTime(timestamp));
     return minTimeout;
 }
 
@@ -571,6 +612,11 @@ int64_t SctpAssociationImpl::processTimeout(const uint64_t timestamp)
             processOutboundChunks(timestamp);
         }
 
+        if (_bundleTimer.hasExpired(timestamp) || _ack.delayTimer.hasExpired(timestamp))
+        {
+            processOutboundChunks(timestamp);
+        }
+
         if (_mtu.probeTimer.hasExpired(timestamp))
         {
             if (_mtu.transmitCount >= _config.flow.maxRetransmits)
@@ -923,6 +969,17 @@ size_t SctpAssociationImpl::outboundPendingSize() const
     return count;
 }
 
+// size of chunks never transmitted, including chunk headers. These are always at the tail of the queue.
+size_t SctpAssociationImpl::getUnsentSize() const
+{
+    size_t count = 0;
+    for (auto* chunk = _outboundDataChunks.back(); chunk && chunk->transmitCount == 0; chunk = chunk->previous)
+    {
+        count += chunk->fullSize();
+    }
+    return count;
+}
+
 namespace
 {
 template <typename T>
@@ -979,12 +1036,15 @@ void SctpAssociationImpl::processOutboundChunks(const uint64_t timestamp)
             _outboundDataChunks.size());
     }
 
+    _bundleTimer.stop();
     uint8_t packetArea[_mtu.current + 16];
     SctpPacketW packet(_peer.tag, _local.port, _peer.port, packetArea, sizeof(packetArea));
     if (_ack.prepared)
     {
         packet.add(pendingAck);
         _ack.prepared = false;
+        _ack.unackedPackets = 0;
+        _ack.delayTimer.stop();
     }
 
     uint32_t retransmitsCount = 0;
@@ -1111,13 +1171,11 @@ void SctpAssociationImpl::onSackReceived(const SctpPacket& sctpPacket,
     _peer.cumulativeAck = cumulativeAck;
 
     auto flightSize = getFlightSize(timestamp);
-    if (unackedIt != _outboundDataChunks.begin())
+    for (auto it = _outboundDataChunks.begin(); it != unackedIt;)
     {
-        for (auto it = _outboundDataChunks.begin(); it != unackedIt; ++it)
-        {
-            _outboundBuffer.free(*it);
-        }
-        _outboundDataChunks.erase(_outboundDataChunks.begin(), unackedIt);
+        auto* ackedChunk = *it;
+        it = _outboundDataChunks.erase(it);
+        _outboundBuffer.free(ackedChunk);
     }
 
     int lossCount = 0;
@@ -1175,8 +1233,9 @@ void SctpAssociationImpl::onSackReceived(const SctpPacket& sctpPacket,
         }
         if (eraseItem)
         {
-            _outboundBuffer.free(*it);
+            auto* ackedChunk = *it;
             it = _outboundDataChunks.erase(it);
+            _outboundBuffer.free(ackedChunk);
         }
         else
         {
@@ -1273,11 +1332,10 @@ void SctpAssociationImpl::handleFastRetransmits(uint64_t timestamp)
 void SctpAssociationImpl::prepareSack(const uint64_t timestamp)
 {
     auto it = _inboundDataChunks.begin();
-    for (;
-         it != _inboundDataChunks.end() && diff(it->second->transmissionSequenceNumber, _local.cumulativeAck + 1) >= 0;
+    for (; it != _inboundDataChunks.end() && diff((*it)->transmissionSequenceNumber, _local.cumulativeAck + 1) >= 0;
          ++it)
     {
-        if (it->second->transmissionSequenceNumber == _local.cumulativeAck + 1)
+        if ((*it)->transmissionSequenceNumber == _local.cumulativeAck + 1)
         {
             ++_local.cumulativeAck;
         }
@@ -1289,17 +1347,18 @@ void SctpAssociationImpl::prepareSack(const uint64_t timestamp)
     SCTP_LOG("ack up to %x", _loggableId.c_str(), _local.cumulativeAck);
 
     // ack blocks we have received
+    _ack.gapDetected = (it != _inboundDataChunks.end());
     if (it != _inboundDataChunks.end())
     {
-        uint32_t blockStart = it->second->transmissionSequenceNumber;
-        uint32_t nextTsn = it->second->transmissionSequenceNumber + 1;
+        uint32_t blockStart = (*it)->transmissionSequenceNumber;
+        uint32_t nextTsn = (*it)->transmissionSequenceNumber + 1;
         uint32_t blockEnd = nextTsn;
         for (++it; it != _inboundDataChunks.end(); ++it)
         {
-            if (it->second->transmissionSequenceNumber != nextTsn)
+            if ((*it)->transmissionSequenceNumber != nextTsn)
             {
                 sackBuilder.addAck(blockStart, blockEnd);
-                blockStart = it->second->transmissionSequenceNumber;
+                blockStart = (*it)->transmissionSequenceNumber;
             }
 
             ++nextTsn;
@@ -1312,6 +1371,43 @@ void SctpAssociationImpl::prepareSack(const uint64_t timestamp)
     _ack.prepared = true;
 }
 
+// RFC 4960 6.2. SACK may be delayed unless there are gaps, too many unacked packets or the window is closing.
+bool SctpAssociationImpl::isSackUrgent() const
+{
+    return _ack.gapDetected || _ack.unackedPackets >= _config.sack.maxUnackedPackets || _config.sack.delayMs == 0 ||
+        _local.advertisedReceiveWindow < _mtu.current;
+}
+
+SctpAssociationImpl::ReceivedDataChunk* SctpAssociationImpl::findInboundChunk(uint32_t tsn) const
+{
+    // chunks mostly arrive in order, search from the tail
+    for (auto* chunk = _inboundDataChunks.back(); chunk; chunk = chunk->previous)
+    {
+        const auto tsnDiff = diff(chunk->transmissionSequenceNumber, tsn);
+        if (tsnDiff == 0)
+        {
+            return chunk;
+        }
+        else if (tsnDiff > 0)
+        {
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+void SctpAssociationImpl::insertInboundChunk(ReceivedDataChunk* receivedChunk)
+{
+    ReceivedDataChunk* position = nullptr;
+    for (auto* chunk = _inboundDataChunks.back();
+         chunk && diff(receivedChunk->transmissionSequenceNumber, chunk->transmissionSequenceNumber) > 0;
+         chunk = chunk->previous)
+    {
+        position = chunk;
+    }
+    _inboundDataChunks.insertBefore(position, receivedChunk);
+}
+
 // gaps in data TODO continue and find complete fragments that do not require in order
 // This will require more elaborate discarding of data in the inbound buffer.
 bool SctpAssociationImpl::gatherReceivedFragments(const uint64_t timestamp)
@@ -1324,10 +1420,10 @@ bool SctpAssociationImpl::gatherReceivedFragments(const uint64_t timestamp)
     InboundChunkList::iterator itBegin = _inboundDataChunks.end();
     size_t fragmentSize = 0;
     for (auto it = _inboundDataChunks.begin();
-         it != _inboundDataChunks.end() && diff(it->second->transmissionSequenceNumber, _local.cumulativeAck) >= 0;
+         it != _inboundDataChunks.end() && diff((*it)->transmissionSequenceNumber, _local.cumulativeAck) >= 0;
          ++it)
     {
-        auto& chunk = *it->second;
+        auto& chunk = **it;
 
         if (chunk.fragmentBegin)
         {
@@ -1351,21 +1447,22 @@ void SctpAssociationImpl::reportFragment(InboundChunkList::iterator chunkHeadIt,
 {
     memory::Array<uint8_t, 512> buffer(fragmentSize);
 
-    ReceivedDataChunk chunkHead = *chunkHeadIt->second;
+    ReceivedDataChunk chunkHead = **chunkHeadIt;
     if (_streams.find(chunkHead.streamId) == _streams.cend())
     {
         auto pairIt = _streams.emplace(std::forward_as_tuple(chunkHead.streamId, chunkHead.streamId));
         pairIt.first->second.sequenceCounter = chunkHead.streamSequenceNumber;
     }
 
-    for (auto it = chunkHeadIt; it != _inboundDataChunks.end(); ++it)
+    for (auto it = chunkHeadIt; it != _inboundDataChunks.end();)
     {
-        const bool isFragmentEnd = it->second->fragmentEnd;
-        buffer.append(it->second->data(), it->second->size);
-        _inboundBuffer.free(it->second);
+        auto* chunk = *it;
+        const bool isFragmentEnd = chunk->fragmentEnd;
+        buffer.append(chunk->data(), chunk->size);
+        it = _inboundDataChunks.erase(it);
+        _inboundBuffer.free(chunk);
         if (isFragmentEnd)
         {
-            _inboundDataChunks.erase(chunkHeadIt, ++it);
             break;
         }
     }
@@ -1474,7 +1571,8 @@ void SctpAssociationImpl::onHeartbeatResponse(const SctpPacket& sctpPacket, cons
 void SctpAssociationImpl::onDataReceived(const SctpPacket& sctpPacket, const uint64_t timestamp)
 {
     bool dataReceived = false;
-    bool newDataReceived = false; // indicates timeout on peer side for ACK
+    bool newDataReceived = false;
+    bool duplicateReceived = false; // indicates timeout on peer side for ACK
 
     uint32_t lastReceivedTsn;
     for (auto& chunk : sctpPacket.chunks())
@@ -1492,10 +1590,11 @@ void SctpAssociationImpl::onDataReceived(const SctpPacket& sctpPacket, const uin
             {
                 const uint32_t tsn = payloadChunk.transmissionSequenceNumber;
 
-                auto chunkIt = _inboundDataChunks.find(tsn);
-                if (chunkIt != _inboundDataChunks.end())
+                auto* existingChunk = findInboundChunk(tsn);
+                if (existingChunk)
                 {
-                    ++chunkIt->second->receiveCount;
+                    ++existingChunk->receiveCount;
+                    duplicateReceived = true;
                     SCTP_LOG("duplicate data chunk %x received", "", tsn);
                     continue;
                 }
@@ -1503,6 +1602,7 @@ void SctpAssociationImpl::onDataReceived(const SctpPacket& sctpPacket, const uin
                 {
                     // we already acked this range and removed the chunk from inbound list
                     SCTP_LOG("duplicate data chunk %x received", "", tsn);
+                    duplicateReceived = true;
                     continue;
                 }
 
@@ -1514,7 +1614,7 @@ void SctpAssociationImpl::onDataReceived(const SctpPacket& sctpPacket, const uin
                             timestamp);
                     if (receivedChunk)
                     {
-                        _inboundDataChunks[tsn] = receivedChunk;
+                        insertInboundChunk(receivedChunk);
                         if (diff(_peer.tsn, tsn) >= 0)
                         {
                             _peer.tsn = tsn + 1;
@@ -1545,11 +1645,20 @@ void SctpAssociationImpl::onDataReceived(const SctpPacket& sctpPacket, const uin
     if (dataReceived)
     {
         prepareSack(timestamp);
+        ++_ack.unackedPackets;
 
         while (newDataReceived && gatherReceivedFragments(timestamp))
             ;
 
-        processOutboundChunks(timestamp);
+        // the listener may have queued responses that the SACK can be bundled with
+        if (duplicateReceived || isSackUrgent() || getUnsentSize() > 0)
+        {
+            processOutboundChunks(timestamp);
+        }
+        else if (!_ack.delayTimer.isRunning())
+        {
+            _ack.delayTimer.startMs(timestamp, _config.sack.delayMs);
+        }
     }
 }
 
@@ -5,14 +5,13 @@
 #include "memory/PoolBuffer.h"
 #include "memory/RingAllocator.h"
 #include "utils/MersienneRandom.h"
-#include <list>
-#include <map>
 #include <unordered_map>
 namespace sctp
 {
 class SctpServerPort;
 
 // Session state for a connection between client and peer
+// Small messages are bundled into packets up to MTU and SACKs are delayed to be piggy-backed on DATA when possible.
 //
 // Unsupported features:
 //  - graceful disconnect
@@ -21,6 +20,95 @@ class SctpServerPort;
 //  - streams
 class SctpAssociationImpl : public SctpAssociation
 {
+    // Intrusive doubly linked list of chunks that live in a RingAllocator.
+    // The list does not own the chunks. Unlink before freeing the chunk in the allocator.
+    template <typename T>
+    class ChunkList
+    {
+    public:
+        class iterator
+        {
+        public:
+            explicit iterator(T* item) : _item(item) {}
+            T* operator*() const { return _item; }
+            iterator& operator++()
+            {
+                _item = _item->next;
+                return *this;
+            }
+            bool operator==(const iterator& it) const { return _item == it._item; }
+            bool operator!=(const iterator& it) const { return _item != it._item; }
+
+        private:
+            T* _item;
+        };
+
+        iterator begin() const { return iterator(_head); }
+        iterator end() const { return iterator(nullptr); }
+        T* front() const { return _head; }
+        T* back() const { return _tail; }
+        bool empty() const { return _head == nullptr; }
+        size_t size() const { return _count; }
+
+        void push_back(T* item) { insertBefore(nullptr, item); }
+        void pop_back() { erase(iterator(_tail)); }
+
+        // position nullptr appends to tail
+        void insertBefore(T* position, T* item)
+        {
+            item->next = position;
+            item->previous = (position ? position->previous : _tail);
+            if (item->previous)
+            {
+                item->previous->next = item;
+            }
+            else
+            {
+                _head = item;
+            }
+            if (position)
+            {
+                position->previous = item;
+            }
+            else
+            {
+                _tail = item;
+            }
+            ++_count;
+        }
+
+        iterator erase(iterator it)
+        {
+            T* item = *it;
+            T* nextItem = item->next;
+            if (item->previous)
+            {
+                item->previous->next = nextItem;
+            }
+            else
+            {
+                _head = nextItem;
+            }
+            if (nextItem)
+            {
+                nextItem->previous = item->previous;
+            }
+            else
+            {
+                _tail = item->previous;
+            }
+            item->next = nullptr;
+            item->previous = nullptr;
+            --_count;
+            return iterator(nextItem);
+        }
+
+    private:
+        T* _head = nullptr;
+        T* _tail = nullptr;
+        size_t _count = 0;
+    };
+
     struct SentDataChunk
     {
         SentDataChunk()
@@ -35,7 +123,9 @@ class SctpAssociationImpl : public SctpAssociation
               fragmentBegin(false),
               fragmentEnd(false),
               reserved0(0),
-              reserved1(0)
+              reserved1(0),
+              next(nullptr),
+              previous(nullptr)
         {
         }
 
@@ -61,6 +151,8 @@ class SctpAssociationImpl : public SctpAssociation
         const bool fragmentEnd;
         uint16_t reserved0;
         const uint32_t reserved1;
+        SentDataChunk* next;
+        SentDataChunk* previous;
 
         uint32_t fullSize() const { return size + PayloadDataChunk::HEADER_SIZE; }
         uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); }
@@ -77,7 +169,9 @@ class SctpAssociationImpl : public SctpAssociation
               payloadProtocol(0),
               receiveCount(0),
               fragmentBegin(true),
-              fragmentEnd(true)
+              fragmentEnd(true),
+              next(nullptr),
+              previous(nullptr)
         {
         }
         ReceivedDataChunk(const PayloadDataChunk& chunk, uint64_t timestamp);
@@ -91,16 +185,14 @@ class SctpAssociationImpl : public SctpAssociation
         uint16_t receiveCount;
         const bool fragmentBegin;
         const bool fragmentEnd;
+        ReceivedDataChunk* next;
+        ReceivedDataChunk* previous;
 
         uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); }
     };
 
-    class LessReceivedDataChunk
-    {
-    public:
-        bool operator()(uint32_t tsnA, uint32_t tsnB) const { return diff(tsnA, tsnB) > 0; }
-    };
-    typedef std::map<uint32_t, ReceivedDataChunk*, LessReceivedDataChunk> InboundChunkList;
+    typedef ChunkList<SentDataChunk> OutboundChunkList;
+    typedef ChunkList<ReceivedDataChunk> InboundChunkList; // sorted on TSN
 
 public:
     SctpAssociationImpl(size_t logId,
@@ -153,6 +245,10 @@ private:
     void onSackReceived(const SctpPacket& sctpPacket, const SelectiveAckChunk& chunk, uint64_t timestamp);
     void handleFastRetransmits(uint64_t timestamp);
     void prepareSack(uint64_t timestamp);
+    bool isSackUrgent() const;
+    size_t getUnsentSize() const;
+    ReceivedDataChunk* findInboundChunk(uint32_t tsn) const;
+    void insertInboundChunk(ReceivedDataChunk* chunk);
     bool gatherReceivedFragments(uint64_t timestamp);
     void reportFragment(InboundChunkList::iterator chunkHeadIt, size_t fragmentSize, uint64_t timestamp);
     uint32_t getFlightSize(uint64_t timestamp) const;
@@ -255,18 +351,22 @@ private:
         void pickInitialProbe();
     } _mtu; // for SCTP layer
 
-    std::list<SentDataChunk*> _outboundDataChunks;
+    OutboundChunkList _outboundDataChunks;
     memory::RingAllocator _outboundBuffer;
+    Timer _bundleTimer; // small messages wait for more data to bundle while data is in flight
 
     InboundChunkList _inboundDataChunks;
     memory::RingAllocator _inboundBuffer;
 
     struct Sacks
     {
-        Sacks() : prepared(false) { pendingAck[0] = 0; }
+        explicit Sacks(const SctpConfig& config);
 
         uint8_t pendingAck[2048];
         bool prepared;
+        bool gapDetected;
+        uint32_t unackedPackets; // packets with DATA received since last SACK was sent
+        Timer delayTimer;
     };
     Sacks _ack;
 
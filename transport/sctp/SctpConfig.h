@@ -50,6 +50,19 @@ struct SctpConfig
         uint32_t max = 4096;
     } mtu;
 
+    struct
+    {
+        uint32_t delayMs = 20; // SACK is delayed at most this long unless data is sent in the meantime
+        uint32_t maxUnackedPackets = 2; // send SACK immediately when this many DATA packets are unacknowledged
+    } sack;
+
+    struct
+    {
+        // While data is in flight, small messages are held back this long to be bundled into a single packet.
+        // 0 sends every message immediately.
+        uint32_t delayMs = 2;
+    } bundling;
+
     uint32_t maxMessageSize = 2048;
 
     size_t transmitBufferSize = 512 * 1024;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "concurrency/CounterWait.h"
 #include <atomic>
 #include <cassert>
 
@@ -14,10 +15,10 @@ public:
     ~ScopedIncrement()
     {
 #if DEBUG
-        auto value = --_counter;
+        auto value = concurrency::decrementAndNotify(_counter);
         assert(value != 0xFFFFFFFFu);
 #else
-        --_counter;
+        concurrency::decrementAndNotify(_counter);
 #endif
     }
 
@@ -128,4 +128,78 @@ private:
     }
 };
 
+// StringBuilder that grows on demand, for output of unknown size. Reserve the expected size up front to keep it to a
+// single allocation. The result can be moved out with release().
+class DynamicStringBuilder
+{
+public:
+    explicit DynamicStringBuilder(const size_t reserveSize) { _data.reserve(reserveSize); }
+
+    DynamicStringBuilder& append(const std::string& string)
+    {
+        _data.append(string);
+        return *this;
+    }
+
+    DynamicStringBuilder& append(const char* string)
+    {
+        _data.append(string);
+        return *this;
+    }
+
+    DynamicStringBuilder& append(const char* string, const size_t length)
+    {
+        _data.append(string, length);
+        return *this;
+    }
+
+    DynamicStringBuilder& append(const int32_t value)
+    {
+        char valueString[16];
+        auto count = std::snprintf(valueString, 16, "%d", value);
+
+        return append(valueString, count);
+    }
+
+    DynamicStringBuilder& append(const uint32_t value)
+    {
+        char valueString[16];
+        auto count = std::snprintf(valueString, 16, "%u", value);
+
+        return append(valueString, count);
+    }
+
+    DynamicStringBuilder& append(const size_t value)
+    {
+        char valueString[24];
+        auto count = std::snprintf(valueString, 24, "%zu", value);
+
+        return append(valueString, count);
+    }
+
+    DynamicStringBuilder& append(const double value)
+    {
+        char valueString[24];
+        auto count = std::snprintf(valueString, 24, "%f", value);
+
+        return append(valueString, count);
+    }
+
+    utils::Span<const char> getSpan() const { return utils::Span<const char>(_data.c_str(), _data.size()); }
+
+    std::string build() const { return _data; }
+    std::string release() { return std::move(_data); }
+
+    const char* get() const { return _data.c_str(); }
+    size_t getLength() const { return _data.size(); }
+
+    void clear() { _data.clear(); }
+
+    bool endsWidth(char c) const { return !_data.empty() && _data.back() == c; }
+    bool empty() const { return _data.empty(); }
+
+private:
+    std::string _data;
+};
+
 } // namespace utils
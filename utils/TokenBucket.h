@@ -0,0 +1,81 @@
+#pragma once
+
+#include "utils/Time.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace utils
+{
+
+/**
+ * Token bucket refilled at a fixed rate up to a burst size. Credit is kept in token nanoseconds to avoid
+ * rounding loss on frequent refills. Not thread safe.
+ */
+class TokenBucket
+{
+public:
+    TokenBucket(uint64_t tokensPerSecond, uint64_t burst)
+        : _rate(tokensPerSecond),
+          _maxCredit(burst * utils::Time::sec),
+          _credit(_maxCredit),
+          _lastRefill(0),
+          _started(false)
+    {
+    }
+
+    void setRate(uint64_t tokensPerSecond, uint64_t burst)
+    {
+        _rate = tokensPerSecond;
+        _maxCredit = burst * utils::Time::sec;
+        _credit = std::min(_credit, _maxCredit);
+    }
+
+    bool consume(const uint64_t timestamp, const uint64_t tokens)
+    {
+        refill(timestamp);
+        const auto cost = tokens * utils::Time::sec;
+        if (_credit < cost)
+        {
+            return false;
+        }
+
+        _credit -= cost;
+        return true;
+    }
+
+    uint64_t getTokens(const uint64_t timestamp)
+    {
+        refill(timestamp);
+        return _credit / utils::Time::sec;
+    }
+
+private:
+    void refill(const uint64_t timestamp)
+    {
+        if (!_started)
+        {
+            _started = true;
+            _lastRefill = timestamp;
+            return;
+        }
+
+        const int64_t elapsed = utils::Time::diff(_lastRefill, timestamp);
+        if (elapsed <= 0 || _rate == 0)
+        {
+            return;
+        }
+        _lastRefill = timestamp;
+
+        // time to fill the bucket bounds the product below _maxCredit
+        const uint64_t fillTime = _maxCredit / _rate;
+        _credit = std::min(_maxCredit, _credit + std::min(static_cast<uint64_t>(elapsed), fillTime) * _rate);
+    }
+
+    uint64_t _rate;
+    uint64_t _maxCredit;
+    uint64_t _credit;
+    uint64_t _lastRefill;
+    bool _started;
+};
+
+} // namespace utils
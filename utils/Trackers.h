@@ -171,6 +171,26 @@ private:
     uint64_t _lastSnapshotUpdatedAt;
 };
 
+// Lock free accumulator of time spent on behalf of an owner, e.g. a conference. Charged from any thread.
+class CostTracker
+{
+public:
+    CostTracker() : _time(0), _count(0) {}
+
+    void add(uint64_t time, uint64_t count = 1)
+    {
+        _time.fetch_add(time, std::memory_order_relaxed);
+        _count.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    uint64_t getTime() const { return _time.load(std::memory_order_relaxed); }
+    uint64_t getCount() const { return _count.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic_uint64_t _time;
+    std::atomic_uint64_t _count;
+};
+
 class TimeGuard
 {
 public:
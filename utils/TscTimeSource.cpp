@@ -0,0 +1,177 @@
+#include "utils/TscTimeSource.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace
+{
+inline uint64_t readTsc()
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+inline uint64_t toNanoseconds(const uint64_t tsc, const uint64_t tscBase, const uint64_t nsBase, const uint64_t scale)
+{
+    // tsc may be slightly behind the base if it was read on another core before a resync
+    const int64_t ticks = static_cast<int64_t>(tsc - tscBase);
+    if (ticks >= 0)
+    {
+        return nsBase + static_cast<uint64_t>((static_cast<unsigned __int128>(ticks) * scale) >> 32);
+    }
+    return nsBase - static_cast<uint64_t>((static_cast<unsigned __int128>(-ticks) * scale) >> 32);
+}
+
+inline uint64_t toScale(const uint64_t nanoseconds, const uint64_t ticks)
+{
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(nanoseconds) << 32) / std::max(ticks, uint64_t(1)));
+}
+} // namespace
+
+namespace utils
+{
+
+TscTimeSource::TscTimeSource(const uint64_t resyncInterval)
+    : _resyncInterval(resyncInterval),
+      _tscUsed(isInvariantTscAvailable()),
+      _sequence(0),
+      _tscBase(0),
+      _nsBase(0),
+      _scale(0),
+      _resyncTicks(0)
+{
+    if (!_tscUsed)
+    {
+        return;
+    }
+
+    _origin = takeSample();
+    Time::rawNanoSleep(10 * Time::ms);
+    const auto sample = takeSample();
+    storeCalibration(sample.tsc,
+        sample.monotonic,
+        toScale(sample.monotonic - _origin.monotonic, sample.tsc - _origin.tsc));
+}
+
+bool TscTimeSource::isInvariantTscAvailable()
+{
+#if defined(__x86_64__)
+    uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+    {
+        return false;
+    }
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+uint64_t TscTimeSource::getAbsoluteTime() const
+{
+    if (!_tscUsed)
+    {
+        return Time::rawAbsoluteTime();
+    }
+
+    const uint64_t tsc = readTsc();
+    uint64_t tscBase, nsBase, scale, resyncTicks;
+    for (;;)
+    {
+        const auto sequence = _sequence.load(std::memory_order_acquire);
+        tscBase = _tscBase.load(std::memory_order_relaxed);
+        nsBase = _nsBase.load(std::memory_order_relaxed);
+        scale = _scale.load(std::memory_order_relaxed);
+        resyncTicks = _resyncTicks.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if ((sequence & 1) == 0 && _sequence.load(std::memory_order_relaxed) == sequence)
+        {
+            break;
+        }
+    }
+
+    if (static_cast<int64_t>(tsc - tscBase) > static_cast<int64_t>(resyncTicks))
+    {
+        resync();
+    }
+    return toNanoseconds(tsc, tscBase, nsBase, scale);
+}
+
+TscTimeSource::Sample TscTimeSource::takeSample()
+{
+    // keep the sample with the shortest clock read to bound the error from preemption
+    Sample best;
+    uint64_t bestSpan = std::numeric_limits<uint64_t>::max();
+    for (int i = 0; i < 5; ++i)
+    {
+        const auto start = readTsc();
+        const auto monotonic = Time::rawAbsoluteTime();
+        const auto span = readTsc() - start;
+        if (span < bestSpan)
+        {
+            bestSpan = span;
+            best.tsc = start + span / 2;
+            best.monotonic = monotonic;
+        }
+    }
+    return best;
+}
+
+void TscTimeSource::resync() const
+{
+    if (_resyncLock.test_and_set(std::memory_order_acquire))
+    {
+        return; // other thread is on it
+    }
+
+    const auto sample = takeSample();
+    const uint64_t estimate = toNanoseconds(sample.tsc,
+        _tscBase.load(std::memory_order_relaxed),
+        _nsBase.load(std::memory_order_relaxed),
+        _scale.load(std::memory_order_relaxed));
+
+    // rate measured since start converges on the true TSC frequency
+    const uint64_t rateScale = toScale(sample.monotonic - _origin.monotonic, sample.tsc - _origin.tsc);
+    const int64_t offset = Time::diff(estimate, sample.monotonic);
+    const int64_t maxSlew = static_cast<int64_t>(std::min(Time::ms, _resyncInterval / 8));
+
+    if (offset > maxSlew)
+    {
+        // behind the monotonic clock, stepping forward keeps time monotonic
+        storeCalibration(sample.tsc, sample.monotonic, rateScale);
+    }
+    else
+    {
+        // Continue from current estimate and reach the monotonic clock at the next resync. Time is never stepped
+        // back. If far ahead, it runs at no less than half rate over several intervals until the clock catches up.
+        const uint64_t resyncTicks = (static_cast<unsigned __int128>(_resyncInterval) << 32) / rateScale;
+        const int64_t slewedInterval =
+            std::max(static_cast<int64_t>(_resyncInterval) + offset, static_cast<int64_t>(_resyncInterval / 2));
+        storeCalibration(sample.tsc, estimate, toScale(slewedInterval, resyncTicks));
+    }
+
+    _resyncLock.clear(std::memory_order_release);
+}
+
+void TscTimeSource::storeCalibration(const uint64_t tscBase, const uint64_t nsBase, const uint64_t scale) const
+{
+    const auto sequence = _sequence.load(std::memory_order_relaxed);
+    _sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    _tscBase.store(tscBase, std::memory_order_relaxed);
+    _nsBase.store(nsBase, std::memory_order_relaxed);
+    _scale.store(scale, std::memory_order_relaxed);
+    _resyncTicks.store((static_cast<unsigned __int128>(_resyncInterval) << 32) / scale, std::memory_order_relaxed);
+
+    _sequence.store(sequence + 2, std::memory_order_release);
+}
+
+} // namespace utils
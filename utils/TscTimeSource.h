@@ -0,0 +1,52 @@
+#pragma once
+#include "utils/Time.h"
+#include <atomic>
+
+namespace utils
+{
+
+/**
+ * Time source reading the invariant TSC instead of the monotonic clock. The TSC is calibrated against
+ * CLOCK_MONOTONIC at start and resynchronized every resyncInterval. Offsets are slewed out over the next interval
+ * to keep time monotonic. Only a large lag behind the monotonic clock is stepped, forward. Falls back to the
+ * monotonic clock if the cpu has no invariant TSC.
+ */
+class TscTimeSource final : public TimeSource
+{
+public:
+    explicit TscTimeSource(uint64_t resyncInterval = Time::sec);
+
+    static bool isInvariantTscAvailable();
+    bool isTscUsed() const { return _tscUsed; }
+
+    uint64_t getAbsoluteTime() const override;
+
+    void nanoSleep(uint64_t nanoSeconds) override { Time::rawNanoSleep(nanoSeconds); }
+    std::chrono::system_clock::time_point wallClock() const override { return std::chrono::system_clock::now(); }
+    void advance(uint64_t nanoSeconds) override { Time::rawNanoSleep(nanoSeconds); }
+
+private:
+    struct Sample
+    {
+        uint64_t tsc = 0;
+        uint64_t monotonic = 0;
+    };
+
+    static Sample takeSample();
+    void resync() const;
+    void storeCalibration(uint64_t tscBase, uint64_t nsBase, uint64_t scale) const;
+
+    const uint64_t _resyncInterval;
+    bool _tscUsed;
+    Sample _origin;
+
+    // seqlock protected conversion, ns = nsBase + ((tsc - tscBase) * scale) >> 32
+    mutable std::atomic_uint32_t _sequence;
+    mutable std::atomic_uint64_t _tscBase;
+    mutable std::atomic_uint64_t _nsBase;
+    mutable std::atomic_uint64_t _scale;
+    mutable std::atomic_uint64_t _resyncTicks;
+    mutable std::atomic_flag _resyncLock = ATOMIC_FLAG_INIT;
+};
+
+} // namespace utils